@@ -7,33 +7,17 @@
 *  will try to get three in a row in order to win.
 *********************************************************************/
 #include "TicTacToe.hpp"
-
-/*********************************************************************
-** Description: Main function. Parameters set as required by SDL.
-*********************************************************************/
-int main( int argc, char** argv )
-{
-    const int SCREEN_WIDTH = 640,
-              SCREEN_HEIGHT = 480;
-
-    srand(time(NULL));
-
-    TicTacToe ticTacToe( SCREEN_WIDTH, SCREEN_HEIGHT);
-
-    ticTacToe.runGame();
-
-    ticTacToe.cleanUp();
-
-    return 0;
-}
+#include <cmath>
 
 /*********************************************************************
 ** Description: Constructor.
 *  Parameters:
 *  1. int width - width of the game window.
 *  2. int height - height of the game window.
+*  3. Random random - the random number generator used by the game.
 *********************************************************************/
-TicTacToe::TicTacToe( int width, int height ) :  ticTacToeGraphics( width, height )
+TicTacToe::TicTacToe( int width, int height, const Random& random ) :
+ticTacToeGraphics( width, height ), gameLogic( random ), random( random )
 {
     //Create the mouse buttons.
     ticTacToeButtons[0][0].setButtonSpecs(   0,   0, 150 , 150 ); 
@@ -45,25 +29,38 @@ TicTacToe::TicTacToe( int width, int height ) :  ticTacToeGraphics( width, heigh
     ticTacToeButtons[2][0].setButtonSpecs(   0, 330, 150 , 150 );
     ticTacToeButtons[2][1].setButtonSpecs( 165, 330, 150 , 150 );
     ticTacToeButtons[2][2].setButtonSpecs( 330, 330, 150 , 150 );
-    ticTacToeButtons[2][2].setButtonSpecs( 330, 330, 150 , 150 );
 
     //Play again button.
     playAgainButton.setButtonSpecs( 500, 100, 120, 120 );
 
-    drawGameCountdown = 9;
+    singleThreaded = false;
+    muted = false;
+    analysis = false;
+    mode = CLASSIC_MODE;
+    mnkWidth = 3;
+    mnkHeight = 3;
+    hoverCell = NO_CELL;
+    pendingClick = NO_CELL;
+    spectators = NULL;
+    trace = NULL;
+
+    frameCount = 0;
+    frameTimeSum = 0.0;
+    frameTimeSquares = 0.0;
+    frameTimeMax = 0.0;
 }
 
 /*********************************************************************
 ** Description: This function runs the game loop until the user clicks 
-*  the close window button.
+*  the close window button. This is the render thread: it turns input
+*  events into commands for the game logic and draws the latest
+*  snapshot the game logic published. With an input trace, the events
+*  polled are recorded, or the trace's events are pushed into the queue
+*  before each poll.
 *********************************************************************/
 void TicTacToe::runGame()
 {
-    //Randomly chooses player X or Player O to make the first move.
-    int randomPlayerStarts = rand() % 2;
-    ticTacToeGraphics.setTurn( randomPlayerStarts );
-    currentPlayer = static_cast<Player>(randomPlayerStarts);
-    previousPlayer = currentPlayer;
+    StartupProfiler::mark( "players and game setup" );
 
     //Initiate all the graphic components.
     if( !ticTacToeGraphics.startUp() )
@@ -74,187 +71,350 @@ void TicTacToe::runGame()
     else
     {
         bool quit = false; //Quits the game.
-        bool endLoop = false; //Exits button event loop.
-        bool mousebButtonClicked = false;
-        bool endRoundLoop = false; //Enters the post-round loop if true.
-
-        Outcome gameState = UNFINISHED;
-        MouseButtons* currentButton = nullptr; //Current mouse button clicked.
         SDL_Event event; //Polling event.
 
+        //The wall is silent; a game without an audio device too. The
+        //audio starts after the first frame, and its cues are silent
+        //until then.
+        bool sound = !muted && spectators == NULL;
+
+        if( sound )
+        {
+            gameLogic.setAudio( &audio );
+        }
+
+        if( !singleThreaded && spectators != NULL )
+        {
+            spectators->start();
+        }
+
+        else if( !singleThreaded )
+        {
+            gameLogic.start();
+        }
+
+        Uint64 frequency = SDL_GetPerformanceFrequency();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+
+        if( trace != NULL )
+        {
+            trace->begin();
+        }
+
         //Running game loop.
         while( !quit )
         {
-            endLoop = false;
+            PROFILE_SCOPE( "frame" );
 
             //Poll for input events.
-            while( SDL_PollEvent( &event ) != 0 )
             {
-                mousebButtonClicked = false;
+                PROFILE_SCOPE( "pollEvents" );
 
-                if( event.type == SDL_QUIT )
+                if( trace != NULL )
                 {
-                    quit = true;
+                    trace->replay( frameCount );
                 }
 
-                else
+                while( SDL_PollEvent( &event ) != 0 )
                 {
-                    //Checks the buttons to see if any are clicked.
-                    for( unsigned i = 0; i < 3 && !endLoop; i++ )
+                    if( trace != NULL )
                     {
-                        for( unsigned j = 0; j < 3 && !endLoop; j++ )
-                        {
-                            //Checks for hover over mouse and valid mouse click.
-                            ticTacToeButtons[i][j].handleEvent( &event );
-
-                            if( ticTacToeButtons[i][j].getMouseOver() == true )
-                            {
-                                endLoop = true;
-                                currentButton = &ticTacToeButtons[i][j];
-                                mousebButtonClicked = ticTacToeButtons[i][j].getMouseClick();
-                            }
-                        }
+                        trace->record( event, frameCount );
                     }
-                }
-            }
 
-            //To get the game order right.
-            previousPlayer = currentPlayer;
-
-            if( mousebButtonClicked && currentButton->getPick() == No_Player )
-            {
-                drawGameCountdown--;
-                currentPlayer = static_cast<Player> ( 1 - static_cast<int>( currentPlayer ) );
-            }
-
-            //Render the graphic to the screen.
-            ticTacToeGraphics.drawGame( currentButton, previousPlayer, gameState );
+                    if( event.type == SDL_QUIT )
+                    {
+                        quit = true;
+                    }
 
-            //Check the game status.
-            gameState = checkGame();
+                    else if( event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F12 )
+                    {
+                        exportProfile();
+                    }
 
-            if( gameState != UNFINISHED )
-                endRoundLoop = true;
+                    else if( event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_t )
+                    {
+                        nextTheme();
+                    }
 
-            //Post-round loop. 
-            while( endRoundLoop )
-            {
-                while( SDL_PollEvent( &event ) != 0 )
-                {
-                    currentButton = nullptr;
-                    mousebButtonClicked = false;
+                    else if( event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_a )
+                    {
+                        analysis = !analysis;
+                    }
 
-                    if( event.type == SDL_QUIT )
+                    //The contents of render target textures were lost.
+                    else if( event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET )
                     {
-                        endRoundLoop = false;
+                        ticTacToeGraphics.resetRenderTargets();
                     }
 
                     else
                     {
-                        //Check to see if the user clicked the play again button.
-                        playAgainButton.handleEvent( &event );
-
-                        if( playAgainButton.getMouseOver() == true )
-                        {
-                            currentButton = &playAgainButton;
-                            mousebButtonClicked = playAgainButton.getMouseClick();
-
-                            //Clicking the play again button will reset
-                            //the Tic Tac Toe buttons and variables.
-                            if( mousebButtonClicked )
-                            {
-                                endRoundLoop = false;
-                                quit = false;
-                                gameState = UNFINISHED;
-                                currentButton = nullptr;
-                                drawGameCountdown = 9;
-                                mousebButtonClicked = false;
-                                ticTacToeGraphics.reset();
-                                playAgainButton.reset();
-
-                                for( unsigned i = 0; i < 3; i++ )
-                                {
-                                    for( unsigned j = 0; j < 3; j++ )
-                                    {
-                                        ticTacToeButtons[i][j].reset();
-                                    }
-                                }
-
-                                randomPlayerStarts = rand() % 2;
-                                ticTacToeGraphics.setTurn( randomPlayerStarts );
-                                currentPlayer = static_cast<Player>(randomPlayerStarts);
-                                previousPlayer = currentPlayer;
-                            }
-                        }
+                        handleInput( &event );
                     }
-                }    
+                }
+
+                sendPendingClick();
+            }
+
+            //Render the graphic to the screen.
+            if( spectators != NULL )
+            {
+                if( singleThreaded )
+                {
+                    spectators->step();
+                }
 
-                ticTacToeGraphics.drawGame( currentButton, previousPlayer, gameState );
+                ticTacToeGraphics.drawWall( spectators->latestSnapshot() );
+            }
+
+            else
+            {
+                if( singleThreaded )
+                {
+                    gameLogic.step();
+                }
+
+                drawGame();
+            }
+
+            Uint64 frameEnd = SDL_GetPerformanceCounter();
+            recordFrameTime( 1000.0 * ( frameEnd - frameStart ) / frequency );
+            frameStart = frameEnd;
+
+            if( frameCount == 1 )
+            {
+                StartupProfiler::mark( "first frame" );
+                StartupProfiler::report();
+
+                if( sound )
+                {
+                    audio.startUp();
+                }
             }
         }
+
+        gameLogic.stop();
+        analyzer.stop();
+
+        if( spectators != NULL )
+        {
+            spectators->stop();
+        }
+
+        printFrameTimes();
+        audio.reportLatency();
+    }
+}
+
+/*********************************************************************
+** Description: Draws the latest snapshot, shaded with the analysis of
+*  its position when the analysis is on. The analyzer is started the
+*  first time and asked for each new position; whatever it has solved
+*  so far is drawn, so the frame never waits for it. Ultimate and Qubic
+*  positions are too large to solve and are not analyzed.
+*********************************************************************/
+void TicTacToe::drawGame()
+{
+    const GameSnapshot &snapshot = gameLogic.latestSnapshot();
+
+    if( !analysis || snapshot.outcome != UNFINISHED || ( mode != CLASSIC_MODE && mode != MNK_MODE ) )
+    {
+        ticTacToeGraphics.drawGame( snapshot );
+        return;
     }
+
+    analyzer.start();
+    analyzer.request( mode == CLASSIC_MODE ? Analyzer::fromBoard( snapshot.board, snapshot.turn ) : snapshot.mnk );
+
+    ticTacToeGraphics.drawGame( snapshot, &analyzer.latest() );
 }
 
 /*********************************************************************
-** Description: Checks for winning conditions of Tic Tac Toe.
-*  
-*  Return: Outcome - the Outcome enum type. Represents the outcome of
-*  the game.
+** Description: Switches to the next theme, and prints it with the
+*  texture memory in use before the new theme is drawn.
 *********************************************************************/
-Outcome TicTacToe::checkGame()
+void TicTacToe::nextTheme()
 {
-    Outcome gameOutcome = UNFINISHED; //Resets outcome.
-
-    //All winning conditions.
-  	if(    ( ticTacToeButtons[0][0].getPick() == previousPlayer
-          && ticTacToeButtons[1][0].getPick() == previousPlayer 
-          && ticTacToeButtons[2][0].getPick() == previousPlayer ) 
-
-        || ( ticTacToeButtons[0][1].getPick() == previousPlayer 
-          && ticTacToeButtons[1][1].getPick() == previousPlayer 
-          && ticTacToeButtons[2][1].getPick() == previousPlayer )
-
-        || ( ticTacToeButtons[0][2].getPick() == previousPlayer 
-          && ticTacToeButtons[1][2].getPick() == previousPlayer 
-          && ticTacToeButtons[2][2].getPick() == previousPlayer ) 
-
-        || ( ticTacToeButtons[0][0].getPick() == previousPlayer 
-          && ticTacToeButtons[0][1].getPick() == previousPlayer 
-          && ticTacToeButtons[0][2].getPick() == previousPlayer )
-
-        || ( ticTacToeButtons[1][0].getPick() == previousPlayer 
-          && ticTacToeButtons[1][1].getPick() == previousPlayer 
-          && ticTacToeButtons[1][2].getPick() == previousPlayer ) 
-
-        || ( ticTacToeButtons[2][0].getPick() == previousPlayer  
-          && ticTacToeButtons[2][1].getPick() == previousPlayer 
-          && ticTacToeButtons[2][2].getPick() == previousPlayer ) 
-
-        || ( ticTacToeButtons[0][0].getPick() == previousPlayer  
-          && ticTacToeButtons[1][1].getPick() == previousPlayer 
-          && ticTacToeButtons[2][2].getPick() == previousPlayer ) 
-
-        || ( ticTacToeButtons[2][0].getPick() == previousPlayer  
-          && ticTacToeButtons[1][1].getPick() == previousPlayer 
-          && ticTacToeButtons[0][2].getPick() == previousPlayer ) )
-    {    
-        if( previousPlayer == X_Player )
+    int next = ( &ticTacToeGraphics.getTheme() - THEMES + 1 ) % THEME_COUNT;
+
+    if( !ticTacToeGraphics.setTheme( THEMES[next] ) )
+    {
+        printf( "Theme %s could not be loaded.\n", THEMES[next].name );
+    }
+
+    printf( "Theme %s, %.2f MB of textures.\n", ticTacToeGraphics.getTheme().name, 
+            ticTacToeGraphics.getTextureBytes() / 1048576.0 );
+}
+
+/*********************************************************************
+** Description: Checks the buttons for the mouse and sends hovers and
+*  clicks to the game logic. When the command queue is full, a hover is
+*  sent again with the next mouse motion, and a click is kept to send
+*  again each frame; a newer click replaces a kept one.
+*
+*  Parameters: SDL_Event* event - the polled event.
+*********************************************************************/
+void TicTacToe::handleInput( SDL_Event* event )
+{
+    if( spectators != NULL )
+    {
+        if( event->type == SDL_MOUSEWHEEL )
         {
-            gameOutcome = X_WON;
+            ticTacToeGraphics.scrollWall( -event->wheel.y * 40 );
         }
-        
-        else if( previousPlayer == O_Player )
+
+        return;
+    }
+
+    if( event->type != SDL_MOUSEMOTION && event->type != SDL_MOUSEBUTTONDOWN )
+    {
+        return;
+    }
+
+    int cell = NO_CELL;
+
+    //The other modes have too many cells for a button each.
+    if( mode != CLASSIC_MODE )
+    {
+        int x = event->type == SDL_MOUSEMOTION ? event->motion.x : event->button.x,
+            y = event->type == SDL_MOUSEMOTION ? event->motion.y : event->button.y;
+
+        if( mode == ULTIMATE_MODE )
+            cell = GraphicsHandler::ultimateCellAt( x, y );
+
+        else if( mode == QUBIC_MODE )
+            cell = GraphicsHandler::qubicCellAt( x, y );
+
+        else
+            cell = GraphicsHandler::mnkCellAt( x, y, mnkWidth, mnkHeight );
+    }
+
+    //Checks for hover over mouse.
+    for( int i = 0; i < 3 && cell == NO_CELL && mode == CLASSIC_MODE; i++ )
+    {
+        for( int j = 0; j < 3 && cell == NO_CELL; j++ )
         {
-            gameOutcome = O_WON;
+            ticTacToeButtons[i][j].handleEvent( event );
+
+            if( ticTacToeButtons[i][j].getMouseOver() )
+            {
+                cell = i * 3 + j;
+            }
         }
     }
 
-    else if( drawGameCountdown < 1 )
+    playAgainButton.handleEvent( event );
+
+    if( cell == NO_CELL && playAgainButton.getMouseOver() )
+    {
+        cell = PLAY_AGAIN_CELL;
+    }
+
+    if( cell != hoverCell && gameLogic.send( InputCommand( InputCommand::HOVER, cell ) ) )
+    {
+        hoverCell = cell;
+    }
+
+    if( event->type == SDL_MOUSEBUTTONDOWN && cell != NO_CELL )
+    {
+        sendPendingClick();
+
+        if( pendingClick != NO_CELL || !gameLogic.send( InputCommand( InputCommand::CLICK, cell ) ) )
+        {
+            if( pendingClick == NO_CELL )
+            {
+                printf( "The game logic is not taking input; the click waits.\n" );
+            }
+
+            pendingClick = cell;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Sends the click the command queue was too full to take,
+*  if there is one and the queue has room now.
+*********************************************************************/
+void TicTacToe::sendPendingClick()
+{
+    if( pendingClick != NO_CELL && gameLogic.send( InputCommand( InputCommand::CLICK, pendingClick ) ) )
+    {
+        pendingClick = NO_CELL;
+    }
+}
+
+/*********************************************************************
+** Description: Chooses between classic Tic Tac Toe, Ultimate Tic Tac
+*  Toe, Qubic and an m,n,k game. Call before setPlayer().
+*
+*  Parameters: GameMode mode - CLASSIC_MODE, ULTIMATE_MODE, QUBIC_MODE
+*  or MNK_MODE.
+*********************************************************************/
+void TicTacToe::setMode( GameMode mode )
+{
+    this->mode = mode;
+    gameLogic.setMode( mode );
+}
+
+/*********************************************************************
+** Description: Sets the board size of the m,n,k mode. Call before
+*  setMode().
+*
+*  Parameters: int width, int height, int k - a size that passes
+*  MnkPosition::validSize().
+*********************************************************************/
+void TicTacToe::setMnkSize( int width, int height, int k )
+{
+    mnkWidth = width;
+    mnkHeight = height;
+    gameLogic.setMnkSize( width, height, k );
+}
+
+/*********************************************************************
+** Description: Adds a frame to the frame time statistics.
+*
+*  Parameters: double milliseconds - the time the frame took.
+*********************************************************************/
+void TicTacToe::recordFrameTime( double milliseconds )
+{
+    frameCount++;
+    frameTimeSum += milliseconds;
+    frameTimeSquares += milliseconds * milliseconds;
+
+    if( milliseconds > frameTimeMax )
+    {
+        frameTimeMax = milliseconds;
+    }
+}
+
+/*********************************************************************
+** Description: Prints the mean, jitter (standard deviation) and worst
+*  frame time of the session.
+*********************************************************************/
+void TicTacToe::printFrameTimes()
+{
+    if( frameCount > 0 )
     {
-        gameOutcome = DRAW;
+        double mean = frameTimeSum / frameCount;
+        double variance = frameTimeSquares / frameCount - mean * mean;
+
+        printf( "Frames: %lld, mean %.2f ms, jitter %.2f ms, worst %.2f ms (%s)\n",
+                frameCount, mean, variance > 0.0 ? sqrt( variance ) : 0.0, frameTimeMax,
+                singleThreaded ? "single thread" : "game logic thread" );
+    }
+}
+
+/*********************************************************************
+** Description: Writes the frame profile to the path given with
+*  setProfilePath(). Does nothing while profiling is off.
+*********************************************************************/
+void TicTacToe::exportProfile()
+{
+    if( Profiler::isEnabled() && !profilePath.empty() )
+    {
+        Profiler::exportTrace( profilePath );
     }
-	
-	return gameOutcome;	
 }
 
 /*********************************************************************
@@ -262,5 +422,52 @@ Outcome TicTacToe::checkGame()
 *********************************************************************/
 void TicTacToe::cleanUp()
 {
+    gameLogic.setAudio( NULL );
+    audio.cleanUp();
     ticTacToeGraphics.cleanUp();
+
+    delete spectators;
+    spectators = NULL;
+}
+
+/*********************************************************************
+** Description: Hands one side of the game to a computer player.
+*
+*  Parameters: Player side - X_Player or O_Player.
+*              AiPlayer* player - the player, owned by the game from now
+*              on, or NULL for a human.
+*********************************************************************/
+void TicTacToe::setPlayer( Player side, AiPlayer* player )
+{
+    gameLogic.setPlayer( side, player );
+}
+
+/*********************************************************************
+** Description: Gives one side of every game of the wall a computer
+*  player of its own. Call after setSpectators().
+*
+*  Parameters: Player side - X_Player or O_Player.
+*              string spec - the player description. The wall plays
+*              random moves for a human.
+*********************************************************************/
+void TicTacToe::setWallPlayer( Player side, const string &spec )
+{
+    if( spectators != NULL )
+    {
+        spectators->setPlayer( side, spec );
+    }
+}
+
+/*********************************************************************
+** Description: Shows a wall of games between computer players instead
+*  of a game to play. The mouse wheel scrolls through the wall.
+*
+*  Parameters: int count - the number of games.
+*              int size - the width of a board in pixels.
+*********************************************************************/
+void TicTacToe::setSpectators( int count, int size )
+{
+    delete spectators;
+    spectators = new SpectatorWall( count, random.split( 3 ) );
+    ticTacToeGraphics.setWallBoardSize( size );
 }
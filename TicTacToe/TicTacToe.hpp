@@ -11,28 +11,86 @@
 
 #include "mouseButtons.hpp"
 #include "graphicsHandler.hpp"
+#include "gameLogic.hpp"
+#include "audioHandler.hpp"
+#include "random.hpp"
+#include "profiler.hpp"
+#include "inputTrace.hpp"
 #include <SDL.h>
 #include <cstdlib>
-#include <ctime>
 
 class TicTacToe
 {
     private:
-        Player currentPlayer,
-               previousPlayer;
-
         MouseButtons ticTacToeButtons[3][3];
         MouseButtons playAgainButton;
 
         GraphicsHandler ticTacToeGraphics;
 
-        int drawGameCountdown;
+        GameLogic gameLogic; //Runs the game rules.
+
+        AudioHandler audio; //Plays the cues the game logic asks for.
+        bool muted; //Leaves the audio device closed.
+
+        Analyzer analyzer; //Solves the empty cells of the board.
+        bool analysis; //Shades the board with the analysis.
+
+        bool singleThreaded; //Runs the game logic on the render thread.
+
+        GameMode mode;
+        int mnkWidth, //Board size of the m,n,k mode.
+            mnkHeight;
+
+        int hoverCell; //Last hovered cell sent to the game logic.
+        int pendingClick; //Click the full command queue could not take yet, or NO_CELL.
+
+        SpectatorWall* spectators; //Games shown instead of the board, or NULL.
+        Random random;
+
+        string profilePath; //Where F12 writes the frame profile.
+
+        InputTrace* trace; //Records or replays the input, or NULL.
+
+        //Frame time statistics in milliseconds.
+        long long frameCount;
+        double frameTimeSum,
+               frameTimeSquares,
+               frameTimeMax;
+
+        //Private functions.
+        void handleInput( SDL_Event* );
+        void sendPendingClick();
+        void nextTheme();
+        void drawGame();
+        void recordFrameTime( double );
+        void printFrameTimes();
 
     public:
-        TicTacToe( int, int );
-        Outcome checkGame();
+        TicTacToe( int, int, const Random& );
         void runGame();
+        void exportProfile();
+        void setProfilePath( const string &path ) { profilePath = path; };
+        void setSingleThreaded( bool single ) { singleThreaded = single; };
+        void setOpenGl( bool openGl ) { ticTacToeGraphics.setOpenGl( openGl ); };
+        void setFastStartup( bool fast ) { ticTacToeGraphics.setFastStartup( fast ); };
+        void setOffscreen( bool memory ) { ticTacToeGraphics.setOffscreen( memory ); };
+        void setInputTrace( InputTrace* input ) { trace = input; };
+        void setCapture( FrameCapture* frames ) { ticTacToeGraphics.setCapture( frames ); };
+        void setTheme( const Theme &theme ) { ticTacToeGraphics.setTheme( theme ); };
+        void setTextureBudget( long long budget ) { ticTacToeGraphics.setTextureBudget( budget ); };
+        void setSlowAiDelay( int delay ) { gameLogic.setSlowAiDelay( delay ); };
+        void setAudioBufferSize( int size ) { audio.setBufferSize( size ); };
+        void setMuted( bool mute ) { muted = mute; };
+        void setAnalysis( bool on ) { analysis = on; };
+        void setPlayer( Player, AiPlayer* );
+        void setWallPlayer( Player, const string & );
+        void setSpectators( int, int );
+        void setMode( GameMode );
+        void setMnkSize( int, int, int );
         void cleanUp();
+
+        //Getter functions.
+        long long getFrameCount() const { return frameCount; };
 };
 
 #endif
@@ -0,0 +1,512 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AiPlayer class is the interface of a computer
+*  player that can take either side of a game. createPlayer() builds
+*  one from a text description such as "mcts:playouts=5000", so the
+*  game and the tools can choose players on the command line. Players
+*  that also play Ultimate Tic Tac Toe, Qubic or m,n,k games override
+*  chooseUltimateMove(), chooseQubicMove() or chooseMnkMove().
+*********************************************************************/
+#include "aiPlayer.hpp"
+#include "perfectPlayer.hpp"
+#include "alphaBetaPlayer.hpp"
+#include "tablePlayer.hpp"
+#include "enginePlayer.hpp"
+#include "bookPlayer.hpp"
+#include "tdPlayer.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+//Smallest MCTS node pool: the root and the children of one expansion,
+//in the mode with the most moves.
+static const int MOST_MOVES_A = GamePosition::MAX_MOVES > UltimatePosition::MAX_MOVES ? GamePosition::MAX_MOVES
+                                                                                    : UltimatePosition::MAX_MOVES;
+static const int MOST_MOVES_B = QubicPosition::MAX_MOVES > MnkPosition::MAX_MOVES ? QubicPosition::MAX_MOVES
+                                                                                  : MnkPosition::MAX_MOVES;
+static const int MIN_POOL_SIZE = 1 + ( MOST_MOVES_A > MOST_MOVES_B ? MOST_MOVES_A : MOST_MOVES_B );
+
+/*********************************************************************
+** Description: Chooses a random legal move.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int RandomPlayer::chooseMove( const GamePosition &position )
+{
+    int moves[GamePosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return count > 0 ? moves[random.nextInt( count )] : -1;
+}
+
+/*********************************************************************
+** Description: Chooses a random legal move of Ultimate Tic Tac Toe.
+*
+*  Parameters: UltimatePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int RandomPlayer::chooseUltimateMove( const UltimatePosition &position )
+{
+    int moves[UltimatePosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return count > 0 ? moves[random.nextInt( count )] : -1;
+}
+
+/*********************************************************************
+** Description: Chooses a random legal move of Qubic.
+*
+*  Parameters: QubicPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int RandomPlayer::chooseQubicMove( const QubicPosition &position )
+{
+    int moves[QubicPosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return count > 0 ? moves[random.nextInt( count )] : -1;
+}
+
+/*********************************************************************
+** Description: Chooses a random legal move of an m,n,k game.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int RandomPlayer::chooseMnkMove( const MnkPosition &position )
+{
+    int moves[MnkPosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return count > 0 ? moves[random.nextInt( count )] : -1;
+}
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters: MctsSettings settings - the search budget.
+*              Random random - seeds the searches.
+*********************************************************************/
+MctsPlayer::MctsPlayer( const MctsSettings &settings, const Random &random )
+    : settings( settings ), random( random )
+{
+    search = NULL;
+    ultimateSearch = NULL;
+    qubicSearch = NULL;
+    mnkSearch = NULL;
+}
+
+/*********************************************************************
+** Description: Destructor. Frees the searches.
+*********************************************************************/
+MctsPlayer::~MctsPlayer()
+{
+    delete search;
+    delete ultimateSearch;
+    delete qubicSearch;
+    delete mnkSearch;
+}
+
+/*********************************************************************
+** Description: Searches a Tic Tac Toe position.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int MctsPlayer::chooseMove( const GamePosition &position )
+{
+    if( search == NULL )
+    {
+        search = new Mcts< GamePosition >( settings, random );
+    }
+
+    return search->search( position );
+}
+
+/*********************************************************************
+** Description: Searches an Ultimate Tic Tac Toe position.
+*
+*  Parameters: UltimatePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int MctsPlayer::chooseUltimateMove( const UltimatePosition &position )
+{
+    if( ultimateSearch == NULL )
+    {
+        ultimateSearch = new Mcts< UltimatePosition >( settings, random.split( 1 ) );
+    }
+
+    return ultimateSearch->search( position );
+}
+
+/*********************************************************************
+** Description: Searches a Qubic position.
+*
+*  Parameters: QubicPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int MctsPlayer::chooseQubicMove( const QubicPosition &position )
+{
+    if( qubicSearch == NULL )
+    {
+        qubicSearch = new Mcts< QubicPosition >( settings, random.split( 2 ) );
+    }
+
+    return qubicSearch->search( position );
+}
+
+/*********************************************************************
+** Description: Searches a position of an m,n,k game.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int MctsPlayer::chooseMnkMove( const MnkPosition &position )
+{
+    if( mnkSearch == NULL )
+    {
+        mnkSearch = new Mcts< MnkPosition >( settings, random.split( 3 ) );
+    }
+
+    return mnkSearch->search( position );
+}
+
+/*********************************************************************
+** Description: Reads a whole number option value.
+*
+*  Parameters: const char* value - the text after the '='.
+*              long long number - receives the number.
+*
+*  Return: bool - false if the value is empty or not a number.
+*********************************************************************/
+static bool parseInteger( const char* value, long long &number )
+{
+    char* end = NULL;
+    number = strtoll( value, &end, 10 );
+
+    return end != value && *end == '\0';
+}
+
+/*********************************************************************
+** Description: Reads the options of an MCTS player, given as a comma
+*  separated list: playouts=N, time=MS, threads=N, nodes=N, c=X and
+*  verbose=0 or 1. A node pool must hold the root and the children of
+*  one expansion in the mode with the most moves.
+*
+*  Parameters: string options - the text after "mcts:".
+*              MctsSettings settings - receives the options.
+*
+*  Return: bool - false if an option is not recognized or its value is
+*  not valid.
+*********************************************************************/
+static bool parseMctsOptions( const string &options, MctsSettings &settings )
+{
+    size_t start = 0;
+    bool playoutsGiven = false;
+
+    while( start < options.size() )
+    {
+        size_t end = options.find( ',', start );
+
+        if( end == string::npos )
+        {
+            end = options.size();
+        }
+
+        string option = options.substr( start, end - start );
+        size_t equals = option.find( '=' );
+
+        if( equals == string::npos )
+        {
+            printf( "Missing value in player option \"%s\".\n", option.c_str() );
+            return false;
+        }
+
+        string key = option.substr( 0, equals );
+        const char* value = option.c_str() + equals + 1;
+        long long number = 0;
+        char* valueEnd = NULL;
+
+        if( key == "c" )
+        {
+            settings.exploration = strtod( value, &valueEnd );
+
+            if( valueEnd == value || *valueEnd != '\0' )
+            {
+                printf( "Player option \"%s\" needs a number.\n", option.c_str() );
+                return false;
+            }
+        }
+
+        else if( key != "playouts" && key != "time" && key != "threads" && key != "nodes" && key != "verbose" )
+        {
+            printf( "Unknown player option \"%s\".\n", key.c_str() );
+            return false;
+        }
+
+        else if( !parseInteger( value, number ) )
+        {
+            printf( "Player option \"%s\" needs a whole number.\n", option.c_str() );
+            return false;
+        }
+
+        else if( key == "playouts" )
+        {
+            settings.playouts = static_cast<int>( number );
+            playoutsGiven = true;
+        }
+
+        else if( key == "time" )
+            settings.timeBudget = static_cast<int>( number );
+
+        else if( key == "threads" )
+            settings.threads = static_cast<int>( number );
+
+        else if( key == "nodes" )
+        {
+            if( number < MIN_POOL_SIZE || number > 0xFFFFFFFFLL )
+            {
+                printf( "Player option \"%s\" needs at least %d nodes.\n", option.c_str(), MIN_POOL_SIZE );
+                return false;
+            }
+
+            settings.poolSize = static_cast<unsigned>( number );
+        }
+
+        else
+            settings.verbose = number != 0;
+
+        start = end + 1;
+    }
+
+    //A time budget on its own replaces the default playout budget.
+    if( settings.timeBudget > 0 && !playoutsGiven )
+    {
+        settings.playouts = 0;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Reads the time control at the front of an engine
+*  player's description, "time=MS," or "clock=MS+INC,", and leaves the
+*  engine's command line. Without one the engine gets a second a move.
+*
+*  Parameters: string options - the text after "engine:".
+*              TimeControl control - receives the time control.
+*              string command - receives the engine's command line.
+*
+*  Return: bool - false if the time control is not understood.
+*********************************************************************/
+static bool parseEngineOptions( const string &options, TimeControl &control, string &command )
+{
+    command = options;
+
+    if( options.compare( 0, 5, "time=" ) != 0 && options.compare( 0, 6, "clock=" ) != 0 )
+    {
+        return true;
+    }
+
+    size_t comma = options.find( ',' );
+
+    if( comma == string::npos )
+    {
+        printf( "Missing engine command in \"%s\".\n", options.c_str() );
+        return false;
+    }
+
+    command = options.substr( comma + 1 );
+
+    if( options[0] == 't' )
+    {
+        control.moveTime = atoi( options.c_str() + 5 );
+        return control.moveTime > 0;
+    }
+
+    control.moveTime = 0;
+    control.clock = atoi( options.c_str() + 6 );
+
+    size_t plus = options.find( '+' );
+
+    if( plus != string::npos && plus < comma )
+    {
+        control.increment = atoi( options.c_str() + plus + 1 );
+    }
+
+    return control.clock > 0;
+}
+
+/*********************************************************************
+** Description: Creates a player from its description: "human",
+*  "random", "perfect", "alphabeta[:depth=N]", "table[:DIR]",
+*  "mcts[:options]", "engine:[time=MS,|clock=MS+INC,]COMMAND" or
+*  "book:FILE[,SPEC]", which plays from an opening book and then as
+*  the player SPEC, "mcts" by default, or "td:FILE", which plays from
+*  a learned value table.
+*
+*  Parameters: string spec - the player description.
+*              Random random - seeds the player.
+*
+*  Return: AiPlayer* - a new player owned by the caller, or NULL for a
+*  human player, an unknown description, an engine that did not start
+*  or a book or value table that could not be opened.
+*********************************************************************/
+AiPlayer* createPlayer( const string &spec, const Random &random )
+{
+    size_t colon = spec.find( ':' );
+    string name = spec.substr( 0, colon );
+    string options = colon == string::npos ? "" : spec.substr( colon + 1 );
+
+    if( name == "random" )
+    {
+        return new RandomPlayer( random );
+    }
+
+    if( name == "perfect" )
+    {
+        return new PerfectPlayer( random );
+    }
+
+    if( name == "alphabeta" )
+    {
+        int depth = GameBoard::CELLS;
+
+        if( options.compare( 0, 6, "depth=" ) == 0 )
+        {
+            depth = atoi( options.c_str() + 6 );
+        }
+
+        else if( !options.empty() )
+        {
+            printf( "Unknown player option \"%s\".\n", options.c_str() );
+            return NULL;
+        }
+
+        return new AlphaBetaPlayer( depth, random );
+    }
+
+    if( name == "table" )
+    {
+        return new TablePlayer( options.empty() ? "tables" : options, random );
+    }
+
+    if( name == "mcts" )
+    {
+        MctsSettings settings;
+        settings.verbose = true;
+
+        if( !parseMctsOptions( options, settings ) )
+        {
+            return NULL;
+        }
+
+        return new MctsPlayer( settings, random );
+    }
+
+    if( name == "engine" )
+    {
+        TimeControl control;
+        string command;
+
+        if( !parseEngineOptions( options, control, command ) || command.empty() )
+        {
+            printf( "Unknown engine player \"%s\".\n", spec.c_str() );
+            return NULL;
+        }
+
+        EnginePlayer* player = new EnginePlayer( control, random );
+
+        if( !player->start( command ) )
+        {
+            delete player;
+            return NULL;
+        }
+
+        return player;
+    }
+
+    if( name == "book" )
+    {
+        size_t comma = options.find( ',' );
+        string path = options.substr( 0, comma );
+        AiPlayer* fallback = createPlayer( comma == string::npos ? "mcts" : options.substr( comma + 1 ), random.split( 1 ) );
+
+        if( fallback == NULL )
+        {
+            printf( "An opening book needs a computer player to play after it.\n" );
+            return NULL;
+        }
+
+        BookPlayer* player = new BookPlayer( fallback );
+
+        if( !player->open( path ) )
+        {
+            printf( "Could not open the opening book \"%s\".\n", path.c_str() );
+            delete player;
+            return NULL;
+        }
+
+        return player;
+    }
+
+    if( name == "td" )
+    {
+        TdPlayer* player = new TdPlayer( random );
+
+        if( !player->load( options ) )
+        {
+            printf( "Could not open the value table \"%s\".\n", options.c_str() );
+            delete player;
+            return NULL;
+        }
+
+        return player;
+    }
+
+    if( name != "human" )
+    {
+        printf( "Unknown player \"%s\", using a human player.\n", spec.c_str() );
+    }
+
+    return NULL;
+}
+
+/*********************************************************************
+** Description: Turns a classic position into the 3x3 k=3 position of
+*  the m,n,k game, so players of that game also play classic games.
+*
+*  Parameters: GamePosition position - the classic position.
+*
+*  Return: MnkPosition - the same position, with the same cells.
+*********************************************************************/
+MnkPosition toMnkPosition( const GamePosition &position )
+{
+    const GameBoard &board = position.getBoard();
+    int ply = board.getMoveCount();
+    Player first = ply % 2 == 0 ? position.getToMove() : GameBoard::other( position.getToMove() );
+    uint16_t marks[2] = { board.getMarks( first ), board.getMarks( GameBoard::other( first ) ) };
+
+    //Replay the marks alternately. Neither player has a line, so no
+    //order of them ends the game early.
+    MnkPosition mnk( 3, 3, 3, first );
+
+    for( int m = 0; m < ply; m++ )
+    {
+        uint16_t &next = marks[m % 2];
+        mnk.play( __builtin_ctz( next ) );
+        next &= next - 1;
+    }
+
+    return mnk;
+}
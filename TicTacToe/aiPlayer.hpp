@@ -0,0 +1,100 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AiPlayer class is the interface of a computer
+*  player that can take either side of a game. createPlayer() builds
+*  one from a text description such as "mcts:playouts=5000", so the
+*  game and the tools can choose players on the command line. Players
+*  that also play Ultimate Tic Tac Toe, Qubic or m,n,k games override
+*  chooseUltimateMove(), chooseQubicMove() or chooseMnkMove().
+*********************************************************************/
+#ifndef AI_PLAYER_HPP
+#define AI_PLAYER_HPP
+
+#include "gamePosition.hpp"
+#include "ultimatePosition.hpp"
+#include "qubicPosition.hpp"
+#include "mnkPosition.hpp"
+#include "mcts.hpp"
+#include "random.hpp"
+#include <string>
+
+using std::string;
+
+class AiPlayer
+{
+    public:
+        virtual ~AiPlayer() {};
+        virtual int chooseMove( const GamePosition & ) = 0;
+        virtual string getName() const = 0;
+
+        virtual bool playsUltimate() const { return false; };
+        virtual int chooseUltimateMove( const UltimatePosition & ) { return -1; };
+
+        virtual bool playsQubic() const { return false; };
+        virtual int chooseQubicMove( const QubicPosition & ) { return -1; };
+
+        virtual bool playsMnk() const { return false; };
+        virtual int chooseMnkMove( const MnkPosition & ) { return -1; };
+};
+
+/*********************************************************************
+** Description: The RandomPlayer class plays a random legal move.
+*********************************************************************/
+class RandomPlayer : public AiPlayer
+{
+    private:
+        Random random;
+
+    public:
+        RandomPlayer( const Random &random ) : random( random ) {};
+        int chooseMove( const GamePosition & );
+        string getName() const { return "random"; };
+
+        bool playsUltimate() const { return true; };
+        int chooseUltimateMove( const UltimatePosition & );
+
+        bool playsQubic() const { return true; };
+        int chooseQubicMove( const QubicPosition & );
+
+        bool playsMnk() const { return true; };
+        int chooseMnkMove( const MnkPosition & );
+};
+
+/*********************************************************************
+** Description: The MctsPlayer class plays the move found by a Monte
+*  Carlo Tree Search. It keeps its tree between moves. The search of
+*  each variant is created when it is first needed.
+*********************************************************************/
+class MctsPlayer : public AiPlayer
+{
+    private:
+        MctsSettings settings;
+        Random random;
+
+        Mcts< GamePosition >* search;
+        Mcts< UltimatePosition >* ultimateSearch;
+        Mcts< QubicPosition >* qubicSearch;
+        Mcts< MnkPosition >* mnkSearch;
+
+    public:
+        MctsPlayer( const MctsSettings &, const Random & );
+        ~MctsPlayer();
+        int chooseMove( const GamePosition & );
+        string getName() const { return "mcts"; };
+
+        bool playsUltimate() const { return true; };
+        int chooseUltimateMove( const UltimatePosition & );
+
+        bool playsQubic() const { return true; };
+        int chooseQubicMove( const QubicPosition & );
+
+        bool playsMnk() const { return true; };
+        int chooseMnkMove( const MnkPosition & );
+};
+
+AiPlayer* createPlayer( const string &, const Random & );
+MnkPosition toMnkPosition( const GamePosition & );
+
+#endif
@@ -0,0 +1,149 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AlphaBetaPlayer class searches a fixed number of
+*  moves ahead with negamax and alpha-beta pruning. Positions at the
+*  depth limit are scored by the lines each player can still complete,
+*  so a shallow search plays reasonably but can be beaten.
+*********************************************************************/
+#include "alphaBetaPlayer.hpp"
+
+//Scores above any evaluation, so a forced result always wins out.
+static const int WIN_SCORE = 100;
+
+//Center first, then corners, then edges: good moves first prune more.
+static const int MOVE_ORDER[GameBoard::CELLS] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters: int depth - moves to search ahead, at least 1.
+*              Random random - chooses between equally good moves.
+*********************************************************************/
+AlphaBetaPlayer::AlphaBetaPlayer( int depth, const Random &random ) : random( random )
+{
+    this->depth = depth > 0 ? depth : 1;
+    nodes = 0;
+}
+
+/*********************************************************************
+** Description: Scores an unfinished position for the player to move:
+*  the lines still open to them minus the lines still open to the
+*  other player.
+*********************************************************************/
+int AlphaBetaPlayer::evaluate( const GamePosition &position )
+{
+    Player mover = position.getToMove();
+    uint16_t own = position.getBoard().getMarks( mover ),
+             theirs = position.getBoard().getMarks( GameBoard::other( mover ) );
+    int value = 0;
+
+    for( int i = 0; i < 8; i++ )
+    {
+        if( ( GameBoard::WIN_LINES[i] & theirs ) == 0 )
+            value++;
+
+        if( ( GameBoard::WIN_LINES[i] & own ) == 0 )
+            value--;
+    }
+
+    return value;
+}
+
+/*********************************************************************
+** Description: Negamax with alpha-beta pruning.
+*
+*  Parameters:
+*  1. GamePosition position - the position, restored on return.
+*  2. int remaining - moves left to search.
+*  3. int alpha, int beta - the search window for the player to move.
+*
+*  Return: int - the score for the player to move.
+*********************************************************************/
+int AlphaBetaPlayer::search( GamePosition &position, int remaining, int alpha, int beta )
+{
+    nodes++;
+
+    if( position.getOutcome() == DRAW )
+    {
+        return 0;
+    }
+
+    //The player who just moved won; sooner is worse for the loser.
+    if( position.getOutcome() != UNFINISHED )
+    {
+        return -WIN_SCORE - __builtin_popcount( position.getBoard().getEmpty() );
+    }
+
+    if( remaining == 0 )
+    {
+        return evaluate( position );
+    }
+
+    uint16_t empty = position.getBoard().getEmpty();
+
+    for( int i = 0; i < GameBoard::CELLS; i++ )
+    {
+        int cell = MOVE_ORDER[i];
+
+        if( ( empty & ( 1 << cell ) ) == 0 )
+        {
+            continue;
+        }
+
+        position.play( cell );
+        int value = -search( position, remaining - 1, -beta, -alpha );
+        position.undo( cell );
+
+        if( value > alpha )
+        {
+            alpha = value;
+
+            if( alpha >= beta )
+            {
+                break;
+            }
+        }
+    }
+
+    return alpha;
+}
+
+/*********************************************************************
+** Description: Chooses a random move among the best ones found.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int AlphaBetaPlayer::chooseMove( const GamePosition &position )
+{
+    GamePosition work = position;
+    int moves[GamePosition::MAX_MOVES],
+        best[GamePosition::MAX_MOVES];
+    int count = position.getMoves( moves ),
+        bestCount = 0,
+        bestScore = -2 * WIN_SCORE;
+
+    for( int i = 0; i < count; i++ )
+    {
+        //A full window for every root move, so ties are exact.
+        work.play( moves[i] );
+        int value = -search( work, depth - 1, -2 * WIN_SCORE, 2 * WIN_SCORE );
+        work.undo( moves[i] );
+
+        if( value > bestScore )
+        {
+            bestScore = value;
+            bestCount = 0;
+        }
+
+        if( value == bestScore )
+        {
+            best[bestCount++] = moves[i];
+        }
+    }
+
+    return bestCount > 0 ? best[random.nextInt( bestCount )] : -1;
+}
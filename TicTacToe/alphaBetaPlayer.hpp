@@ -0,0 +1,32 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AlphaBetaPlayer class searches a fixed number of
+*  moves ahead with negamax and alpha-beta pruning. Positions at the
+*  depth limit are scored by the lines each player can still complete,
+*  so a shallow search plays reasonably but can be beaten.
+*********************************************************************/
+#ifndef ALPHA_BETA_PLAYER_HPP
+#define ALPHA_BETA_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+
+class AlphaBetaPlayer : public AiPlayer
+{
+    private:
+        int depth; //Moves searched ahead.
+        Random random; //Chooses between equally good moves.
+        long long nodes; //Positions searched so far.
+
+        int search( GamePosition &, int, int, int );
+        static int evaluate( const GamePosition & );
+
+    public:
+        AlphaBetaPlayer( int depth, const Random &random );
+        int chooseMove( const GamePosition & );
+        string getName() const { return "alphabeta"; };
+        long long getNodes() const { return nodes; };
+};
+
+#endif
@@ -0,0 +1,357 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Analyzer class solves every empty cell of the
+*  position on the screen on its own thread: whether playing there wins,
+*  draws or loses with best play, and how soon. The render thread hands
+*  it positions and reads back Heatmaps through triple buffers, so it
+*  never waits; each cell is published as soon as it is solved. Solved
+*  positions stay in a transposition table from one position to the
+*  next, so after a move the analysis mostly looks up what it already
+*  searched. Classic boards are analyzed as the 3,3,3 game.
+*********************************************************************/
+#include "analyzer.hpp"
+#include <chrono>
+
+/*********************************************************************
+** Description: Constructor. The table holds a million positions, 12 MB.
+*********************************************************************/
+Analyzer::Analyzer() : requestCount( 0 ), nodes( 0 ), running( false )
+{
+    tableWidth = 0;
+    tableHeight = 0;
+    tableK = 0;
+    incremental = true;
+    searching = 0;
+    aborted = false;
+}
+
+/*********************************************************************
+** Description: Destructor. Stops the thread if it is still running.
+*********************************************************************/
+Analyzer::~Analyzer()
+{
+    stop();
+}
+
+/*********************************************************************
+** Description: Starts the analysis thread. The table is allocated by
+*  the thread, so starting does not wait for it.
+*********************************************************************/
+void Analyzer::start()
+{
+    if( !running.load() )
+    {
+        running.store( true );
+        worker = std::thread( &Analyzer::run, this );
+    }
+}
+
+/*********************************************************************
+** Description: Stops the analysis thread, ending the running search,
+*  and waits for it to end.
+*********************************************************************/
+void Analyzer::stop()
+{
+    running.store( false );
+    requestCount.fetch_add( 1 );
+
+    if( worker.joinable() )
+    {
+        worker.join();
+    }
+}
+
+/*********************************************************************
+** Description: Asks for a position to be analyzed instead of the last
+*  one. Render thread only; asking for the same position again does
+*  nothing.
+*
+*  Parameters: MnkPosition position - an unfinished position.
+*********************************************************************/
+void Analyzer::request( const MnkPosition &position )
+{
+    if( position == requested && requestCount.load( std::memory_order_relaxed ) != 0 )
+    {
+        return;
+    }
+
+    requested = position;
+    requests.writeBuffer() = position;
+    requests.publish();
+    requestCount.fetch_add( 1, std::memory_order_release );
+}
+
+/*********************************************************************
+** Description: Returns a classic board as the same position of the
+*  3,3,3 game.
+*
+*  Parameters: GameBoard board - an unfinished board.
+*              Player toMove - the player to move.
+*
+*  Return: MnkPosition - the position.
+*********************************************************************/
+MnkPosition Analyzer::fromBoard( const GameBoard &board, Player toMove )
+{
+    uint32_t xMarks = board.getMarks( X_Player ),
+             oMarks = board.getMarks( O_Player );
+
+    //The player with more marks started; with as many, the one to move.
+    Player first = toMove;
+
+    if( __builtin_popcount( xMarks ) != __builtin_popcount( oMarks ) )
+    {
+        first = __builtin_popcount( xMarks ) > __builtin_popcount( oMarks ) ? X_Player : O_Player;
+    }
+
+    uint32_t firstMarks = first == X_Player ? xMarks : oMarks,
+             secondMarks = first == X_Player ? oMarks : xMarks;
+
+    //No line is complete on an unfinished board, so any order of the
+    //moves gives the same position.
+    MnkPosition position( 3, 3, 3, first );
+
+    while( firstMarks != 0 )
+    {
+        position.play( __builtin_ctz( firstMarks ) );
+        firstMarks &= firstMarks - 1;
+
+        if( secondMarks != 0 )
+        {
+            position.play( __builtin_ctz( secondMarks ) );
+            secondMarks &= secondMarks - 1;
+        }
+    }
+
+    return position;
+}
+
+/*********************************************************************
+** Description: The thread loop. Analyzes the newest position each time
+*  one is requested, and sleeps briefly while there is none.
+*********************************************************************/
+void Analyzer::run()
+{
+    if( table.empty() )
+    {
+        table.resize( 1 << TABLE_BITS );
+        clearTable();
+    }
+
+    unsigned analyzed = 0;
+
+    while( running.load() )
+    {
+        unsigned count = requestCount.load( std::memory_order_acquire );
+
+        if( count == analyzed )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            continue;
+        }
+
+        analyzed = count;
+        searching = count;
+        analyze( requests.read() );
+    }
+}
+
+/*********************************************************************
+** Description: Solves the move in every empty cell of a position and
+*  publishes the heatmap after each one. Stops early when another
+*  position is requested; what was solved stays in the table.
+*
+*  Parameters: MnkPosition position - the position to analyze.
+*********************************************************************/
+void Analyzer::analyze( const MnkPosition &position )
+{
+    if( position.getWidth() != tableWidth || position.getHeight() != tableHeight
+        || position.getK() != tableK || !incremental )
+    {
+        clearTable();
+        tableWidth = position.getWidth();
+        tableHeight = position.getHeight();
+        tableK = position.getK();
+    }
+
+    Heatmap heatmap;
+    heatmap.position = position;
+
+    heatmaps.writeBuffer() = heatmap;
+    heatmaps.publish();
+
+    if( position.getOutcome() != UNFINISHED )
+    {
+        return;
+    }
+
+    aborted = false;
+
+    MnkPosition child = position;
+
+    for( uint32_t empty = position.getEmpty(); empty != 0; empty &= empty - 1 )
+    {
+        int cell = __builtin_ctz( empty );
+
+        child.play( cell );
+        int score = -search( child, -INFINITE_SCORE, INFINITE_SCORE );
+        child.undo( cell );
+
+        if( aborted )
+        {
+            return;
+        }
+
+        heatmap.scores[cell] = static_cast<int8_t>( score );
+        heatmap.solved |= 1u << cell;
+
+        heatmaps.writeBuffer() = heatmap;
+        heatmaps.publish();
+    }
+}
+
+/*********************************************************************
+** Description: Scores a position for the player to move with negamax,
+*  alpha-beta pruning and the transposition table. Checks every 4096
+*  positions whether the search should stop.
+*
+*  Parameters:
+*  1. MnkPosition position - the position, restored on return.
+*  2. int alpha, int beta - the window; a score outside it is only a
+*  bound.
+*
+*  Return: int - the score for the player to move, meaningless once
+*  aborted is set.
+*********************************************************************/
+int Analyzer::search( MnkPosition &position, int alpha, int beta )
+{
+    long long searched = nodes.load( std::memory_order_relaxed ) + 1;
+    nodes.store( searched, std::memory_order_relaxed );
+
+    if( ( searched & 4095 ) == 0 && requestCount.load( std::memory_order_relaxed ) != searching )
+    {
+        aborted = true;
+    }
+
+    if( aborted )
+    {
+        return 0;
+    }
+
+    int empty = __builtin_popcount( position.getEmpty() );
+
+    if( position.getOutcome() == DRAW )
+    {
+        return 0;
+    }
+
+    //The player who just moved won.
+    if( position.getOutcome() != UNFINISHED )
+    {
+        return -( 1 + empty );
+    }
+
+    //No win can score more than winning with this move.
+    if( alpha >= empty )
+    {
+        return empty;
+    }
+
+    Entry &entry = probe( position );
+    int bestMove = -1;
+
+    if( entry.xMarks == position.getMarks( X_Player ) && entry.oMarks == position.getMarks( O_Player )
+        && entry.toMove == position.getToMove() )
+    {
+        int score = entry.score;
+
+        if( entry.bound == EXACT || ( entry.bound == LOWER && score >= beta )
+            || ( entry.bound == UPPER && score <= alpha ) )
+        {
+            return score;
+        }
+
+        bestMove = entry.bestMove;
+    }
+
+    int moves[MnkPosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    //The best move of an earlier search first.
+    for( int i = 1; i < count && bestMove >= 0; i++ )
+    {
+        if( moves[i] == bestMove )
+        {
+            moves[i] = moves[0];
+            moves[0] = bestMove;
+        }
+    }
+
+    int originalAlpha = alpha,
+        best = -INFINITE_SCORE;
+
+    for( int i = 0; i < count && alpha < beta; i++ )
+    {
+        position.play( moves[i] );
+        int score = -search( position, -beta, -alpha );
+        position.undo( moves[i] );
+
+        if( aborted )
+        {
+            return 0;
+        }
+
+        if( score > best )
+        {
+            best = score;
+            bestMove = moves[i];
+        }
+
+        if( score > alpha )
+        {
+            alpha = score;
+        }
+    }
+
+    //probe() may have given the slot to another position meanwhile.
+    Entry &slot = probe( position );
+    slot.xMarks = position.getMarks( X_Player );
+    slot.oMarks = position.getMarks( O_Player );
+    slot.toMove = static_cast<uint8_t>( position.getToMove() );
+    slot.score = static_cast<int8_t>( best );
+    slot.bound = static_cast<uint8_t>( best <= originalAlpha ? UPPER : ( best >= beta ? LOWER : EXACT ) );
+    slot.bestMove = static_cast<uint8_t>( bestMove );
+
+    return best;
+}
+
+/*********************************************************************
+** Description: Returns the table slot of a position, whichever
+*  position it holds.
+*
+*  Parameters: MnkPosition position - the position.
+*
+*  Return: Entry& - the slot.
+*********************************************************************/
+Analyzer::Entry& Analyzer::probe( const MnkPosition &position )
+{
+    uint64_t hash = position.getMarks( X_Player ) * 0x9E3779B97F4A7C15ULL
+                    ^ position.getMarks( O_Player ) * 0xC2B2AE3D27D4EB4FULL
+                    ^ position.getToMove();
+
+    return table[( hash ^ hash >> 29 ) & ( ( 1 << TABLE_BITS ) - 1 )];
+}
+
+/*********************************************************************
+** Description: Empties the table.
+*********************************************************************/
+void Analyzer::clearTable()
+{
+    Entry empty = { 0xFFFFFFFF, 0xFFFFFFFF, 0, EXACT, 0, 0 };
+
+    for( unsigned i = 0; i < table.size(); i++ )
+    {
+        table[i] = empty;
+    }
+}
@@ -0,0 +1,115 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Analyzer class solves every empty cell of the
+*  position on the screen on its own thread: whether playing there wins,
+*  draws or loses with best play, and how soon. The render thread hands
+*  it positions and reads back Heatmaps through triple buffers, so it
+*  never waits; each cell is published as soon as it is solved. Solved
+*  positions stay in a transposition table from one position to the
+*  next, so after a move the analysis mostly looks up what it already
+*  searched. Classic boards are analyzed as the 3,3,3 game.
+*********************************************************************/
+#ifndef ANALYZER_HPP
+#define ANALYZER_HPP
+
+#include "mnkPosition.hpp"
+#include "tripleBuffer.hpp"
+#include <atomic>
+#include <thread>
+
+#include <vector>
+using std::vector;
+
+/*********************************************************************
+** Description: The Heatmap struct holds the solved cells of one
+*  position. A score is for the player to move, as in PerfectPlayer: a
+*  win scores 1 plus the number of empty cells left at the end, a loss
+*  the negative of that and a draw 0.
+*********************************************************************/
+struct Heatmap
+{
+    MnkPosition position;
+    int8_t scores[MnkPosition::MAX_CELLS]; //Of the move in each cell.
+    uint32_t solved; //Cells whose score is known.
+
+    Heatmap()
+    {
+        solved = 0;
+
+        for( int i = 0; i < MnkPosition::MAX_CELLS; i++ )
+        {
+            scores[i] = 0;
+        }
+    }
+};
+
+class Analyzer
+{
+    private:
+        static const int TABLE_BITS = 20;
+        static const int INFINITE_SCORE = MnkPosition::MAX_CELLS + 2;
+
+        enum Bound { EXACT, LOWER, UPPER };
+
+        /*********************************************************************
+         ** Description: This struct is one solved position. Empty entries
+         *  have both masks full, which no position has.
+         *********************************************************************/
+        struct Entry
+        {
+            uint32_t xMarks,
+                     oMarks;
+            int8_t score;
+            uint8_t bound;
+            uint8_t toMove;
+            uint8_t bestMove; //Searched first the next time.
+        };
+
+        vector< Entry > table; //The analysis thread's only.
+        int tableWidth, //Board size the table was filled for.
+            tableHeight,
+            tableK;
+        bool incremental; //Otherwise the table is cleared for every position.
+
+        MnkPosition requested; //The render thread's only.
+        TripleBuffer< MnkPosition > requests;
+        TripleBuffer< Heatmap > heatmaps;
+        std::atomic< unsigned > requestCount; //A search stops when it changes.
+
+        unsigned searching; //requestCount of the running analysis.
+        bool aborted;
+        std::atomic< long long > nodes;
+
+        std::thread worker;
+        std::atomic< bool > running;
+
+        //Private functions.
+        void run();
+        void analyze( const MnkPosition & );
+        int search( MnkPosition &, int, int );
+        Entry& probe( const MnkPosition & );
+        void clearTable();
+
+        //The thread holds a pointer to the analyzer.
+        Analyzer( const Analyzer & );
+        Analyzer& operator=( const Analyzer & );
+
+    public:
+        Analyzer();
+        ~Analyzer();
+        void start();
+        void stop();
+        void request( const MnkPosition & );
+        const Heatmap& latest() { return heatmaps.read(); };
+        void setIncremental( bool on ) { incremental = on; };
+
+        //Getter functions.
+        bool isRunning() const { return running.load(); };
+        long long getNodes() const { return nodes.load(); };
+
+        static MnkPosition fromBoard( const GameBoard &, Player );
+};
+
+#endif
@@ -0,0 +1,367 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AudioHandler class plays the sound cues of the
+*  game: a move, a win, a draw and the mouse moving over a cell. Every
+*  cue is decoded once when the audio starts, into samples already in
+*  the format of the device. The game logic asks for a cue through a
+*  lock-free queue, and the audio callback itself starts and mixes the
+*  cues, so asking never waits for the audio thread's lock. The time
+*  from the input behind a cue to the callback that starts it is
+*  measured and reported.
+*********************************************************************/
+#include "audioHandler.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+//Sound files that replace the built in cues, in any format SDL_mixer
+//decodes. None ship with the game.
+static const char* CUE_FILES[CUE_COUNT] = { "sound/move.wav", "sound/win.wav", "sound/draw.wav", "sound/hover.wav" };
+
+/*********************************************************************
+** Description: Constructor. The buffer starts at 512 sample frames,
+*  about 12 ms at 44.1 kHz.
+*********************************************************************/
+AudioHandler::AudioHandler() : latencyCount( 0 ), latencySum( 0 ), latencyWorst( 0 )
+{
+    bufferSize = 512;
+    frequency = 44100;
+    channels = 2;
+    open = false;
+
+    for( int i = 0; i < CUE_COUNT; i++ )
+    {
+        chunks[i] = NULL;
+    }
+
+    for( int i = 0; i < MAX_VOICES; i++ )
+    {
+        voices[i].chunk = NULL;
+        voices[i].position = 0;
+    }
+}
+
+/*********************************************************************
+** Description: Destructor. Closes the audio if cleanUp() was not
+*  called.
+*********************************************************************/
+AudioHandler::~AudioHandler()
+{
+    cleanUp();
+}
+
+/*********************************************************************
+** Description: Starts the audio subsystem, opens the audio device and
+*  decodes every cue. The game starts it after the first frame, so the
+*  window does not wait for the audio device; cues asked for before it
+*  is open are not played.
+*
+*  Return: bool - false if there is no audio; the game plays silently.
+*********************************************************************/
+bool AudioHandler::startUp()
+{
+    if( open.load() )
+    {
+        return true;
+    }
+
+    if( SDL_InitSubSystem( SDL_INIT_AUDIO ) < 0 )
+    {
+        printf( "SDL audio could not initialize! SDL Error: %s\n", SDL_GetError() );
+        return false;
+    }
+
+    if( Mix_OpenAudio( 44100, AUDIO_S16SYS, 2, bufferSize ) < 0 )
+    {
+        printf( "SDL_mixer could not open the audio device! SDL_mixer Error: %s\n", Mix_GetError() );
+        SDL_QuitSubSystem( SDL_INIT_AUDIO );
+        return false;
+    }
+
+    //The device may have changed the rate and channels, never the format.
+    Uint16 format = 0;
+    Mix_QuerySpec( &frequency, &format, &channels );
+
+    if( format != AUDIO_S16SYS )
+    {
+        printf( "Unsupported audio format %#x!\n", format );
+        Mix_CloseAudio();
+        SDL_QuitSubSystem( SDL_INIT_AUDIO );
+        return false;
+    }
+
+    for( int i = 0; i < CUE_COUNT; i++ )
+    {
+        loadCue( static_cast<AudioCue>( i ) );
+    }
+
+    //Cues are mixed in after the mixer's own channels, which stay silent.
+    Mix_SetPostMix( mixCallback, this );
+
+    //Lets the game logic thread ask for cues.
+    open.store( true, std::memory_order_release );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Decodes a cue from its sound file, or synthesizes it
+*  when there is none. Mix_LoadWAV() converts the file to the format of
+*  the device, so the callback only adds samples.
+*
+*  Parameters: AudioCue cue - the cue to load.
+*
+*  Return: bool - true if the cue can be played.
+*********************************************************************/
+bool AudioHandler::loadCue( AudioCue cue )
+{
+    chunks[cue] = Mix_LoadWAV( CUE_FILES[cue] );
+
+    if( chunks[cue] == NULL )
+    {
+        const double MOVE_NOTES[] = { 660.0 },
+                     WIN_NOTES[] = { 523.3, 659.3, 784.0 },
+                     DRAW_NOTES[] = { 392.0, 329.6 },
+                     HOVER_NOTES[] = { 1320.0 };
+
+        if( cue == MOVE_CUE )
+            synthesize( cue, MOVE_NOTES, 1, 60, 0.4 );
+
+        else if( cue == WIN_CUE )
+            synthesize( cue, WIN_NOTES, 3, 90, 0.4 );
+
+        else if( cue == DRAW_CUE )
+            synthesize( cue, DRAW_NOTES, 2, 150, 0.35 );
+
+        else
+            synthesize( cue, HOVER_NOTES, 1, 15, 0.12 );
+    }
+
+    return chunks[cue] != NULL;
+}
+
+/*********************************************************************
+** Description: Synthesizes a cue as a row of decaying sine tones in the
+*  rate and channels of the device.
+*
+*  Parameters:
+*  1. AudioCue cue - the cue to synthesize.
+*  2. const double* notes - the frequency of each tone in Hz.
+*  3. int noteCount - the number of tones.
+*  4. int noteLength - the length of each tone in milliseconds.
+*  5. double amplitude - the loudness, 1.0 is full scale.
+*********************************************************************/
+void AudioHandler::synthesize( AudioCue cue, const double* notes, int noteCount, int noteLength, double amplitude )
+{
+    const double TWO_PI = 6.283185307179586;
+
+    int frames = frequency * noteLength / 1000;
+    vector< Sint16 > &cueSamples = samples[cue];
+
+    cueSamples.assign( static_cast<size_t>( frames ) * noteCount * channels, 0 );
+
+    for( int note = 0; note < noteCount; note++ )
+    {
+        for( int frame = 0; frame < frames; frame++ )
+        {
+            double time = static_cast<double>( frame ) / frequency;
+
+            //A 2 ms attack avoids a click; the decay ends near silence.
+            double envelope = std::min( 1.0, time * 500.0 ) * exp( -5.0 * frame / frames );
+            Sint16 value = static_cast<Sint16>( 32767.0 * amplitude * envelope * sin( TWO_PI * notes[note] * time ) );
+
+            for( int channel = 0; channel < channels; channel++ )
+            {
+                cueSamples[( static_cast<size_t>( note ) * frames + frame ) * channels + channel] = value;
+            }
+        }
+    }
+
+    //The chunk only points at the samples; they are freed with the handler.
+    chunks[cue] = Mix_QuickLoad_RAW( reinterpret_cast<Uint8*>( &cueSamples[0] ),
+                                     static_cast<Uint32>( cueSamples.size() * sizeof( Sint16 ) ) );
+}
+
+/*********************************************************************
+** Description: Asks for a cue to be played. Called by the game logic
+*  thread; it never waits for the audio thread.
+*
+*  Parameters: AudioCue cue - the cue to play.
+*              long long inputTime - Profiler::now() when the input
+*              behind the cue was read.
+*
+*  Return: bool - false if the audio is not open or too many cues are
+*  waiting; the cue is dropped.
+*********************************************************************/
+bool AudioHandler::play( AudioCue cue, long long inputTime )
+{
+    if( !open.load( std::memory_order_acquire ) )
+    {
+        return false;
+    }
+
+    CueCommand command = { cue, inputTime };
+
+    return commands.push( command );
+}
+
+/*********************************************************************
+** Description: The Mix_SetPostMix() callback, on the audio thread.
+*
+*  Parameters:
+*  1. void* data - the AudioHandler.
+*  2. Uint8* stream - the samples to add the cues to.
+*  3. int length - the length of the stream in bytes.
+*********************************************************************/
+void AudioHandler::mixCallback( void* data, Uint8* stream, int length )
+{
+    static_cast<AudioHandler*>( data )->mix( stream, length );
+}
+
+/*********************************************************************
+** Description: Starts the cues that were asked for, recording how long
+*  each waited, and adds every sounding cue to the stream.
+*
+*  Parameters: Uint8* stream - the samples to add the cues to.
+*              int length - the length of the stream in bytes.
+*********************************************************************/
+void AudioHandler::mix( Uint8* stream, int length )
+{
+    long long now = Profiler::now();
+    CueCommand command;
+
+    while( commands.pop( command ) )
+    {
+        long long latency = now - command.inputTime;
+
+        latencyCount.store( latencyCount.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        latencySum.store( latencySum.load( std::memory_order_relaxed ) + latency, std::memory_order_relaxed );
+
+        if( latency > latencyWorst.load( std::memory_order_relaxed ) )
+        {
+            latencyWorst.store( latency, std::memory_order_relaxed );
+        }
+
+        start( command.cue );
+    }
+
+    Sint16* output = reinterpret_cast<Sint16*>( stream );
+
+    for( int i = 0; i < MAX_VOICES; i++ )
+    {
+        Voice &voice = voices[i];
+
+        if( voice.chunk == NULL )
+        {
+            continue;
+        }
+
+        const Sint16* input = reinterpret_cast<const Sint16*>( voice.chunk->abuf + voice.position );
+        Uint32 bytes = std::min( voice.chunk->alen - voice.position, static_cast<Uint32>( length ) );
+        int count = static_cast<int>( bytes / sizeof( Sint16 ) );
+
+        for( int sample = 0; sample < count; sample++ )
+        {
+            int sum = output[sample] + input[sample];
+            output[sample] = static_cast<Sint16>( sum > 32767 ? 32767 : ( sum < -32768 ? -32768 : sum ) );
+        }
+
+        voice.position += count * sizeof( Sint16 );
+
+        if( voice.position + sizeof( Sint16 ) > voice.chunk->alen )
+        {
+            voice.chunk = NULL;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Starts a cue on a free voice, or on the voice furthest
+*  through its cue when all are sounding. Audio thread only.
+*
+*  Parameters: AudioCue cue - the cue to start.
+*********************************************************************/
+void AudioHandler::start( AudioCue cue )
+{
+    if( chunks[cue] == NULL )
+    {
+        return;
+    }
+
+    int chosen = 0;
+
+    for( int i = 0; i < MAX_VOICES; i++ )
+    {
+        if( voices[i].chunk == NULL )
+        {
+            chosen = i;
+            break;
+        }
+
+        if( voices[i].position > voices[chosen].position )
+        {
+            chosen = i;
+        }
+    }
+
+    voices[chosen].chunk = chunks[cue];
+    voices[chosen].position = 0;
+}
+
+/*********************************************************************
+** Description: Returns the mean time from an input to the callback
+*  that started its cue, in nanoseconds.
+*********************************************************************/
+double AudioHandler::getLatencyMean() const
+{
+    long long count = latencyCount.load();
+
+    return count > 0 ? static_cast<double>( latencySum.load() ) / count : 0.0;
+}
+
+/*********************************************************************
+** Description: Prints the cue latency of the session. The cue is heard
+*  up to one more buffer later, while the device plays the stream.
+*********************************************************************/
+void AudioHandler::reportLatency() const
+{
+    if( open.load() && latencyCount.load() > 0 )
+    {
+        printf( "Audio cues: %lld, input to callback mean %.2f ms, worst %.2f ms, buffer %d frames (%.2f ms)\n",
+                latencyCount.load(), getLatencyMean() / 1e6, latencyWorst.load() / 1e6,
+                bufferSize, 1000.0 * bufferSize / frequency );
+    }
+}
+
+/*********************************************************************
+** Description: Stops the callback, frees the cues and closes the audio
+*  device.
+*********************************************************************/
+void AudioHandler::cleanUp()
+{
+    if( !open.load() )
+    {
+        return;
+    }
+
+    open.store( false );
+    Mix_SetPostMix( NULL, NULL );
+    Mix_CloseAudio();
+
+    for( int i = 0; i < CUE_COUNT; i++ )
+    {
+        Mix_FreeChunk( chunks[i] );
+        chunks[i] = NULL;
+        samples[i].clear();
+    }
+
+    for( int i = 0; i < MAX_VOICES; i++ )
+    {
+        voices[i].chunk = NULL;
+    }
+
+    SDL_QuitSubSystem( SDL_INIT_AUDIO );
+}
@@ -0,0 +1,96 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The AudioHandler class plays the sound cues of the
+*  game: a move, a win, a draw and the mouse moving over a cell. Every
+*  cue is decoded once when the audio starts, into samples already in
+*  the format of the device. The game logic asks for a cue through a
+*  lock-free queue, and the audio callback itself starts and mixes the
+*  cues, so asking never waits for the audio thread's lock. The time
+*  from the input behind a cue to the callback that starts it is
+*  measured and reported.
+*********************************************************************/
+#ifndef AUDIO_HANDLER_HPP
+#define AUDIO_HANDLER_HPP
+
+#include "spscQueue.hpp"
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <atomic>
+
+#include <vector>
+using std::vector;
+
+enum AudioCue { MOVE_CUE, WIN_CUE, DRAW_CUE, HOVER_CUE, CUE_COUNT };
+
+class AudioHandler
+{
+    private:
+        static const int MAX_VOICES = 8; //Cues that can sound at once.
+
+        /*********************************************************************
+         ** Description: This struct is a request to start a cue.
+         *********************************************************************/
+        struct CueCommand
+        {
+            AudioCue cue;
+            long long inputTime; //Profiler::now() of the input behind it.
+        };
+
+        /*********************************************************************
+         ** Description: This struct is one cue sounding. Only the audio
+         *  callback uses the voices.
+         *********************************************************************/
+        struct Voice
+        {
+            Mix_Chunk* chunk; //NULL while the voice is free.
+            Uint32 position; //Bytes of the chunk already mixed.
+        };
+
+        int bufferSize; //Sample frames per audio callback.
+        int frequency,
+            channels;
+        std::atomic< bool > open; //The cues are ready; play() is silent until then.
+
+        Mix_Chunk* chunks[CUE_COUNT];
+        vector< Sint16 > samples[CUE_COUNT]; //Synthesized cues, NULL chunks' data.
+        Voice voices[MAX_VOICES];
+
+        SpscQueue< CueCommand, 64 > commands;
+
+        //Written by the audio callback only.
+        std::atomic< long long > latencyCount,
+                                 latencySum,
+                                 latencyWorst; //Nanoseconds.
+
+        //Private functions.
+        bool loadCue( AudioCue );
+        void synthesize( AudioCue, const double*, int, int, double );
+        void start( AudioCue );
+        void mix( Uint8*, int );
+        static void mixCallback( void*, Uint8*, int );
+
+        //The audio callback holds a pointer to the handler.
+        AudioHandler( const AudioHandler & );
+        AudioHandler& operator=( const AudioHandler & );
+
+    public:
+        AudioHandler();
+        ~AudioHandler();
+        bool startUp();
+        bool play( AudioCue, long long );
+        void reportLatency() const;
+        void cleanUp();
+        void setBufferSize( int size ) { bufferSize = size; };
+
+        //Getter functions.
+        bool isOpen() const { return open.load(); };
+        int getBufferSize() const { return bufferSize; };
+        int getFrequency() const { return frequency; };
+        long long getLatencyCount() const { return latencyCount.load(); };
+        double getLatencyMean() const;
+        long long getLatencyWorst() const { return latencyWorst.load(); };
+};
+
+#endif
@@ -0,0 +1,452 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BatchGames class plays LANES independent random
+*  games at once. The boards are stored as structure of arrays, one
+*  32 bit lane per board, so move generation, random move selection and
+*  win detection run on every lane with the same SSE2 or AVX2
+*  instructions. A scalar kernel gives the same results everywhere
+*  else. Finished lanes are counted and restart from the start position.
+*********************************************************************/
+#include "batchGames.hpp"
+
+#if defined( __i386__ ) || defined( __x86_64__ )
+#define BATCH_GAMES_X86
+#include <immintrin.h>
+#endif
+
+//65536 % count for each number of empty cells. A 16 bit random number
+//times count whose low 16 bits are below this is drawn again, so each
+//empty cell is picked equally often (Lemire's method).
+static const uint32_t REJECT_BELOW[GameBoard::CELLS + 1] = { 0, 0, 0, 1, 0, 1, 4, 2, 0, 7 };
+
+/*********************************************************************
+** Description: Constructor. Seeds every lane with its own random
+*  stream and starts them all from an empty board with X to move.
+*
+*  Parameters: Random random - seeds the lanes.
+*              Isa isa - the instruction set to use. Falls back to the
+*              best one the processor supports.
+*********************************************************************/
+BatchGames::BatchGames( const Random &random, Isa isa )
+{
+    Random seeder = random;
+
+    for( int lane = 0; lane < LANES; lane++ )
+    {
+        //xorshift32 must not start from 0.
+        states[lane] = seeder.next() | 1;
+    }
+
+    this->isa = isa > bestIsa() ? bestIsa() : isa;
+
+    reset( GamePosition( X_Player ) );
+}
+
+/*********************************************************************
+** Description: Returns the best instruction set the processor supports.
+*********************************************************************/
+BatchGames::Isa BatchGames::bestIsa()
+{
+#ifdef BATCH_GAMES_X86
+    if( __builtin_cpu_supports( "avx2" ) )
+        return AVX2;
+
+    if( __builtin_cpu_supports( "sse2" ) )
+        return SSE2;
+#endif
+
+    return SCALAR;
+}
+
+/*********************************************************************
+** Description: Returns the name of an instruction set.
+*********************************************************************/
+const char* BatchGames::isaName( Isa isa )
+{
+    if( isa == AVX2 )
+        return "AVX2";
+
+    if( isa == SSE2 )
+        return "SSE2";
+
+    return "scalar";
+}
+
+/*********************************************************************
+** Description: Restarts every lane from a position and clears the
+*  counts.
+*
+*  Parameters: GamePosition start - an unfinished position.
+*********************************************************************/
+void BatchGames::reset( const GamePosition &start )
+{
+    startX = start.getBoard().getMarks( X_Player );
+    startO = start.getBoard().getMarks( O_Player );
+    startTurn = start.getToMove() == O_Player ? 0xFFFFFFFF : 0;
+
+    for( int lane = 0; lane < LANES; lane++ )
+    {
+        xMarks[lane] = startX;
+        oMarks[lane] = startO;
+        turns[lane] = startTurn;
+        xWins[lane] = 0;
+        oWins[lane] = 0;
+        draws[lane] = 0;
+    }
+}
+
+/*********************************************************************
+** Description: Makes one random move in every lane, a number of times.
+*
+*  Parameters: int steps - the number of moves per lane.
+*********************************************************************/
+void BatchGames::advance( int steps )
+{
+    for( int i = 0; i < steps; i++ )
+    {
+        if( isa == AVX2 )
+            stepAvx2();
+
+        else if( isa == SSE2 )
+            stepSse2();
+
+        else
+            stepScalar();
+    }
+}
+
+/*********************************************************************
+** Description: Adds up a counter over the lanes.
+*********************************************************************/
+long long BatchGames::sum( const uint32_t* counts ) const
+{
+    long long total = 0;
+
+    for( int lane = 0; lane < LANES; lane++ )
+    {
+        total += counts[lane];
+    }
+
+    return total;
+}
+
+/*********************************************************************
+** Description: The reference kernel. Written with the same masks the
+*  vector kernels use, so all three produce the same games.
+*
+*  A random number k below the number of empty cells is taken from the
+*  high 16 bits of the lane's random state, and the k-th empty cell is
+*  played. The rare draws that would favour the first cells are
+*  rejected and the lane's state is advanced again; the vector kernels
+*  advance the rejected lanes alone, so every kernel still plays the
+*  same games. After the move the mover's lines are checked, and a lane
+*  that won or filled the board is counted and restarted.
+*********************************************************************/
+void BatchGames::stepScalar()
+{
+    for( int lane = 0; lane < LANES; lane++ )
+    {
+        uint32_t x = xMarks[lane],
+                 o = oMarks[lane],
+                 turn = turns[lane],
+                 state = states[lane];
+
+        uint32_t empty = ~( x | o ) & GameBoard::FULL;
+        uint32_t count = 0;
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            count += ( empty >> cell ) & 1;
+        }
+
+        uint32_t product;
+
+        do
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            product = ( state >> 16 ) * count;
+        }
+        while( ( product & 0xFFFF ) < REJECT_BELOW[count] );
+
+        uint32_t k = product >> 16,
+                 rank = 0,
+                 chosen = 0;
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            uint32_t bit = ( empty >> cell ) & 1;
+
+            if( bit && rank == k )
+            {
+                chosen = 1u << cell;
+            }
+
+            rank += bit;
+        }
+
+        x |= chosen & ~turn;
+        o |= chosen & turn;
+
+        uint32_t mover = turn ? o : x;
+        bool won = false;
+
+        for( int line = 0; line < 8; line++ )
+        {
+            if( ( mover & GameBoard::WIN_LINES[line] ) == GameBoard::WIN_LINES[line] )
+            {
+                won = true;
+            }
+        }
+
+        bool filled = ( x | o ) == GameBoard::FULL;
+
+        if( won || filled )
+        {
+            if( !won )
+                draws[lane]++;
+
+            else if( turn )
+                oWins[lane]++;
+
+            else
+                xWins[lane]++;
+
+            x = startX;
+            o = startO;
+            turn = startTurn;
+        }
+
+        else
+        {
+            turn = ~turn;
+        }
+
+        xMarks[lane] = x;
+        oMarks[lane] = o;
+        turns[lane] = turn;
+        states[lane] = state;
+    }
+}
+
+#ifdef BATCH_GAMES_X86
+
+/*********************************************************************
+** Description: The SSE2 kernel, four lanes per register. Comparisons
+*  give all ones for true, so subtracting a mask counts it.
+*********************************************************************/
+__attribute__(( target( "sse2" ) ))
+void BatchGames::stepSse2()
+{
+    const __m128i full = _mm_set1_epi32( GameBoard::FULL ),
+                  ones = _mm_set1_epi32( -1 ),
+                  startXs = _mm_set1_epi32( startX ),
+                  startOs = _mm_set1_epi32( startO ),
+                  startTurns = _mm_set1_epi32( startTurn );
+
+    for( int lane = 0; lane < LANES; lane += 4 )
+    {
+        __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i*>( xMarks + lane ) ),
+                o = _mm_loadu_si128( reinterpret_cast<const __m128i*>( oMarks + lane ) ),
+                turn = _mm_loadu_si128( reinterpret_cast<const __m128i*>( turns + lane ) ),
+                state = _mm_loadu_si128( reinterpret_cast<const __m128i*>( states + lane ) );
+
+        __m128i empty = _mm_andnot_si128( _mm_or_si128( x, o ), full );
+        __m128i count = _mm_setzero_si128(),
+                rejectBelow = _mm_setzero_si128();
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            __m128i bit = _mm_set1_epi32( 1 << cell );
+            count = _mm_sub_epi32( count, _mm_cmpeq_epi32( _mm_and_si128( empty, bit ), bit ) );
+        }
+
+        for( int cells = 1; cells <= GameBoard::CELLS; cells++ )
+        {
+            __m128i isCount = _mm_cmpeq_epi32( count, _mm_set1_epi32( cells ) );
+            rejectBelow = _mm_or_si128( rejectBelow, _mm_and_si128( isCount, _mm_set1_epi32( REJECT_BELOW[cells] ) ) );
+        }
+
+        //Every lane draws once; rejected lanes draw again on their own.
+        __m128i redraw = ones;
+
+        for( ;; )
+        {
+            __m128i next = _mm_xor_si128( state, _mm_slli_epi32( state, 13 ) );
+            next = _mm_xor_si128( next, _mm_srli_epi32( next, 17 ) );
+            next = _mm_xor_si128( next, _mm_slli_epi32( next, 5 ) );
+            state = _mm_or_si128( _mm_and_si128( redraw, next ), _mm_andnot_si128( redraw, state ) );
+
+            //The high halves of both operands are 0, so the low 16 bits
+            //of each lane hold the low half of random * count.
+            __m128i low = _mm_mullo_epi16( _mm_srli_epi32( state, 16 ), count );
+            redraw = _mm_cmplt_epi32( low, rejectBelow );
+
+            if( _mm_movemask_epi8( redraw ) == 0 )
+            {
+                break;
+            }
+        }
+
+        //Likewise the high half: ( random * count ) >> 16.
+        __m128i k = _mm_mulhi_epu16( _mm_srli_epi32( state, 16 ), count ),
+                rank = _mm_setzero_si128(),
+                chosen = _mm_setzero_si128();
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            __m128i bit = _mm_set1_epi32( 1 << cell );
+            __m128i isEmpty = _mm_cmpeq_epi32( _mm_and_si128( empty, bit ), bit );
+            __m128i hit = _mm_and_si128( isEmpty, _mm_cmpeq_epi32( rank, k ) );
+
+            chosen = _mm_or_si128( chosen, _mm_and_si128( hit, bit ) );
+            rank = _mm_sub_epi32( rank, isEmpty );
+        }
+
+        x = _mm_or_si128( x, _mm_andnot_si128( turn, chosen ) );
+        o = _mm_or_si128( o, _mm_and_si128( turn, chosen ) );
+
+        __m128i mover = _mm_or_si128( _mm_andnot_si128( turn, x ), _mm_and_si128( turn, o ) ),
+                won = _mm_setzero_si128();
+
+        for( int line = 0; line < 8; line++ )
+        {
+            __m128i lineMask = _mm_set1_epi32( GameBoard::WIN_LINES[line] );
+            won = _mm_or_si128( won, _mm_cmpeq_epi32( _mm_and_si128( mover, lineMask ), lineMask ) );
+        }
+
+        __m128i filled = _mm_cmpeq_epi32( _mm_or_si128( x, o ), full ),
+                done = _mm_or_si128( won, filled );
+
+        __m128i* xWinCounts = reinterpret_cast<__m128i*>( xWins + lane );
+        __m128i* oWinCounts = reinterpret_cast<__m128i*>( oWins + lane );
+        __m128i* drawCounts = reinterpret_cast<__m128i*>( draws + lane );
+
+        _mm_storeu_si128( xWinCounts, _mm_sub_epi32( _mm_loadu_si128( xWinCounts ), _mm_andnot_si128( turn, won ) ) );
+        _mm_storeu_si128( oWinCounts, _mm_sub_epi32( _mm_loadu_si128( oWinCounts ), _mm_and_si128( turn, won ) ) );
+        _mm_storeu_si128( drawCounts, _mm_sub_epi32( _mm_loadu_si128( drawCounts ), _mm_andnot_si128( won, filled ) ) );
+
+        x = _mm_or_si128( _mm_and_si128( done, startXs ), _mm_andnot_si128( done, x ) );
+        o = _mm_or_si128( _mm_and_si128( done, startOs ), _mm_andnot_si128( done, o ) );
+        turn = _mm_or_si128( _mm_and_si128( done, startTurns ), _mm_andnot_si128( done, _mm_xor_si128( turn, ones ) ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( xMarks + lane ), x );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( oMarks + lane ), o );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( turns + lane ), turn );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( states + lane ), state );
+    }
+}
+
+/*********************************************************************
+** Description: The AVX2 kernel, eight lanes per register. Same steps
+*  as the SSE2 kernel.
+*********************************************************************/
+__attribute__(( target( "avx2" ) ))
+void BatchGames::stepAvx2()
+{
+    const __m256i full = _mm256_set1_epi32( GameBoard::FULL ),
+                  ones = _mm256_set1_epi32( -1 ),
+                  startXs = _mm256_set1_epi32( startX ),
+                  startOs = _mm256_set1_epi32( startO ),
+                  startTurns = _mm256_set1_epi32( startTurn );
+
+    for( int lane = 0; lane < LANES; lane += 8 )
+    {
+        __m256i x = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( xMarks + lane ) ),
+                o = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( oMarks + lane ) ),
+                turn = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( turns + lane ) ),
+                state = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( states + lane ) );
+
+        __m256i empty = _mm256_andnot_si256( _mm256_or_si256( x, o ), full );
+        __m256i count = _mm256_setzero_si256(),
+                rejectBelow = _mm256_setzero_si256();
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            __m256i bit = _mm256_set1_epi32( 1 << cell );
+            count = _mm256_sub_epi32( count, _mm256_cmpeq_epi32( _mm256_and_si256( empty, bit ), bit ) );
+        }
+
+        for( int cells = 1; cells <= GameBoard::CELLS; cells++ )
+        {
+            __m256i isCount = _mm256_cmpeq_epi32( count, _mm256_set1_epi32( cells ) );
+            rejectBelow = _mm256_or_si256( rejectBelow, _mm256_and_si256( isCount, _mm256_set1_epi32( REJECT_BELOW[cells] ) ) );
+        }
+
+        __m256i redraw = ones;
+
+        for( ;; )
+        {
+            __m256i next = _mm256_xor_si256( state, _mm256_slli_epi32( state, 13 ) );
+            next = _mm256_xor_si256( next, _mm256_srli_epi32( next, 17 ) );
+            next = _mm256_xor_si256( next, _mm256_slli_epi32( next, 5 ) );
+            state = _mm256_blendv_epi8( state, next, redraw );
+
+            __m256i low = _mm256_mullo_epi16( _mm256_srli_epi32( state, 16 ), count );
+            redraw = _mm256_cmpgt_epi32( rejectBelow, low );
+
+            if( _mm256_movemask_epi8( redraw ) == 0 )
+            {
+                break;
+            }
+        }
+
+        __m256i k = _mm256_mulhi_epu16( _mm256_srli_epi32( state, 16 ), count ),
+                rank = _mm256_setzero_si256(),
+                chosen = _mm256_setzero_si256();
+
+        for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+        {
+            __m256i bit = _mm256_set1_epi32( 1 << cell );
+            __m256i isEmpty = _mm256_cmpeq_epi32( _mm256_and_si256( empty, bit ), bit );
+            __m256i hit = _mm256_and_si256( isEmpty, _mm256_cmpeq_epi32( rank, k ) );
+
+            chosen = _mm256_or_si256( chosen, _mm256_and_si256( hit, bit ) );
+            rank = _mm256_sub_epi32( rank, isEmpty );
+        }
+
+        x = _mm256_or_si256( x, _mm256_andnot_si256( turn, chosen ) );
+        o = _mm256_or_si256( o, _mm256_and_si256( turn, chosen ) );
+
+        __m256i mover = _mm256_blendv_epi8( x, o, turn ),
+                won = _mm256_setzero_si256();
+
+        for( int line = 0; line < 8; line++ )
+        {
+            __m256i lineMask = _mm256_set1_epi32( GameBoard::WIN_LINES[line] );
+            won = _mm256_or_si256( won, _mm256_cmpeq_epi32( _mm256_and_si256( mover, lineMask ), lineMask ) );
+        }
+
+        __m256i filled = _mm256_cmpeq_epi32( _mm256_or_si256( x, o ), full ),
+                done = _mm256_or_si256( won, filled );
+
+        __m256i* xWinCounts = reinterpret_cast<__m256i*>( xWins + lane );
+        __m256i* oWinCounts = reinterpret_cast<__m256i*>( oWins + lane );
+        __m256i* drawCounts = reinterpret_cast<__m256i*>( draws + lane );
+
+        _mm256_storeu_si256( xWinCounts, _mm256_sub_epi32( _mm256_loadu_si256( xWinCounts ), _mm256_andnot_si256( turn, won ) ) );
+        _mm256_storeu_si256( oWinCounts, _mm256_sub_epi32( _mm256_loadu_si256( oWinCounts ), _mm256_and_si256( turn, won ) ) );
+        _mm256_storeu_si256( drawCounts, _mm256_sub_epi32( _mm256_loadu_si256( drawCounts ), _mm256_andnot_si256( won, filled ) ) );
+
+        x = _mm256_blendv_epi8( x, startXs, done );
+        o = _mm256_blendv_epi8( o, startOs, done );
+        turn = _mm256_blendv_epi8( _mm256_xor_si256( turn, ones ), startTurns, done );
+
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( xMarks + lane ), x );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( oMarks + lane ), o );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( turns + lane ), turn );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( states + lane ), state );
+    }
+}
+
+#else
+
+//Without x86 vector units bestIsa() never selects these.
+void BatchGames::stepSse2() { stepScalar(); }
+void BatchGames::stepAvx2() { stepScalar(); }
+
+#endif
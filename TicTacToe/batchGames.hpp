@@ -0,0 +1,65 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BatchGames class plays LANES independent random
+*  games at once. The boards are stored as structure of arrays, one
+*  32 bit lane per board, so move generation, random move selection and
+*  win detection run on every lane with the same SSE2 or AVX2
+*  instructions. A scalar kernel gives the same results everywhere
+*  else. Finished lanes are counted and restart from the start position.
+*********************************************************************/
+#ifndef BATCH_GAMES_HPP
+#define BATCH_GAMES_HPP
+
+#include "gamePosition.hpp"
+#include "random.hpp"
+#include <stdint.h>
+
+class BatchGames
+{
+    public:
+        enum Isa { SCALAR, SSE2, AVX2 };
+
+        static const int LANES = 32;
+
+    private:
+        //One entry per lane.
+        alignas( 32 ) uint32_t xMarks[LANES];
+        alignas( 32 ) uint32_t oMarks[LANES];
+        alignas( 32 ) uint32_t turns[LANES]; //0 when X is to move, all ones for O.
+        alignas( 32 ) uint32_t states[LANES]; //xorshift32 random state.
+        alignas( 32 ) uint32_t xWins[LANES];
+        alignas( 32 ) uint32_t oWins[LANES];
+        alignas( 32 ) uint32_t draws[LANES];
+
+        //The position every lane starts and restarts from.
+        uint32_t startX,
+                 startO,
+                 startTurn;
+
+        Isa isa;
+
+        //Private functions.
+        void stepScalar();
+        void stepSse2();
+        void stepAvx2();
+        long long sum( const uint32_t* ) const;
+
+    public:
+        BatchGames( const Random &, Isa isa = bestIsa() );
+        void reset( const GamePosition & );
+        void advance( int );
+
+        //Getter functions.
+        long long getXWins() const { return sum( xWins ); };
+        long long getOWins() const { return sum( oWins ); };
+        long long getDraws() const { return sum( draws ); };
+        long long getGames() const { return getXWins() + getOWins() + getDraws(); };
+        Isa getIsa() const { return isa; };
+
+        static Isa bestIsa();
+        static const char* isaName( Isa );
+};
+
+#endif
@@ -0,0 +1,1760 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Benchmark class measures the game core, input and
+*  render paths and writes the results as JSON so they can be compared
+*  between releases. Each result records the time and the number of
+*  heap allocations made through operator new per operation.
+*********************************************************************/
+#include "benchmark.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <cstring>
+#include <new>
+
+//Counts every allocation made through operator new, on any thread:
+//search, game logic, analyzer and capture threads allocate too.
+static std::atomic< unsigned long long > allocationCounter( 0 );
+
+void* operator new( std::size_t size )
+{
+    allocationCounter.fetch_add( 1, std::memory_order_relaxed );
+
+    void* memory = malloc( size == 0 ? 1 : size );
+
+    if( memory == NULL )
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete( void* memory ) noexcept
+{
+    free( memory );
+}
+
+void operator delete( void* memory, std::size_t ) noexcept
+{
+    free( memory );
+}
+
+/*********************************************************************
+** Description: Main function. Parameters set as required by SDL.
+*  Accepts "--out FILE" to choose where the JSON results are written,
+*  and "--golden DIR" to compare rendered frames with the golden images
+*  in DIR instead of benchmarking. "--update-golden" rewrites them.
+*  "--renderer gl" renders the golden frames with OpenGL.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    string outPath = "benchmark.json";
+    string goldenDir;
+    bool updateGolden = false;
+    bool openGl = false;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--out" ) == 0 && i + 1 < argc )
+        {
+            outPath = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--golden" ) == 0 && i + 1 < argc )
+        {
+            goldenDir = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--update-golden" ) == 0 )
+        {
+            updateGolden = true;
+        }
+
+        else if( strcmp( argv[i], "--renderer" ) == 0 && i + 1 < argc )
+        {
+            openGl = strcmp( argv[++i], "gl" ) == 0;
+        }
+    }
+
+    Benchmark benchmark;
+
+    if( !goldenDir.empty() )
+    {
+        int failures = 1;
+
+        if( benchmark.startGraphics( openGl ) )
+        {
+            failures = benchmark.checkGolden( goldenDir, updateGolden );
+        }
+
+        benchmark.stopGraphics();
+
+        return failures == 0 ? 0 : 1;
+    }
+
+    benchmark.benchCheckGame();
+    benchmark.benchHandleEvent();
+    benchmark.benchProfileScope();
+    benchmark.benchHandoff();
+    benchmark.benchAudio();
+    benchmark.benchMcts();
+    benchmark.benchUltimate();
+    benchmark.benchQubic();
+
+    bool splitsDiffer = benchmark.checkSplits();
+    bool batchesMatch = benchmark.benchBatchGames();
+    bool gomokuCorrect = benchmark.benchGomoku();
+    bool analysisCorrect = benchmark.benchAnalysis();
+    bool engineLegal = benchmark.benchEngine();
+    bool bookFound = benchmark.benchBook();
+    bool allocationFree = true;
+
+    benchmark.benchStartup();
+
+    if( benchmark.startGraphics() )
+    {
+        benchmark.benchDrawGame();
+        benchmark.benchThemes();
+        benchmark.benchDrawUltimate();
+        benchmark.benchDrawQubic();
+        benchmark.benchDrawWall( "" );
+        benchmark.benchCapture( "" );
+        allocationFree = benchmark.benchMatchFrames();
+        benchmark.benchJitter();
+    }
+
+    benchmark.stopGraphics();
+
+    //The same frames again on OpenGL, compared with the SDL renderer.
+    if( benchmark.startGraphics( true ) )
+    {
+        benchmark.benchDrawGl();
+        benchmark.benchDrawWall( " (gl)" );
+        benchmark.benchCapture( " (gl)" );
+    }
+
+    benchmark.stopGraphics();
+
+    if( !allocationFree )
+    {
+        printf( "FAIL: frames of a running match allocated memory!\n" );
+    }
+
+    if( !splitsDiffer )
+    {
+        printf( "FAIL: two chains of random splits gave the same numbers!\n" );
+    }
+
+    if( !batchesMatch )
+    {
+        printf( "FAIL: the batch game kernels disagree!\n" );
+    }
+
+    if( !gomokuCorrect )
+    {
+        printf( "FAIL: the Gomoku evaluation or threat search is wrong!\n" );
+    }
+
+    if( !analysisCorrect )
+    {
+        printf( "FAIL: the analysis disagrees with the solved table!\n" );
+    }
+
+    if( !engineLegal )
+    {
+        printf( "FAIL: the reference engine answered with an illegal move!\n" );
+    }
+
+    if( !bookFound )
+    {
+        printf( "FAIL: the opening book lost a position or a move!\n" );
+    }
+
+    return benchmark.writeJson( outPath ) && allocationFree && splitsDiffer && batchesMatch && gomokuCorrect
+           && analysisCorrect && engineLegal
+           && bookFound ? 0 : 1;
+}
+
+/*********************************************************************
+** Description: Constructor.
+*********************************************************************/
+Benchmark::Benchmark()
+{
+    graphics = NULL;
+}
+
+/*********************************************************************
+** Description: Destructor.
+*********************************************************************/
+Benchmark::~Benchmark()
+{
+    stopGraphics();
+}
+
+/*********************************************************************
+** Description: Returns the number of allocations made so far.
+*********************************************************************/
+unsigned long long Benchmark::allocations()
+{
+    return allocationCounter.load( std::memory_order_relaxed );
+}
+
+/*********************************************************************
+** Description: Measures GameBoard::checkGame over a fixed set of
+*  random positions, both finished and unfinished.
+*********************************************************************/
+void Benchmark::benchCheckGame()
+{
+    const int POSITIONS = 16;
+
+    Random random( 1 );
+    GameBoard boards[POSITIONS];
+    Player lastPlayers[POSITIONS];
+
+    for( int p = 0; p < POSITIONS; p++ )
+    {
+        int moves = random.nextInt( 10 );
+        Player player = static_cast<Player>( random.nextInt( 2 ) );
+        lastPlayers[p] = No_Player;
+
+        for( int m = 0; m < moves; m++ )
+        {
+            int cell = random.nextInt( GameBoard::CELLS );
+
+            while( !boards[p].play( cell, player ) )
+            {
+                cell = ( cell + 1 ) % GameBoard::CELLS;
+            }
+
+            lastPlayers[p] = player;
+            player = GameBoard::other( player );
+        }
+    }
+
+    int outcomes = 0;
+
+    measure( "GameBoard::checkGame", 10000000, [&]( long long i )
+    {
+        outcomes += boards[i % POSITIONS].checkGame( lastPlayers[i % POSITIONS] );
+    } );
+
+    printf( "(checksum %d)\n", outcomes );
+}
+
+/*********************************************************************
+** Description: Measures MouseButtons::handleEvent the way runGame
+*  dispatches a polled event to the nine board buttons, over a
+*  synthetic stream of mouse motion and click events.
+*********************************************************************/
+void Benchmark::benchHandleEvent()
+{
+    const int EVENTS = 1024;
+
+    MouseButtons buttons[3][3];
+
+    for( int i = 0; i < 3; i++ )
+    {
+        for( int j = 0; j < 3; j++ )
+        {
+            buttons[i][j].setButtonSpecs( j * 165, i * 165, 150, 150 );
+        }
+    }
+
+    Random random( 2 );
+    vector< SDL_Event > events( EVENTS );
+
+    for( int e = 0; e < EVENTS; e++ )
+    {
+        memset( &events[e], 0, sizeof( SDL_Event ) );
+
+        if( random.nextInt( 8 ) == 0 )
+        {
+            events[e].type = SDL_MOUSEBUTTONDOWN;
+            events[e].button.button = SDL_BUTTON_LEFT;
+            events[e].button.x = random.nextInt( 640 );
+            events[e].button.y = random.nextInt( 480 );
+        }
+
+        else
+        {
+            events[e].type = SDL_MOUSEMOTION;
+            events[e].motion.x = random.nextInt( 640 );
+            events[e].motion.y = random.nextInt( 480 );
+        }
+    }
+
+    int hovered = 0;
+
+    measure( "MouseButtons::handleEvent", 2000000, [&]( long long n )
+    {
+        SDL_Event* event = &events[n % EVENTS];
+        bool endLoop = false;
+
+        for( unsigned i = 0; i < 3 && !endLoop; i++ )
+        {
+            for( unsigned j = 0; j < 3 && !endLoop; j++ )
+            {
+                buttons[i][j].handleEvent( event );
+
+                if( buttons[i][j].getMouseOver() )
+                {
+                    endLoop = true;
+                    hovered++;
+                }
+            }
+        }
+    } );
+
+    printf( "(checksum %d)\n", hovered );
+}
+
+/*********************************************************************
+** Description: Measures an empty profiler scope, disabled and enabled.
+*********************************************************************/
+void Benchmark::benchProfileScope()
+{
+    measure( "ProfileScope (disabled)", 10000000, [&]( long long )
+    {
+        PROFILE_SCOPE( "empty" );
+    } );
+
+    Profiler::setEnabled( true );
+
+    measure( "ProfileScope (enabled)", 10000000, [&]( long long )
+    {
+        PROFILE_SCOPE( "empty" );
+    } );
+
+    Profiler::setEnabled( false );
+}
+
+/*********************************************************************
+** Description: Measures the hand off from the render thread to the
+*  game logic and back: one input command through the queue, one
+*  snapshot published and read through the triple buffer.
+*********************************************************************/
+void Benchmark::benchHandoff()
+{
+    GameLogic logic( Random( 4 ) );
+    unsigned long long sequences = 0;
+
+    measure( "GameLogic command and snapshot", 2000000, [&]( long long i )
+    {
+        logic.send( InputCommand( InputCommand::HOVER, static_cast<int>( i % GameBoard::CELLS ) ) );
+        logic.step();
+        sequences += logic.latestSnapshot().sequence;
+    } );
+
+    printf( "(checksum %llu)\n", sequences );
+}
+
+/*********************************************************************
+** Description: Measures the sound cues from the click to the audio
+*  callback that starts them, with three audio buffer sizes. Clicks
+*  arrive at uneven times, as a player's would, and go through the game
+*  logic like in the game. Then measures asking for one cue.
+*********************************************************************/
+void Benchmark::benchAudio()
+{
+    const int BUFFERS[] = { 128, 512, 2048 },
+              CLICKS = 100;
+
+    for( int i = 0; i < 3; i++ )
+    {
+        AudioHandler audio;
+        audio.setBufferSize( BUFFERS[i] );
+
+        if( !audio.startUp() )
+        {
+            return;
+        }
+
+        GameLogic logic( Random( 5 ) );
+        logic.setAudio( &audio );
+
+        for( int click = 0; click < CLICKS; click++ )
+        {
+            logic.send( InputCommand( InputCommand::CLICK, click % GameBoard::CELLS ) );
+            logic.send( InputCommand( InputCommand::CLICK, PLAY_AGAIN_CELL ) );
+            logic.step();
+            std::this_thread::sleep_for( std::chrono::microseconds( 1000 + click * 7919 % 4000 ) );
+        }
+
+        //Lets the last cues reach the callback.
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 * 1000 * BUFFERS[i] / audio.getFrequency() + 5 ) );
+
+        char name[64];
+        snprintf( name, sizeof( name ), "audio cue latency (%d frames)", BUFFERS[i] );
+
+        Result result( name, audio.getLatencyCount(), audio.getLatencyMean(), 0.0 );
+        result.worstNs = static_cast<double>( audio.getLatencyWorst() );
+        results.push_back( result );
+
+        printf( "%-40s %12.1f ns/op %8.1f ns worst\n", result.name.c_str(), result.nsPerOp, result.worstNs );
+
+        //Fewer requests than the queue holds, so none is dropped.
+        if( BUFFERS[i] == 512 )
+        {
+            measure( "AudioHandler::play", 50, [&]( long long )
+            {
+                audio.play( MOVE_CUE, Profiler::now() );
+            } );
+        }
+
+        audio.cleanUp();
+    }
+}
+
+/*********************************************************************
+** Description: Checks the analysis of random classic positions against
+*  the PerfectPlayer's solved table, then measures how long the analysis
+*  of each position of a 4,4,4 game takes once the previous position was
+*  analyzed, keeping the transposition table and clearing it each time.
+*  The analyzer runs on its thread as in the game; the benchmark polls
+*  for the finished heatmap.
+*
+*  Return: bool - false if a solved cell differs from the table.
+*********************************************************************/
+bool Benchmark::benchAnalysis()
+{
+    bool correct = true;
+
+    //Waits until every empty cell of a position is solved.
+    auto waitFor = []( Analyzer &analyzer, const MnkPosition &position ) -> const Heatmap&
+    {
+        analyzer.request( position );
+
+        while( analyzer.latest().position != position || analyzer.latest().solved != position.getEmpty() )
+        {
+            std::this_thread::yield();
+        }
+
+        return analyzer.latest();
+    };
+
+    {
+        Analyzer analyzer;
+        Random random( 6 );
+
+        analyzer.start();
+
+        for( int game = 0; game < 20 && correct; game++ )
+        {
+            GamePosition position( static_cast<Player>( game % 2 ) );
+
+            while( position.getOutcome() == UNFINISHED && correct )
+            {
+                const Heatmap &heatmap = waitFor( analyzer, Analyzer::fromBoard( position.getBoard(), position.getToMove() ) );
+                int moves[GamePosition::MAX_MOVES];
+                int count = position.getMoves( moves );
+
+                for( int i = 0; i < count; i++ )
+                {
+                    GamePosition next = position;
+                    next.play( moves[i] );
+
+                    if( heatmap.scores[moves[i]] != -PerfectPlayer::score( next ) )
+                    {
+                        correct = false;
+                    }
+                }
+
+                position.play( moves[random.nextInt( count )] );
+            }
+        }
+    }
+
+    const int SEQUENCE[] = { 5, 10, 6, 9, 0, 15, 3, 12, 1, 2, 4, 7, 8, 11, 13, 14 };
+    const char* NAMES[2] = { "analysis after a 4,4,4 move", "analysis after a 4,4,4 move (no reuse)" };
+
+    for( int reuse = 1; reuse >= 0; reuse-- )
+    {
+        Analyzer analyzer;
+        MnkPosition position( 4, 4, 4, X_Player );
+
+        analyzer.setIncremental( reuse == 1 );
+        analyzer.start();
+        waitFor( analyzer, position );
+
+        long long nodes = analyzer.getNodes(),
+                  moves = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for( int i = 0; position.play( SEQUENCE[i] ) && position.getOutcome() == UNFINISHED; i++ )
+        {
+            waitFor( analyzer, position );
+            moves++;
+        }
+
+        double elapsed = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+
+        results.push_back( Result( NAMES[1 - reuse], moves, elapsed / moves, 0.0 ) );
+        printf( "%-40s %12.1f ns/op %8lld nodes/move\n", NAMES[1 - reuse], elapsed / moves,
+                ( analyzer.getNodes() - nodes ) / moves );
+    }
+
+    return correct;
+}
+
+/*********************************************************************
+** Description: Measures the engine protocol with the reference engine,
+*  which answers at once, so the times are the protocol's own: one
+*  position at a time, each waiting for its answer, and pipelined with
+*  windows of positions sent before their answers are read. A random
+*  move made in the game's own process is measured for comparison. The
+*  benchmark is skipped if the reference engine has not been built.
+*
+*  Return: bool - false if an answer was not a legal move.
+*********************************************************************/
+bool Benchmark::benchEngine()
+{
+#ifdef _WIN32
+    const char* COMMAND = "refengine.exe";
+#else
+    const char* COMMAND = "./refengine";
+#endif
+    const int POSITIONS = 256;
+    const int ROUNDS = 20;
+
+    Engine engine;
+
+    if( !engine.start( COMMAND ) )
+    {
+        printf( "Skipped the engine protocol, build %s with \"make refengine\".\n", COMMAND );
+        return true;
+    }
+
+    Random random( 12 );
+    vector< GamePosition > positions;
+    vector< string > descriptions;
+
+    while( static_cast<int>( positions.size() ) < POSITIONS )
+    {
+        GamePosition position( static_cast<Player>( random.nextInt( 2 ) ) );
+        int moves[GamePosition::MAX_MOVES];
+
+        for( int m = random.nextInt( 8 ); m > 0 && position.getOutcome() == UNFINISHED; m-- )
+        {
+            position.play( moves[random.nextInt( position.getMoves( moves ) )] );
+        }
+
+        if( position.getOutcome() == UNFINISHED )
+        {
+            positions.push_back( position );
+            descriptions.push_back( Engine::describe( position ) );
+        }
+    }
+
+    //A move is legal if its cell is empty.
+    bool legal = true;
+    auto check = [&]( int p, int move )
+    {
+        if( move < 0 || move >= GameBoard::CELLS || positions[p].getBoard().getPick( move ) != No_Player )
+        {
+            legal = false;
+        }
+    };
+
+    TimeControl control;
+    control.moveTime = 1;
+
+    measure( "engine move round trip", 2000, [&]( long long i )
+    {
+        int p = static_cast<int>( i % POSITIONS );
+        check( p, engine.wait( engine.go( descriptions[p], control ), 5000 ) );
+    } );
+
+    const int WINDOWS[3] = { 1, 16, 256 };
+
+    for( int w = 0; w < 3; w++ )
+    {
+        vector< int > moves;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for( int round = 0; round < ROUNDS; round++ )
+        {
+            if( !engine.analyze( descriptions, control, WINDOWS[w], moves ) )
+            {
+                legal = false;
+            }
+        }
+
+        double elapsed = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+
+        for( int p = 0; p < POSITIONS; p++ )
+        {
+            check( p, moves[p] );
+        }
+
+        char name[64];
+        snprintf( name, sizeof( name ), "engine analysis (window %d)", WINDOWS[w] );
+
+        double nsPerPosition = elapsed / ( ROUNDS * POSITIONS );
+        results.push_back( Result( name, ROUNDS * POSITIONS, nsPerPosition, 0.0 ) );
+        printf( "%-40s %12.1f ns/op %12.0f positions/sec\n", name, nsPerPosition, 1e9 / nsPerPosition );
+    }
+
+    engine.quit();
+
+    RandomPlayer player( random );
+
+    measure( "random move (in process)", 100000, [&]( long long i )
+    {
+        check( static_cast<int>( i % POSITIONS ), player.chooseMove( positions[i % POSITIONS] ) );
+    } );
+
+    return legal;
+}
+
+/*********************************************************************
+** Description: Writes an opening book of random 4,4,4 positions, each
+*  stored in its canonical orientation, and measures looking them up
+*  again in every orientation against the MCTS move the book replaces.
+*  The book file is removed afterwards.
+*
+*  Return: bool - false if a position was not found or its move was
+*  not the one written.
+*********************************************************************/
+bool Benchmark::benchBook()
+{
+    const char* PATH = "benchmark.book";
+    const int POSITIONS = 4096;
+    const int PLIES = 8;
+
+    Random random( 13 );
+    vector< MnkPosition > positions;
+    vector< OpeningBook::Entry > entries;
+    std::set< uint64_t > keys;
+
+    while( static_cast<int>( positions.size() ) < POSITIONS )
+    {
+        MnkPosition position( 4, 4, 4, static_cast<Player>( random.nextInt( 2 ) ) );
+        int moves[MnkPosition::MAX_MOVES];
+
+        for( int m = random.nextInt( PLIES ); m > 0; m-- )
+        {
+            position.play( moves[random.nextInt( position.getMoves( moves ) )] );
+        }
+
+        int transform = 0;
+        uint64_t key = OpeningBook::canonicalKey( position, transform );
+
+        if( position.getOutcome() != UNFINISHED || !keys.insert( key ).second )
+        {
+            continue;
+        }
+
+        //Any legal move, written in the canonical orientation.
+        OpeningBook::Entry entry;
+        entry.key = key;
+        entry.games = 1;
+        entry.score = OpeningBook::SCORE_SCALE / 2;
+        entry.move = static_cast<uint8_t>( OpeningBook::transformCell( moves[random.nextInt( position.getMoves( moves ) )],
+                                                                       transform, 4, 4 ) );
+        entry.moveCount = 1;
+
+        entries.push_back( entry );
+        positions.push_back( position );
+    }
+
+    OpeningBook book;
+    bool found = OpeningBook::write( PATH, 4, 4, 4, PLIES, entries ) && book.open( PATH );
+
+    measure( "opening book lookup", 200000, [&]( long long i )
+    {
+        const MnkPosition &position = positions[i % POSITIONS];
+        int move = -1;
+
+        if( book.find( position, move ) == NULL || !( position.getEmpty() >> move & 1 ) )
+        {
+            found = false;
+        }
+    } );
+
+    //Every position also under its reflections and rotations.
+    for( int p = 0; p < POSITIONS && found; p++ )
+    {
+        int move = -1,
+            transform = 0;
+        const OpeningBook::Entry* entry = book.find( positions[p], move );
+        MnkPosition after = positions[p];
+        after.play( move );
+        uint64_t afterKey = OpeningBook::canonicalKey( after, transform );
+
+        for( int t = 1; t < 8 && entry != NULL; t++ )
+        {
+            int moved = -1;
+            MnkPosition turned = transformPosition( positions[p], t );
+
+            if( book.find( turned, moved ) != entry || !turned.play( moved )
+                || OpeningBook::canonicalKey( turned, transform ) != afterKey )
+            {
+                found = false;
+            }
+        }
+    }
+
+    book.close();
+    std::remove( PATH );
+
+    MctsSettings settings;
+    settings.threads = 1;
+    settings.playouts = 1000;
+    MctsPlayer player( settings, random );
+
+    measure( "MCTS move replaced by the book", 20, [&]( long long i )
+    {
+        player.chooseMnkMove( positions[i % POSITIONS] );
+    } );
+
+    return found;
+}
+
+/*********************************************************************
+** Description: Turns a position by one of the board's symmetries.
+*
+*  Parameters: MnkPosition position - the position.
+*              int transform - the symmetry, as in OpeningBook.
+*
+*  Return: MnkPosition - the turned position, with the same player to
+*  move.
+*********************************************************************/
+MnkPosition Benchmark::transformPosition( const MnkPosition &position, int transform )
+{
+    int width = position.getWidth(),
+        height = position.getHeight();
+    Player mover = position.getToMove();
+    uint32_t marks[2] = { position.getMarks( GameBoard::other( mover ) ), position.getMarks( mover ) };
+
+    //The player with more marks started, otherwise the one to move did.
+    bool moverFirst = __builtin_popcount( marks[0] ) == __builtin_popcount( marks[1] );
+
+    if( moverFirst )
+    {
+        std::swap( marks[0], marks[1] );
+    }
+
+    MnkPosition turned( width, height, position.getK(), moverFirst ? mover : GameBoard::other( mover ) );
+
+    for( int m = 0; m < position.getPly(); m++ )
+    {
+        uint32_t &next = marks[m % 2];
+        turned.play( OpeningBook::transformCell( __builtin_ctz( next ), transform, width, height ) );
+        next &= next - 1;
+    }
+
+    return turned;
+}
+
+/*********************************************************************
+** Description: Measures the MCTS player through whole self-play games,
+*  once with one search thread and once with every hardware thread.
+*  The time per playout includes the tree reuse between moves.
+*********************************************************************/
+void Benchmark::benchMcts()
+{
+    const int GAMES = 10;
+    int hardware = static_cast<int>( std::thread::hardware_concurrency() );
+    int threadCounts[2] = { 1, hardware };
+
+    for( int run = 0; run < ( hardware > 1 ? 2 : 1 ); run++ )
+    {
+        int threads = threadCounts[run];
+        MctsSettings settings;
+        settings.threads = threads;
+        settings.playouts = 10000;
+
+        Mcts< GamePosition > search( settings, Random( 7 ) );
+        long long playouts = 0;
+        double seconds = 0.0;
+        int draws = 0;
+
+        for( int game = 0; game < GAMES; game++ )
+        {
+            GamePosition position( static_cast<Player>( game % 2 ) );
+
+            while( position.getOutcome() == UNFINISHED )
+            {
+                position.play( search.search( position ) );
+                playouts += search.getPlayouts();
+                seconds += search.getSeconds();
+            }
+
+            if( position.getOutcome() == DRAW )
+            {
+                draws++;
+            }
+        }
+
+        char name[64];
+        snprintf( name, sizeof( name ), "MCTS playout (%d thread%s)", threads, threads == 1 ? "" : "s" );
+
+        double nsPerPlayout = seconds * 1e9 / playouts;
+        results.push_back( Result( name, playouts, nsPerPlayout, 0.0 ) );
+
+        printf( "%-40s %12.1f ns/op %12.0f playouts/sec (%d of %d self-play games drawn)\n", name,
+                nsPerPlayout, playouts / seconds, draws, GAMES );
+    }
+}
+
+/*********************************************************************
+** Description: Measures random games of Ultimate Tic Tac Toe, which
+*  mostly exercise the legal move generation, and the MCTS playouts per
+*  second on the larger game.
+*********************************************************************/
+void Benchmark::benchUltimate()
+{
+    Random random( 10 );
+    int moves[UltimatePosition::MAX_MOVES];
+    long long plies = 0;
+
+    measure( "UltimatePosition random game", 200000, [&]( long long i )
+    {
+        UltimatePosition position( static_cast<Player>( i % 2 ) );
+
+        while( position.getOutcome() == UNFINISHED )
+        {
+            position.play( moves[random.nextInt( position.getMoves( moves ) )] );
+            plies++;
+        }
+    } );
+
+    printf( "(checksum %lld)\n", plies );
+
+    MctsSettings settings;
+    settings.threads = 1;
+    settings.playouts = 2000;
+    settings.poolSize = 1 << 20;
+
+    Mcts< UltimatePosition > search( settings, Random( 11 ) );
+    UltimatePosition position( X_Player );
+    long long playouts = 0;
+    double seconds = 0.0;
+
+    while( position.getOutcome() == UNFINISHED )
+    {
+        position.play( search.search( position ) );
+        playouts += search.getPlayouts();
+        seconds += search.getSeconds();
+    }
+
+    results.push_back( Result( "MCTS playout (ultimate, 1 thread)", playouts, seconds * 1e9 / playouts, 0.0 ) );
+
+    printf( "%-40s %12.1f ns/op %12.0f playouts/sec\n", "MCTS playout (ultimate, 1 thread)",
+            seconds * 1e9 / playouts, playouts / seconds );
+}
+
+/*********************************************************************
+** Description: Measures random games of Qubic, where every move checks
+*  only the lines through its cell, and the MCTS playouts per second on
+*  the 4x4x4 board.
+*********************************************************************/
+void Benchmark::benchQubic()
+{
+    Random random( 13 );
+    int moves[QubicPosition::MAX_MOVES];
+    long long plies = 0;
+
+    measure( "QubicPosition random game", 200000, [&]( long long i )
+    {
+        QubicPosition position( static_cast<Player>( i % 2 ) );
+
+        while( position.getOutcome() == UNFINISHED )
+        {
+            position.play( moves[random.nextInt( position.getMoves( moves ) )] );
+            plies++;
+        }
+    } );
+
+    printf( "(checksum %lld)\n", plies );
+
+    MctsSettings settings;
+    settings.threads = 1;
+    settings.playouts = 2000;
+    settings.poolSize = 1 << 20;
+
+    Mcts< QubicPosition > search( settings, Random( 14 ) );
+    QubicPosition position( X_Player );
+    long long playouts = 0;
+    double seconds = 0.0;
+
+    while( position.getOutcome() == UNFINISHED )
+    {
+        position.play( search.search( position ) );
+        playouts += search.getPlayouts();
+        seconds += search.getSeconds();
+    }
+
+    results.push_back( Result( "MCTS playout (qubic, 1 thread)", playouts, seconds * 1e9 / playouts, 0.0 ) );
+
+    printf( "%-40s %12.1f ns/op %12.0f playouts/sec\n", "MCTS playout (qubic, 1 thread)",
+            seconds * 1e9 / playouts, playouts / seconds );
+}
+
+/*********************************************************************
+** Description: Checks that generators split along different chains,
+*  as the tournament splits a generator per game and then per player
+*  and search thread, give different numbers. Also checks that chains
+*  differing only in the stream of an earlier split differ.
+*
+*  Return: bool - false if two of the chains start the same.
+*********************************************************************/
+bool Benchmark::checkSplits()
+{
+    const int GAMES = 64,
+              DRAWS = 4;
+    std::set< vector< uint32_t > > sequences;
+
+    for( int game = 0; game < GAMES; game++ )
+    {
+        for( int side = 1; side <= 2; side++ )
+        {
+            Random random = Random( 7 ).split( game ).split( side ).split( 0 );
+            vector< uint32_t > draws;
+
+            for( int i = 0; i < DRAWS; i++ )
+            {
+                draws.push_back( random.next() );
+            }
+
+            sequences.insert( draws );
+        }
+    }
+
+    bool differ = sequences.size() == static_cast<size_t>( 2 * GAMES );
+
+    printf( "%-40s %12s %d of %d chains distinct\n", "Random split chains", differ ? "PASS" : "FAIL",
+            static_cast<int>( sequences.size() ), 2 * GAMES );
+
+    return differ;
+}
+
+/*********************************************************************
+** Description: Measures random games played one board at a time with
+*  GamePosition, then BatchGames with every instruction set the
+*  processor supports. Every kernel plays the same games from the same
+*  seed, so their counts must match.
+*
+*  Return: bool - false if the kernels' results differ.
+*********************************************************************/
+bool Benchmark::benchBatchGames()
+{
+    const int GAMES = 2000000,
+              STEPS = 500000;
+
+    Random random( 8 );
+    int xWon = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int game = 0; game < GAMES; game++ )
+    {
+        GamePosition position( X_Player );
+        int moves[GamePosition::MAX_MOVES];
+
+        while( position.getOutcome() == UNFINISHED )
+        {
+            position.play( moves[random.nextInt( position.getMoves( moves ) )] );
+        }
+
+        xWon += position.getOutcome() == X_WON;
+    }
+
+    double elapsed = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+    results.push_back( Result( "random game (one board)", GAMES, elapsed / GAMES, 0.0 ) );
+
+    printf( "%-40s %12.1f ns/op %12.0f games/sec (X won %.1f%%)\n", "random game (one board)",
+            elapsed / GAMES, GAMES * 1e9 / elapsed, 100.0 * xWon / GAMES );
+
+    bool match = true;
+    long long firstCounts[3] = { 0, 0, 0 };
+
+    for( int isa = BatchGames::SCALAR; isa <= BatchGames::bestIsa(); isa++ )
+    {
+        BatchGames batch( Random( 9 ), static_cast<BatchGames::Isa>( isa ) );
+
+        start = std::chrono::steady_clock::now();
+        batch.advance( STEPS );
+        elapsed = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+
+        long long games = batch.getGames();
+        long long counts[3] = { batch.getXWins(), batch.getOWins(), batch.getDraws() };
+
+        char name[64];
+        snprintf( name, sizeof( name ), "random game (batch of %d, %s)", BatchGames::LANES,
+                  BatchGames::isaName( batch.getIsa() ) );
+
+        results.push_back( Result( name, games, elapsed / games, 0.0 ) );
+
+        printf( "%-40s %12.1f ns/op %12.0f games/sec (X won %.1f%%)\n", name,
+                elapsed / games, games * 1e9 / elapsed, 100.0 * counts[0] / games );
+
+        for( int i = 0; i < 3; i++ )
+        {
+            if( isa == BatchGames::SCALAR )
+                firstCounts[i] = counts[i];
+
+            else if( counts[i] != firstCounts[i] )
+                match = false;
+        }
+    }
+
+    return match;
+}
+
+/*********************************************************************
+** Description: Starts the graphics offscreen, where nothing waits for
+*  vsync. The software renderer needs no display; OpenGL draws into a
+*  hidden window.
+*
+*  Parameters: bool openGl - use the OpenGL renderer.
+*
+*  Return: bool - indicates whether the graphics started.
+*********************************************************************/
+bool Benchmark::startGraphics( bool openGl )
+{
+    graphics = new GraphicsHandler( 640, 480, true );
+    graphics->setOpenGl( openGl );
+
+    if( !graphics->startUp() || graphics->isOpenGl() != openGl )
+    {
+        printf( openGl ? "OpenGL benchmarks skipped!\n" : "Graphics benchmarks skipped!\n" );
+        return false;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Measures starting the offscreen graphics up to the end
+*  of the first frame, in the fast startup mode and with everything
+*  started and loaded up front, and prints the phases of the last
+*  start up of each. The process, the libraries and the files are
+*  already loaded, so this is a warm start; the game prints its own
+*  cold start at its first frame.
+*********************************************************************/
+void Benchmark::benchStartup()
+{
+    GameSnapshot snapshot;
+
+    for( int fast = 1; fast >= 0; fast-- )
+    {
+        measure( fast ? "startup to first frame" : "startup to first frame (full)", 20, [&]( long long )
+        {
+            GraphicsHandler startup( 640, 480, true );
+
+            StartupProfiler::reset();
+            startup.setFastStartup( fast == 1 );
+
+            if( startup.startUp() )
+            {
+                startup.drawGame( snapshot );
+                StartupProfiler::mark( "first frame" );
+            }
+
+            startup.cleanUp();
+        } );
+
+        StartupProfiler::report();
+    }
+
+    double full = results.back().nsPerOp,
+           fast = results[results.size() - 2].nsPerOp;
+
+    printf( "%-40s %12.2fx faster to the first frame\n", "", full / fast );
+}
+
+/*********************************************************************
+** Description: Measures a full frame of a game in progress, with five
+*  marks on the board and a hovered cell.
+*********************************************************************/
+void Benchmark::benchDrawGame()
+{
+    GameSnapshot snapshot;
+    snapshot.hoverCell = 2;
+
+    for( int m = 0; m < 5; m++ )
+    {
+        snapshot.board.play( m, static_cast<Player>( m % 2 ) );
+    }
+
+    measure( "GraphicsHandler::drawGame", 2000, [&]( long long )
+    {
+        graphics->drawGame( snapshot );
+    } );
+}
+
+/*********************************************************************
+** Description: Measures switching to the next theme and drawing the
+*  frame of benchDrawGame() in it, with a budget that keeps every
+*  theme cached and with one that only fits the theme on the screen,
+*  and prints the texture memory and evictions of each.
+*********************************************************************/
+void Benchmark::benchThemes()
+{
+    const char* NAMES[2] = { "GraphicsHandler::setTheme (cached)", "GraphicsHandler::setTheme (tight budget)" };
+    GameSnapshot snapshot;
+
+    for( int m = 0; m < 5; m++ )
+    {
+        snapshot.board.play( m, static_cast<Player>( m % 2 ) );
+    }
+
+    //The tight budget is what the frame of one theme uses.
+    graphics->setTheme( THEMES[0] );
+    graphics->drawGame( snapshot );
+
+    const long long BUDGETS[2] = { graphics->getTextureCache().getBudget(), graphics->getTextureCache().getBytes() };
+
+    for( int b = 0; b < 2; b++ )
+    {
+        long long evictions = graphics->getTextureCache().getEvictions();
+
+        graphics->setTextureBudget( BUDGETS[b] );
+
+        measure( NAMES[b], 300, [&]( long long i )
+        {
+            graphics->setTheme( THEMES[i % THEME_COUNT] );
+            graphics->drawGame( snapshot );
+        } );
+
+        printf( "%-40s %12.2f MB of textures, %d cached, %lld evicted\n", "", graphics->getTextureBytes() / 1048576.0,
+                graphics->getTextureCache().getCount(), graphics->getTextureCache().getEvictions() - evictions );
+    }
+
+    graphics->setTextureBudget( BUDGETS[0] );
+    graphics->setTheme( THEMES[0] );
+}
+
+/*********************************************************************
+** Description: Builds the fixed set of 15x15 Gomoku positions: random
+*  moves crowded into the center so the positions are full of threats,
+*  and a four-three that X wins in two attacking moves.
+*
+*  Return: vector<GomokuBoard> - the positions, the four-three first.
+*********************************************************************/
+vector< GomokuBoard > Benchmark::gomokuPositions()
+{
+    vector< GomokuBoard > positions;
+    GomokuBoard fourThree( 15, X_Player );
+    int xCells[] = { 7 * 15 + 3, 7 * 15 + 4, 7 * 15 + 5, 5 * 15 + 6, 6 * 15 + 6 },
+        oCells[] = { 7 * 15 + 2, 0, 14, 14 * 15, 14 * 15 + 14 };
+
+    for( int i = 0; i < 5; i++ )
+    {
+        fourThree.play( xCells[i] );
+        fourThree.play( oCells[i] );
+    }
+
+    positions.push_back( fourThree );
+
+    for( int p = 0; p < 15; p++ )
+    {
+        GomokuBoard position( 15, static_cast<Player>( p % 2 ) );
+        Random random( 20 + p );
+        int stones = 16 + 2 * p;
+
+        while( position.getStones() < stones && position.getOutcome() == UNFINISHED )
+        {
+            position.play( ( 4 + random.nextInt( 7 ) ) * 15 + 4 + random.nextInt( 7 ) );
+        }
+
+        if( position.getOutcome() == UNFINISHED )
+        {
+            positions.push_back( position );
+        }
+    }
+
+    return positions;
+}
+
+/*********************************************************************
+** Description: Measures the Gomoku evaluation on the fixed positions:
+*  a move and its undo, which update the score incrementally, against
+*  scoring the board from scratch, then the threat space search nodes
+*  per second.
+*
+*  Return: bool - false if an incremental score differs from a full
+*  one or the four-three is not found.
+*********************************************************************/
+bool Benchmark::benchGomoku()
+{
+    vector< GomokuBoard > positions = gomokuPositions();
+    GomokuBoard board = positions[1];
+    int moves[GomokuBoard::MAX_MOVES];
+    int count = board.getMoves( moves );
+    bool correct = true;
+    long long checksum = 0;
+
+    measure( "GomokuBoard play and undo", 5000000, [&]( long long i )
+    {
+        int move = moves[i % count];
+
+        board.play( move );
+        checksum += board.getScore();
+        board.undo( move );
+    } );
+
+    measure( "GomokuBoard::evaluate (full board)", 200000, [&]( long long )
+    {
+        checksum += board.evaluate();
+    } );
+
+    printf( "(checksum %lld)\n", checksum );
+
+    for( unsigned p = 0; p < positions.size(); p++ )
+    {
+        correct = correct && positions[p].getScore() == positions[p].evaluate();
+    }
+
+    ThreatSearch search;
+    long long nodes = 0;
+    int wins = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( unsigned p = 0; p < positions.size(); p++ )
+    {
+        int move = search.findWin( positions[p], 4 );
+
+        nodes += search.getNodes();
+        wins += move >= 0;
+
+        if( p == 0 && move != 7 * 15 + 6 )
+        {
+            correct = false;
+        }
+    }
+
+    double elapsed = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+    results.push_back( Result( "ThreatSearch node", nodes, elapsed / nodes, 0.0 ) );
+
+    printf( "%-40s %12.1f ns/op %12.0f nodes/sec (%d of %d positions won by force)\n", "ThreatSearch node",
+            elapsed / nodes, nodes * 1e9 / elapsed, wins, static_cast<int>( positions.size() ) );
+
+    return correct;
+}
+
+/*********************************************************************
+** Description: Measures a frame of an Ultimate Tic Tac Toe game in
+*  progress. The marks texture is up to date after the first frame, so
+*  this is the cost of a frame without a new move.
+*********************************************************************/
+void Benchmark::benchDrawUltimate()
+{
+    GameSnapshot snapshot = ultimateScene();
+
+    measure( "GraphicsHandler::drawGame (ultimate)", 2000, [&]( long long )
+    {
+        graphics->drawGame( snapshot );
+    } );
+}
+
+/*********************************************************************
+** Description: Measures a frame of a Qubic game in progress, with the
+*  marks texture up to date.
+*********************************************************************/
+void Benchmark::benchDrawQubic()
+{
+    GameSnapshot snapshot = qubicScene();
+
+    measure( "GraphicsHandler::drawGame (qubic)", 2000, [&]( long long )
+    {
+        graphics->drawGame( snapshot );
+    } );
+}
+
+/*********************************************************************
+** Description: Measures the frames of benchDrawGame(), 
+*  benchDrawUltimate() and benchDrawQubic() on the OpenGL renderer, and
+*  prints their time against the same frame on the SDL renderer and
+*  how much of the instance buffer was uploaded. Each frame is waited
+*  for, so on a software driver like Mesa's llvmpipe both renderers
+*  are timed on the CPU alike.
+*********************************************************************/
+void Benchmark::benchDrawGl()
+{
+    const char* SCENES[3] = { "", " (ultimate)", " (qubic)" };
+    GameSnapshot snapshots[3];
+
+    snapshots[0].hoverCell = 2;
+
+    for( int m = 0; m < 5; m++ )
+    {
+        snapshots[0].board.play( m, static_cast<Player>( m % 2 ) );
+    }
+
+    snapshots[1] = ultimateScene();
+    snapshots[2] = qubicScene();
+
+    for( int scene = 0; scene < 3; scene++ )
+    {
+        const long long FRAMES = 2000;
+        string sdlName = string( "GraphicsHandler::drawGame" ) + SCENES[scene];
+        long long uploadedBefore = graphics->getUploadedBytes();
+
+        measure( string( "GlRenderer::draw" ) + SCENES[scene], FRAMES, [&]( long long )
+        {
+            graphics->drawGame( snapshots[scene] );
+        } );
+
+        double glTime = results.back().nsPerOp,
+               uploaded = static_cast<double>( graphics->getUploadedBytes() - uploadedBefore ) 
+                          / ( FRAMES + FRAMES / 10 + 1 );
+
+        for( unsigned i = 0; i < results.size(); i++ )
+        {
+            if( results[i].name == sdlName )
+            {
+                printf( "%-40s %12.2fx the SDL frame time, %.0f bytes uploaded per frame\n", "", 
+                        glTime / results[i].nsPerOp, uploaded );
+            }
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Measures the spectator wall with 1,000 games of random
+*  players, about 33 of which move each frame: frames that only step
+*  the games, and frames that also scroll, so the whole window shows
+*  other boards. Prints the frames per second of both.
+*
+*  Parameters: string suffix - added to the names, for the renderer.
+*********************************************************************/
+void Benchmark::benchDrawWall( const string &suffix )
+{
+    SpectatorWall wall( 1000, Random( 7 ) );
+    int direction = 1;
+
+    graphics->resetRenderTargets();
+
+    measure( "GraphicsHandler::drawWall" + suffix, 2000, [&]( long long )
+    {
+        wall.step();
+        graphics->drawWall( wall.latestSnapshot() );
+    } );
+
+    double steady = results.back().nsPerOp;
+
+    measure( "GraphicsHandler::drawWall (scrolling)" + suffix, 2000, [&]( long long frame )
+    {
+        //Back and forth over the whole wall, a screen at a time.
+        if( frame % 8 == 0 )
+            direction = -direction;
+
+        wall.step();
+        graphics->scrollWall( direction * 480 );
+        graphics->drawWall( wall.latestSnapshot() );
+    } );
+
+    printf( "%-40s %12.0f fps steady, %.0f fps scrolling\n", "", 1e9 / steady, 1e9 / results.back().nsPerOp );
+}
+
+/*********************************************************************
+** Description: Builds an Ultimate Tic Tac Toe game 30 random moves in,
+*  with the first legal cell hovered.
+*
+*  Return: GameSnapshot - the scene.
+*********************************************************************/
+GameSnapshot Benchmark::ultimateScene()
+{
+    GameSnapshot snapshot;
+    Random random( 12 );
+    int moves[UltimatePosition::MAX_MOVES];
+
+    snapshot.mode = ULTIMATE_MODE;
+
+    for( int m = 0; m < 30 && snapshot.ultimate.getOutcome() == UNFINISHED; m++ )
+    {
+        snapshot.ultimate.play( moves[random.nextInt( snapshot.ultimate.getMoves( moves ) )] );
+    }
+
+    snapshot.ultimate.getMoves( moves );
+    snapshot.hoverCell = moves[0];
+    snapshot.turn = snapshot.ultimate.getToMove();
+    snapshot.outcome = snapshot.ultimate.getOutcome();
+
+    return snapshot;
+}
+
+/*********************************************************************
+** Description: Builds a Qubic game 20 random moves in, with the first
+*  empty cell hovered.
+*
+*  Return: GameSnapshot - the scene.
+*********************************************************************/
+GameSnapshot Benchmark::qubicScene()
+{
+    GameSnapshot snapshot;
+    Random random( 15 );
+    int moves[QubicPosition::MAX_MOVES];
+
+    snapshot.mode = QUBIC_MODE;
+
+    for( int m = 0; m < 20 && snapshot.qubic.getOutcome() == UNFINISHED; m++ )
+    {
+        snapshot.qubic.play( moves[random.nextInt( snapshot.qubic.getMoves( moves ) )] );
+    }
+
+    snapshot.qubic.getMoves( moves );
+    snapshot.hoverCell = moves[0];
+    snapshot.turn = snapshot.qubic.getToMove();
+    snapshot.outcome = snapshot.qubic.getOutcome();
+
+    return snapshot;
+}
+
+/*********************************************************************
+** Description: Measures the frame of benchDrawGame() while every frame
+*  is captured to a Y4M video, which is deleted afterwards, and prints
+*  the time against the frame without capturing. Frames are drawn far
+*  faster than they are encoded, so many are dropped; the capture
+*  prints how many, and the time capturing took on the render thread.
+*
+*  Parameters: string suffix - added to the name, for the renderer.
+*********************************************************************/
+void Benchmark::benchCapture( const string &suffix )
+{
+    const char* PATH = "benchmark.y4m";
+
+    GameSnapshot snapshot;
+    snapshot.hoverCell = 2;
+
+    for( int m = 0; m < 5; m++ )
+    {
+        snapshot.board.play( m, static_cast<Player>( m % 2 ) );
+    }
+
+    FrameCapture capture;
+
+    if( !capture.start( PATH, 640, 480, 2 ) )
+    {
+        return;
+    }
+
+    graphics->setCapture( &capture );
+
+    measure( "GraphicsHandler::drawGame (capture)" + suffix, 300, [&]( long long )
+    {
+        graphics->drawGame( snapshot );
+    } );
+
+    graphics->setCapture( NULL );
+    capture.stop();
+    remove( PATH );
+
+    double captureTime = results.back().nsPerOp;
+    string plainName = suffix.empty() ? "GraphicsHandler::drawGame" : "GlRenderer::draw";
+
+    for( unsigned i = 0; i < results.size(); i++ )
+    {
+        if( results[i].name == plainName )
+        {
+            printf( "%-40s %12.2fx the frame time without capturing\n", "", captureTime / results[i].nsPerOp );
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Plays rounds of a match frame by frame: marks are
+*  placed, X wins and scores, and the board is reset. Once the warm up
+*  has run, no frame may allocate from the heap.
+*
+*  Return: bool - true if the match frames made no allocations.
+*********************************************************************/
+bool Benchmark::benchMatchFrames()
+{
+    const int FRAMES_PER_MARK = 4,
+              ROUND_FRAMES = 10 * FRAMES_PER_MARK;
+
+    GameSnapshot snapshot;
+    snapshot.hoverCell = 4;
+
+    measure( "GraphicsHandler::drawGame (match)", 4000, [&]( long long i )
+    {
+        int frame = static_cast<int>( i % ROUND_FRAMES );
+
+        if( frame == 0 )
+        {
+            snapshot.board.reset();
+            snapshot.outcome = UNFINISHED;
+        }
+
+        if( frame < 9 * FRAMES_PER_MARK )
+        {
+            if( frame % FRAMES_PER_MARK == 0 )
+            {
+                int cell = frame / FRAMES_PER_MARK;
+                snapshot.board.play( cell, static_cast<Player>( cell % 2 ) );
+                snapshot.turn = static_cast<Player>( 1 - cell % 2 );
+            }
+        }
+
+        else if( snapshot.outcome == UNFINISHED )
+        {
+            snapshot.outcome = X_WON;
+            snapshot.xPoints++;
+        }
+
+        graphics->drawGame( snapshot );
+    } );
+
+    return results.back().allocsPerOp == 0.0;
+}
+
+/*********************************************************************
+** Description: Measures frame times while a simulated AI stalls the
+*  game logic for 20 ms after every move, once with the game logic on
+*  the render thread and once on its own thread. The jitter shows how
+*  much of the stall reaches the frames.
+*********************************************************************/
+void Benchmark::benchJitter()
+{
+    const int FRAMES = 600,
+              FRAMES_PER_CLICK = 30,
+              SLOW_AI_DELAY = 20;
+
+    for( int threaded = 0; threaded < 2; threaded++ )
+    {
+        GameLogic logic( Random( 5 ) );
+        logic.setSlowAiDelay( SLOW_AI_DELAY );
+
+        if( threaded )
+        {
+            logic.start();
+        }
+
+        Random random( 6 );
+        double sum = 0.0,
+               squares = 0.0,
+               worst = 0.0;
+
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+        for( int frame = 0; frame < FRAMES; frame++ )
+        {
+            const GameSnapshot &snapshot = logic.latestSnapshot();
+
+            if( frame % FRAMES_PER_CLICK == 0 )
+            {
+                int cell = PLAY_AGAIN_CELL;
+
+                if( snapshot.outcome == UNFINISHED )
+                {
+                    cell = random.nextInt( GameBoard::CELLS );
+
+                    while( snapshot.board.getPick( cell ) != No_Player )
+                    {
+                        cell = ( cell + 1 ) % GameBoard::CELLS;
+                    }
+                }
+
+                logic.send( InputCommand( InputCommand::CLICK, cell ) );
+            }
+
+            if( !threaded )
+            {
+                logic.step();
+            }
+
+            graphics->drawGame( logic.latestSnapshot() );
+
+            std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+            double elapsed = std::chrono::duration< double, std::nano >( frameEnd - frameStart ).count();
+            frameStart = frameEnd;
+
+            sum += elapsed;
+            squares += elapsed * elapsed;
+
+            if( elapsed > worst )
+            {
+                worst = elapsed;
+            }
+        }
+
+        logic.stop();
+
+        double mean = sum / FRAMES;
+        double variance = squares / FRAMES - mean * mean;
+        Result result( threaded ? "frame time, slow AI (game logic thread)" 
+                                : "frame time, slow AI (single thread)", FRAMES, mean, 0.0 );
+        result.jitterNs = variance > 0.0 ? sqrt( variance ) : 0.0;
+        result.worstNs = worst;
+        results.push_back( result );
+
+        printf( "%-40s %12.1f ns/op %12.1f ns jitter %12.1f ns worst\n", result.name.c_str(),
+                mean, result.jitterNs, worst );
+    }
+}
+
+/*********************************************************************
+** Description: Tells whether a file exists and can be read.
+*
+*  Parameters: string path - the file.
+*
+*  Return: bool - true if the file can be opened.
+*********************************************************************/
+static bool fileExists( const string &path )
+{
+    FILE* file = fopen( path.c_str(), "rb" );
+
+    if( file == NULL )
+    {
+        return false;
+    }
+
+    fclose( file );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Renders a fixed set of scenes and compares each frame
+*  with its golden PNG image, or rewrites the golden images. The
+*  golden images depend on the renderer and fonts of the machine, so
+*  they are written once with update on a known good build; a scene
+*  without one fails, so a wrong folder can not pass unnoticed.
+*
+*  Parameters:
+*  1. string dir - the folder holding the golden images.
+*  2. bool update - write the frames as the new golden images.
+*
+*  Return: int - the number of scenes that did not match.
+*********************************************************************/
+int Benchmark::checkGolden( const string &dir, bool update )
+{
+    const int SETTLE_FRAMES = 150; //Lets the line and font animations finish.
+    const char* SCENES[] = { "board", "midgame", "xwon", "ultimate", "qubic" };
+
+    int failures = 0,
+        missing = 0;
+
+    for( int scene = 0; scene < 5; scene++ )
+    {
+        GameSnapshot snapshot;
+
+        if( scene == 3 )
+        {
+            snapshot = ultimateScene();
+        }
+
+        else if( scene == 4 )
+        {
+            snapshot = qubicScene();
+        }
+
+        else if( scene >= 1 )
+        {
+            int marks = scene == 1 ? 5 : 7;
+
+            for( int m = 0; m < marks; m++ )
+            {
+                snapshot.board.play( m, static_cast<Player>( m % 2 ) );
+            }
+
+            snapshot.hoverCell = scene == 1 ? 2 : NO_CELL;
+            snapshot.outcome = scene == 1 ? UNFINISHED : X_WON;
+            snapshot.xPoints = scene == 1 ? 0 : 1;
+        }
+
+        for( int f = 0; f < SETTLE_FRAMES; f++ )
+        {
+            graphics->drawGame( snapshot );
+        }
+
+        string path = dir + "/" + SCENES[scene] + ".png";
+
+        if( update )
+        {
+            if( !graphics->saveFrame( path ) )
+            {
+                failures++;
+            }
+
+            printf( "Wrote %s\n", path.c_str() );
+        }
+
+        else if( !fileExists( path ) )
+        {
+            failures++;
+            missing++;
+            printf( "%-10s FAIL (no golden image %s)\n", SCENES[scene], path.c_str() );
+        }
+
+        else
+        {
+            int mismatches = graphics->compareFrame( path, 2 );
+
+            if( mismatches != 0 )
+            {
+                failures++;
+            }
+
+            printf( "%-10s %s (%d pixels differ)\n", SCENES[scene], 
+                    mismatches == 0 ? "PASS" : "FAIL", mismatches );
+        }
+    }
+
+    if( missing > 0 )
+    {
+        printf( "%d of 5 golden images missing; run with --update-golden on a known good build to write them.\n",
+                missing );
+    }
+
+    return failures;
+}
+
+/*********************************************************************
+** Description: Shuts down the graphics started by startGraphics().
+*********************************************************************/
+void Benchmark::stopGraphics()
+{
+    if( graphics != NULL )
+    {
+        graphics->cleanUp();
+        delete graphics;
+        graphics = NULL;
+    }
+}
+
+/*********************************************************************
+** Description: Writes the results as JSON.
+*
+*  Parameters: string path - the file the results are written to.
+*
+*  Return: bool - indicates whether the file was written.
+*********************************************************************/
+bool Benchmark::writeJson( const string &path )
+{
+    FILE* file = fopen( path.c_str(), "w" );
+
+    if( file == NULL )
+    {
+        printf( "Unable to write %s!\n", path.c_str() );
+        return false;
+    }
+
+    fprintf( file, "{\n  \"benchmarks\": [\n" );
+
+    for( unsigned i = 0; i < results.size(); i++ )
+    {
+        fprintf( file, "    { \"name\": \"%s\", \"iterations\": %lld, \"ns_per_op\": %.2f, \"allocs_per_op\": %.4f",
+                 results[i].name.c_str(), results[i].iterations, results[i].nsPerOp, results[i].allocsPerOp );
+
+        if( results[i].worstNs > 0.0 )
+        {
+            fprintf( file, ", \"jitter_ns\": %.2f, \"worst_ns\": %.2f", results[i].jitterNs, results[i].worstNs );
+        }
+
+        fprintf( file, " }%s\n", i + 1 < results.size() ? "," : "" );
+    }
+
+    fprintf( file, "  ]\n}\n" );
+    fclose( file );
+
+    return true;
+}
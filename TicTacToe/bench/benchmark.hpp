@@ -0,0 +1,134 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Benchmark class measures the game core, input and
+*  render paths and writes the results as JSON so they can be compared
+*  between releases. Each result records the time and the number of
+*  heap allocations made through operator new per operation.
+*********************************************************************/
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include "../graphicsHandler.hpp"
+#include "../mouseButtons.hpp"
+#include "../mcts.hpp"
+#include "../batchGames.hpp"
+#include "../threatSearch.hpp"
+#include "../perfectPlayer.hpp"
+#include "../engine.hpp"
+#include "../openingBook.hpp"
+#include <chrono>
+#include <cstdio>
+
+class Benchmark
+{
+    private:
+        /*********************************************************************
+         ** Description: This struct holds the measurements of one benchmark.
+         *********************************************************************/
+        struct Result
+        {
+            string name;
+            long long iterations;
+            double nsPerOp;
+            double allocsPerOp;
+            double jitterNs; //Frame time results only.
+            double worstNs;
+
+            Result( const string &name, long long iterations, double nsPerOp, double allocsPerOp )
+            {
+                this->name = name;
+                this->iterations = iterations;
+                this->nsPerOp = nsPerOp;
+                this->allocsPerOp = allocsPerOp;
+                jitterNs = 0.0;
+                worstNs = 0.0;
+            }
+        };
+
+        vector< Result > results;
+
+        GraphicsHandler* graphics; //Renders offscreen.
+
+        template< class Operation >
+        void measure( const string &, long long, Operation );
+
+        static GameSnapshot ultimateScene();
+        static GameSnapshot qubicScene();
+        static vector< GomokuBoard > gomokuPositions();
+        static MnkPosition transformPosition( const MnkPosition &, int );
+
+    public:
+        Benchmark();
+        ~Benchmark();
+        void benchCheckGame();
+        void benchHandleEvent();
+        void benchProfileScope();
+        bool startGraphics( bool = false );
+        void benchHandoff();
+        void benchAudio();
+        void benchMcts();
+        bool checkSplits();
+        void benchUltimate();
+        void benchQubic();
+        bool benchBatchGames();
+        bool benchGomoku();
+        bool benchAnalysis();
+        bool benchEngine();
+        bool benchBook();
+        void benchStartup();
+        void benchDrawGame();
+        void benchThemes();
+        void benchDrawUltimate();
+        void benchDrawQubic();
+        void benchDrawGl();
+        void benchDrawWall( const string & );
+        void benchCapture( const string & );
+        bool benchMatchFrames();
+        void benchJitter();
+        int checkGolden( const string &, bool );
+        void stopGraphics();
+        bool writeJson( const string & );
+
+        static unsigned long long allocations();
+};
+
+/*********************************************************************
+** Description: Runs an operation a number of times after a short warm
+*  up and records the average time and allocations of one run.
+*
+*  Parameters:
+*  1. string name - the name the result is reported under.
+*  2. long long iterations - how many times the operation is run.
+*  3. Operation operation - callable taking the iteration number.
+*********************************************************************/
+template< class Operation >
+void Benchmark::measure( const string &name, long long iterations, Operation operation )
+{
+    for( long long i = 0; i < iterations / 10 + 1; i++ )
+    {
+        operation( i );
+    }
+
+    unsigned long long allocationsBefore = allocations();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( long long i = 0; i < iterations; i++ )
+    {
+        operation( i );
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    unsigned long long allocated = allocations() - allocationsBefore;
+
+    double elapsed = std::chrono::duration< double, std::nano >( end - start ).count();
+
+    results.push_back( Result( name, iterations, elapsed / iterations,
+                               static_cast<double>( allocated ) / iterations ) );
+
+    printf( "%-40s %12.1f ns/op %8.2f allocs/op\n", name.c_str(),
+            elapsed / iterations, static_cast<double>( allocated ) / iterations );
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BookPlayer class plays the moves of an opening book
+*  while the position is in it and hands the rest of the game to
+*  another player, so the first moves of a larger board cost a lookup
+*  instead of a search. How often the book had the position is printed
+*  as the game goes on.
+*********************************************************************/
+#include "bookPlayer.hpp"
+#include <cstdio>
+
+/*********************************************************************
+** Description: Constructor. Call open() before the first move.
+*
+*  Parameters: AiPlayer* fallback - plays the positions not in the
+*  book. The book player deletes it.
+*********************************************************************/
+BookPlayer::BookPlayer( AiPlayer* fallback )
+{
+    this->fallback = fallback;
+    lookups = 0;
+    hits = 0;
+    lastPly = -1;
+    outOfBook = false;
+}
+
+/*********************************************************************
+** Description: Destructor. Prints the hit rate of every game played.
+*********************************************************************/
+BookPlayer::~BookPlayer()
+{
+    if( lookups > 0 )
+    {
+        printf( "Opening book hit rate: %d of %d lookups (%.0f%%).\n", hits, lookups, 100.0 * hits / lookups );
+    }
+
+    delete fallback;
+}
+
+/*********************************************************************
+** Description: Looks up the book move of a position. Positions deeper
+*  than the book are not looked up, or counted.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the book move, or -1 if the position is not in the
+*  book.
+*********************************************************************/
+int BookPlayer::bookMove( const MnkPosition &position )
+{
+    int ply = position.getPly();
+
+    if( ply <= lastPly )
+    {
+        outOfBook = false;
+    }
+
+    lastPly = ply;
+
+    if( outOfBook || !book.isOpen() || ply >= book.getPlies() || position.getWidth() != book.getWidth()
+        || position.getHeight() != book.getHeight() || position.getK() != book.getK() )
+    {
+        return -1;
+    }
+
+    int move = -1;
+    const OpeningBook::Entry* entry = book.find( position, move );
+
+    lookups++;
+
+    if( entry == NULL || move >= position.getCells() || !( position.getEmpty() >> move & 1 ) )
+    {
+        printf( "Out of book at ply %d, hit rate %d of %d.\n", ply, hits, lookups );
+        outOfBook = true;
+        return -1;
+    }
+
+    hits++;
+    printf( "Book move %d: %u games, %.1f%% scored, hit rate %d of %d.\n", move, entry->games,
+            100.0 * entry->score / OpeningBook::SCORE_SCALE, hits, lookups );
+
+    return move;
+}
+
+/*********************************************************************
+** Description: Plays a classic move from a 3x3 k=3 book, or asks the
+*  fallback player.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int BookPlayer::chooseMove( const GamePosition &position )
+{
+    int move = bookMove( toMnkPosition( position ) );
+
+    return move >= 0 ? move : fallback->chooseMove( position );
+}
+
+/*********************************************************************
+** Description: Plays an m,n,k move from the book, or asks the fallback
+*  player.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int BookPlayer::chooseMnkMove( const MnkPosition &position )
+{
+    int move = bookMove( position );
+
+    return move >= 0 ? move : fallback->chooseMnkMove( position );
+}
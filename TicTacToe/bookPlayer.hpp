@@ -0,0 +1,55 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BookPlayer class plays the moves of an opening book
+*  while the position is in it and hands the rest of the game to
+*  another player, so the first moves of a larger board cost a lookup
+*  instead of a search. How often the book had the position is printed
+*  as the game goes on.
+*********************************************************************/
+#ifndef BOOK_PLAYER_HPP
+#define BOOK_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+#include "openingBook.hpp"
+
+class BookPlayer : public AiPlayer
+{
+    private:
+        OpeningBook book;
+        AiPlayer* fallback; //Plays the positions not in the book.
+        int lookups,
+            hits,
+            lastPly; //Of the last lookup, to notice a new game.
+        bool outOfBook; //The book had no move earlier in this game.
+
+        //Private functions.
+        int bookMove( const MnkPosition & );
+
+        //The fallback player is owned by one book player only.
+        BookPlayer( const BookPlayer & );
+        BookPlayer& operator=( const BookPlayer & );
+
+    public:
+        BookPlayer( AiPlayer* );
+        ~BookPlayer();
+        bool open( const string &path ) { return book.open( path ); };
+        int chooseMove( const GamePosition & );
+        string getName() const { return "book+" + fallback->getName(); };
+
+        bool playsUltimate() const { return fallback->playsUltimate(); };
+        int chooseUltimateMove( const UltimatePosition &position ) { return fallback->chooseUltimateMove( position ); };
+
+        bool playsQubic() const { return fallback->playsQubic(); };
+        int chooseQubicMove( const QubicPosition &position ) { return fallback->chooseQubicMove( position ); };
+
+        bool playsMnk() const { return fallback->playsMnk(); };
+        int chooseMnkMove( const MnkPosition & );
+
+        //Getter functions.
+        int getLookups() const { return lookups; };
+        int getHits() const { return hits; };
+};
+
+#endif
@@ -0,0 +1,378 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ChildProcess class runs a command as a child
+*  process with its standard input and output connected to pipes, with
+*  CreateProcess or fork and exec. Lines are written to the child's
+*  input and read back from its output, with a timeout, so a child
+*  that hangs or dies can not stall the game.
+*********************************************************************/
+#include "childProcess.hpp"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/*********************************************************************
+** Description: Constructor. No process is running.
+*********************************************************************/
+ChildProcess::ChildProcess()
+{
+#ifdef _WIN32
+    process = NULL;
+    input = NULL;
+    output = NULL;
+#else
+    process = -1;
+    input = -1;
+    output = -1;
+#endif
+}
+
+/*********************************************************************
+** Description: Destructor. Closes the pipes and ends the process.
+*********************************************************************/
+ChildProcess::~ChildProcess()
+{
+    close();
+}
+
+/*********************************************************************
+** Description: Starts a command with pipes for its standard input and
+*  output. Its standard error stays the game's.
+*
+*  Parameters: string command - the command line, for example
+*  "./refengine".
+*
+*  Return: bool - false if the process could not be started.
+*********************************************************************/
+bool ChildProcess::start( const string &command )
+{
+    close();
+
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES inherit = { sizeof( SECURITY_ATTRIBUTES ), NULL, TRUE };
+    HANDLE childInput = NULL,
+           childOutput = NULL;
+
+    if( !CreatePipe( &childInput, &input, &inherit, 0 ) )
+    {
+        printf( "Could not create a pipe for %s!\n", command.c_str() );
+        return false;
+    }
+
+    if( !CreatePipe( &output, &childOutput, &inherit, 0 ) )
+    {
+        printf( "Could not create a pipe for %s!\n", command.c_str() );
+        CloseHandle( childInput );
+        close();
+        return false;
+    }
+
+    //The child inherits only its own ends.
+    SetHandleInformation( input, HANDLE_FLAG_INHERIT, 0 );
+    SetHandleInformation( output, HANDLE_FLAG_INHERIT, 0 );
+
+    STARTUPINFOA startup;
+    PROCESS_INFORMATION information;
+    ZeroMemory( &startup, sizeof( startup ) );
+    startup.cb = sizeof( startup );
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = childInput;
+    startup.hStdOutput = childOutput;
+    startup.hStdError = GetStdHandle( STD_ERROR_HANDLE );
+
+    std::vector< char > commandLine( command.begin(), command.end() );
+    commandLine.push_back( '\0' );
+
+    BOOL started = CreateProcessA( NULL, &commandLine[0], NULL, NULL, TRUE, 0, NULL, NULL, &startup, &information );
+
+    CloseHandle( childInput );
+    CloseHandle( childOutput );
+
+    if( !started )
+    {
+        printf( "Could not start %s!\n", command.c_str() );
+        close();
+        return false;
+    }
+
+    CloseHandle( information.hThread );
+    process = information.hProcess;
+#else
+    int childInput[2],
+        childOutput[2];
+
+    if( pipe( childInput ) != 0 )
+    {
+        printf( "Could not create a pipe for %s!\n", command.c_str() );
+        return false;
+    }
+
+    if( pipe( childOutput ) != 0 )
+    {
+        printf( "Could not create a pipe for %s!\n", command.c_str() );
+        ::close( childInput[0] );
+        ::close( childInput[1] );
+        return false;
+    }
+
+    //A child that exits makes writes fail instead of killing the game.
+    signal( SIGPIPE, SIG_IGN );
+
+    process = fork();
+
+    if( process == 0 )
+    {
+        dup2( childInput[0], 0 );
+        dup2( childOutput[1], 1 );
+        ::close( childInput[0] );
+        ::close( childInput[1] );
+        ::close( childOutput[0] );
+        ::close( childOutput[1] );
+
+        execl( "/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>( NULL ) );
+        _exit( 127 );
+    }
+
+    ::close( childInput[0] );
+    ::close( childOutput[1] );
+    input = childInput[1];
+    output = childOutput[0];
+
+    if( process < 0 )
+    {
+        printf( "Could not start %s!\n", command.c_str() );
+        close();
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Writes text to the child's standard input, all of it
+*  at once, so several lines cost one system call.
+*
+*  Parameters: string text - the text, each line ending in '\n'.
+*
+*  Return: bool - false if the child is gone.
+*********************************************************************/
+bool ChildProcess::write( const string &text )
+{
+    size_t written = 0;
+
+    while( written < text.size() )
+    {
+#ifdef _WIN32
+        DWORD count = 0;
+
+        if( input == NULL || !WriteFile( input, text.data() + written, static_cast<DWORD>( text.size() - written ),
+                                         &count, NULL ) )
+        {
+            return false;
+        }
+#else
+        ssize_t count = input < 0 ? -1 : ::write( input, text.data() + written, text.size() - written );
+
+        if( count <= 0 )
+        {
+            return false;
+        }
+#endif
+
+        written += count;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Reads what the child has written so far, waiting for it
+*  up to a timeout.
+*
+*  Parameters: int timeout - milliseconds to wait, or -1 for as long as
+*  it takes.
+*
+*  Return: int - 1 if output was read, 0 on timeout and -1 once the
+*  child closed its output.
+*********************************************************************/
+int ChildProcess::receive( int timeout )
+{
+    char buffer[4096];
+
+#ifdef _WIN32
+    if( output == NULL )
+    {
+        return -1;
+    }
+
+    //Anonymous pipes have no timeout; poll them, yielding at first so a
+    //quick reply is seen at once, then sleeping.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int polls = 0; ; polls++ )
+    {
+        DWORD available = 0;
+
+        if( !PeekNamedPipe( output, NULL, 0, NULL, &available, NULL ) )
+        {
+            return -1;
+        }
+
+        if( available > 0 )
+        {
+            break;
+        }
+
+        if( timeout >= 0 && std::chrono::steady_clock::now() - start >= std::chrono::milliseconds( timeout ) )
+        {
+            return 0;
+        }
+
+        if( polls < 1000 )
+            std::this_thread::yield();
+
+        else
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    DWORD count = 0;
+
+    if( !ReadFile( output, buffer, sizeof( buffer ), &count, NULL ) || count == 0 )
+    {
+        return -1;
+    }
+#else
+    if( output < 0 )
+    {
+        return -1;
+    }
+
+    struct pollfd ready = { output, POLLIN, 0 };
+
+    if( poll( &ready, 1, timeout ) == 0 )
+    {
+        return 0;
+    }
+
+    ssize_t count = read( output, buffer, sizeof( buffer ) );
+
+    if( count <= 0 )
+    {
+        return -1;
+    }
+#endif
+
+    received.append( buffer, count );
+
+    return 1;
+}
+
+/*********************************************************************
+** Description: Reads one line of the child's standard output.
+*
+*  Parameters: string line - receives the line, without its newline.
+*              int timeout - milliseconds to wait for it, or -1 for as
+*              long as it takes.
+*
+*  Return: int - 1 if a line was read, 0 on timeout and -1 once the
+*  child closed its output.
+*********************************************************************/
+int ChildProcess::readLine( string &line, int timeout )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( ;; )
+    {
+        size_t end = received.find( '\n' );
+
+        if( end != string::npos )
+        {
+            line.assign( received, 0, end > 0 && received[end - 1] == '\r' ? end - 1 : end );
+            received.erase( 0, end + 1 );
+            return 1;
+        }
+
+        int left = timeout;
+
+        if( timeout >= 0 )
+        {
+            long long waited = std::chrono::duration_cast< std::chrono::milliseconds >(
+                std::chrono::steady_clock::now() - start ).count();
+            left = waited >= timeout ? 0 : static_cast<int>( timeout - waited );
+        }
+
+        int status = receive( left );
+
+        if( status <= 0 )
+        {
+            return status;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Closes the child's standard input, which tells it to
+*  exit, and waits a second for it before ending it.
+*********************************************************************/
+void ChildProcess::close()
+{
+#ifdef _WIN32
+    if( input != NULL )
+        CloseHandle( input );
+
+    if( process != NULL && WaitForSingleObject( process, 1000 ) == WAIT_TIMEOUT )
+        TerminateProcess( process, 1 );
+
+    if( process != NULL )
+        CloseHandle( process );
+
+    if( output != NULL )
+        CloseHandle( output );
+
+    process = NULL;
+    input = NULL;
+    output = NULL;
+#else
+    if( input >= 0 )
+        ::close( input );
+
+    for( int waited = 0; process > 0 && waited <= 1000; waited += 10 )
+    {
+        if( waitpid( process, NULL, WNOHANG ) != 0 )
+        {
+            process = -1;
+            break;
+        }
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    if( process > 0 )
+    {
+        kill( process, SIGKILL );
+        waitpid( process, NULL, 0 );
+    }
+
+    if( output >= 0 )
+        ::close( output );
+
+    process = -1;
+    input = -1;
+    output = -1;
+#endif
+
+    received.clear();
+}
@@ -0,0 +1,49 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ChildProcess class runs a command as a child
+*  process with its standard input and output connected to pipes, with
+*  CreateProcess or fork and exec. Lines are written to the child's
+*  input and read back from its output, with a timeout, so a child
+*  that hangs or dies can not stall the game.
+*********************************************************************/
+#ifndef CHILD_PROCESS_HPP
+#define CHILD_PROCESS_HPP
+
+#include <string>
+
+using std::string;
+
+class ChildProcess
+{
+    private:
+        string received; //Output read but not returned as a line yet.
+
+#ifdef _WIN32
+        void* process;
+        void* input; //Write end of the child's standard input.
+        void* output; //Read end of the child's standard output.
+#else
+        int process;
+        int input;
+        int output;
+#endif
+
+        //Private functions.
+        int receive( int );
+
+        //The pipes can not be shared between two owners.
+        ChildProcess( const ChildProcess & );
+        ChildProcess& operator=( const ChildProcess & );
+
+    public:
+        ChildProcess();
+        ~ChildProcess();
+        bool start( const string & );
+        bool write( const string & );
+        int readLine( string &, int );
+        void close();
+};
+
+#endif
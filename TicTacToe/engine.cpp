@@ -0,0 +1,400 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Engine class talks to an AI engine running as a
+*  child process, in a line based protocol modelled on UCI, so engines
+*  written elsewhere play without being linked into the game. See
+*  engine.hpp for the commands.
+*********************************************************************/
+#include "engine.hpp"
+#include <cstdio>
+#include <cstring>
+
+//Milliseconds an engine gets to introduce itself.
+static const int START_TIMEOUT = 5000;
+
+static const char* GAME_NAMES[4] = { "classic", "ultimate", "qubic", "mnk" };
+
+/*********************************************************************
+** Description: Constructor. No engine is running.
+*********************************************************************/
+Engine::Engine()
+{
+    for( int i = 0; i < 4; i++ )
+    {
+        games[i] = false;
+    }
+
+    nextId = 1;
+    pending = 0;
+}
+
+/*********************************************************************
+** Description: Starts an engine and reads its introduction.
+*
+*  Parameters: string command - the command line of the engine.
+*
+*  Return: bool - false if the engine did not start or did not finish
+*  its introduction in time.
+*********************************************************************/
+bool Engine::start( const string &command )
+{
+    name = command;
+    pending = 0;
+
+    if( !process.start( command ) || !process.write( "ttp\n" ) )
+    {
+        return false;
+    }
+
+    string line;
+
+    while( process.readLine( line, START_TIMEOUT ) == 1 )
+    {
+        if( line.compare( 0, 8, "id name " ) == 0 )
+        {
+            name = line.substr( 8 );
+        }
+
+        else if( line.compare( 0, 6, "games " ) == 0 )
+        {
+            for( int i = 0; i < 4; i++ )
+            {
+                string game = string( " " ) + GAME_NAMES[i];
+                size_t found = ( line + " " ).find( game + " " );
+
+                games[i] = found != string::npos;
+            }
+        }
+
+        else if( line == "ttpok" )
+        {
+            return true;
+        }
+    }
+
+    printf( "The engine %s did not answer ttp!\n", command.c_str() );
+    process.close();
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Waits until the engine is idle.
+*
+*  Parameters: int timeout - milliseconds to wait.
+*
+*  Return: bool - false if the engine did not answer in time.
+*********************************************************************/
+bool Engine::isReady( int timeout )
+{
+    if( !process.write( "isready\n" ) )
+    {
+        return false;
+    }
+
+    string line;
+
+    while( process.readLine( line, timeout ) == 1 )
+    {
+        if( line == "readyok" )
+        {
+            return true;
+        }
+
+        //Answers to searches sent before.
+        if( line.compare( 0, 9, "bestmove " ) == 0 && pending > 0 )
+        {
+            pending--;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Tells the engine the next positions are from a new
+*  game.
+*********************************************************************/
+void Engine::newGame()
+{
+    process.write( "newgame\n" );
+}
+
+/*********************************************************************
+** Description: Sends a position and starts a search of it, without
+*  waiting for the answer.
+*
+*  Parameters: string position - the position, from describe().
+*              TimeControl control - the time for the search.
+*
+*  Return: unsigned - the id of the search, or 0 if the engine is gone.
+*********************************************************************/
+unsigned Engine::go( const string &position, const TimeControl &control )
+{
+    char search[96];
+
+    if( control.moveTime > 0 )
+        snprintf( search, sizeof( search ), "go movetime %d id %u\n", control.moveTime, nextId );
+
+    else
+        snprintf( search, sizeof( search ), "go time %d inc %d id %u\n", control.clock, control.increment, nextId );
+
+    if( !process.write( "position " + position + "\n" + search ) )
+    {
+        return 0;
+    }
+
+    pending++;
+
+    return nextId++;
+}
+
+/*********************************************************************
+** Description: Reads the next answer to a search.
+*
+*  Parameters:
+*  1. unsigned id - receives the id of the search answered.
+*  2. int move - receives the cell the engine chose.
+*  3. int timeout - milliseconds to wait, or -1 for as long as it takes.
+*
+*  Return: bool - false on timeout or if the engine is gone.
+*********************************************************************/
+bool Engine::poll( unsigned &id, int &move, int timeout )
+{
+    string line;
+
+    while( process.readLine( line, timeout ) == 1 )
+    {
+        if( line.compare( 0, 9, "bestmove " ) != 0 )
+        {
+            continue;
+        }
+
+        pending--;
+        id = 0;
+        move = -1;
+
+        if( sscanf( line.c_str() + 9, "%d id %u", &move, &id ) >= 1 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Waits for the answer to one search. Answers to earlier
+*  searches that are still on their way are skipped.
+*
+*  Parameters: unsigned id - the search, from go().
+*              int timeout - milliseconds to wait.
+*
+*  Return: int - the cell the engine chose, or -1 if it did not answer
+*  in time.
+*********************************************************************/
+int Engine::wait( unsigned id, int timeout )
+{
+    unsigned answered = 0;
+    int move = -1;
+
+    while( poll( answered, move, timeout ) )
+    {
+        if( answered == id )
+        {
+            return move;
+        }
+    }
+
+    return -1;
+}
+
+/*********************************************************************
+** Description: Asks the engine to answer the running search now.
+*********************************************************************/
+void Engine::stop()
+{
+    process.write( "stop\n" );
+}
+
+/*********************************************************************
+** Description: Tells the engine to exit and closes it.
+*********************************************************************/
+void Engine::quit()
+{
+    process.write( "quit\n" );
+    process.close();
+    pending = 0;
+}
+
+/*********************************************************************
+** Description: Finds the engine's move in many positions, keeping up
+*  to window searches on their way at a time. The positions of a window
+*  are sent together and answered together, so the round trips through
+*  the pipes are shared.
+*
+*  Parameters:
+*  1. vector<string> positions - the positions, from describe().
+*  2. TimeControl control - the time for each search.
+*  3. int window - the most searches sent and not answered.
+*  4. vector<int> moves - receives the move of each position, -1 where
+*  the engine did not answer.
+*
+*  Return: bool - false if the engine stopped answering.
+*********************************************************************/
+bool Engine::analyze( const vector< string > &positions, const TimeControl &control, int window, vector< int > &moves )
+{
+    int timeout = ( control.moveTime > 0 ? control.moveTime : control.clock ) + START_TIMEOUT;
+    unsigned firstId = nextId;
+    size_t sent = 0,
+           answered = 0;
+
+    moves.assign( positions.size(), -1 );
+
+    if( window < 1 )
+    {
+        window = 1;
+    }
+
+    while( answered < positions.size() )
+    {
+        string batch;
+        char search[96];
+
+        //Fills the window in one write.
+        for( ; sent < positions.size() && static_cast<int>( sent - answered ) < window; sent++ )
+        {
+            if( control.moveTime > 0 )
+                snprintf( search, sizeof( search ), "go movetime %d id %u\n", control.moveTime, nextId );
+
+            else
+                snprintf( search, sizeof( search ), "go time %d inc %d id %u\n", control.clock, control.increment, nextId );
+
+            batch += "position " + positions[sent] + "\n" + search;
+            nextId++;
+            pending++;
+        }
+
+        if( !batch.empty() && !process.write( batch ) )
+        {
+            return false;
+        }
+
+        //Waits for one answer, then takes every other one already there.
+        unsigned id = 0;
+        int move = -1,
+            received = 0;
+
+        for( int wait = timeout; answered < sent && poll( id, move, wait ); wait = 0 )
+        {
+            if( id >= firstId && id - firstId < positions.size() )
+            {
+                moves[id - firstId] = move;
+            }
+
+            answered++;
+            received++;
+        }
+
+        if( received == 0 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Writes a classic position in the protocol's notation.
+*
+*  Parameters: GamePosition position - the position.
+*
+*  Return: string - the GAME CELLS SIDE of a position command.
+*********************************************************************/
+string Engine::describe( const GamePosition &position )
+{
+    string text = "classic ";
+
+    for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+    {
+        Player pick = position.getBoard().getPick( cell );
+        text += pick == X_Player ? 'x' : ( pick == O_Player ? 'o' : '.' );
+    }
+
+    return text + ( position.getToMove() == X_Player ? " x" : " o" );
+}
+
+/*********************************************************************
+** Description: Writes an Ultimate Tic Tac Toe position in the
+*  protocol's notation.
+*
+*  Parameters: UltimatePosition position - the position.
+*
+*  Return: string - the GAME CELLS SIDE BOARD of a position command.
+*********************************************************************/
+string Engine::describe( const UltimatePosition &position )
+{
+    string text = "ultimate ";
+
+    for( int cell = 0; cell < UltimatePosition::CELLS; cell++ )
+    {
+        Player pick = position.getPick( cell );
+        text += pick == X_Player ? 'x' : ( pick == O_Player ? 'o' : '.' );
+    }
+
+    text += position.getToMove() == X_Player ? " x " : " o ";
+
+    if( position.getActiveBoard() == UltimatePosition::ANY_BOARD )
+        text += '-';
+
+    else
+        text += static_cast<char>( '0' + position.getActiveBoard() );
+
+    return text;
+}
+
+/*********************************************************************
+** Description: Writes a Qubic position in the protocol's notation.
+*
+*  Parameters: QubicPosition position - the position.
+*
+*  Return: string - the GAME CELLS SIDE of a position command.
+*********************************************************************/
+string Engine::describe( const QubicPosition &position )
+{
+    string text = "qubic ";
+
+    for( int cell = 0; cell < QubicPosition::CELLS; cell++ )
+    {
+        Player pick = position.getPick( cell );
+        text += pick == X_Player ? 'x' : ( pick == O_Player ? 'o' : '.' );
+    }
+
+    return text + ( position.getToMove() == X_Player ? " x" : " o" );
+}
+
+/*********************************************************************
+** Description: Writes an m,n,k position in the protocol's notation.
+*
+*  Parameters: MnkPosition position - the position.
+*
+*  Return: string - the GAME CELLS SIDE of a position command.
+*********************************************************************/
+string Engine::describe( const MnkPosition &position )
+{
+    char game[32];
+    snprintf( game, sizeof( game ), "mnk:%d,%d,%d ", position.getWidth(), position.getHeight(), position.getK() );
+
+    string text = game;
+
+    for( int cell = 0; cell < position.getCells(); cell++ )
+    {
+        Player pick = position.getPick( cell );
+        text += pick == X_Player ? 'x' : ( pick == O_Player ? 'o' : '.' );
+    }
+
+    return text + ( position.getToMove() == X_Player ? " x" : " o" );
+}
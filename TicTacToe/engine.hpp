@@ -0,0 +1,104 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Engine class talks to an AI engine running as a
+*  child process, in a line based protocol modelled on UCI, so engines
+*  written elsewhere play without being linked into the game. The game
+*  sends, one command a line:
+*
+*    ttp                        asks the engine to introduce itself
+*    isready                    asks for "readyok" once it is idle
+*    newgame                    the next positions are from a new game
+*    position GAME CELLS SIDE [BOARD]
+*                               sets up a position: GAME is classic,
+*                               ultimate, qubic or mnk:W,H,K, CELLS one
+*                               character a cell, x, o or '.', in the
+*                               game's cell order, SIDE the player to
+*                               move, x or o, and BOARD the Ultimate
+*                               board to play in, 0 to 8, or - for any
+*    go movetime MS [id N]      searches for MS milliseconds
+*    go time MS inc MS [id N]   searches with MS left on the clock
+*    stop                       answers the running search at once
+*    quit                       exits
+*
+*  and the engine answers:
+*
+*    id name NAME               introduces itself, then
+*    games GAME...              the games it plays, then
+*    ttpok                      ends the introduction
+*    readyok                    answers isready
+*    info TEXT                  anything, ignored
+*    bestmove CELL [id N]       answers a go, with its id
+*
+*  A go is answered whenever the search ends, so the game can send more
+*  positions before the first answer comes back. Engines answer the
+*  positions in the order they came, which lets many positions share
+*  one round trip when a batch is analyzed.
+*********************************************************************/
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include "childProcess.hpp"
+#include "gamePosition.hpp"
+#include "ultimatePosition.hpp"
+#include "qubicPosition.hpp"
+#include "mnkPosition.hpp"
+
+#include <vector>
+using std::vector;
+
+/*********************************************************************
+** Description: The TimeControl struct is the time an engine gets for
+*  a move: a fixed time, or a clock with an increment.
+*********************************************************************/
+struct TimeControl
+{
+    int moveTime; //Milliseconds per move, or 0 to play on the clock.
+    int clock, //Milliseconds left.
+        increment; //Milliseconds added after each move.
+
+    TimeControl()
+    {
+        moveTime = 1000;
+        clock = 0;
+        increment = 0;
+    }
+};
+
+class Engine
+{
+    private:
+        ChildProcess process;
+        string name;
+        bool games[4]; //Classic, Ultimate, Qubic and m,n,k.
+        unsigned nextId;
+        int pending; //Searches sent and not answered yet.
+
+    public:
+        Engine();
+        bool start( const string & );
+        bool isReady( int );
+        void newGame();
+        unsigned go( const string &, const TimeControl & );
+        int wait( unsigned, int );
+        bool poll( unsigned &, int &, int );
+        void stop();
+        void quit();
+        bool analyze( const vector< string > &, const TimeControl &, int, vector< int > & );
+
+        //Getter functions.
+        const string &getName() const { return name; };
+        bool playsClassic() const { return games[0]; };
+        bool playsUltimate() const { return games[1]; };
+        bool playsQubic() const { return games[2]; };
+        bool playsMnk() const { return games[3]; };
+        int getPending() const { return pending; };
+
+        static string describe( const GamePosition & );
+        static string describe( const UltimatePosition & );
+        static string describe( const QubicPosition & );
+        static string describe( const MnkPosition & );
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The EnginePlayer class is a computer player whose moves
+*  come from an external engine, a separate program spoken to through
+*  the Engine protocol. It plays the games the engine says it plays,
+*  with a fixed time per move or on a clock. A move the engine does not
+*  send in time, or an illegal one, is replaced by a random legal move.
+*********************************************************************/
+#include "enginePlayer.hpp"
+#include <chrono>
+#include <cstdio>
+
+//Milliseconds an engine may be late before its search is stopped.
+static const int GRACE = 1000;
+
+/*********************************************************************
+** Description: Constructor. Call start() before the first move.
+*
+*  Parameters: TimeControl control - the time for each move.
+*              Random random - chooses the replacement moves.
+*********************************************************************/
+EnginePlayer::EnginePlayer( const TimeControl &control, const Random &random )
+    : control( control ), random( random )
+{
+    //empty.
+}
+
+/*********************************************************************
+** Description: Destructor. Tells the engine to exit.
+*********************************************************************/
+EnginePlayer::~EnginePlayer()
+{
+    engine.quit();
+}
+
+/*********************************************************************
+** Description: Asks the engine for its move and waits for it, stopping
+*  the search if it runs over its time. On a clock, the time the answer
+*  took is taken off the clock and the increment added.
+*
+*  Parameters:
+*  1. string position - the position, from Engine::describe().
+*  2. const int* moves - the legal moves.
+*  3. int count - the number of legal moves.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int EnginePlayer::request( const string &position, const int* moves, int count )
+{
+    if( count == 0 )
+    {
+        return -1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    unsigned id = engine.go( position, control );
+    int move = -1;
+
+    if( id != 0 )
+    {
+        move = engine.wait( id, ( control.moveTime > 0 ? control.moveTime : control.clock ) + GRACE );
+
+        if( move < 0 )
+        {
+            engine.stop();
+            move = engine.wait( id, GRACE );
+        }
+    }
+
+    if( control.moveTime == 0 )
+    {
+        long long used = std::chrono::duration_cast< std::chrono::milliseconds >(
+            std::chrono::steady_clock::now() - start ).count();
+
+        control.clock = static_cast<int>( control.clock > used ? control.clock - used : 0 ) + control.increment;
+    }
+
+    for( int i = 0; i < count; i++ )
+    {
+        if( moves[i] == move )
+        {
+            return move;
+        }
+    }
+
+    printf( "The engine %s did not answer with a legal move, playing a random one.\n", engine.getName().c_str() );
+
+    return moves[random.nextInt( count )];
+}
+
+/*********************************************************************
+** Description: Asks the engine for a classic Tic Tac Toe move.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int EnginePlayer::chooseMove( const GamePosition &position )
+{
+    int moves[GamePosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return request( Engine::describe( position ), moves, count );
+}
+
+/*********************************************************************
+** Description: Asks the engine for an Ultimate Tic Tac Toe move.
+*
+*  Parameters: UltimatePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int EnginePlayer::chooseUltimateMove( const UltimatePosition &position )
+{
+    int moves[UltimatePosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return request( Engine::describe( position ), moves, count );
+}
+
+/*********************************************************************
+** Description: Asks the engine for a Qubic move.
+*
+*  Parameters: QubicPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int EnginePlayer::chooseQubicMove( const QubicPosition &position )
+{
+    int moves[QubicPosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return request( Engine::describe( position ), moves, count );
+}
+
+/*********************************************************************
+** Description: Asks the engine for an m,n,k move.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int EnginePlayer::chooseMnkMove( const MnkPosition &position )
+{
+    int moves[MnkPosition::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    return request( Engine::describe( position ), moves, count );
+}
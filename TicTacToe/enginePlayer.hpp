@@ -0,0 +1,44 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The EnginePlayer class is a computer player whose moves
+*  come from an external engine, a separate program spoken to through
+*  the Engine protocol. It plays the games the engine says it plays,
+*  with a fixed time per move or on a clock. A move the engine does not
+*  send in time, or an illegal one, is replaced by a random legal move.
+*********************************************************************/
+#ifndef ENGINE_PLAYER_HPP
+#define ENGINE_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+#include "engine.hpp"
+
+class EnginePlayer : public AiPlayer
+{
+    private:
+        Engine engine;
+        TimeControl control;
+        Random random; //Replaces the moves the engine did not make.
+
+        //Private functions.
+        int request( const string &, const int*, int );
+
+    public:
+        EnginePlayer( const TimeControl &, const Random & );
+        ~EnginePlayer();
+        bool start( const string &command ) { return engine.start( command ); };
+        int chooseMove( const GamePosition & );
+        string getName() const { return engine.getName(); };
+
+        bool playsUltimate() const { return engine.playsUltimate(); };
+        int chooseUltimateMove( const UltimatePosition & );
+
+        bool playsQubic() const { return engine.playsQubic(); };
+        int chooseQubicMove( const QubicPosition & );
+
+        bool playsMnk() const { return engine.playsMnk(); };
+        int chooseMnkMove( const MnkPosition & );
+};
+
+#endif
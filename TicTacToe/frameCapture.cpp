@@ -0,0 +1,393 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The FrameCapture class records the frames the game
+*  draws, as a sequence of PNG images or as one raw or Y4M video file.
+*  The render thread copies each frame into the next of a ring of
+*  buffers allocated up front, and worker threads encode the buffers
+*  and write them out. If the workers fall behind and the next buffer
+*  is still in use, the frame is dropped instead of waiting for it, so
+*  capturing never stalls the game loop. The time the render thread
+*  spends on capturing is measured and printed with the frames written
+*  and dropped.
+*********************************************************************/
+#include "frameCapture.hpp"
+#include <SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+/*********************************************************************
+** Description: Waits a little for another thread, yielding at first
+*  so a short wait ends at once, then sleeping.
+*
+*  Parameters: int polls - how many times this wait has polled.
+*********************************************************************/
+static void backOff( int polls )
+{
+    if( polls < 100 )
+        std::this_thread::yield();
+
+    else
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+}
+
+/*********************************************************************
+** Description: Tells whether a string ends with a suffix.
+*
+*  Parameters: string text - the string.
+*              const char* suffix - the suffix.
+*
+*  Return: bool - true if text ends with suffix.
+*********************************************************************/
+static bool endsWith( const string &text, const char* suffix )
+{
+    size_t length = strlen( suffix );
+
+    return text.size() >= length && text.compare( text.size() - length, length, suffix ) == 0;
+}
+
+/*********************************************************************
+** Description: Constructor. Nothing is captured until start().
+*********************************************************************/
+FrameCapture::FrameCapture() : nextFrame( 0 ), written( 0 ), captured( 0 ), stopping( false ), failed( false )
+{
+    format = PNG_FORMAT;
+    stream = NULL;
+    width = 0;
+    height = 0;
+    frames = 0;
+    dropped = 0;
+    captureStart = 0;
+    overheadSum = 0.0;
+    overheadMax = 0.0;
+
+    for( int i = 0; i < SLOTS; i++ )
+    {
+        slots[i].sequence.store( -1 );
+        slots[i].state.store( FREE );
+    }
+}
+
+/*********************************************************************
+** Description: Destructor. Finishes the frames captured so far.
+*********************************************************************/
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+/*********************************************************************
+** Description: Allocates the ring of buffers and starts the workers.
+*  A path ending in .y4m is written as a Y4M video, 4:2:0 at 60 frames
+*  a second, which most players and encoders read; one ending in .raw
+*  as the ARGB8888 pixels of one frame after another. Any other path
+*  is the start of the names of numbered PNG images.
+*
+*  Parameters:
+*  1. string path - where the frames go, for example "capture.y4m" or
+*  "shots/frame" for shots/frame000000.png and on.
+*  2. int width - width of the frames.
+*  3. int height - height of the frames.
+*  4. int threads - the number of worker threads.
+*
+*  Return: bool - false if the video file could not be created.
+*********************************************************************/
+bool FrameCapture::start( const string &path, int width, int height, int threads )
+{
+    stop();
+
+    this->path = path;
+    this->width = width;
+    this->height = height;
+    format = endsWith( path, ".y4m" ) ? Y4M_FORMAT : ( endsWith( path, ".raw" ) ? RAW_FORMAT : PNG_FORMAT );
+
+    if( format != PNG_FORMAT )
+    {
+        stream = fopen( path.c_str(), "wb" );
+
+        if( stream == NULL )
+        {
+            printf( "Could not write %s!\n", path.c_str() );
+            return false;
+        }
+
+        if( format == Y4M_FORMAT )
+        {
+            fprintf( stream, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 C420jpeg\n", width, height );
+        }
+    }
+
+    int chroma = ( ( width + 1 ) / 2 ) * ( ( height + 1 ) / 2 );
+
+    for( int i = 0; i < SLOTS; i++ )
+    {
+        slots[i].pixels.assign( 4 * width * height, 0 );
+        slots[i].planes.assign( format == Y4M_FORMAT ? width * height + 2 * chroma : 0, 0 );
+        slots[i].sequence.store( -1 );
+        slots[i].state.store( FREE );
+    }
+
+    nextFrame.store( 0 );
+    written.store( 0 );
+    captured.store( 0 );
+    stopping.store( false );
+    failed.store( false );
+    frames = 0;
+    dropped = 0;
+    overheadSum = 0.0;
+    overheadMax = 0.0;
+
+    for( int i = 0; i < ( threads > 0 ? threads : 1 ); i++ )
+    {
+        workers.push_back( std::thread( &FrameCapture::work, this ) );
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Gets the buffer to copy the next frame into. Render
+*  thread only; every buffer returned is handed back with commit().
+*
+*  Return: Uint8* - the buffer, getPitch() bytes a row, or NULL if the
+*  frame is dropped because the workers have not freed it yet.
+*********************************************************************/
+Uint8* FrameCapture::acquire()
+{
+    if( workers.empty() )
+    {
+        return NULL;
+    }
+
+    captureStart = SDL_GetPerformanceCounter();
+    frames++;
+
+    Slot &slot = slots[captured.load( std::memory_order_relaxed ) % SLOTS];
+
+    if( slot.state.load( std::memory_order_acquire ) != FREE )
+    {
+        dropped++;
+        return NULL;
+    }
+
+    return &slot.pixels[0];
+}
+
+/*********************************************************************
+** Description: Hands the buffer from acquire() to the workers, and
+*  adds the time since acquire() to the capture overhead.
+*
+*  Parameters: bool filled - false if no frame was copied into it.
+*********************************************************************/
+void FrameCapture::commit( bool filled )
+{
+    long long sequence = captured.load( std::memory_order_relaxed );
+
+    if( filled )
+    {
+        Slot &slot = slots[sequence % SLOTS];
+
+        slot.sequence.store( sequence, std::memory_order_release );
+        slot.state.store( FILLED, std::memory_order_release );
+        captured.store( sequence + 1, std::memory_order_release );
+    }
+
+    double milliseconds = 1000.0 * ( SDL_GetPerformanceCounter() - captureStart ) / SDL_GetPerformanceFrequency();
+
+    overheadSum += milliseconds;
+
+    if( milliseconds > overheadMax )
+    {
+        overheadMax = milliseconds;
+    }
+}
+
+/*********************************************************************
+** Description: Runs a worker thread. Each worker takes the number of
+*  the next frame, waits for the render thread to fill its buffer,
+*  encodes and writes it and frees the buffer. The buffer may still
+*  hold the frame a lap earlier, so the worker first waits for its own
+*  frame number, which the render thread stores only after the buffer
+*  was freed, and then for that frame to be filled. Once stop() is
+*  called, workers exit when no captured frame is left.
+*********************************************************************/
+void FrameCapture::work()
+{
+    for( ;; )
+    {
+        long long sequence = nextFrame.fetch_add( 1 );
+        Slot &slot = slots[sequence % SLOTS];
+
+        for( int polls = 0; slot.sequence.load( std::memory_order_acquire ) != sequence
+                            || slot.state.load( std::memory_order_acquire ) != FILLED; polls++ )
+        {
+            if( stopping.load() && sequence >= captured.load() )
+            {
+                return;
+            }
+
+            backOff( polls );
+        }
+
+        if( !encode( slot ) )
+        {
+            failed.store( true );
+        }
+
+        slot.state.store( FREE, std::memory_order_release );
+    }
+}
+
+/*********************************************************************
+** Description: Writes one frame. PNG images are written by every
+*  worker at once; frames of a video are converted at once but written
+*  one after another, in the order they were captured.
+*
+*  Parameters: Slot slot - the buffer of the frame.
+*
+*  Return: bool - false if the frame could not be written.
+*********************************************************************/
+bool FrameCapture::encode( Slot &slot )
+{
+    if( format == PNG_FORMAT )
+    {
+        char name[32];
+        snprintf( name, sizeof( name ), "%06lld.png", slot.sequence.load( std::memory_order_relaxed ) );
+
+        SDL_Surface* frame = SDL_CreateRGBSurfaceWithFormatFrom( &slot.pixels[0], width, height, 32, getPitch(),
+                                                                 SDL_PIXELFORMAT_ARGB8888 );
+        bool saved = frame != NULL && IMG_SavePNG( frame, ( path + name ).c_str() ) == 0;
+
+        if( frame != NULL )
+        {
+            SDL_FreeSurface( frame );
+        }
+
+        return saved;
+    }
+
+    if( format == Y4M_FORMAT )
+    {
+        toPlanes( slot );
+    }
+
+    //Waits for the frames before this one.
+    long long sequence = slot.sequence.load( std::memory_order_relaxed );
+
+    for( int polls = 0; written.load( std::memory_order_acquire ) != sequence; polls++ )
+    {
+        backOff( polls );
+    }
+
+    bool saved;
+
+    if( format == Y4M_FORMAT )
+        saved = fputs( "FRAME\n", stream ) >= 0 && fwrite( &slot.planes[0], 1, slot.planes.size(), stream ) == slot.planes.size();
+
+    else
+        saved = fwrite( &slot.pixels[0], 1, slot.pixels.size(), stream ) == slot.pixels.size();
+
+    written.store( sequence + 1, std::memory_order_release );
+
+    return saved;
+}
+
+/*********************************************************************
+** Description: Converts a frame to the Y, U and V planes of a Y4M
+*  frame, with the full range BT.601 colors of JPEG. U and V are the
+*  average of each 2x2 block of pixels.
+*
+*  Parameters: Slot slot - the buffer of the frame.
+*********************************************************************/
+void FrameCapture::toPlanes( Slot &slot )
+{
+    int chromaWidth = ( width + 1 ) / 2,
+        chromaHeight = ( height + 1 ) / 2;
+    Uint8* luma = &slot.planes[0];
+    Uint8* blue = luma + width * height;
+    Uint8* red = blue + chromaWidth * chromaHeight;
+
+    for( int y = 0; y < height; y++ )
+    {
+        const Uint32* row = reinterpret_cast< const Uint32* >( &slot.pixels[0] + y * getPitch() );
+
+        for( int x = 0; x < width; x++ )
+        {
+            int r = ( row[x] >> 16 ) & 0xFF,
+                g = ( row[x] >> 8 ) & 0xFF,
+                b = row[x] & 0xFF;
+
+            luma[y * width + x] = static_cast<Uint8>( ( 77 * r + 150 * g + 29 * b + 128 ) >> 8 );
+        }
+    }
+
+    for( int y = 0; y < chromaHeight; y++ )
+    {
+        const Uint32* top = reinterpret_cast< const Uint32* >( &slot.pixels[0] + 2 * y * getPitch() );
+        const Uint32* bottom = reinterpret_cast< const Uint32* >( &slot.pixels[0]
+                                                                   + std::min( 2 * y + 1, height - 1 ) * getPitch() );
+
+        for( int x = 0; x < chromaWidth; x++ )
+        {
+            int left = 2 * x,
+                right = std::min( 2 * x + 1, width - 1 ),
+                r = 0,
+                g = 0,
+                b = 0;
+            Uint32 block[4] = { top[left], top[right], bottom[left], bottom[right] };
+
+            for( int i = 0; i < 4; i++ )
+            {
+                r += ( block[i] >> 16 ) & 0xFF;
+                g += ( block[i] >> 8 ) & 0xFF;
+                b += block[i] & 0xFF;
+            }
+
+            r /= 4;
+            g /= 4;
+            b /= 4;
+
+            //Offset by 128 << 8 so the sums are never negative.
+            blue[y * chromaWidth + x] = static_cast<Uint8>( ( 32895 - 43 * r - 85 * g + 128 * b ) >> 8 );
+            red[y * chromaWidth + x] = static_cast<Uint8>( ( 32895 + 128 * r - 107 * g - 21 * b ) >> 8 );
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Waits for the workers to write every frame captured,
+*  closes the video file and prints the frames written and dropped and
+*  the time capturing took on the render thread.
+*********************************************************************/
+void FrameCapture::stop()
+{
+    if( workers.empty() )
+    {
+        return;
+    }
+
+    stopping.store( true );
+
+    for( size_t i = 0; i < workers.size(); i++ )
+    {
+        workers[i].join();
+    }
+
+    workers.clear();
+
+    if( stream != NULL )
+    {
+        fclose( stream );
+        stream = NULL;
+    }
+
+    if( failed.load() )
+    {
+        printf( "Some frames could not be written to %s!\n", path.c_str() );
+    }
+
+    printf( "Captured %lld frames to %s, %lld dropped; capturing took %.3f ms a frame, worst %.3f ms\n",
+            captured.load(), path.c_str(), dropped, frames > 0 ? overheadSum / frames : 0.0, overheadMax );
+}
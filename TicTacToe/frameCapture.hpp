@@ -0,0 +1,96 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The FrameCapture class records the frames the game
+*  draws, as a sequence of PNG images or as one raw or Y4M video file.
+*  The render thread copies each frame into the next of a ring of
+*  buffers allocated up front, and worker threads encode the buffers
+*  and write them out. If the workers fall behind and the next buffer
+*  is still in use, the frame is dropped instead of waiting for it, so
+*  capturing never stalls the game loop. The time the render thread
+*  spends on capturing is measured and printed with the frames written
+*  and dropped.
+*********************************************************************/
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <SDL.h>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class FrameCapture
+{
+    public:
+        enum Format { PNG_FORMAT, RAW_FORMAT, Y4M_FORMAT };
+
+        //Buffers in the ring; frames in flight before one is dropped.
+        static const int SLOTS = 8;
+
+    private:
+        enum SlotState { FREE, FILLED };
+
+        /*********************************************************************
+         ** Description: This struct is one buffer of the ring.
+         *********************************************************************/
+        struct Slot
+        {
+            vector< Uint8 > pixels; //ARGB8888, top row first.
+            vector< Uint8 > planes; //The Y, U and V planes of a Y4M frame.
+            //Number of the frame among those captured. Atomic since a worker
+            //waiting for a later lap reads it while the slot is refilled;
+            //it is stored after the pixels, before the state is FILLED.
+            std::atomic< long long > sequence;
+            std::atomic< int > state;
+        };
+
+        Slot slots[SLOTS];
+        Format format;
+        string path;
+        FILE* stream; //The raw or Y4M file.
+        int width,
+            height;
+
+        vector< std::thread > workers;
+        std::atomic< long long > nextFrame; //Next frame a worker takes.
+        std::atomic< long long > written; //Frames written to the stream, in order.
+        std::atomic< long long > captured; //Frames handed to the workers.
+        std::atomic< bool > stopping;
+        std::atomic< bool > failed; //A frame could not be written.
+
+        //Render thread statistics.
+        long long frames, //Frames offered to acquire().
+                  dropped;
+        Uint64 captureStart;
+        double overheadSum, //Milliseconds.
+               overheadMax;
+
+        //Private functions.
+        void work();
+        bool encode( Slot & );
+        void toPlanes( Slot & );
+
+        //A capture owns its threads and file; it can not be copied.
+        FrameCapture( const FrameCapture & );
+        FrameCapture &operator=( const FrameCapture & );
+
+    public:
+        FrameCapture();
+        ~FrameCapture();
+        bool start( const string &, int, int, int );
+        Uint8* acquire();
+        void commit( bool );
+        void stop();
+
+        //Getter functions.
+        bool isRunning() const { return !workers.empty(); };
+        int getPitch() const { return width * 4; };
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GameBoard class holds the rules of Tic Tac Toe
+*  without any graphics, so the game can run on its own thread and be
+*  played by AIs and simulations. The marks of each player are stored
+*  as a 9 bit mask where cell ( row * 3 + column ) is bit cell.
+*********************************************************************/
+#include "gameBoard.hpp"
+#include "profiler.hpp"
+
+//All winning conditions: three rows, three columns and two diagonals.
+const uint16_t GameBoard::WIN_LINES[8] = { 0x007, 0x038, 0x1C0, 0x049,
+                                           0x092, 0x124, 0x111, 0x054 };
+
+/*********************************************************************
+** Description: Constructor. Starts with an empty board.
+*********************************************************************/
+GameBoard::GameBoard()
+{
+    reset();
+}
+
+/*********************************************************************
+** Description: Clears every cell.
+*********************************************************************/
+void GameBoard::reset()
+{
+    marks[X_Player] = 0;
+    marks[O_Player] = 0;
+}
+
+/*********************************************************************
+** Description: Places a mark.
+*
+*  Parameters:
+*  1. int cell - the cell, row * 3 + column.
+*  2. Player player - the player making the move.
+*
+*  Return: bool - false if the cell was already taken.
+*********************************************************************/
+bool GameBoard::play( int cell, Player player )
+{
+    uint16_t bit = static_cast<uint16_t>( 1 << cell );
+
+    if( ( getEmpty() & bit ) == 0 )
+    {
+        return false;
+    }
+
+    marks[player] |= bit;
+    return true;
+}
+
+/*********************************************************************
+** Description: Takes back a mark placed with play().
+*
+*  Parameters:
+*  1. int cell - the cell, row * 3 + column.
+*  2. Player player - the player who made the move.
+*********************************************************************/
+void GameBoard::undo( int cell, Player player )
+{
+    marks[player] &= static_cast<uint16_t>( ~( 1 << cell ) );
+}
+
+/*********************************************************************
+** Description: Checks whether a player has three in a row.
+*
+*  Parameters: Player player - the player to check.
+*
+*  Return: bool - true if the player has a winning line.
+*********************************************************************/
+bool GameBoard::hasWon( Player player ) const
+{
+    uint16_t playerMarks = marks[player];
+
+    for( int i = 0; i < 8; i++ )
+    {
+        if( ( playerMarks & WIN_LINES[i] ) == WIN_LINES[i] )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Checks for winning conditions of Tic Tac Toe. Only
+*  the player who made the last move can have just won.
+*
+*  Parameters: Player lastPlayer - the player who made the last move.
+*
+*  Return: Outcome - the outcome of the game so far.
+*********************************************************************/
+Outcome GameBoard::checkGame( Player lastPlayer ) const
+{
+    PROFILE_SCOPE( "checkGame" );
+
+    Outcome gameOutcome = UNFINISHED;
+
+    if( lastPlayer != No_Player && hasWon( lastPlayer ) )
+    {
+        gameOutcome = lastPlayer == X_Player ? X_WON : O_WON;
+    }
+
+    else if( getEmpty() == 0 )
+    {
+        gameOutcome = DRAW;
+    }
+
+    return gameOutcome;
+}
+
+/*********************************************************************
+** Description: Returns the player who picked a cell.
+*
+*  Parameters: int cell - the cell, row * 3 + column.
+*
+*  Return: Player - the player, or No_Player if the cell is empty.
+*********************************************************************/
+Player GameBoard::getPick( int cell ) const
+{
+    uint16_t bit = static_cast<uint16_t>( 1 << cell );
+
+    if( marks[X_Player] & bit )
+        return X_Player;
+
+    else if( marks[O_Player] & bit )
+        return O_Player;
+
+    return No_Player;
+}
+
+/*********************************************************************
+** Description: Counts the marks on the board.
+*
+*  Return: int - the number of moves made.
+*********************************************************************/
+int GameBoard::getMoveCount() const
+{
+    int count = 0;
+
+    for( uint16_t occupied = marks[0] | marks[1]; occupied != 0; occupied &= occupied - 1 )
+    {
+        count++;
+    }
+
+    return count;
+}
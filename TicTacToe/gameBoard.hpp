@@ -0,0 +1,47 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GameBoard class holds the rules of Tic Tac Toe
+*  without any graphics, so the game can run on its own thread and be
+*  played by AIs and simulations. The marks of each player are stored
+*  as a 9 bit mask where cell ( row * 3 + column ) is bit cell.
+*********************************************************************/
+#ifndef GAME_BOARD_HPP
+#define GAME_BOARD_HPP
+
+#include <stdint.h>
+
+//Used to store information on which player has
+//picked a cell.
+enum Player { X_Player, O_Player, No_Player };
+
+enum Outcome { X_WON, O_WON, DRAW, UNFINISHED };
+
+class GameBoard
+{
+    private:
+        uint16_t marks[2]; //Indexed by X_Player and O_Player.
+
+    public:
+        static const int CELLS = 9;
+        static const uint16_t FULL = 0x1FF;
+        static const uint16_t WIN_LINES[8];
+
+        GameBoard();
+        void reset();
+        bool play( int, Player );
+        void undo( int, Player );
+        bool hasWon( Player ) const;
+        Outcome checkGame( Player ) const;
+        Player getPick( int ) const;
+
+        //Getter functions.
+        uint16_t getMarks( Player player ) const { return marks[player]; };
+        uint16_t getEmpty() const { return FULL & ~( marks[0] | marks[1] ); };
+        int getMoveCount() const;
+
+        static Player other( Player player ) { return static_cast<Player>( 1 - static_cast<int>( player ) ); };
+};
+
+#endif
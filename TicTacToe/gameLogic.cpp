@@ -0,0 +1,383 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GameLogic class runs the game simulation on its own
+*  thread. The render thread sends it input commands through a
+*  lock-free queue and draws the latest GameSnapshot it publishes, so a
+*  slow rule evaluation or AI move never stalls the frame loop. Either
+*  side can be taken by an AiPlayer, which moves on the logic thread.
+*  The game is classic Tic Tac Toe, Ultimate Tic Tac Toe, Qubic or an
+*  m,n,k game on a larger board.
+*********************************************************************/
+#include "gameLogic.hpp"
+#include "profiler.hpp"
+#include <chrono>
+#include <cstdio>
+
+/*********************************************************************
+** Description: Constructor. Starts the first round and publishes it,
+*  so there is a snapshot to draw before the thread runs.
+*
+*  Parameters: Random random - chooses the starting player.
+*********************************************************************/
+GameLogic::GameLogic( const Random &random ) : random( random ), running( false )
+{
+    hoverCell = NO_CELL;
+    xPoints = 0;
+    oPoints = 0;
+    sequence = 0;
+    slowAiDelay = 0;
+    audio = NULL;
+    mode = CLASSIC_MODE;
+    players[X_Player] = NULL;
+    players[O_Player] = NULL;
+
+    startRound();
+    publish();
+}
+
+/*********************************************************************
+** Description: Destructor. Stops the thread if it is still running
+*  and deletes the computer players.
+*********************************************************************/
+GameLogic::~GameLogic()
+{
+    stop();
+
+    delete players[X_Player];
+    delete players[O_Player];
+}
+
+/*********************************************************************
+** Description: Hands one side to a computer player. Call before the
+*  thread is started.
+*
+*  Parameters: Player side - X_Player or O_Player.
+*              AiPlayer* player - the player, owned by the game logic
+*              from now on, or NULL for a human.
+*********************************************************************/
+void GameLogic::setPlayer( Player side, AiPlayer* player )
+{
+    if( player != NULL && ( ( mode == ULTIMATE_MODE && !player->playsUltimate() )
+                            || ( mode == QUBIC_MODE && !player->playsQubic() )
+                            || ( mode == MNK_MODE && !player->playsMnk() ) ) )
+    {
+        printf( "The %s player does not play this mode, using a human player.\n",
+                player->getName().c_str() );
+        delete player;
+        player = NULL;
+    }
+
+    delete players[side];
+    players[side] = player;
+}
+
+/*********************************************************************
+** Description: Chooses the game to play and starts a new round of it.
+*  Call before the thread is started and before setPlayer().
+*
+*  Parameters: GameMode mode - CLASSIC_MODE, ULTIMATE_MODE, QUBIC_MODE
+*  or MNK_MODE.
+*********************************************************************/
+void GameLogic::setMode( GameMode mode )
+{
+    this->mode = mode;
+
+    startRound();
+    publish();
+}
+
+/*********************************************************************
+** Description: Sets the board size of the m,n,k mode. Call before
+*  setMode().
+*
+*  Parameters: int width, int height, int k - a size that passes
+*  MnkPosition::validSize().
+*********************************************************************/
+void GameLogic::setMnkSize( int width, int height, int k )
+{
+    mnk = MnkPosition( width, height, k );
+}
+
+/*********************************************************************
+** Description: Returns the player to move in the current game.
+*********************************************************************/
+Player GameLogic::getToMove() const
+{
+    if( mode == ULTIMATE_MODE )
+        return ultimate.getToMove();
+
+    if( mode == QUBIC_MODE )
+        return qubic.getToMove();
+
+    if( mode == MNK_MODE )
+        return mnk.getToMove();
+
+    return position.getToMove();
+}
+
+/*********************************************************************
+** Description: Returns the outcome of the current game so far.
+*********************************************************************/
+Outcome GameLogic::getOutcome() const
+{
+    if( mode == ULTIMATE_MODE )
+        return ultimate.getOutcome();
+
+    if( mode == QUBIC_MODE )
+        return qubic.getOutcome();
+
+    if( mode == MNK_MODE )
+        return mnk.getOutcome();
+
+    return position.getOutcome();
+}
+
+/*********************************************************************
+** Description: Starts the game logic thread.
+*********************************************************************/
+void GameLogic::start()
+{
+    if( !running.load() )
+    {
+        running.store( true );
+        worker = std::thread( &GameLogic::run, this );
+    }
+}
+
+/*********************************************************************
+** Description: Stops the game logic thread and waits for it to end.
+*********************************************************************/
+void GameLogic::stop()
+{
+    running.store( false );
+
+    if( worker.joinable() )
+    {
+        worker.join();
+    }
+}
+
+/*********************************************************************
+** Description: The thread loop. Sleeps briefly when there is nothing
+*  to do, which bounds the input latency to about a millisecond.
+*********************************************************************/
+void GameLogic::run()
+{
+    while( running.load() )
+    {
+        if( !step() )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Applies every pending input command, then lets a
+*  computer player make its move, and publishes a new snapshot if
+*  anything changed. Called by the thread loop, or once per frame by
+*  the render thread when running single-threaded.
+*
+*  Return: bool - true if a new snapshot was published.
+*********************************************************************/
+bool GameLogic::step()
+{
+    PROFILE_SCOPE( "gameLogic" );
+
+    bool changed = false;
+    InputCommand command;
+
+    while( commands.pop( command ) )
+    {
+        if( apply( command ) )
+        {
+            changed = true;
+        }
+    }
+
+    //One move per step, so commands are still read between the moves
+    //of two computer players.
+    if( playAiMove() )
+    {
+        changed = true;
+    }
+
+    if( changed )
+    {
+        publish();
+    }
+
+    return changed;
+}
+
+/*********************************************************************
+** Description: Clears the board and randomly chooses player X or
+*  player O to make the first move.
+*********************************************************************/
+void GameLogic::startRound()
+{
+    Player first = static_cast<Player>( random.nextInt( 2 ) );
+
+    position = GamePosition( first );
+    ultimate = UltimatePosition( first );
+    qubic = QubicPosition( first );
+    mnk = MnkPosition( mnk.getWidth(), mnk.getHeight(), mnk.getK(), first );
+}
+
+/*********************************************************************
+** Description: Applies one input command.
+*
+*  Parameters: InputCommand command - the command to apply.
+*
+*  Return: bool - true if the game state changed.
+*********************************************************************/
+bool GameLogic::apply( const InputCommand &command )
+{
+    bool changed = false;
+
+    if( command.type == InputCommand::HOVER )
+    {
+        changed = hoverCell != command.cell;
+        hoverCell = command.cell;
+
+        if( changed && hoverCell != NO_CELL && audio != NULL )
+        {
+            audio->play( HOVER_CUE, command.time );
+        }
+    }
+
+    //Clicking the play again button after a round starts a new round.
+    else if( command.cell == PLAY_AGAIN_CELL )
+    {
+        if( getOutcome() != UNFINISHED )
+        {
+            startRound();
+            changed = true;
+        }
+    }
+
+    //Clicks on the board are ignored while a computer player is to move.
+    else if( players[getToMove()] == NULL )
+    {
+        changed = playMove( command.cell, command.time );
+    }
+
+    return changed;
+}
+
+/*********************************************************************
+** Description: Lets the computer player make its move, if it is to
+*  move in an unfinished round.
+*
+*  Return: bool - true if a move was made.
+*********************************************************************/
+bool GameLogic::playAiMove()
+{
+    AiPlayer* player = players[getToMove()];
+
+    if( player == NULL || getOutcome() != UNFINISHED )
+    {
+        return false;
+    }
+
+    int cell;
+
+    {
+        PROFILE_SCOPE( "aiMove" );
+        if( mode == ULTIMATE_MODE )
+            cell = player->chooseUltimateMove( ultimate );
+
+        else if( mode == QUBIC_MODE )
+            cell = player->chooseQubicMove( qubic );
+
+        else if( mode == MNK_MODE )
+            cell = player->chooseMnkMove( mnk );
+
+        else
+            cell = player->chooseMove( position );
+    }
+
+    return playMove( cell, Profiler::now() );
+}
+
+/*********************************************************************
+** Description: Plays a move for the player to move and scores the
+*  round if it ended, with the sound cue of the move.
+*
+*  Parameters: int cell - the cell to play.
+*              long long inputTime - Profiler::now() when the click or
+*              the computer's choice was made, for the cue latency.
+*
+*  Return: bool - false if the move is not legal.
+*********************************************************************/
+bool GameLogic::playMove( int cell, long long inputTime )
+{
+    bool legal;
+
+    if( mode == ULTIMATE_MODE )
+        legal = ultimate.play( cell );
+
+    else if( mode == QUBIC_MODE )
+        legal = qubic.play( cell );
+
+    else if( mode == MNK_MODE )
+        legal = mnk.play( cell );
+
+    else
+        legal = cell >= 0 && cell < GameBoard::CELLS && position.play( cell );
+
+    if( !legal )
+    {
+        return false;
+    }
+
+    if( getOutcome() == X_WON )
+        xPoints++;
+
+    else if( getOutcome() == O_WON )
+        oPoints++;
+
+    if( audio != NULL )
+    {
+        if( getOutcome() == UNFINISHED )
+            audio->play( MOVE_CUE, inputTime );
+
+        else
+            audio->play( getOutcome() == DRAW ? DRAW_CUE : WIN_CUE, inputTime );
+    }
+
+    //Stands in for an AI computing its reply. The move is shown first.
+    if( slowAiDelay > 0 && getOutcome() == UNFINISHED )
+    {
+        PROFILE_SCOPE( "slowAi" );
+        publish();
+        std::this_thread::sleep_for( std::chrono::milliseconds( slowAiDelay ) );
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Copies the game state into a snapshot for the render
+*  thread.
+*********************************************************************/
+void GameLogic::publish()
+{
+    GameSnapshot &snapshot = snapshots.writeBuffer();
+
+    snapshot.mode = mode;
+    snapshot.board = position.getBoard();
+    snapshot.ultimate = ultimate;
+    snapshot.qubic = qubic;
+    snapshot.mnk = mnk;
+    snapshot.turn = getToMove();
+    snapshot.outcome = getOutcome();
+    snapshot.hoverCell = hoverCell;
+    snapshot.xPoints = xPoints;
+    snapshot.oPoints = oPoints;
+    snapshot.sequence = ++sequence;
+
+    snapshots.publish();
+}
@@ -0,0 +1,146 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GameLogic class runs the game simulation on its own
+*  thread. The render thread sends it input commands through a
+*  lock-free queue and draws the latest GameSnapshot it publishes, so a
+*  slow rule evaluation or AI move never stalls the frame loop. Either
+*  side can be taken by an AiPlayer, which moves on the logic thread.
+*  The game is classic Tic Tac Toe, Ultimate Tic Tac Toe, Qubic or an
+*  m,n,k game on a larger board.
+*********************************************************************/
+#ifndef GAME_LOGIC_HPP
+#define GAME_LOGIC_HPP
+
+#include "gamePosition.hpp"
+#include "ultimatePosition.hpp"
+#include "qubicPosition.hpp"
+#include "mnkPosition.hpp"
+#include "aiPlayer.hpp"
+#include "random.hpp"
+#include "spscQueue.hpp"
+#include "tripleBuffer.hpp"
+#include "audioHandler.hpp"
+#include "profiler.hpp"
+#include <atomic>
+#include <thread>
+
+//Cell numbers used for the buttons outside of the board.
+const int NO_CELL = -1;
+const int PLAY_AGAIN_CELL = -2;
+
+enum GameMode { CLASSIC_MODE, ULTIMATE_MODE, QUBIC_MODE, MNK_MODE };
+
+/*********************************************************************
+** Description: The GameSnapshot struct is an immutable copy of
+*  everything the render thread needs to draw one frame.
+*********************************************************************/
+struct GameSnapshot
+{
+    GameMode mode;
+    GameBoard board; //Classic mode only.
+    UltimatePosition ultimate; //Ultimate mode only.
+    QubicPosition qubic; //Qubic mode only.
+    MnkPosition mnk; //m,n,k mode only.
+    Player turn; //Player to move.
+    Outcome outcome;
+    int hoverCell; //Cell under the mouse, PLAY_AGAIN_CELL or NO_CELL.
+    int xPoints,
+        oPoints;
+    unsigned long long sequence; //Increases with every published snapshot.
+
+    GameSnapshot()
+    {
+        mode = CLASSIC_MODE;
+        turn = X_Player;
+        outcome = UNFINISHED;
+        hoverCell = NO_CELL;
+        xPoints = 0;
+        oPoints = 0;
+        sequence = 0;
+    }
+};
+
+/*********************************************************************
+** Description: The InputCommand struct is a player action sent from
+*  the render thread to the game logic.
+*********************************************************************/
+struct InputCommand
+{
+    enum Type { HOVER, CLICK };
+
+    Type type;
+    int cell; //Cell number, PLAY_AGAIN_CELL or NO_CELL.
+    long long time; //Profiler::now() when the input was read.
+
+    InputCommand()
+    {
+        type = HOVER;
+        cell = NO_CELL;
+        time = 0;
+    }
+
+    InputCommand( Type type, int cell )
+    {
+        this->type = type;
+        this->cell = cell;
+        time = Profiler::now();
+    }
+};
+
+class GameLogic
+{
+    private:
+        GameMode mode;
+        GamePosition position;
+        UltimatePosition ultimate;
+        QubicPosition qubic;
+        MnkPosition mnk;
+
+        AiPlayer* players[2]; //Computer player of each side, NULL for a human.
+
+        int hoverCell,
+            xPoints,
+            oPoints;
+
+        unsigned long long sequence;
+
+        Random random; //Chooses the starting player.
+
+        int slowAiDelay; //Milliseconds a simulated AI thinks per move.
+
+        AudioHandler* audio; //Plays the sound cues, or NULL for silence.
+
+        SpscQueue< InputCommand, 256 > commands;
+        TripleBuffer< GameSnapshot > snapshots;
+
+        std::thread worker;
+        std::atomic< bool > running;
+
+        //Private functions.
+        void startRound();
+        bool apply( const InputCommand & );
+        bool playMove( int, long long );
+        bool playAiMove();
+        Player getToMove() const;
+        Outcome getOutcome() const;
+        void publish();
+        void run();
+
+    public:
+        GameLogic( const Random & );
+        ~GameLogic();
+        void start();
+        void stop();
+        bool step();
+        bool send( const InputCommand &command ) { return commands.push( command ); };
+        const GameSnapshot& latestSnapshot() { return snapshots.read(); };
+        void setSlowAiDelay( int delay ) { slowAiDelay = delay; };
+        void setAudio( AudioHandler* newAudio ) { audio = newAudio; };
+        void setPlayer( Player, AiPlayer* );
+        void setMode( GameMode );
+        void setMnkSize( int, int, int );
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GamePosition class is a Tic Tac Toe board together
+*  with the player to move and the outcome so far. It is the position
+*  type the game logic and the AI players search over. Other board
+*  variants provide the same functions so the search engines can be
+*  reused for them.
+*********************************************************************/
+#include "gamePosition.hpp"
+
+/*********************************************************************
+** Description: Constructor. Starts with an empty board.
+*
+*  Parameters: Player toMove - the player who makes the first move.
+*********************************************************************/
+GamePosition::GamePosition( Player toMove )
+{
+    this->toMove = toMove;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Makes a move for the player to move.
+*
+*  Parameters: int cell - the cell, row * 3 + column.
+*
+*  Return: bool - false if the game is over or the cell is taken.
+*********************************************************************/
+bool GamePosition::play( int cell )
+{
+    if( outcome != UNFINISHED || !board.play( cell, toMove ) )
+    {
+        return false;
+    }
+
+    outcome = board.checkGame( toMove );
+    toMove = GameBoard::other( toMove );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Takes back the last move, which was made in a cell.
+*
+*  Parameters: int cell - the cell of the last move.
+*********************************************************************/
+void GamePosition::undo( int cell )
+{
+    toMove = GameBoard::other( toMove );
+    board.undo( cell, toMove );
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Lists the legal moves.
+*
+*  Parameters: int* moves - receives up to MAX_MOVES cells.
+*
+*  Return: int - the number of legal moves.
+*********************************************************************/
+int GamePosition::getMoves( int* moves ) const
+{
+    int count = 0;
+
+    for( uint16_t mask = getMoveMask(); mask != 0; mask &= mask - 1 )
+    {
+        moves[count++] = __builtin_ctz( mask );
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Returns the legal moves as a bit mask of cells.
+*
+*  Return: uint16_t - the empty cells, or 0 once the game is over.
+*********************************************************************/
+uint16_t GamePosition::getMoveMask() const
+{
+    return outcome == UNFINISHED ? board.getEmpty() : 0;
+}
+
+/*********************************************************************
+** Description: Compares two positions.
+*
+*  Return: bool - true if the marks and the player to move match.
+*********************************************************************/
+bool GamePosition::operator==( const GamePosition &other ) const
+{
+    return toMove == other.toMove
+        && board.getMarks( X_Player ) == other.board.getMarks( X_Player )
+        && board.getMarks( O_Player ) == other.board.getMarks( O_Player );
+}
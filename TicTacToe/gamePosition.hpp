@@ -0,0 +1,41 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GamePosition class is a Tic Tac Toe board together
+*  with the player to move and the outcome so far. It is the position
+*  type the game logic and the AI players search over. Other board
+*  variants provide the same functions so the search engines can be
+*  reused for them.
+*********************************************************************/
+#ifndef GAME_POSITION_HPP
+#define GAME_POSITION_HPP
+
+#include "gameBoard.hpp"
+
+class GamePosition
+{
+    private:
+        GameBoard board;
+        Player toMove;
+        Outcome outcome;
+
+    public:
+        static const int MAX_MOVES = GameBoard::CELLS;
+
+        GamePosition( Player toMove = X_Player );
+        bool play( int );
+        void undo( int );
+        int getMoves( int* ) const;
+        uint16_t getMoveMask() const;
+
+        //Getter functions.
+        const GameBoard& getBoard() const { return board; };
+        Player getToMove() const { return toMove; };
+        Outcome getOutcome() const { return outcome; };
+
+        bool operator==( const GamePosition & ) const;
+        bool operator!=( const GamePosition &other ) const { return !( *this == other ); };
+};
+
+#endif
@@ -0,0 +1,754 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GlRenderer class draws a frame with OpenGL 3.3 as
+*  one instanced draw call. Everything on the screen is a quad: filled
+*  rectangles, Xs and Os, which the fragment shader draws from signed
+*  distance functions so they stay sharp at any size, and text, cut
+*  from an atlas of the HUD strings. The quads of a frame are kept in
+*  a vertex buffer that lives as long as the renderer, and only the
+*  quads that differ from the last frame are uploaded. A frame can also
+*  keep the last one and rewrite some of its quads in place.
+*********************************************************************/
+#include "glRenderer.hpp"
+#include <SDL_ttf.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+//Places a unit quad over the rectangle of its instance.
+static const char* VERTEX_SHADER =
+    "#version 330 core\n"
+    "layout( location = 0 ) in vec2 corner;\n"
+    "layout( location = 1 ) in vec4 rect;\n"
+    "layout( location = 2 ) in vec4 color;\n"
+    "layout( location = 3 ) in vec4 clip;\n"
+    "layout( location = 4 ) in float shape;\n"
+    "uniform vec2 screen;\n"
+    "uniform float scroll;\n"
+    "out vec2 local;\n"
+    "out vec4 tint;\n"
+    "out vec2 texel;\n"
+    "flat out int kind;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pixel = rect.xy + corner * rect.zw - vec2( 0.0, scroll );\n"
+    "    gl_Position = vec4( pixel.x / screen.x * 2.0 - 1.0, 1.0 - pixel.y / screen.y * 2.0, 0.0, 1.0 );\n"
+    "    local = corner * 2.0 - 1.0;\n"
+    "    tint = color;\n"
+    "    texel = mix( clip.xy, clip.zw, corner );\n"
+    "    kind = int( shape );\n"
+    "}\n";
+
+//Fills rectangles, samples text from the atlas, and draws the X as two
+//strokes and the O as a ring from their distance to each pixel, which
+//also gives the antialiased edge.
+static const char* FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "in vec2 local;\n"
+    "in vec4 tint;\n"
+    "in vec2 texel;\n"
+    "flat in int kind;\n"
+    "uniform sampler2D atlas;\n"
+    "out vec4 fragColor;\n"
+    "float segment( vec2 p, vec2 a, vec2 b )\n"
+    "{\n"
+    "    vec2 pa = p - a, ba = b - a;\n"
+    "    return length( pa - ba * clamp( dot( pa, ba ) / dot( ba, ba ), 0.0, 1.0 ) );\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    if( kind == 3 )\n"
+    "    {\n"
+    "        fragColor = texture( atlas, texel ) * vec4( 1.0, 1.0, 1.0, tint.a );\n"
+    "        return;\n"
+    "    }\n"
+    "    float coverage = 1.0;\n"
+    "    if( kind != 0 )\n"
+    "    {\n"
+    "        float distance = kind == 1\n"
+    "            ? min( segment( local, vec2( -0.78, -0.78 ), vec2( 0.78, 0.78 ) ),\n"
+    "                   segment( local, vec2( -0.78, 0.78 ), vec2( 0.78, -0.78 ) ) ) - 0.1\n"
+    "            : abs( length( local ) - 0.78 ) - 0.09;\n"
+    "        coverage = clamp( 0.5 - distance / fwidth( distance ), 0.0, 1.0 );\n"
+    "    }\n"
+    "    fragColor = vec4( tint.rgb, tint.a * coverage );\n"
+    "}\n";
+
+/*********************************************************************
+** Description: Constructor. Nothing is created until startUp().
+*********************************************************************/
+GlRenderer::GlRenderer()
+{
+    screenWidth = 0;
+    screenHeight = 0;
+    program = 0;
+    vertexArray = 0;
+    cornerBuffer = 0;
+    instanceBuffer = 0;
+    atlas = 0;
+    screenLocation = -1;
+    scrollLocation = -1;
+    atlasWidth = 0;
+    atlasHeight = 0;
+    xColor = THEMES[0].xColor;
+    oColor = THEMES[0].oColor;
+    originX = 0;
+    originY = 0;
+    scroll = 0;
+    cursor = 0;
+    capacity = 1024;
+    uploadedBytes = 0;
+    packReads = 0;
+
+    for( int i = 0; i < PACK_BUFFERS; i++ )
+    {
+        packBuffers[i] = 0;
+    }
+
+    for( int i = 0; i < TEXT_COUNT; i++ )
+    {
+        textRects[i] = { 0, 0, 0, 0 };
+    }
+}
+
+/*********************************************************************
+** Description: Sets up GLEW, the shaders, the buffers and the text
+*  atlas. An OpenGL 3.3 core context must be current.
+*
+*  Parameters: int width, int height - the size of the screen.
+*              Theme theme - the font and colors of the marks and text.
+*
+*  Return: bool - indicates whether the renderer is ready.
+*********************************************************************/
+bool GlRenderer::startUp( int width, int height, const Theme &theme )
+{
+    screenWidth = width;
+    screenHeight = height;
+
+    //Core profiles need this for GLEW to load every function.
+    glewExperimental = GL_TRUE;
+    GLenum error = glewInit();
+
+    if( error != GLEW_OK )
+    {
+        printf( "GLEW could not initialize! GLEW Error: %s\n", 
+                reinterpret_cast<const char*>( glewGetErrorString( error ) ) );
+        return false;
+    }
+
+    //glewInit() can leave an error behind on core profiles.
+    glGetError();
+
+    if( !GLEW_VERSION_3_3 )
+    {
+        printf( "OpenGL 3.3 is not supported! Version: %s\n", 
+                reinterpret_cast<const char*>( glGetString( GL_VERSION ) ) );
+        return false;
+    }
+
+    if( !linkProgram() || !loadAtlas( theme ) )
+    {
+        return false;
+    }
+
+    const float CORNERS[8] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+    glGenVertexArrays( 1, &vertexArray );
+    glBindVertexArray( vertexArray );
+
+    glGenBuffers( 1, &cornerBuffer );
+    glBindBuffer( GL_ARRAY_BUFFER, cornerBuffer );
+    glBufferData( GL_ARRAY_BUFFER, sizeof( CORNERS ), CORNERS, GL_STATIC_DRAW );
+    glEnableVertexAttribArray( 0 );
+    glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof( float ), NULL );
+
+    glGenBuffers( 1, &instanceBuffer );
+    glBindBuffer( GL_ARRAY_BUFFER, instanceBuffer );
+    glBufferData( GL_ARRAY_BUFFER, capacity * sizeof( Instance ), NULL, GL_DYNAMIC_DRAW );
+
+    const int SIZES[4] = { 4, 4, 4, 1 };
+    const size_t OFFSETS[4] = { offsetof( Instance, rect ), offsetof( Instance, color ),
+                                offsetof( Instance, clip ), offsetof( Instance, shape ) };
+
+    for( int i = 0; i < 4; i++ )
+    {
+        glEnableVertexAttribArray( i + 1 );
+        glVertexAttribPointer( i + 1, SIZES[i], GL_FLOAT, GL_FALSE, sizeof( Instance ),
+                               reinterpret_cast<const void*>( OFFSETS[i] ) );
+        glVertexAttribDivisor( i + 1, 1 );
+    }
+
+    instances.reserve( capacity );
+    uploaded.reserve( capacity );
+    written.reserve( capacity );
+
+    glUseProgram( program );
+    glUniform2f( screenLocation, static_cast<float>( width ), static_cast<float>( height ) );
+    glUniform1i( glGetUniformLocation( program, "atlas" ), 0 );
+
+    glDisable( GL_DEPTH_TEST );
+    glEnable( GL_BLEND );
+    glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+
+    error = glGetError();
+
+    if( error != GL_NO_ERROR )
+    {
+        printf( "OpenGL setup failed! OpenGL Error: 0x%x\n", error );
+        return false;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Compiles a shader.
+*
+*  Parameters: GLenum type - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER.
+*              const char* source - the GLSL source.
+*
+*  Return: GLuint - the shader, or 0 if it did not compile.
+*********************************************************************/
+GLuint GlRenderer::compileShader( GLenum type, const char* source )
+{
+    GLuint shader = glCreateShader( type );
+    GLint compiled = GL_FALSE;
+
+    glShaderSource( shader, 1, &source, NULL );
+    glCompileShader( shader );
+    glGetShaderiv( shader, GL_COMPILE_STATUS, &compiled );
+
+    if( compiled != GL_TRUE )
+    {
+        char log[1024];
+        glGetShaderInfoLog( shader, sizeof( log ), NULL, log );
+        printf( "Shader could not compile! %s\n", log );
+
+        glDeleteShader( shader );
+        shader = 0;
+    }
+
+    return shader;
+}
+
+/*********************************************************************
+** Description: Compiles and links the shader program.
+*
+*  Return: bool - indicates whether the program linked.
+*********************************************************************/
+bool GlRenderer::linkProgram()
+{
+    GLuint vertexShader = compileShader( GL_VERTEX_SHADER, VERTEX_SHADER ),
+           fragmentShader = compileShader( GL_FRAGMENT_SHADER, FRAGMENT_SHADER );
+    GLint linked = GL_FALSE;
+
+    if( vertexShader != 0 && fragmentShader != 0 )
+    {
+        program = glCreateProgram();
+        glAttachShader( program, vertexShader );
+        glAttachShader( program, fragmentShader );
+        glLinkProgram( program );
+        glGetProgramiv( program, GL_LINK_STATUS, &linked );
+
+        if( linked != GL_TRUE )
+        {
+            char log[1024];
+            glGetProgramInfoLog( program, sizeof( log ), NULL, log );
+            printf( "Shader program could not link! %s\n", log );
+        }
+
+        else
+        {
+            screenLocation = glGetUniformLocation( program, "screen" );
+            scrollLocation = glGetUniformLocation( program, "scroll" );
+        }
+    }
+
+    //The program keeps what it needs of the shaders.
+    glDeleteShader( vertexShader );
+    glDeleteShader( fragmentShader );
+
+    return linked == GL_TRUE;
+}
+
+/*********************************************************************
+** Description: Switches to the font and colors of another theme. The
+*  atlas is made again, and the next frames draw in the new colors.
+*
+*  Parameters: Theme theme - the new theme.
+*
+*  Return: bool - indicates whether the new atlas was made. If not, the
+*  old theme is kept.
+*********************************************************************/
+bool GlRenderer::setTheme( const Theme &theme )
+{
+    return loadAtlas( theme );
+}
+
+/*********************************************************************
+** Description: Renders the HUD strings and digits with SDL_ttf and
+*  stacks them into one texture, a row of pixels apart so filtering
+*  does not bleed one into the next. Replaces the atlas and the mark
+*  colors only once the new atlas is made.
+*
+*  Parameters: Theme theme - the font and colors of the text.
+*
+*  Return: bool - indicates whether the atlas was made.
+*********************************************************************/
+bool GlRenderer::loadAtlas( const Theme &theme )
+{
+    const char* STRINGS[DIGITS] = { "Player X Turn", "Player O Turn", "X WON", "O WON", "DRAW",
+                                    "X Points: ", "O Points: ", "Play Again?" };
+    const SDL_Color COLORS[DIGITS] = { theme.xColor, theme.oColor, theme.xColor, theme.oColor, theme.textColor,
+                                       theme.xColor, theme.oColor, theme.textColor };
+
+    TTF_Font* font = TTF_OpenFont( theme.fontPath, theme.fontSize );
+
+    if( font == NULL )
+    {
+        printf( "Failed to load font for the text atlas! SDL_ttf Error: %s\n", TTF_GetError() );
+        return false;
+    }
+
+    SDL_Surface* surfaces[TEXT_COUNT] = { NULL };
+    SDL_Rect rects[TEXT_COUNT];
+    bool success = true;
+    int width = 1,
+        height = 0;
+
+    for( int i = 0; i < TEXT_COUNT && success; i++ )
+    {
+        char digit[2] = { static_cast<char>( '0' + i - DIGITS ), '\0' };
+        SDL_Surface* rendered = TTF_RenderText_Blended( font, i < DIGITS ? STRINGS[i] : digit,
+                                                        i < DIGITS ? COLORS[i] : theme.textColor );
+
+        if( rendered == NULL )
+        {
+            printf( "Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError() );
+            success = false;
+        }
+
+        else
+        {
+            surfaces[i] = SDL_ConvertSurfaceFormat( rendered, SDL_PIXELFORMAT_RGBA32, 0 );
+            SDL_FreeSurface( rendered );
+
+            if( surfaces[i] == NULL )
+            {
+                printf( "Unable to convert text surface! SDL Error: %s\n", SDL_GetError() );
+                success = false;
+            }
+
+            else
+            {
+                rects[i] = { 0, height, surfaces[i]->w, surfaces[i]->h };
+                height += surfaces[i]->h + 1;
+
+                if( surfaces[i]->w > width )
+                {
+                    width = surfaces[i]->w;
+                }
+            }
+        }
+    }
+
+    TTF_CloseFont( font );
+
+    if( success )
+    {
+        vector< Uint8 > pixels( width * height * 4, 0 );
+
+        for( int i = 0; i < TEXT_COUNT; i++ )
+        {
+            for( int y = 0; y < surfaces[i]->h; y++ )
+            {
+                memcpy( &pixels[( ( rects[i].y + y ) * width ) * 4],
+                        static_cast<const Uint8*>( surfaces[i]->pixels ) + y * surfaces[i]->pitch,
+                        surfaces[i]->w * 4 );
+            }
+
+            textRects[i] = rects[i];
+        }
+
+        if( atlas != 0 )
+        {
+            glDeleteTextures( 1, &atlas );
+        }
+
+        atlasWidth = width;
+        atlasHeight = height;
+        xColor = theme.xColor;
+        oColor = theme.oColor;
+
+        glGenTextures( 1, &atlas );
+        glBindTexture( GL_TEXTURE_2D, atlas );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+        glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0, GL_RGBA,
+                      GL_UNSIGNED_BYTE, &pixels[0] );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+    }
+
+    for( int i = 0; i < TEXT_COUNT; i++ )
+    {
+        if( surfaces[i] != NULL )
+            SDL_FreeSurface( surfaces[i] );
+    }
+
+    return success;
+}
+
+/*********************************************************************
+** Description: Starts a new frame with no quads.
+*********************************************************************/
+void GlRenderer::begin()
+{
+    instances.clear();
+    written.clear();
+    cursor = 0;
+    originX = 0;
+    originY = 0;
+    scroll = 0;
+}
+
+/*********************************************************************
+** Description: Keeps the quads of the last frame and moves where the
+*  next quads are written, so they replace the quads from there on.
+*  Quads written past the end are added.
+*
+*  Parameters: int index - the first quad to replace.
+*********************************************************************/
+void GlRenderer::seek( int index )
+{
+    cursor = index < getInstanceCount() ? index : getInstanceCount();
+}
+
+/*********************************************************************
+** Description: Adds one quad to the frame.
+*
+*  Parameters:
+*  1. SDL_Rect rect - where it is drawn, relative to the origin.
+*  2. SDL_Color color - the fill color, or the alpha of text.
+*  3. Shape shape - what the fragment shader draws.
+*  4. SDL_Rect* clip - the text in the atlas, or NULL.
+*********************************************************************/
+void GlRenderer::addInstance( const SDL_Rect &rect, SDL_Color color, Shape shape, const SDL_Rect* clip )
+{
+    Instance instance;
+
+    instance.rect[0] = static_cast<float>( rect.x + originX );
+    instance.rect[1] = static_cast<float>( rect.y + originY );
+    instance.rect[2] = static_cast<float>( rect.w );
+    instance.rect[3] = static_cast<float>( rect.h );
+    instance.color[0] = color.r / 255.0f;
+    instance.color[1] = color.g / 255.0f;
+    instance.color[2] = color.b / 255.0f;
+    instance.color[3] = color.a / 255.0f;
+    instance.clip[0] = clip == NULL ? 0.0f : static_cast<float>( clip->x ) / atlasWidth;
+    instance.clip[1] = clip == NULL ? 0.0f : static_cast<float>( clip->y ) / atlasHeight;
+    instance.clip[2] = clip == NULL ? 0.0f : static_cast<float>( clip->x + clip->w ) / atlasWidth;
+    instance.clip[3] = clip == NULL ? 0.0f : static_cast<float>( clip->y + clip->h ) / atlasHeight;
+    instance.shape = static_cast<float>( shape );
+
+    if( cursor < getInstanceCount() )
+        instances[cursor] = instance;
+
+    else
+        instances.push_back( instance );
+
+    if( !written.empty() && written.back().last == cursor )
+    {
+        written.back().last++;
+    }
+
+    else
+    {
+        Run run = { cursor, cursor + 1 };
+        written.push_back( run );
+    }
+
+    cursor++;
+}
+
+/*********************************************************************
+** Description: Adds filled rectangles to the frame.
+*
+*  Parameters:
+*  1. SDL_Rect* rects - the rectangles.
+*  2. int count - how many there are.
+*  3. SDL_Color color - their color.
+*********************************************************************/
+void GlRenderer::addRects( const SDL_Rect* rects, int count, SDL_Color color )
+{
+    for( int i = 0; i < count; i++ )
+    {
+        addInstance( rects[i], color, RECT_SHAPE, NULL );
+    }
+}
+
+/*********************************************************************
+** Description: Adds an X or an O to the frame.
+*
+*  Parameters: Player player - X_Player or O_Player.
+*              SDL_Rect box - the square the mark fills.
+*********************************************************************/
+void GlRenderer::addMark( Player player, const SDL_Rect &box )
+{
+    if( player == X_Player )
+        addInstance( box, xColor, X_SHAPE, NULL );
+
+    else
+        addInstance( box, oColor, O_SHAPE, NULL );
+}
+
+/*********************************************************************
+** Description: Adds a string of the atlas to the frame.
+*
+*  Parameters:
+*  1. Text text - the string.
+*  2. SDL_Rect box - where it is drawn, stretched to fit.
+*  3. Uint8 alpha - its opacity.
+*********************************************************************/
+void GlRenderer::addText( Text text, const SDL_Rect &box, Uint8 alpha )
+{
+    SDL_Color color = { 0xFF, 0xFF, 0xFF, alpha };
+
+    addInstance( box, color, TEXT_SHAPE, &textRects[text] );
+}
+
+/*********************************************************************
+** Description: Uploads the quads written this frame that differ from
+*  those already in the instance buffer. Between moves a frame only
+*  changes the fading text, so most frames upload a few quads or none.
+*  The buffer grows, and is then uploaded whole, only when a frame
+*  outgrows it.
+*********************************************************************/
+void GlRenderer::upload()
+{
+    int count = getInstanceCount();
+
+    glBindBuffer( GL_ARRAY_BUFFER, instanceBuffer );
+
+    if( count > capacity )
+    {
+        while( capacity < count )
+        {
+            capacity *= 2;
+        }
+
+        glBufferData( GL_ARRAY_BUFFER, capacity * sizeof( Instance ), NULL, GL_DYNAMIC_DRAW );
+        uploaded.clear();
+        written.clear();
+
+        Run whole = { 0, count };
+        written.push_back( whole );
+    }
+
+    for( unsigned r = 0; r < written.size(); r++ )
+    {
+        int same = static_cast<int>( uploaded.size() ),
+            first = written[r].first,
+            last = written[r].last;
+
+        //Trim the quads at either end that are already uploaded.
+        while( first < last && first < same && memcmp( &instances[first], &uploaded[first], sizeof( Instance ) ) == 0 )
+        {
+            first++;
+        }
+
+        while( last > first && last <= same && memcmp( &instances[last - 1], &uploaded[last - 1], sizeof( Instance ) ) == 0 )
+        {
+            last--;
+        }
+
+        if( first == last )
+        {
+            continue;
+        }
+
+        glBufferSubData( GL_ARRAY_BUFFER, first * sizeof( Instance ), ( last - first ) * sizeof( Instance ),
+                         &instances[first] );
+
+        if( same < last )
+        {
+            uploaded.resize( last );
+        }
+
+        memcpy( &uploaded[first], &instances[first], ( last - first ) * sizeof( Instance ) );
+        uploadedBytes += ( last - first ) * sizeof( Instance );
+    }
+
+    written.clear();
+}
+
+/*********************************************************************
+** Description: Clears the screen to white and draws every quad of the
+*  frame with one call.
+*********************************************************************/
+void GlRenderer::draw()
+{
+    upload();
+
+    glViewport( 0, 0, screenWidth, screenHeight );
+    glClearColor( 1.0f, 1.0f, 1.0f, 1.0f );
+    glClear( GL_COLOR_BUFFER_BIT );
+
+    glUseProgram( program );
+    glUniform1f( scrollLocation, static_cast<float>( scroll ) );
+    glBindVertexArray( vertexArray );
+    glActiveTexture( GL_TEXTURE0 );
+    glBindTexture( GL_TEXTURE_2D, atlas );
+    glDrawArraysInstanced( GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>( instances.size() ) );
+}
+
+/*********************************************************************
+** Description: Waits for the frame to be drawn. Used instead of a
+*  buffer swap when rendering offscreen.
+*********************************************************************/
+void GlRenderer::finish()
+{
+    glFinish();
+}
+
+/*********************************************************************
+** Description: Reads the drawn frame, top row first.
+*
+*  Parameters: SDL_Surface* frame - receives the pixels, in
+*  SDL_PIXELFORMAT_ARGB8888 and the size of the screen.
+*
+*  Return: bool - indicates whether the frame was read.
+*********************************************************************/
+bool GlRenderer::readPixels( SDL_Surface* frame )
+{
+    glPixelStorei( GL_PACK_ALIGNMENT, 4 );
+
+    //OpenGL rows start at the bottom.
+    for( int y = 0; y < screenHeight; y++ )
+    {
+        glReadPixels( 0, screenHeight - 1 - y, screenWidth, 1, GL_BGRA, GL_UNSIGNED_BYTE,
+                      static_cast<Uint8*>( frame->pixels ) + y * frame->pitch );
+    }
+
+    GLenum error = glGetError();
+
+    if( error != GL_NO_ERROR )
+    {
+        printf( "Unable to read the frame! OpenGL Error: 0x%x\n", error );
+    }
+
+    return error == GL_NO_ERROR;
+}
+
+/*********************************************************************
+** Description: Starts reading the drawn frame into a pixel buffer,
+*  which the GPU fills while the next frames are drawn, and copies out
+*  the frame read PACK_BUFFERS - 1 frames ago, which is finished by
+*  now, so the render thread does not wait for the read. Captured
+*  frames are that many frames behind the screen.
+*
+*  Parameters: Uint8* pixels - receives the pixels of the older frame,
+*              in SDL_PIXELFORMAT_ARGB8888, top row first.
+*              int pitch - bytes from one row of pixels to the next.
+*
+*  Return: bool - false while there is no older frame yet, or if it
+*  could not be read.
+*********************************************************************/
+bool GlRenderer::readPixelsAsync( Uint8* pixels, int pitch )
+{
+    GLsizeiptr size = 4LL * screenWidth * screenHeight;
+
+    if( packBuffers[0] == 0 )
+    {
+        glGenBuffers( PACK_BUFFERS, packBuffers );
+
+        for( int i = 0; i < PACK_BUFFERS; i++ )
+        {
+            glBindBuffer( GL_PIXEL_PACK_BUFFER, packBuffers[i] );
+            glBufferData( GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ );
+        }
+    }
+
+    glPixelStorei( GL_PACK_ALIGNMENT, 4 );
+    glBindBuffer( GL_PIXEL_PACK_BUFFER, packBuffers[packReads % PACK_BUFFERS] );
+    glReadPixels( 0, 0, screenWidth, screenHeight, GL_BGRA, GL_UNSIGNED_BYTE, NULL );
+    packReads++;
+
+    bool read = false;
+
+    //The oldest read is in the buffer the next read goes to.
+    if( packReads >= PACK_BUFFERS )
+    {
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, packBuffers[packReads % PACK_BUFFERS] );
+
+        const Uint8* mapped = static_cast< const Uint8* >( glMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, size,
+                                                                                 GL_MAP_READ_BIT ) );
+
+        if( mapped != NULL )
+        {
+            //OpenGL rows start at the bottom.
+            for( int y = 0; y < screenHeight; y++ )
+            {
+                memcpy( pixels + y * pitch, mapped + ( screenHeight - 1 - y ) * screenWidth * 4, screenWidth * 4 );
+            }
+
+            read = glUnmapBuffer( GL_PIXEL_PACK_BUFFER ) == GL_TRUE;
+        }
+    }
+
+    glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+
+    return read;
+}
+
+/*********************************************************************
+** Description: Frees the OpenGL objects. The context must still be
+*  current.
+*********************************************************************/
+void GlRenderer::cleanUp()
+{
+    if( packBuffers[0] != 0 )
+    {
+        glDeleteBuffers( PACK_BUFFERS, packBuffers );
+
+        for( int i = 0; i < PACK_BUFFERS; i++ )
+        {
+            packBuffers[i] = 0;
+        }
+
+        packReads = 0;
+    }
+
+    if( atlas != 0 )
+    {
+        glDeleteTextures( 1, &atlas );
+        atlas = 0;
+    }
+
+    if( instanceBuffer != 0 )
+    {
+        glDeleteBuffers( 1, &instanceBuffer );
+        instanceBuffer = 0;
+    }
+
+    if( cornerBuffer != 0 )
+    {
+        glDeleteBuffers( 1, &cornerBuffer );
+        cornerBuffer = 0;
+    }
+
+    if( vertexArray != 0 )
+    {
+        glDeleteVertexArrays( 1, &vertexArray );
+        vertexArray = 0;
+    }
+
+    if( program != 0 )
+    {
+        glDeleteProgram( program );
+        program = 0;
+    }
+}
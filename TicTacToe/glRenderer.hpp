@@ -0,0 +1,124 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GlRenderer class draws a frame with OpenGL 3.3 as
+*  one instanced draw call. Everything on the screen is a quad: filled
+*  rectangles, Xs and Os, which the fragment shader draws from signed
+*  distance functions so they stay sharp at any size, and text, cut
+*  from an atlas of the HUD strings. The quads of a frame are kept in
+*  a vertex buffer that lives as long as the renderer, and only the
+*  quads that differ from the last frame are uploaded. A frame can also
+*  keep the last one and rewrite some of its quads in place.
+*********************************************************************/
+#ifndef GL_RENDERER_HPP
+#define GL_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <SDL.h>
+#include "gameBoard.hpp"
+#include "theme.hpp"
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+class GlRenderer
+{
+    public:
+        //The strings in the text atlas.
+        enum Text { X_TURN, O_TURN, X_WIN, O_WIN, DRAW_TEXT, X_POINTS, O_POINTS, PLAY_AGAIN, DIGITS,
+                    TEXT_COUNT = DIGITS + 10 };
+
+    private:
+        //What the fragment shader draws in a quad.
+        enum Shape { RECT_SHAPE, X_SHAPE, O_SHAPE, TEXT_SHAPE };
+
+        /*********************************************************************
+         ** Description: This struct is one quad of the frame, as read by
+         *  the vertex shader once per instance.
+         *********************************************************************/
+        struct Instance
+        {
+            float rect[4]; //x, y, w, h in window pixels.
+            float color[4];
+            float clip[4]; //Atlas corners of text, in texture coordinates.
+            float shape;
+        };
+
+        /*********************************************************************
+         ** Description: This struct is a run of quads written this frame.
+         *********************************************************************/
+        struct Run
+        {
+            int first;
+            int last; //One past the last quad.
+        };
+
+        int screenWidth,
+            screenHeight;
+
+        GLuint program;
+        GLuint vertexArray;
+        GLuint cornerBuffer; //The four corners of a unit quad.
+        GLuint instanceBuffer;
+        GLuint atlas;
+        GLint screenLocation;
+        GLint scrollLocation;
+
+        SDL_Rect textRects[TEXT_COUNT]; //Where each string is in the atlas.
+        int atlasWidth,
+            atlasHeight;
+
+        SDL_Color xColor, //Of the marks, from the theme.
+                  oColor;
+
+        int originX, //Added to everything drawn, like an SDL viewport.
+            originY;
+        int scroll; //Moves the whole frame up, in the shader.
+
+        vector< Instance > instances; //The frame being built.
+        int cursor; //Where the next quad is written.
+        vector< Run > written; //The quads that may differ from the last frame.
+        vector< Instance > uploaded; //What instanceBuffer holds.
+        int capacity; //Instances instanceBuffer has room for.
+        long long uploadedBytes;
+
+        //Pixel buffers frames are read into without waiting for them.
+        static const int PACK_BUFFERS = 3;
+        GLuint packBuffers[PACK_BUFFERS];
+        long long packReads; //Reads started.
+
+        //Private functions.
+        static GLuint compileShader( GLenum, const char* );
+        bool linkProgram();
+        bool loadAtlas( const Theme & );
+        void addInstance( const SDL_Rect &, SDL_Color, Shape, const SDL_Rect* );
+        void upload();
+
+    public:
+        GlRenderer();
+        bool startUp( int, int, const Theme & );
+        bool setTheme( const Theme & );
+        void begin();
+        void seek( int );
+        void setOrigin( int x, int y ) { originX = x; originY = y; };
+        void setScroll( int y ) { scroll = y; };
+        void addRects( const SDL_Rect*, int, SDL_Color );
+        void addMark( Player, const SDL_Rect & );
+        void addText( Text, const SDL_Rect &, Uint8 );
+        void draw();
+        void finish();
+        bool readPixels( SDL_Surface* );
+        bool readPixelsAsync( Uint8*, int );
+        void cleanUp();
+
+        //Getter functions.
+        int getInstanceCount() const { return static_cast<int>( instances.size() ); };
+        long long getUploadedBytes() const { return uploadedBytes; };
+        long long getAtlasBytes() const { return atlas != 0 ? 4LL * atlasWidth * atlasHeight : 0; };
+};
+
+#endif
@@ -0,0 +1,451 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GomokuBoard class is a board of five in a row on up
+*  to 19x19 cells with an evaluation kept up to date move by move. The
+*  board is covered by windows of six cells along every row, column
+*  and diagonal, each held as a base 3 number of its cells, and a
+*  precomputed table scores every window pattern: fives, open fours,
+*  fours, open and broken threes and twos. A move changes only the 24
+*  windows through its cell, so it updates the score instead of
+*  rescanning the board. A second table classifies the threat a move
+*  makes along a line from the nine cells around it.
+*********************************************************************/
+#include "gomokuBoard.hpp"
+
+//Right, down, down right and down left, as column and row steps.
+const int GomokuBoard::DIRECTIONS[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+
+static const int POWERS[10] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561, 19683 };
+
+/*********************************************************************
+** Description: The PatternTables struct holds the two precomputed
+*  tables. Window scores are indexed by the base 3 code of six cells,
+*  0 for empty, 1 for X and 2 for O. Threats are indexed by the code of
+*  the nine cells centered on a move, 0 for empty, 1 for the mover and
+*  2 for the opponent or the edge of the board.
+*********************************************************************/
+struct PatternTables
+{
+    static const int WINDOW_LAST = GomokuBoard::WINDOW - 1;
+
+    int windowScores[729];
+    uint8_t threats[19683];
+
+    /*********************************************************************
+     ** Description: Constructor. Fills both tables.
+     *********************************************************************/
+    PatternTables()
+    {
+        for( int code = 0; code < 729; code++ )
+        {
+            int digits[GomokuBoard::WINDOW];
+
+            for( int i = 0; i < GomokuBoard::WINDOW; i++ )
+            {
+                digits[i] = code / POWERS[i] % 3;
+            }
+
+            windowScores[code] = windowScore( digits, 1 ) - windowScore( digits, 2 );
+        }
+
+        for( int code = 0; code < 19683; code++ )
+        {
+            threats[code] = 0xFF;
+        }
+
+        for( int code = 0; code < 19683; code++ )
+        {
+            if( code / POWERS[GomokuBoard::SPAN] % 3 == 1 )
+            {
+                classify( code );
+            }
+        }
+    }
+
+    /*********************************************************************
+     ** Description: Scores the patterns of one player in a window.
+     *
+     *  Parameters: int* digits - the six cells of the window.
+     *              int own - the player's digit.
+     *
+     *  Return: int - the score of the strongest pattern.
+     *********************************************************************/
+    static int windowScore( const int* digits, int own )
+    {
+        int best = 0;
+
+        //The two windows of five inside the six.
+        for( int start = 0; start <= 1; start++ )
+        {
+            int mine = 0,
+                empty = 0;
+
+            for( int i = start; i < start + 5; i++ )
+            {
+                mine += digits[i] == own;
+                empty += digits[i] == 0;
+            }
+
+            if( mine + empty < 5 )
+                continue;
+
+            if( mine == 5 )
+                return 100000;
+
+            int scores[5] = { 0, 1, 10, 50, 1000 };
+
+            if( scores[mine] > best )
+                best = scores[mine];
+        }
+
+        //Both ends empty: _XXXX_ is an open four, and three marks with
+        //one gap inside are an open or broken three.
+        if( digits[0] == 0 && digits[WINDOW_LAST] == 0 )
+        {
+            int mine = 0,
+                empty = 0;
+
+            for( int i = 1; i < WINDOW_LAST; i++ )
+            {
+                mine += digits[i] == own;
+                empty += digits[i] == 0;
+            }
+
+            if( mine == 4 )
+                best = 10000;
+
+            else if( mine == 3 && empty == 1 && best < 500 )
+                best = 500;
+        }
+
+        return best;
+    }
+
+    /*********************************************************************
+     ** Description: Classifies the threat of the mark in the center of
+     *  nine cells, filling in the table as it goes. A line that one
+     *  more mark turns into a five is a four, or an open four if two
+     *  different cells do it; one that a mark turns into an open four
+     *  is an open three, into a four a three, and into any three a two.
+     *
+     *  Parameters: int code - the nine cells, with the center marked.
+     *
+     *  Return: int - the GomokuBoard::Threat.
+     *********************************************************************/
+    int classify( int code )
+    {
+        if( threats[code] != 0xFF )
+        {
+            return threats[code];
+        }
+
+        const int CENTER = GomokuBoard::SPAN;
+        int digits[9];
+
+        for( int i = 0; i < 9; i++ )
+        {
+            digits[i] = code / POWERS[i] % 3;
+        }
+
+        int run = 1;
+
+        for( int i = CENTER - 1; i >= 0 && digits[i] == 1; i-- )
+            run++;
+
+        for( int i = CENTER + 1; i < 9 && digits[i] == 1; i++ )
+            run++;
+
+        int threat = GomokuBoard::NO_THREAT;
+
+        if( run >= 5 )
+        {
+            threat = GomokuBoard::FIVE;
+        }
+
+        else
+        {
+            int fives = 0,
+                strongest = GomokuBoard::NO_THREAT;
+
+            for( int i = 0; i < 9; i++ )
+            {
+                if( digits[i] != 0 )
+                {
+                    continue;
+                }
+
+                int next = classify( code + POWERS[i] );
+
+                if( next == GomokuBoard::FIVE )
+                    fives++;
+
+                else if( next > strongest )
+                    strongest = next;
+            }
+
+            if( fives >= 2 )
+                threat = GomokuBoard::OPEN_FOUR;
+
+            else if( fives == 1 )
+                threat = GomokuBoard::FOUR;
+
+            else if( strongest == GomokuBoard::OPEN_FOUR )
+                threat = GomokuBoard::OPEN_THREE;
+
+            else if( strongest == GomokuBoard::FOUR )
+                threat = GomokuBoard::THREE;
+
+            else if( strongest >= GomokuBoard::THREE )
+                threat = GomokuBoard::TWO;
+        }
+
+        threats[code] = static_cast<uint8_t>( threat );
+
+        return threat;
+    }
+};
+
+static const PatternTables TABLES;
+
+/*********************************************************************
+** Description: Constructor. Starts with an empty board.
+*
+*  Parameters: int size - the board is size by size cells, at most
+*              MAX_SIZE.
+*              Player toMove - the player who makes the first move.
+*********************************************************************/
+GomokuBoard::GomokuBoard( int size, Player toMove )
+{
+    this->size = size;
+    this->toMove = toMove;
+    outcome = UNFINISHED;
+    score = 0;
+    stones = 0;
+
+    for( int cell = 0; cell < MAX_CELLS; cell++ )
+    {
+        cells[cell] = 0;
+
+        for( int d = 0; d < 4; d++ )
+        {
+            windows[d][cell] = 0;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Changes a cell and updates the windows through it and
+*  the score. The windows of a direction through a cell start up to
+*  five cells back along the direction.
+*
+*  Parameters: int cell - the cell, row * size + column.
+*              int change - the digit to add: 1 or 2 to place X or O,
+*              -1 or -2 to take them away.
+*********************************************************************/
+void GomokuBoard::place( int cell, int change )
+{
+    int x = cell % size,
+        y = cell / size;
+
+    for( int d = 0; d < 4; d++ )
+    {
+        int dx = DIRECTIONS[d][0],
+            dy = DIRECTIONS[d][1];
+
+        for( int offset = 0; offset < WINDOW; offset++ )
+        {
+            int startX = x - offset * dx,
+                startY = y - offset * dy,
+                endX = startX + ( WINDOW - 1 ) * dx,
+                endY = startY + ( WINDOW - 1 ) * dy;
+
+            if( startX < 0 || startX >= size || startY < 0 || endX < 0 || endX >= size || endY >= size )
+            {
+                continue;
+            }
+
+            uint16_t &window = windows[d][startY * size + startX];
+
+            score -= TABLES.windowScores[window];
+            window = static_cast<uint16_t>( window + change * POWERS[offset] );
+            score += TABLES.windowScores[window];
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Makes a move for the player to move.
+*
+*  Parameters: int cell - the cell, row * size + column.
+*
+*  Return: bool - false if the game is over or the cell is taken.
+*********************************************************************/
+bool GomokuBoard::play( int cell )
+{
+    if( outcome != UNFINISHED || cell < 0 || cell >= getCells() || cells[cell] != 0 )
+    {
+        return false;
+    }
+
+    if( getBestThreat( cell, toMove ) == FIVE )
+        outcome = toMove == X_Player ? X_WON : O_WON;
+
+    else if( stones + 1 == getCells() )
+        outcome = DRAW;
+
+    cells[cell] = static_cast<uint8_t>( toMove + 1 );
+    place( cell, toMove + 1 );
+    stones++;
+    toMove = GameBoard::other( toMove );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Takes back the last move, which was made in a cell.
+*
+*  Parameters: int cell - the cell of the last move.
+*********************************************************************/
+void GomokuBoard::undo( int cell )
+{
+    toMove = GameBoard::other( toMove );
+    place( cell, -( toMove + 1 ) );
+    cells[cell] = 0;
+    stones--;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Lists the legal moves.
+*
+*  Parameters: int* moves - receives up to MAX_MOVES cells.
+*
+*  Return: int - the number of legal moves.
+*********************************************************************/
+int GomokuBoard::getMoves( int* moves ) const
+{
+    int count = 0;
+
+    for( int cell = 0; cell < getCells() && outcome == UNFINISHED; cell++ )
+    {
+        if( cells[cell] == 0 )
+        {
+            moves[count++] = cell;
+        }
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Classifies the threat a player would make along one
+*  line by marking a cell.
+*
+*  Parameters:
+*  1. int cell - an empty cell.
+*  2. Player player - the player marking it.
+*  3. int direction - an index into DIRECTIONS.
+*
+*  Return: Threat - the threat along that line.
+*********************************************************************/
+GomokuBoard::Threat GomokuBoard::getThreat( int cell, Player player, int direction ) const
+{
+    int x = cell % size,
+        y = cell / size,
+        dx = DIRECTIONS[direction][0],
+        dy = DIRECTIONS[direction][1];
+    int own = player + 1,
+        code = POWERS[SPAN];
+
+    for( int i = -SPAN; i <= SPAN; i++ )
+    {
+        if( i == 0 )
+        {
+            continue;
+        }
+
+        int cx = x + i * dx,
+            cy = y + i * dy;
+        int digit = 2;
+
+        if( cx >= 0 && cx < size && cy >= 0 && cy < size )
+        {
+            int pick = cells[cy * size + cx];
+            digit = pick == 0 ? 0 : pick == own ? 1 : 2;
+        }
+
+        code += digit * POWERS[i + SPAN];
+    }
+
+    return static_cast<Threat>( TABLES.threats[code] );
+}
+
+/*********************************************************************
+** Description: Returns the strongest threat a player would make by
+*  marking a cell.
+*
+*  Parameters: int cell - an empty cell.
+*              Player player - the player marking it.
+*
+*  Return: Threat - the strongest threat over the four lines.
+*********************************************************************/
+GomokuBoard::Threat GomokuBoard::getBestThreat( int cell, Player player ) const
+{
+    Threat best = NO_THREAT;
+
+    for( int d = 0; d < 4 && best != FIVE; d++ )
+    {
+        Threat threat = getThreat( cell, player, d );
+
+        if( threat > best )
+        {
+            best = threat;
+        }
+    }
+
+    return best;
+}
+
+/*********************************************************************
+** Description: Scores the board from scratch by reading every window.
+*  Gives the same result as getScore(), which is kept up to date move
+*  by move.
+*
+*  Return: int - the score for the player to move.
+*********************************************************************/
+int GomokuBoard::evaluate() const
+{
+    int total = 0;
+
+    for( int d = 0; d < 4; d++ )
+    {
+        int dx = DIRECTIONS[d][0],
+            dy = DIRECTIONS[d][1];
+
+        for( int start = 0; start < getCells(); start++ )
+        {
+            int x = start % size,
+                y = start / size,
+                endX = x + ( WINDOW - 1 ) * dx,
+                endY = y + ( WINDOW - 1 ) * dy;
+
+            if( endX < 0 || endX >= size || endY >= size )
+            {
+                continue;
+            }
+
+            int code = 0;
+
+            for( int i = 0; i < WINDOW; i++ )
+            {
+                code += cells[( y + i * dy ) * size + x + i * dx] * POWERS[i];
+            }
+
+            total += TABLES.windowScores[code];
+        }
+    }
+
+    return toMove == X_Player ? total : -total;
+}
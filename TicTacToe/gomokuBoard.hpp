@@ -0,0 +1,64 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The GomokuBoard class is a board of five in a row on up
+*  to 19x19 cells with an evaluation kept up to date move by move. The
+*  board is covered by windows of six cells along every row, column
+*  and diagonal, each held as a base 3 number of its cells, and a
+*  precomputed table scores every window pattern: fives, open fours,
+*  fours, open and broken threes and twos. A move changes only the 24
+*  windows through its cell, so it updates the score instead of
+*  rescanning the board. A second table classifies the threat a move
+*  makes along a line from the nine cells around it.
+*********************************************************************/
+#ifndef GOMOKU_BOARD_HPP
+#define GOMOKU_BOARD_HPP
+
+#include "gameBoard.hpp"
+
+class GomokuBoard
+{
+    public:
+        static const int MAX_SIZE = 19;
+        static const int MAX_CELLS = MAX_SIZE * MAX_SIZE;
+        static const int MAX_MOVES = MAX_CELLS;
+        static const int WINDOW = 6; //Cells in an evaluation window.
+        static const int SPAN = 4; //Cells on each side of a move that its threat depends on.
+
+        //Threats a move makes along one line, weakest first.
+        enum Threat { NO_THREAT, TWO, THREE, OPEN_THREE, FOUR, OPEN_FOUR, FIVE };
+
+    private:
+        int size;
+        uint8_t cells[MAX_CELLS]; //0 when empty, else the player plus 1.
+        uint16_t windows[4][MAX_CELLS]; //Base 3 code of the window starting at each cell.
+        int score; //Window scores for X minus those for O.
+        int stones;
+        Player toMove;
+        Outcome outcome;
+
+        void place( int, int );
+
+    public:
+        GomokuBoard( int size = 15, Player toMove = X_Player );
+        bool play( int );
+        void undo( int );
+        int getMoves( int* ) const;
+        Threat getThreat( int, Player, int ) const;
+        Threat getBestThreat( int, Player ) const;
+        int evaluate() const;
+
+        //Getter functions.
+        int getSize() const { return size; };
+        int getCells() const { return size * size; };
+        int getStones() const { return stones; };
+        Player getPick( int cell ) const { return cells[cell] == 0 ? No_Player : static_cast<Player>( cells[cell] - 1 ); };
+        int getScore() const { return toMove == X_Player ? score : -score; };
+        Player getToMove() const { return toMove; };
+        Outcome getOutcome() const { return outcome; };
+
+        static const int DIRECTIONS[4][2];
+};
+
+#endif
@@ -6,6 +6,8 @@
 *  the graphic related components of the Tic Tac Toe game.  
 *********************************************************************/
 #include "graphicsHandler.hpp"
+#include <cstdlib>
+#include <algorithm>
 
 /*********************************************************************
 ** Description: Constructor.
@@ -13,12 +15,20 @@
 * Parameters: 
 * 1. int screenWidth - the window screen width in pixels.
 * 2. int screenHeight - the window screen height in pixels.
+* 3. bool offscreen - render into memory instead of a window.
 *********************************************************************/
-GraphicsHandler::GraphicsHandler( int screenWidth, int screenHeight ) :
+GraphicsHandler::GraphicsHandler( int screenWidth, int screenHeight, bool offscreen ) :
 SCREEN_WIDTH ( screenWidth ), SCREEN_HEIGHT ( screenHeight )
 {
 	mainWindow = NULL;
 	mainRenderer = NULL;
+    offscreenSurface = NULL;
+    this->offscreen = offscreen;
+    glContext = NULL;
+    useOpenGl = false;
+    fastStartup = true;
+    capture = NULL;
+    theme = &ticTacToeTextures.getTheme();
     highlightOpacity = 0;
 
     
@@ -47,235 +57,1444 @@ SCREEN_WIDTH ( screenWidth ), SCREEN_HEIGHT ( screenHeight )
     XPLoc = { 125, 400, 15, 20 };
     OPLoc = { 125, 425, 15, 20 };
 
-    //Used for controlling point increments.
-    incremented = false;
-    
     fontOpacity = 0;
+
+    //Two lines across and two down inside each board of the grid.
+    for( int board = 0; board < GameBoard::CELLS; board++ )
+    {
+        SDL_Rect area = cellRect( board );
+
+        for( int i = 0; i < 2; i++ )
+        {
+            ultimateLines[board * 4 + i] = { area.x + 49 + i * 50, area.y + 6, 2, 138 };
+            ultimateLines[board * 4 + 2 + i] = { area.x + 6, area.y + 49 + i * 50, 138, 2 };
+        }
+    }
+
+    //Qubic shows the four layers of the cube side by side, each a 4x4
+    //grid of 58 pixel cells with three lines across and three down.
+    for( int layer = 0; layer < QubicPosition::SIZE; layer++ )
+    {
+        qubicSlices[layer] = { ( layer % 2 ) * 248, ( layer / 2 ) * 248, 232, 232 };
+
+        for( int i = 0; i < 3; i++ )
+        {
+            qubicLines[layer * 6 + i] = { qubicSlices[layer].x + 57 + i * 58, qubicSlices[layer].y + 4, 2, 224 };
+            qubicLines[layer * 6 + 3 + i] = { qubicSlices[layer].x + 4, qubicSlices[layer].y + 57 + i * 58, 224, 2 };
+        }
+    }
+
+    marksTexture = NULL;
+    drawnMode = CLASSIC_MODE;
+    marksTextureValid = false;
+
+    wallBoardSize = 48;
+    wallScroll = 0;
+    wallTexture = NULL;
+    wallValid = false;
+}
+
+/*********************************************************************
+** Description: Destructor. 
+*********************************************************************/
+GraphicsHandler::~GraphicsHandler()
+{
+    //empty.
+}
+
+/*********************************************************************
+** Description: This function initializes SDL and graphics setup for
+* the program.
+*
+* Return: bool - indicates whether the operations were successful.
+*********************************************************************/
+bool GraphicsHandler::initiateSDL()
+{
+    bool initSuccess = true;
+
+    //The game draws and reads input, nothing more. Starting audio,
+    //joysticks, haptics and game controllers as well costs startup time
+    //for devices that are never used; a part of the game that needs one
+    //starts it with SDL_InitSubSystem() on first use. Offscreen software
+    //rendering needs no display, only the event queue, and offscreen
+    //OpenGL still needs a hidden window.
+    Uint32 subsystems = SDL_INIT_VIDEO | SDL_INIT_EVENTS;
+
+    if( offscreen )
+    {
+        subsystems = useOpenGl ? SDL_INIT_VIDEO : SDL_INIT_EVENTS;
+    }
+
+    if( !fastStartup )
+    {
+        subsystems |= SDL_INIT_EVERYTHING & ~SDL_INIT_VIDEO;
+    }
+
+    //Initiates SDL.
+    if( SDL_Init( subsystems ) < 0 )
+    {
+        printf( "SDL did not successfully initialize! SDL ERROR: %s\n", SDL_GetError() );
+        initSuccess = false;
+    }
+
+    else
+    {
+        //Set texture filtering to linear.
+        if( !SDL_SetHint( SDL_HINT_RENDER_SCALE_QUALITY, "1" ) )
+        {
+            printf( "WARNING: Linear texture filtering was not enabled!" );
+        }
+
+        StartupProfiler::mark( "SDL_Init" );
+
+        if( useOpenGl && createGlContext() )
+        {
+            initSuccess = true;
+        }
+
+        else if( offscreen )
+        {
+            initSuccess = createOffscreenRenderer();
+        }
+
+        else
+        {
+            initSuccess = createWindowRenderer();
+        }
+
+        if( initSuccess && mainRenderer != NULL )
+        {
+            //Initialize renderer color set to white.
+            SDL_SetRenderDrawColor( mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+        }
+
+        StartupProfiler::mark( mainRenderer != NULL ? "create renderer" : "create OpenGL context" );
+
+        if( initSuccess )
+        {
+            //Initialize PNG loading. SDL_image also does this itself when
+            //the first PNG is loaded, so it is left to the first mark.
+            int imgFlags = IMG_INIT_PNG;
+
+            if( !fastStartup && !( IMG_Init( imgFlags ) & imgFlags ) )
+            {
+                printf( "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError() );
+                initSuccess = false;
+            }
+
+            //Initialize SDL_ttf true type font.
+            if( TTF_Init() == -1 )
+            {
+                printf( "SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError() );
+                initSuccess = false;
+            }
+
+            StartupProfiler::mark( "IMG_Init and TTF_Init" );
+        }
+    }
+
+    return initSuccess;
+}
+
+/*********************************************************************
+** Description: This function creates the visible window and its
+* renderer. The software renderer is used as a fallback.
+*
+* Return: bool - indicates whether the operations were successful.
+*********************************************************************/
+bool GraphicsHandler::createWindowRenderer()
+{
+    bool createSuccess = true;
+
+    mainWindow = SDL_CreateWindow( "Tic Tac Toe", SDL_WINDOWPOS_UNDEFINED, 
+                                   SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, 
+                                   SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
+
+    if( mainWindow == NULL )
+    {
+        printf( "Window could not be created! SDL Error: %s\n", SDL_GetError() );
+        createSuccess = false;
+    }
+
+    else
+    {
+        //Create renderer for window and uses software rendering as a fallback.
+        mainRenderer = SDL_CreateRenderer( mainWindow, -1, SDL_RENDERER_PRESENTVSYNC 
+                       | SDL_RENDERER_ACCELERATED );
+
+        if( mainRenderer == NULL )
+        {
+            printf( "Accelerated Renderer could not be created! SDL Error: %s\n", SDL_GetError() );
+            printf( "Attempting to use Software Renderer...\n" );
+
+            mainRenderer = SDL_CreateRenderer( mainWindow, -1, 
+                           SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_SOFTWARE );
+
+            if( mainRenderer == NULL )
+            {
+                printf( "Software Renderer could not be created! SDL Error: %s\n", SDL_GetError() );
+                createSuccess = false;
+            }
+        }
+    }
+
+    return createSuccess;
+}
+
+/*********************************************************************
+** Description: This function creates a software renderer that draws
+* into a surface in memory instead of a window. There is no vsync, so
+* frames render as fast as the CPU allows.
+*
+* Return: bool - indicates whether the operations were successful.
+*********************************************************************/
+bool GraphicsHandler::createOffscreenRenderer()
+{
+    bool createSuccess = true;
+
+    offscreenSurface = SDL_CreateRGBSurfaceWithFormat( 0, SCREEN_WIDTH, SCREEN_HEIGHT, 
+                                                       32, SDL_PIXELFORMAT_ARGB8888 );
+
+    if( offscreenSurface == NULL )
+    {
+        printf( "Offscreen surface could not be created! SDL Error: %s\n", SDL_GetError() );
+        createSuccess = false;
+    }
+
+    else
+    {
+        mainRenderer = SDL_CreateSoftwareRenderer( offscreenSurface );
+
+        if( mainRenderer == NULL )
+        {
+            printf( "Offscreen Renderer could not be created! SDL Error: %s\n", SDL_GetError() );
+            createSuccess = false;
+        }
+    }
+
+    return createSuccess;
+}
+
+/*********************************************************************
+** Description: This function creates a window with an OpenGL 3.3 core
+* context for the OpenGL renderer. The window stays hidden offscreen,
+* where frames are read back instead of shown. On failure the window
+* is destroyed again so the SDL renderer can take over.
+*
+* Return: bool - indicates whether the context was created.
+*********************************************************************/
+bool GraphicsHandler::createGlContext()
+{
+    SDL_GL_SetAttribute( SDL_GL_CONTEXT_MAJOR_VERSION, 3 );
+    SDL_GL_SetAttribute( SDL_GL_CONTEXT_MINOR_VERSION, 3 );
+    SDL_GL_SetAttribute( SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE );
+    SDL_GL_SetAttribute( SDL_GL_DOUBLEBUFFER, 1 );
+
+    mainWindow = SDL_CreateWindow( "Tic Tac Toe", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                   SCREEN_WIDTH, SCREEN_HEIGHT, 
+                                   SDL_WINDOW_OPENGL | ( offscreen ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN ) );
+
+    if( mainWindow == NULL )
+    {
+        printf( "OpenGL window could not be created! SDL Error: %s\n", SDL_GetError() );
+    }
+
+    else
+    {
+        glContext = SDL_GL_CreateContext( mainWindow );
+
+        if( glContext == NULL )
+        {
+            printf( "OpenGL 3.3 context could not be created! SDL Error: %s\n", SDL_GetError() );
+            destroyGlContext();
+        }
+
+        //Wait for vsync on screen, like the SDL renderer.
+        else if( SDL_GL_SetSwapInterval( offscreen ? 0 : 1 ) != 0 )
+        {
+            printf( "WARNING: OpenGL vsync could not be set! SDL Error: %s\n", SDL_GetError() );
+        }
+    }
+
+    if( glContext == NULL )
+    {
+        printf( "Using the SDL renderer instead of OpenGL.\n" );
+    }
+
+    return glContext != NULL;
+}
+
+/*********************************************************************
+** Description: This function frees the OpenGL renderer, its context
+* and the window the context belongs to.
+*********************************************************************/
+void GraphicsHandler::destroyGlContext()
+{
+    if( glContext != NULL )
+    {
+        glRenderer.cleanUp();
+        SDL_GL_DeleteContext( glContext );
+        glContext = NULL;
+    }
+
+    if( mainWindow != NULL )
+    {
+        SDL_DestroyWindow( mainWindow );
+        mainWindow = NULL;
+    }
+}
+
+/*********************************************************************
+** Description: This function reads the last rendered frame into a new
+* surface. Meant for the offscreen renderers, whose frame is still
+* intact after drawGame().
+*
+* Return: SDL_Surface* - the frame, or NULL on failure. The caller
+* frees it.
+*********************************************************************/
+SDL_Surface* GraphicsHandler::readFrame()
+{
+    SDL_Surface* frame = SDL_CreateRGBSurfaceWithFormat( 0, SCREEN_WIDTH, SCREEN_HEIGHT, 
+                                                         32, SDL_PIXELFORMAT_ARGB8888 );
+
+    if( frame == NULL )
+    {
+        printf( "Frame surface could not be created! SDL Error: %s\n", SDL_GetError() );
+    }
+
+    else if( glContext != NULL )
+    {
+        if( !glRenderer.readPixels( frame ) )
+        {
+            SDL_FreeSurface( frame );
+            frame = NULL;
+        }
+    }
+
+    else
+    {
+        //Read the whole screen, not the HUD viewport drawn last.
+        SDL_RenderSetViewport( mainRenderer, NULL );
+
+        if( SDL_RenderReadPixels( mainRenderer, NULL, SDL_PIXELFORMAT_ARGB8888, 
+                                  frame->pixels, frame->pitch ) != 0 )
+        {
+            printf( "Unable to read the frame! SDL Error: %s\n", SDL_GetError() );
+            SDL_FreeSurface( frame );
+            frame = NULL;
+        }
+    }
+
+    return frame;
+}
+
+/*********************************************************************
+** Description: This function saves the last rendered frame as a PNG.
+*
+* Parameters: string path - the PNG file to write.
+*
+* Return: bool - indicates whether the frame was saved.
+*********************************************************************/
+bool GraphicsHandler::saveFrame( const string &path )
+{
+    bool saved = false;
+
+    SDL_Surface* frame = readFrame();
+
+    if( frame != NULL )
+    {
+        if( IMG_SavePNG( frame, path.c_str() ) != 0 )
+        {
+            printf( "Unable to save %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError() );
+        }
+
+        else
+        {
+            saved = true;
+        }
+
+        SDL_FreeSurface( frame );
+    }
+
+    return saved;
+}
+
+/*********************************************************************
+** Description: This function compares the last rendered frame with a
+* golden PNG image.
+*
+* Parameters:
+* 1. string path - the golden PNG image.
+* 2. int tolerance - the largest per channel difference that still
+*    counts as a match.
+*
+* Return: int - the number of pixels that differ, or -1 if the images
+* could not be compared.
+*********************************************************************/
+int GraphicsHandler::compareFrame( const string &path, int tolerance )
+{
+    int mismatches = -1;
+
+    SDL_Surface* frame = readFrame();
+    SDL_Surface* loaded = IMG_Load( path.c_str() );
+    SDL_Surface* golden = NULL;
+
+    if( loaded == NULL )
+    {
+        printf( "Unable to load %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError() );
+    }
+
+    else
+    {
+        golden = SDL_ConvertSurfaceFormat( loaded, SDL_PIXELFORMAT_ARGB8888, 0 );
+        SDL_FreeSurface( loaded );
+    }
+
+    if( frame != NULL && golden != NULL && golden->w == frame->w && golden->h == frame->h )
+    {
+        mismatches = 0;
+
+        for( int y = 0; y < frame->h; y++ )
+        {
+            const Uint8* framePixel = static_cast<const Uint8*>( frame->pixels ) + y * frame->pitch;
+            const Uint8* goldenPixel = static_cast<const Uint8*>( golden->pixels ) + y * golden->pitch;
+
+            for( int x = 0; x < frame->w; x++ )
+            {
+                for( int c = 0; c < 4; c++ )
+                {
+                    if( abs( framePixel[c] - goldenPixel[c] ) > tolerance )
+                    {
+                        mismatches++;
+                        break;
+                    }
+                }
+
+                framePixel += 4;
+                goldenPixel += 4;
+            }
+        }
+    }
+
+    if( frame != NULL )
+        SDL_FreeSurface( frame );
+
+    if( golden != NULL )
+        SDL_FreeSurface( golden );
+
+    return mismatches;
 }
 
-/*********************************************************************
-** Description: Destructor. 
-*********************************************************************/
-GraphicsHandler::~GraphicsHandler()
-{
-    //empty.
+/*********************************************************************
+** Description: This function allows SDL to initiate outside of the
+*  class. It also loads media.
+*
+*  Return: bool - indicates if the initiation process was successful.
+*********************************************************************/
+bool GraphicsHandler::startUp()
+{
+    bool success = true;
+
+    //Initiates SDL and all related functions.
+    if( !initiateSDL() )
+    {
+        printf( "Program failed to initialize!\n" );
+        success = false;
+    }
+
+    else if( glContext != NULL && !glRenderer.startUp( SCREEN_WIDTH, SCREEN_HEIGHT, *theme ) )
+    {
+        printf( "OpenGL renderer could not start! Using the SDL renderer instead.\n" );
+        destroyGlContext();
+
+        success = offscreen ? createOffscreenRenderer() : createWindowRenderer();
+    }
+
+    if( glContext != NULL )
+    {
+        StartupProfiler::mark( "GlRenderer::startUp" );
+    }
+
+    //The OpenGL renderer makes its own text atlas and draws the marks
+    //itself, so the textures are only loaded for the SDL renderer.
+    if( !success || glContext != NULL )
+    {
+        return success;
+    }
+
+    //Loads media.
+    if( !ticTacToeTextures.loadMedia( mainRenderer, !fastStartup ) )
+    {
+        printf( "Failed to load media!\n" );
+        success = false;
+    }
+
+    else
+    {
+        //Retrieve the X and O sprite clippings.
+        X = ticTacToeTextures.getRectX();
+        O = ticTacToeTextures.getRectO();
+
+        //Allows alpha blending.
+        SDL_SetRenderDrawBlendMode( mainRenderer, SDL_BLENDMODE_BLEND ); 
+
+        //Without render targets the marks are drawn every frame instead.
+        marksTexture = SDL_CreateTexture( mainRenderer, SDL_PIXELFORMAT_ARGB8888, 
+                                          SDL_TEXTUREACCESS_TARGET, fillRectangle.w, fillRectangle.h );
+
+        if( marksTexture == NULL )
+        {
+            printf( "WARNING: Render targets are not supported! SDL Error: %s\n", SDL_GetError() );
+        }
+
+        else
+        {
+            SDL_SetTextureBlendMode( marksTexture, SDL_BLENDMODE_BLEND );
+        }
+    }
+
+    StartupProfiler::mark( "loadMedia" );
+
+    return success;
+}
+
+/*********************************************************************
+** Description: This function clears the color on the screen to white.
+*********************************************************************/
+void GraphicsHandler::clearScreen()
+{
+    //The OpenGL renderer clears when the frame is drawn.
+    if( glContext != NULL )
+    {
+        glRenderer.begin();
+        return;
+    }
+
+    SDL_SetRenderDrawColor ( mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF ); 
+    SDL_RenderClear( mainRenderer );
+}
+
+/*********************************************************************
+** Description: This function switches to another theme. The textures
+*  of the new theme are made as the next frames draw them, and the
+*  render targets are drawn again in its colors. Can be called before
+*  startUp().
+*
+*  Parameters: Theme newTheme - the theme, one of THEMES.
+*
+*  Return: bool - indicates whether the theme could be loaded. When
+*  the OpenGL renderer cannot load it the old theme is kept.
+*********************************************************************/
+bool GraphicsHandler::setTheme( const Theme &newTheme )
+{
+    if( glContext != NULL && !glRenderer.setTheme( newTheme ) )
+    {
+        return false;
+    }
+
+    theme = &newTheme;
+    resetRenderTargets();
+
+    return ticTacToeTextures.setTheme( newTheme );
+}
+
+/*********************************************************************
+** Description: This function returns how much memory the textures take
+*  now: the cached images and text, the render targets and the text
+*  atlas of the OpenGL renderer, at four bytes a pixel.
+*
+*  Return: long long - the memory in bytes.
+*********************************************************************/
+long long GraphicsHandler::getTextureBytes() const
+{
+    long long bytes = ticTacToeTextures.getCache().getBytes() + glRenderer.getAtlasBytes();
+    SDL_Texture* targets[2] = { marksTexture, wallTexture };
+
+    for( int i = 0; i < 2; i++ )
+    {
+        int width = 0,
+            height = 0;
+
+        if( targets[i] != NULL && SDL_QueryTexture( targets[i], NULL, NULL, &width, &height ) == 0 )
+        {
+            bytes += 4LL * width * height;
+        }
+    }
+
+    return bytes;
+}
+
+/*********************************************************************
+** Description: This function draws the Tic Tac Toe board. 
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*              Heatmap* heatmap - the analysis to shade the empty cells
+*              with, or NULL.
+*********************************************************************/
+void GraphicsHandler::drawGame( const GameSnapshot &snapshot, const Heatmap* heatmap )
+{
+    PROFILE_SCOPE( "drawGame" );
+
+    clearScreen();
+    drawBoard( snapshot );
+
+    if( snapshot.mode == ULTIMATE_MODE )
+        drawUltimate( snapshot );
+
+    else if( snapshot.mode == QUBIC_MODE )
+        drawQubic( snapshot );
+
+    else if( snapshot.mode == MNK_MODE )
+        drawMnk( snapshot );
+
+    else
+        drawMarks( snapshot );
+
+    if( heatmap != NULL )
+        drawAnalysis( snapshot, *heatmap );
+
+    drawHud( snapshot );
+    present();
+}
+
+/*********************************************************************
+** Description: This function copies the frame that was drawn into the
+*  frame capture, before it is shown, while the renderer still holds
+*  it. OpenGL frames are read into pixel buffers and copied out a few
+*  frames later, when they are ready; the SDL renderer has no such
+*  read, and its frames are copied at once. A frame the capture has no
+*  free buffer for is not read at all.
+*********************************************************************/
+void GraphicsHandler::captureFrame()
+{
+    if( capture == NULL || !capture->isRunning() )
+    {
+        return;
+    }
+
+    PROFILE_SCOPE( "captureFrame" );
+
+    Uint8* pixels = capture->acquire();
+
+    if( pixels == NULL )
+    {
+        return;
+    }
+
+    bool read;
+
+    if( glContext != NULL )
+        read = glRenderer.readPixelsAsync( pixels, capture->getPitch() );
+
+    else
+    {
+        //Read the whole screen, not the HUD viewport drawn last.
+        SDL_RenderSetViewport( mainRenderer, NULL );
+        read = SDL_RenderReadPixels( mainRenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, capture->getPitch() ) == 0;
+    }
+
+    capture->commit( read );
+}
+
+/*********************************************************************
+** Description: This function shows the frame that was drawn, in the
+*  window or, offscreen, where readFrame() finds it.
+*********************************************************************/
+void GraphicsHandler::present()
+{
+    if( glContext != NULL )
+    {
+        PROFILE_SCOPE( "GlRenderer::draw" );
+        glRenderer.draw();
+
+        //Offscreen frames are read back, so they have to be finished.
+        if( offscreen )
+            glRenderer.finish();
+
+        captureFrame();
+
+        if( !offscreen )
+            SDL_GL_SwapWindow( mainWindow );
+    }
+
+    else
+    {
+        captureFrame();
+
+        PROFILE_SCOPE( "SDL_RenderPresent" );
+        SDL_RenderPresent( mainRenderer ); //Update the rendering screen.
+    }
+}
+
+/*********************************************************************
+** Description: This function draws the spectator wall: every game as
+*  a small board, in rows filling the width of the window, scrolled by
+*  scrollWall(). The first frame draws every board. After that a frame
+*  draws only the boards whose version changed since the last one, into
+*  the wall texture, or over their own quads on OpenGL, and the rest of
+*  the frame is reused.
+*
+*  Parameters: WallSnapshot wall - the games to show.
+*********************************************************************/
+void GraphicsHandler::drawWall( const WallSnapshot &wall )
+{
+    PROFILE_SCOPE( "drawWall" );
+
+    int count = wall.getCount(),
+        pitch = wallBoardSize + WALL_GAP,
+        columns = SCREEN_WIDTH / pitch > 0 ? SCREEN_WIDTH / pitch : 1,
+        height = ( count + columns - 1 ) / columns * pitch + WALL_GAP;
+
+    //Keep the scroll inside the wall.
+    if( wallScroll > height - SCREEN_HEIGHT )
+        wallScroll = height - SCREEN_HEIGHT;
+
+    if( wallScroll < 0 )
+        wallScroll = 0;
+
+    bool full = !wallValid || static_cast<int>( drawnVersions.size() ) != count;
+
+    if( full && glContext == NULL )
+    {
+        if( wallTexture != NULL )
+        {
+            SDL_DestroyTexture( wallTexture );
+        }
+
+        //Without render targets the visible boards are drawn every frame.
+        wallTexture = SDL_CreateTexture( mainRenderer, SDL_PIXELFORMAT_ARGB8888, 
+                                         SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH, height );
+
+        if( wallTexture == NULL )
+        {
+            printf( "WARNING: Could not create the wall texture! SDL Error: %s\n", SDL_GetError() );
+        }
+    }
+
+    if( full )
+    {
+        drawnVersions.assign( count, 0 );
+        wallValid = true;
+    }
+
+    if( glContext == NULL && wallTexture == NULL )
+    {
+        clearScreen();
+
+        int first = wallScroll / pitch * columns,
+            last = ( wallScroll + SCREEN_HEIGHT ) / pitch * columns + columns;
+
+        for( int board = first; board < last && board < count; board++ )
+        {
+            drawWallBoard( wall.positions[board], WALL_GAP + board % columns * pitch,
+                           WALL_GAP + board / columns * pitch - wallScroll );
+        }
+
+        present();
+        return;
+    }
+
+    if( glContext != NULL )
+    {
+        if( full )
+            glRenderer.begin();
+    }
+
+    else
+    {
+        SDL_SetRenderTarget( mainRenderer, wallTexture );
+
+        if( full )
+        {
+            SDL_SetRenderDrawColor( mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+            SDL_RenderClear( mainRenderer );
+        }
+    }
+
+    for( int board = 0; board < count; board++ )
+    {
+        if( full || wall.versions[board] != drawnVersions[board] )
+        {
+            //Every board has the same number of quads, so a board
+            //knows where its quads are.
+            if( glContext != NULL )
+                glRenderer.seek( board * WALL_QUADS );
+
+            drawWallBoard( wall.positions[board], WALL_GAP + board % columns * pitch,
+                           WALL_GAP + board / columns * pitch );
+            drawnVersions[board] = wall.versions[board];
+        }
+    }
+
+    if( glContext != NULL )
+    {
+        glRenderer.setScroll( wallScroll );
+    }
+
+    else
+    {
+        SDL_SetRenderTarget( mainRenderer, NULL );
+        SDL_RenderSetViewport( mainRenderer, NULL );
+        clearScreen();
+
+        SDL_Rect shown = { 0, wallScroll, SCREEN_WIDTH, height < SCREEN_HEIGHT ? height : SCREEN_HEIGHT },
+                 screen = { 0, 0, shown.w, shown.h };
+
+        SDL_RenderCopy( mainRenderer, wallTexture, &shown, &screen );
+    }
+
+    present();
+}
+
+/*********************************************************************
+** Description: This function draws one board of the spectator wall,
+*  tinted in the winner's color, or grey for a draw, once the game is
+*  over. On OpenGL it always adds WALL_QUADS quads, empty ones where
+*  there is nothing to draw, so the board can be drawn over in place.
+*
+*  Parameters: GamePosition position - the game.
+*              int x, y - the top left corner of the board.
+*********************************************************************/
+void GraphicsHandler::drawWallBoard( const GamePosition &position, int x, int y )
+{
+    int size = wallBoardSize,
+        line = size / 24 > 0 ? size / 24 : 1,
+        cell = ( size - 2 * line ) / 3,
+        inset = cell / 8;
+
+    SDL_Rect box = { x, y, size, size },
+             none = { x, y, 0, 0 },
+             grid[4] = { { x + cell, y, line, size }, { x + 2 * cell + line, y, line, size },
+                         { x, y + cell, size, line }, { x, y + 2 * cell + line, size, line } };
+
+    fillRects( &box, 1, theme->board, 0xFF );
+    fillRects( grid, 4, theme->lines, 0xFF );
+
+    for( int c = 0; c < GameBoard::CELLS; c++ )
+    {
+        Player pick = position.getBoard().getPick( c );
+        SDL_Rect mark = { x + ( c % 3 ) * ( cell + line ) + inset, y + ( c / 3 ) * ( cell + line ) + inset,
+                          cell - 2 * inset, cell - 2 * inset };
+
+        if( pick != No_Player )
+            drawMark( pick, mark );
+
+        else if( glContext != NULL )
+            fillRects( &none, 1, 0, 0, 0, 0 );
+    }
+
+    if( position.getOutcome() == X_WON )
+        fillRects( &box, 1, 0x55, 0xA3, 0x00, 0x50 );
+
+    else if( position.getOutcome() == O_WON )
+        fillRects( &box, 1, 0x9D, 0x00, 0x00, 0x50 );
+
+    else if( position.getOutcome() == DRAW )
+        fillRects( &box, 1, 0x80, 0x80, 0x80, 0x60 );
+
+    else if( glContext != NULL )
+        fillRects( &none, 1, 0, 0, 0, 0 );
+}
+
+/*********************************************************************
+** Description: This function returns the screen area of a board cell.
+*
+*  Parameters: int cell - the cell, row * 3 + column.
+*
+*  Return: SDL_Rect - the cell area.
+*********************************************************************/
+SDL_Rect GraphicsHandler::cellRect( int cell )
+{
+    SDL_Rect rect = { ( cell % 3 ) * 165, ( cell / 3 ) * 165, 150, 150 };
+
+    return rect;
+}
+
+/*********************************************************************
+** Description: This function draws the board, its grid lines and the
+*  highlight of the hovered cell.
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*********************************************************************/
+void GraphicsHandler::drawBoard( const GameSnapshot &snapshot )
+{
+    PROFILE_SCOPE( "drawBoard" );
+
+    //Render the viewport for the board.
+    setViewport( fillRectangle );
+
+    //Draw the dark grey portion.
+    fillRects( &fillRectangle, 1, theme->board, 0xFF );
+
+    //Draw the grey lines. Qubic and m,n,k boards draw their own grids.
+    if( snapshot.mode != QUBIC_MODE && snapshot.mode != MNK_MODE )
+        fillRects( lines, 4, theme->lines, 0xFF );
+
+    //Line animations.
+    if( lines[0].h < 396 )
+        lines[0].h += 5; 
+
+    if( lines[1].h < 396 )
+        lines[1].h += 5; 
+
+    if( lines[2].w < 396 )
+        lines[2].w += 5; 
+
+    if( lines[3].w < 396 )
+        lines[3].w += 5; 
+
+    //Highlights the cell that is hovered over by the mouse.
+    if( snapshot.mode == CLASSIC_MODE && snapshot.outcome == UNFINISHED && snapshot.hoverCell >= 0 
+        && snapshot.hoverCell < GameBoard::CELLS ) 
+    {
+        highlightOpacity = 35;
+        highlight = cellRect( snapshot.hoverCell );
+
+        fillRects( &highlight, 1, theme->highlight, highlightOpacity );
+    }
+}
+
+/*********************************************************************
+** Description: This function draws the Xs and Os on the board.
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*********************************************************************/
+void GraphicsHandler::drawMarks( const GameSnapshot &snapshot )
+{
+    PROFILE_SCOPE( "drawMarks" );
+
+    for( int cell = 0; cell < GameBoard::CELLS; cell++ )
+    {
+        Player pick = snapshot.board.getPick( cell );
+
+        if( pick != No_Player )
+        {
+            drawMark( pick, cellRect( cell ) );
+        }
+    }
+}
+
+/*********************************************************************
+** Description: This function shades the solved empty cells of a classic
+*  or m,n,k board: green where the move wins, grey where it draws and
+*  red where it loses, stronger the sooner the game ends. Cells with the
+*  same score share a color, so the overlay is one fill call per score,
+*  all in the instance buffer on OpenGL. A heatmap of another position,
+*  from before the last move, is not drawn.
+*
+*  Parameters: GameSnapshot snapshot - the game state drawn.
+*              Heatmap heatmap - the latest analysis.
+*********************************************************************/
+void GraphicsHandler::drawAnalysis( const GameSnapshot &snapshot, const Heatmap &heatmap )
+{
+    PROFILE_SCOPE( "drawAnalysis" );
+
+    const MnkPosition &position = heatmap.position;
+
+    if( heatmap.solved == 0 || snapshot.outcome != UNFINISHED || ( snapshot.mode == CLASSIC_MODE 
+        ? position != Analyzer::fromBoard( snapshot.board, snapshot.turn ) : position != snapshot.mnk ) )
+    {
+        return;
+    }
+
+    int empty = __builtin_popcount( position.getEmpty() );
+    uint32_t remaining = heatmap.solved;
+
+    while( remaining != 0 )
+    {
+        SDL_Rect cells[MnkPosition::MAX_CELLS];
+        int count = 0,
+            score = heatmap.scores[__builtin_ctz( remaining )];
+
+        for( uint32_t solved = remaining; solved != 0; solved &= solved - 1 )
+        {
+            int cell = __builtin_ctz( solved );
+
+            if( heatmap.scores[cell] == score )
+            {
+                cells[count++] = snapshot.mode == CLASSIC_MODE ? cellRect( cell )
+                                 : mnkCellRect( cell, position.getWidth(), position.getHeight() );
+                remaining &= ~( 1u << cell );
+            }
+        }
+
+        //A score is 1 plus the cells left empty at the end, of up to
+        //empty - 1 after this move.
+        Uint8 alpha = static_cast<Uint8>( score == 0 ? 40 : 30 + 90 * ( score > 0 ? score : -score ) / empty );
+
+        if( score > 0 )
+            fillRects( cells, count, 0x42, 0xF4, 0x6E, alpha );
+
+        else if( score < 0 )
+            fillRects( cells, count, 0xF4, 0x42, 0x42, alpha );
+
+        else
+            fillRects( cells, count, 0xCC, 0xCC, 0xCC, alpha );
+    }
+}
+
+/*********************************************************************
+** Description: This function returns the screen area of a cell of
+*  Ultimate Tic Tac Toe.
+*
+*  Parameters: int cell - board * 9 + cell within the board.
+*
+*  Return: SDL_Rect - the cell area.
+*********************************************************************/
+SDL_Rect GraphicsHandler::ultimateCellRect( int cell )
+{
+    SDL_Rect area = cellRect( cell / GameBoard::CELLS );
+    int local = cell % GameBoard::CELLS;
+    SDL_Rect rect = { area.x + ( local % 3 ) * 50 + 5, area.y + ( local / 3 ) * 50 + 5, 40, 40 };
+
+    return rect;
+}
+
+/*********************************************************************
+** Description: This function finds the Ultimate Tic Tac Toe cell at a
+*  point on the screen.
+*
+*  Parameters: int x, int y - the point, in window coordinates.
+*
+*  Return: int - board * 9 + cell within the board, or NO_CELL for a
+*  point outside the boards.
+*********************************************************************/
+int GraphicsHandler::ultimateCellAt( int x, int y )
+{
+    //Boards are 150 pixels with 15 pixel lines between them.
+    if( x < 0 || y < 0 || x >= 3 * 165 || y >= 3 * 165 || x % 165 >= 150 || y % 165 >= 150 )
+    {
+        return NO_CELL;
+    }
+
+    int board = ( y / 165 ) * 3 + x / 165,
+        local = ( y % 165 / 50 ) * 3 + x % 165 / 50;
+
+    return board * GameBoard::CELLS + local;
+}
+
+/*********************************************************************
+** Description: This function draws Ultimate Tic Tac Toe over the
+*  board: the highlight of the boards that may be played in, the grid
+*  lines inside the boards, the hovered cell and the marks.
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*********************************************************************/
+void GraphicsHandler::drawUltimate( const GameSnapshot &snapshot )
+{
+    PROFILE_SCOPE( "drawUltimate" );
+
+    const UltimatePosition &position = snapshot.ultimate;
+
+    //Highlights every board the player to move may play in at once.
+    SDL_Rect playable[GameBoard::CELLS];
+    int count = 0;
+
+    for( uint16_t boards = position.getPlayableBoards(); boards != 0; boards &= boards - 1 )
+    {
+        playable[count++] = cellRect( __builtin_ctz( boards ) );
+    }
+
+    fillRects( playable, count, theme->highlight, 30 );
+
+    fillRects( ultimateLines, 36, 0x80, 0x80, 0x80, 0xFF );
+
+    int hover = snapshot.hoverCell;
+
+    if( hover >= 0 && hover < UltimatePosition::CELLS
+        && ( position.getMoveMask( hover / GameBoard::CELLS ) & ( 1 << hover % GameBoard::CELLS ) ) )
+    {
+        highlightOpacity = 60;
+        highlight = ultimateCellRect( hover );
+
+        fillRects( &highlight, 1, theme->highlight, highlightOpacity );
+    }
+
+    if( marksTexture != NULL )
+    {
+        updateMarksTexture( snapshot );
+        SDL_RenderCopy( mainRenderer, marksTexture, NULL, &fillRectangle );
+    }
+
+    else
+    {
+        drawUltimateMarks( UltimatePosition(), position );
+    }
+}
+
+/*********************************************************************
+** Description: This function brings the marks texture up to date. New
+*  marks are drawn on top of the old ones; when a mark was taken away,
+*  by a new round, the texture is cleared and drawn again.
+*
+*  Parameters: GameSnapshot snapshot - the game state to show, in
+*  Ultimate or Qubic mode.
+*********************************************************************/
+void GraphicsHandler::updateMarksTexture( const GameSnapshot &snapshot )
+{
+    bool restart = !marksTextureValid || drawnMode != snapshot.mode,
+         changed = restart;
+
+    for( int player = X_Player; player <= O_Player; player++ )
+    {
+        Player owner = static_cast<Player>( player );
+
+        if( snapshot.mode == QUBIC_MODE )
+        {
+            uint64_t drawn = drawnQubic.getStones( owner ),
+                     now = snapshot.qubic.getStones( owner );
+
+            restart = restart || ( drawn & ~now ) != 0;
+            changed = changed || drawn != now;
+        }
+
+        else
+        {
+            for( int board = 0; board < GameBoard::CELLS; board++ )
+            {
+                uint16_t drawn = drawnUltimate.getBoardMarks( board, owner ),
+                         now = snapshot.ultimate.getBoardMarks( board, owner );
+
+                restart = restart || ( drawn & ~now ) != 0;
+                changed = changed || drawn != now;
+            }
+        }
+    }
+
+    if( !changed )
+    {
+        return;
+    }
+
+    PROFILE_SCOPE( "updateMarksTexture" );
+
+    SDL_SetRenderTarget( mainRenderer, marksTexture );
+
+    if( restart )
+    {
+        SDL_SetRenderDrawColor( mainRenderer, 0, 0, 0, 0 );
+        SDL_RenderClear( mainRenderer );
+        drawnUltimate = UltimatePosition();
+        drawnQubic = QubicPosition();
+    }
+
+    if( snapshot.mode == QUBIC_MODE )
+        drawQubicMarks( drawnQubic, snapshot.qubic );
+
+    else
+        drawUltimateMarks( drawnUltimate, snapshot.ultimate );
+
+    //Switching targets resets the viewport.
+    SDL_SetRenderTarget( mainRenderer, NULL );
+    SDL_RenderSetViewport( mainRenderer, &fillRectangle );
+
+    drawnMode = snapshot.mode;
+    drawnUltimate = snapshot.ultimate;
+    drawnQubic = snapshot.qubic;
+    marksTextureValid = true;
 }
 
 /*********************************************************************
-** Description: This function initializes SDL and graphics setup for
-* the program.
+** Description: This function draws the marks and the won boards that
+*  are in one position but not in an earlier one. A won board is
+*  covered by one large mark.
 *
-* Return: bool - indicates whether the operations were successful.
+*  Parameters: UltimatePosition drawn - the position already drawn.
+*              UltimatePosition position - the position to draw.
 *********************************************************************/
-bool GraphicsHandler::initiateSDL()
+void GraphicsHandler::drawUltimateMarks( const UltimatePosition &drawn, const UltimatePosition &position )
 {
-    bool initSuccess = true;
-
-    //Initiates SDL.
-    if( SDL_Init( SDL_INIT_EVERYTHING ) < 0 )
+    for( int player = X_Player; player <= O_Player; player++ )
     {
-        printf( "SDL did not successfully initialize! SDL ERROR: %s\n", SDL_GetError() );
-        initSuccess = false;
-    }
+        Player owner = static_cast<Player>( player );
 
-    else
-    {
-        //Set texture filtering to linear.
-        if( !SDL_SetHint( SDL_HINT_RENDER_SCALE_QUALITY, "1" ) )
+        for( int board = 0; board < GameBoard::CELLS; board++ )
         {
-            printf( "WARNING: Linear texture filtering was not enabled!" );
+            uint16_t added = position.getBoardMarks( board, owner ) & ~drawn.getBoardMarks( board, owner );
+
+            for( ; added != 0; added &= added - 1 )
+            {
+                drawMark( owner, ultimateCellRect( board * GameBoard::CELLS + __builtin_ctz( added ) ) );
+            }
         }
-        
-        mainWindow = SDL_CreateWindow( "Tic Tac Toe", SDL_WINDOWPOS_UNDEFINED, 
-                                        SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, 
-                                        SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
+    }
 
-        if( mainWindow == NULL )
-		{
-			printf( "Window could not be created! SDL Error: %s\n", SDL_GetError() );
-			initSuccess = false;
-		}
+    for( int player = X_Player; player <= O_Player; player++ )
+    {
+        Player owner = static_cast<Player>( player );
+        uint16_t added = position.getWonBoards( owner ) & ~drawn.getWonBoards( owner );
+
+        for( ; added != 0; added &= added - 1 )
+        {
+            SDL_Rect box = cellRect( __builtin_ctz( added ) );
 
-		else
-		{
-			//Create renderer for window and uses software rendering as a fallback.
-			mainRenderer = SDL_CreateRenderer( mainWindow, -1, SDL_RENDERER_PRESENTVSYNC 
-                           | SDL_RENDERER_ACCELERATED );
+            fillRects( &box, 1, theme->board, 0xC0 );
+            drawMark( owner, box );
+        }
+    }
+}
 
-			if( mainRenderer == NULL )
-			{
-				printf( "Accelerated Renderer could not be created! SDL Error: %s\n", SDL_GetError() );
-				printf( "Attempting to use Software Renderer...\n" );
+/*********************************************************************
+** Description: This function returns the screen area of a Qubic cell.
+*
+*  Parameters: int cell - layer * 16 + row * 4 + column.
+*
+*  Return: SDL_Rect - the cell area.
+*********************************************************************/
+SDL_Rect GraphicsHandler::qubicCellRect( int cell )
+{
+    int layer = cell / 16,
+        row = cell / 4 % 4,
+        column = cell % 4;
+    SDL_Rect rect = { ( layer % 2 ) * 248 + column * 58 + 8, ( layer / 2 ) * 248 + row * 58 + 8, 42, 42 };
 
-			    mainRenderer = SDL_CreateRenderer( mainWindow, -1, 
-                               SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_SOFTWARE );
+    return rect;
+}
 
-                if( mainRenderer == NULL )
-                {
+/*********************************************************************
+** Description: This function finds the Qubic cell at a point on the
+*  screen.
+*
+*  Parameters: int x, int y - the point, in window coordinates.
+*
+*  Return: int - layer * 16 + row * 4 + column, or NO_CELL for a point
+*  outside the layers.
+*********************************************************************/
+int GraphicsHandler::qubicCellAt( int x, int y )
+{
+    //Layers are 232 pixels with 16 pixels between them.
+    if( x < 0 || y < 0 || x >= 2 * 248 || y >= 2 * 248 || x % 248 >= 232 || y % 248 >= 232 )
+    {
+        return NO_CELL;
+    }
 
-                    printf( "Software Renderer could not be created! SDL Error: %s\n", SDL_GetError() );
-                    initSuccess = false;
-                }
-			}
-
-			else
-			{
-				//Initialize renderer color set to white.
-				SDL_SetRenderDrawColor( mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
-
-				//Initialize PNG loading.
-				int imgFlags = IMG_INIT_PNG;
-
-				if( !( IMG_Init( imgFlags ) & imgFlags ) )
-				{
-					printf( "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError() );
-					initSuccess = false;
-				}
-                
-                //Initialize SDL_ttf true type font.
-                if( TTF_Init() == -1 )
-                {
-                    printf( "SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError() );
-                    initSuccess = false;
-                }
-			}
-		}
-	}
+    int layer = ( y / 248 ) * 2 + x / 248;
 
-	return initSuccess;
+    return layer * 16 + ( y % 248 / 58 ) * 4 + x % 248 / 58;
 }
 
 /*********************************************************************
-** Description: This function allows SDL to initiate outside of the
-*  class. It also loads media.
+** Description: This function draws Qubic as four layers side by side:
+*  the layers and their grid lines, the hovered cell with the cells
+*  above and below it in the other layers, the marks, and the winning
+*  line once the game is won.
 *
-*  Return: bool - indicates if the initiation process was successful.
+*  Parameters: GameSnapshot snapshot - the game state to draw.
 *********************************************************************/
-bool GraphicsHandler::startUp()
+void GraphicsHandler::drawQubic( const GameSnapshot &snapshot )
 {
-    bool success = true;
+    PROFILE_SCOPE( "drawQubic" );
 
-    //Initiates SDL and all related functions.
-    if( !initiateSDL() )
+    const QubicPosition &position = snapshot.qubic;
+
+    fillRects( qubicSlices, QubicPosition::SIZE, 0x2A, 0x2A, 0x2A, 0xFF );
+
+    fillRects( qubicLines, QubicPosition::SIZE * 6, 0x80, 0x80, 0x80, 0xFF );
+
+    int hover = snapshot.hoverCell;
+
+    if( snapshot.outcome == UNFINISHED && hover >= 0 && hover < QubicPosition::CELLS
+        && position.getPick( hover ) == No_Player )
     {
-        printf( "Program failed to initialize!\n" );
-        success = false;
+        SDL_Rect column[QubicPosition::SIZE];
+
+        for( int layer = 0; layer < QubicPosition::SIZE; layer++ )
+        {
+            column[layer] = qubicCellRect( layer * 16 + hover % 16 );
+        }
+
+        fillRects( column, QubicPosition::SIZE, theme->highlight, 20 );
+
+        highlightOpacity = 60;
+        highlight = qubicCellRect( hover );
+
+        fillRects( &highlight, 1, theme->highlight, highlightOpacity );
     }
 
-    //Loads media.
-    else if( !ticTacToeTextures.loadMedia( mainRenderer ) )
+    if( marksTexture != NULL )
     {
-        printf( "Failed to load media!\n" );
-        success = false;
+        updateMarksTexture( snapshot );
+        SDL_RenderCopy( mainRenderer, marksTexture, NULL, &fillRectangle );
     }
 
     else
     {
-        //Retrieve the X and O sprite clippings.
-        X = ticTacToeTextures.getRectX();
-        O = ticTacToeTextures.getRectO();
+        drawQubicMarks( QubicPosition(), position );
+    }
 
-        //Allows alpha blending.
-        SDL_SetRenderDrawBlendMode( mainRenderer, SDL_BLENDMODE_BLEND ); 
+    if( position.getWinningLine() != 0 )
+    {
+        SDL_Rect winning[QubicPosition::SIZE];
+        int count = 0;
+
+        for( uint64_t cells = position.getWinningLine(); cells != 0; cells &= cells - 1 )
+        {
+            winning[count++] = qubicCellRect( __builtin_ctzll( cells ) );
+        }
+
+        fillRects( winning, count, 0xF4, 0xD0, 0x42, 90 );
     }
+}
 
-    return success;
+/*********************************************************************
+** Description: This function draws the Qubic marks that are in one
+*  position but not in an earlier one.
+*
+*  Parameters: QubicPosition drawn - the position already drawn.
+*              QubicPosition position - the position to draw.
+*********************************************************************/
+void GraphicsHandler::drawQubicMarks( const QubicPosition &drawn, const QubicPosition &position )
+{
+    for( int player = X_Player; player <= O_Player; player++ )
+    {
+        Player owner = static_cast<Player>( player );
+        uint64_t added = position.getStones( owner ) & ~drawn.getStones( owner );
+
+        for( ; added != 0; added &= added - 1 )
+        {
+            drawMark( owner, qubicCellRect( __builtin_ctzll( added ) ) );
+        }
+    }
 }
 
 /*********************************************************************
-** Description: This function clears the color on the screen to white.
+** Description: This function returns the screen area of a cell of an
+*  m,n,k board. The cells are square and the board is centered.
+*
+*  Parameters: int cell - the cell, row * width + column.
+*              int width, int height - the board size.
+*
+*  Return: SDL_Rect - the cell area.
 *********************************************************************/
-void GraphicsHandler::clearScreen()
+SDL_Rect GraphicsHandler::mnkCellRect( int cell, int width, int height )
 {
-    SDL_SetRenderDrawColor ( mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF ); 
-    SDL_RenderClear( mainRenderer );
+    int size = 480 / ( width > height ? width : height ),
+        left = ( 480 - width * size ) / 2,
+        top = ( 480 - height * size ) / 2;
+    int margin = size / 10;
+    SDL_Rect rect = { left + ( cell % width ) * size + margin, top + ( cell / width ) * size + margin,
+                      size - 2 * margin, size - 2 * margin };
+
+    return rect;
 }
 
 /*********************************************************************
-** Description: This function draws the Tic Tac Toe board. 
+** Description: This function finds the m,n,k cell at a point on the
+*  screen.
 *
-*  Parameters:
-*  1. MouseButtons* mouseHoverButton - current mouse button that the
-*     mouse pointer is hovering over.
-*  2. bool click - represents a valid mouse click.
+*  Parameters: int x, int y - the point, in window coordinates.
+*              int width, int height - the board size.
+*
+*  Return: int - row * width + column, or NO_CELL for a point outside
+*  the board.
 *********************************************************************/
-void GraphicsHandler::drawGame( MouseButtons* mouseHoverButton, Player player, Outcome win )
+int GraphicsHandler::mnkCellAt( int x, int y, int width, int height )
 {
-    clearScreen();
+    int size = 480 / ( width > height ? width : height ),
+        column = x - ( 480 - width * size ) / 2,
+        row = y - ( 480 - height * size ) / 2;
 
-    //Render the viewport for the board.
-    SDL_RenderSetViewport( mainRenderer, &fillRectangle);
+    if( column < 0 || row < 0 || column >= width * size || row >= height * size )
+    {
+        return NO_CELL;
+    }
 
-    //Draw the dark grey portion.
-    SDL_SetRenderDrawColor( mainRenderer, 0x1A, 0x1A, 0x1A, 0xFF );
-    SDL_RenderFillRect( mainRenderer, &fillRectangle );
+    return ( row / size ) * width + column / size;
+}
 
-    //Set the color of the grey lines.
-    SDL_SetRenderDrawColor( mainRenderer, 0xCC, 0xCC, 0xCC, 0xFF );
+/*********************************************************************
+** Description: This function draws an m,n,k board: its grid lines,
+*  the hovered cell, the marks and the winning line once the game is
+*  won. The grid is built on the stack and drawn with one call.
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*********************************************************************/
+void GraphicsHandler::drawMnk( const GameSnapshot &snapshot )
+{
+    PROFILE_SCOPE( "drawMnk" );
 
-    //Draw the grey lines.
-    SDL_RenderFillRect( mainRenderer, &lines[0] );
-    SDL_RenderFillRect( mainRenderer, &lines[1] );
-    SDL_RenderFillRect( mainRenderer, &lines[2] );
-    SDL_RenderFillRect( mainRenderer, &lines[3] );
+    const MnkPosition &position = snapshot.mnk;
+    int width = position.getWidth(),
+        height = position.getHeight(),
+        size = 480 / ( width > height ? width : height ),
+        left = ( 480 - width * size ) / 2,
+        top = ( 480 - height * size ) / 2;
 
-    //Line animations.
-    if( lines[0].h < 396 )
-        lines[0].h += 5; 
+    SDL_Rect grid[2 * MnkPosition::MAX_CELLS];
+    int count = 0;
 
-    if( lines[1].h < 396 )
-        lines[1].h += 5; 
+    for( int column = 1; column < width; column++ )
+    {
+        grid[count++] = { left + column * size - 1, top + 4, 2, height * size - 8 };
+    }
 
-    if( lines[2].w < 396 )
-        lines[2].w += 5; 
+    for( int row = 1; row < height; row++ )
+    {
+        grid[count++] = { left + 4, top + row * size - 1, width * size - 8, 2 };
+    }
 
-    if( lines[3].w < 396 )
-        lines[3].w += 5; 
+    fillRects( grid, count, theme->lines, 0xFF );
 
-    //Highlights mouse buttons that are hovered over by the mouse.
-    if( mouseHoverButton == nullptr )
-        highlightOpacity = 0;
+    int hover = snapshot.hoverCell;
 
-    else if( win == UNFINISHED ) 
+    if( snapshot.outcome == UNFINISHED && hover >= 0 && hover < position.getCells()
+        && position.getPick( hover ) == No_Player )
     {
-        highlightOpacity = 35;
+        highlightOpacity = 60;
+        highlight = mnkCellRect( hover, width, height );
 
-        highlight = { mouseHoverButton->getXLocation(), mouseHoverButton->getYLocation(), 
-                      mouseHoverButton->getWidth(), mouseHoverButton->getHeight() };
+        fillRects( &highlight, 1, theme->highlight, highlightOpacity );
+    }
 
-        SDL_SetRenderDrawColor( mainRenderer, 0x42, 0xE2, 0xF4, highlightOpacity );
-        SDL_RenderFillRect( mainRenderer, &highlight );
+    for( int player = X_Player; player <= O_Player; player++ )
+    {
+        Player owner = static_cast<Player>( player );
 
-        if( mouseHoverButton->getMouseClick() && mouseHoverButton->getPick() == No_Player )
+        for( uint32_t marks = position.getMarks( owner ); marks != 0; marks &= marks - 1 )
         {
-            buttonClicked.emplace_back( highlight, player );
-            mouseHoverButton->setPick( player );
-
-            if(win == UNFINISHED)
-            {
-                turn = 1 - turn;
-            }
+            drawMark( owner, mnkCellRect( __builtin_ctz( marks ), width, height ) );
         }
     }
-    
-    //Draw the Xs and Os. 
-    for( unsigned i = 0; i < buttonClicked.size(); i++ )
+
+    if( snapshot.outcome == X_WON || snapshot.outcome == O_WON )
     {
-        if( buttonClicked.at(i).cPlayer == X_Player )
-        {
-            renderTexture( ticTacToeTextures.getXO(), &X, &buttonClicked.at(i).button );
-        }
+        uint32_t lines[MnkPosition::MAX_LINES],
+                 winner = position.getMarks( snapshot.outcome == X_WON ? X_Player : O_Player );
+        int lineCount = position.getLines( lines );
 
-        else if( buttonClicked.at(i).cPlayer == O_Player )
+        for( int i = 0; i < lineCount; i++ )
         {
-            renderTexture( ticTacToeTextures.getXO(), &O, &buttonClicked.at(i).button );
+            if( ( winner & lines[i] ) != lines[i] )
+            {
+                continue;
+            }
+
+            count = 0;
+
+            for( uint32_t cells = lines[i]; cells != 0; cells &= cells - 1 )
+            {
+                grid[count++] = mnkCellRect( __builtin_ctz( cells ), width, height );
+            }
+
+            fillRects( grid, count, 0xF4, 0xD0, 0x42, 90 );
+            break;
         }
     }
+}
+
+/*********************************************************************
+** Description: This function draws the HUD with the turn, outcome,
+*  play again button and points.
+*
+*  Parameters: GameSnapshot snapshot - the game state to draw.
+*********************************************************************/
+void GraphicsHandler::drawHud( const GameSnapshot &snapshot )
+{
+    PROFILE_SCOPE( "drawHud" );
 
     //Create the viewport HUD that displays game information.
-    SDL_RenderSetViewport( mainRenderer, &viewportHud );
-    SDL_SetRenderDrawColor( mainRenderer, 0xCC, 0xCC, 0xCC, 0xFF );
-    SDL_RenderFillRect( mainRenderer, &viewportSpecs );
+    setViewport( viewportHud );
+    fillRects( &viewportSpecs, 1, theme->lines, 0xFF );
 
     //Fade in font animation variable
     if(fontOpacity < 249 )
@@ -283,132 +1502,190 @@ void GraphicsHandler::drawGame( MouseButtons* mouseHoverButton, Player player, O
         fontOpacity += 2;
     }
 
-    //Draw the win and draw message.
-    if( win == DRAW )
+    //Draw the win or draw message and the play again button.
+    if( snapshot.outcome != UNFINISHED )
     {
-        renderTexture( ticTacToeTextures.getDraw(), NULL, &text );
+        GlRenderer::Text message = GlRenderer::DRAW_TEXT;
 
-        SDL_SetRenderDrawColor( mainRenderer, 0xAF, 0xAF, 0xA8, 0xFF );
-        SDL_RenderFillRect( mainRenderer, &playAgainBox);
-        renderTexture( ticTacToeTextures.getPlayAgain(), NULL, &playAgainText );
+        if( snapshot.outcome == X_WON )
+            message = GlRenderer::X_WIN;
 
-        if( mouseHoverButton == nullptr )
-            highlightOpacity = 0;
+        else if( snapshot.outcome == O_WON )
+            message = GlRenderer::O_WIN;
 
-        else 
-        {
-            highlightOpacity = 50;
+        drawText( message, text, 0xFF );
 
-            highlight = { 20, mouseHoverButton->getYLocation(), 
-                          mouseHoverButton->getWidth(), mouseHoverButton->getHeight() };
+        fillRects( &playAgainBox, 1, 0xAF, 0xAF, 0xA8, 0xFF );
+        drawText( GlRenderer::PLAY_AGAIN, playAgainText, 0xFF );
 
-            SDL_SetRenderDrawColor( mainRenderer, 0x42, 0xE2, 0xF4, highlightOpacity );
-            SDL_RenderFillRect( mainRenderer, &playAgainBox );
+        if( snapshot.hoverCell == PLAY_AGAIN_CELL )
+        {
+            highlightOpacity = 50;
 
-            if( mouseHoverButton->getMouseClick() && mouseHoverButton->getPick() == No_Player )
-            {
-                buttonClicked.emplace_back( highlight, player );
-                mouseHoverButton->setPick( player );
-            }
+            fillRects( &playAgainBox, 1, theme->highlight, highlightOpacity );
         }
     }
 
-    else if( win == X_WON )
+    else if( snapshot.turn == X_Player )
     {
-        renderTexture( ticTacToeTextures.getXWin(), NULL, &text );
-        SDL_SetRenderDrawColor( mainRenderer, 0xAF, 0xAF, 0xA8, 0xFF );
-        SDL_RenderFillRect( mainRenderer, &playAgainBox);
-        renderTexture( ticTacToeTextures.getPlayAgain(), NULL, &playAgainText );
+        drawText( GlRenderer::X_TURN, text, fontOpacity );
+    }
 
-        if(!incremented)
-        {
-            ticTacToeTextures.incrementX( mainRenderer );
-            incremented = true;
-        }
+    else
+    {
+        drawText( GlRenderer::O_TURN, text, fontOpacity );
+    }
 
-        if( mouseHoverButton == nullptr )
-            highlightOpacity = 0;
+    drawText( GlRenderer::X_POINTS, Xpoints, fontOpacity );
 
-        else 
-        {
-            highlightOpacity = 50;
+    drawPoints( snapshot.xPoints, XPLoc );
 
-            highlight = { 20, mouseHoverButton->getYLocation(), 
-                          mouseHoverButton->getWidth(), mouseHoverButton->getHeight() };
+    drawText( GlRenderer::O_POINTS, Opoints, fontOpacity );
 
-            SDL_SetRenderDrawColor( mainRenderer, 0x42, 0xE2, 0xF4, highlightOpacity );
-            SDL_RenderFillRect( mainRenderer, &playAgainBox );
+    drawPoints( snapshot.oPoints, OPLoc );
+}
 
-            if( mouseHoverButton->getMouseClick() && mouseHoverButton->getPick() == No_Player )
-            {
-                buttonClicked.emplace_back( highlight, player );
-                mouseHoverButton->setPick( player );
-            }
-        }
+/*********************************************************************
+** Description: This function draws a score from the pre-rendered digit
+*  textures, so a new score needs no text rendering or new texture.
+*  Every digit is as wide as the box, so longer scores grow to the
+*  right, away from the label, instead of squeezing their digits. A
+*  score too long for the HUD moves left to stay inside it.
+*
+*  Parameters:
+*  1. int points - the score to draw.
+*  2. SDL_Rect box - where the first digit is drawn.
+*********************************************************************/
+void GraphicsHandler::drawPoints( int points, const SDL_Rect &box )
+{
+    char pointText[12];
+    int length = snprintf( pointText, sizeof( pointText ), "%d", points );
 
-    }
+    SDL_Rect digitBox = box;
+    digitBox.x = std::min( box.x, viewportHud.w - length * box.w );
 
-    else if( win == O_WON )
+    for( int i = 0; i < length; i++ )
     {
-        renderTexture( ticTacToeTextures.getOWin(), NULL, &text );
+        drawText( static_cast<GlRenderer::Text>( GlRenderer::DIGITS + pointText[i] - '0' ), digitBox, fontOpacity );
 
-        SDL_SetRenderDrawColor( mainRenderer, 0xAF, 0xAF, 0xA8, 0xFF );
-        SDL_RenderFillRect( mainRenderer, &playAgainBox);
-        renderTexture( ticTacToeTextures.getPlayAgain(), NULL, &playAgainText );
+        digitBox.x += digitBox.w;
+    }
+}
 
-        if(!incremented)
-        {
-            ticTacToeTextures.incrementO( mainRenderer );
-            incremented = true;
-        }
+/*********************************************************************
+** Description: This function sets where the following drawing goes,
+*  like SDL_RenderSetViewport() but for either renderer.
+*
+*  Parameters: SDL_Rect viewport - the area of the screen to draw in.
+*********************************************************************/
+void GraphicsHandler::setViewport( const SDL_Rect &viewport )
+{
+    if( glContext != NULL )
+        glRenderer.setOrigin( viewport.x, viewport.y );
 
-        if( mouseHoverButton == nullptr )
-            highlightOpacity = 0;
+    else
+        SDL_RenderSetViewport( mainRenderer, &viewport );
+}
 
-        else 
-        {
-            highlightOpacity = 50;
+/*********************************************************************
+** Description: This function fills rectangles with a color on either
+*  renderer.
+*
+*  Parameters:
+*  1. SDL_Rect* rects - the rectangles.
+*  2. int count - how many there are.
+*  3. Uint8 r, g, b, a - the color.
+*********************************************************************/
+void GraphicsHandler::fillRects( const SDL_Rect* rects, int count, Uint8 r, Uint8 g, Uint8 b, Uint8 a )
+{
+    if( glContext != NULL )
+    {
+        SDL_Color color = { r, g, b, a };
+        glRenderer.addRects( rects, count, color );
+    }
 
-            highlight = { 20, mouseHoverButton->getYLocation(), 
-                          mouseHoverButton->getWidth(), mouseHoverButton->getHeight() };
+    else
+    {
+        SDL_SetRenderDrawColor( mainRenderer, r, g, b, a );
+        SDL_RenderFillRects( mainRenderer, rects, count );
+    }
+}
 
-            SDL_SetRenderDrawColor( mainRenderer, 0x42, 0xE2, 0xF4, highlightOpacity );
-            SDL_RenderFillRect( mainRenderer, &playAgainBox );
+/*********************************************************************
+** Description: This function fills rectangles with a theme color.
+*
+*  Parameters:
+*  1. SDL_Rect* rects - the rectangles.
+*  2. int count - how many there are.
+*  3. SDL_Color color - the color; its alpha is ignored.
+*  4. Uint8 alpha - the opacity.
+*********************************************************************/
+void GraphicsHandler::fillRects( const SDL_Rect* rects, int count, SDL_Color color, Uint8 alpha )
+{
+    fillRects( rects, count, color.r, color.g, color.b, alpha );
+}
 
-            if( mouseHoverButton->getMouseClick() && mouseHoverButton->getPick() == No_Player )
-            {
-                buttonClicked.emplace_back( highlight, player );
-                mouseHoverButton->setPick( player );
-            }
-        }
+/*********************************************************************
+** Description: This function draws an X or an O: a clip of the sprite
+*  sheet on the SDL renderer, a shader drawn shape on OpenGL.
+*
+*  Parameters: Player player - X_Player or O_Player.
+*              SDL_Rect box - the square the mark fills.
+*********************************************************************/
+void GraphicsHandler::drawMark( Player player, const SDL_Rect &box )
+{
+    if( glContext != NULL )
+    {
+        glRenderer.addMark( player, box );
     }
 
-    else if( turn == 0 )
+    else
     {
-        SDL_SetTextureAlphaMod( ticTacToeTextures.getXTurn(), fontOpacity ); 
-        renderTexture( ticTacToeTextures.getXTurn(), NULL, &text );
+        SDL_Rect renderQuad = box;
+        renderTexture( ticTacToeTextures.getXO(), player == X_Player ? &X : &O, &renderQuad );
     }
+}
 
-    else if( turn == 1 )
+/*********************************************************************
+** Description: This function draws one of the HUD strings on either
+*  renderer.
+*
+*  Parameters:
+*  1. GlRenderer::Text text - the string.
+*  2. SDL_Rect box - where it is drawn, stretched to fit.
+*  3. Uint8 alpha - its opacity.
+*********************************************************************/
+void GraphicsHandler::drawText( GlRenderer::Text text, const SDL_Rect &box, Uint8 alpha )
+{
+    if( glContext != NULL )
     {
-        SDL_SetTextureAlphaMod( ticTacToeTextures.getOTurn(), fontOpacity ); 
-        renderTexture( ticTacToeTextures.getOTurn(), NULL, &text );
+        glRenderer.addText( text, box, alpha );
+        return;
     }
 
+    //Only the string drawn is asked for, as the textures are made on
+    //first use.
+    SDL_Texture* texture = NULL;
+    SDL_Rect renderQuad = box;
 
-    SDL_SetTextureAlphaMod( ticTacToeTextures.getXPoints(), fontOpacity ); 
-    renderTexture( ticTacToeTextures.getXPoints(), NULL, &Xpoints ); 
-
-    SDL_SetTextureAlphaMod( ticTacToeTextures.getXP(), fontOpacity ); 
-    renderTexture( ticTacToeTextures.getXP(), NULL, &XPLoc); 
-
-    SDL_SetTextureAlphaMod( ticTacToeTextures.getOPoints(), fontOpacity ); 
-    renderTexture( ticTacToeTextures.getOPoints(), NULL, &Opoints ); 
-
-    SDL_SetTextureAlphaMod( ticTacToeTextures.getOP(), fontOpacity ); 
-    renderTexture( ticTacToeTextures.getOP(), NULL, &OPLoc); 
+    switch( text )
+    {
+        case GlRenderer::X_TURN: texture = ticTacToeTextures.getXTurn(); break;
+        case GlRenderer::O_TURN: texture = ticTacToeTextures.getOTurn(); break;
+        case GlRenderer::X_WIN: texture = ticTacToeTextures.getXWin(); break;
+        case GlRenderer::O_WIN: texture = ticTacToeTextures.getOWin(); break;
+        case GlRenderer::DRAW_TEXT: texture = ticTacToeTextures.getDraw(); break;
+        case GlRenderer::X_POINTS: texture = ticTacToeTextures.getXPoints(); break;
+        case GlRenderer::O_POINTS: texture = ticTacToeTextures.getOPoints(); break;
+        case GlRenderer::PLAY_AGAIN: texture = ticTacToeTextures.getPlayAgain(); break;
+        default: texture = ticTacToeTextures.getDigit( text - GlRenderer::DIGITS ); break;
+    }
 
-    SDL_RenderPresent( mainRenderer ); //Update the rendering screen.
+    if( texture != NULL )
+    {
+        SDL_SetTextureAlphaMod( texture, alpha ); 
+        renderTexture( texture, NULL, &renderQuad );
+    }
 }
 
 /*********************************************************************
@@ -435,26 +1712,30 @@ SDL_Rect* renderQuad, double angle, SDL_Point* center, SDL_RendererFlip flip )
     }
 }
 
-/*********************************************************************
-** Description: Function to reset the button choices every turn. 
-*********************************************************************/
-void GraphicsHandler::reset()
-{
-    incremented = false;
-    buttonClicked.clear();
-    turn = 1;
-}
-
 /*********************************************************************
 ** Description: Cleans up SDL functions and frees memory. 
 *********************************************************************/
 void GraphicsHandler::cleanUp()
 {
-    //reset( 3 );
-    reset();
-
     ticTacToeTextures.cleanUp();
 
+    if( glContext != NULL )
+    {
+        destroyGlContext();
+    }
+
+    if( marksTexture != NULL )
+    {
+        SDL_DestroyTexture( marksTexture );
+        marksTexture = NULL;
+    }
+
+    if( wallTexture != NULL )
+    {
+        SDL_DestroyTexture( wallTexture );
+        wallTexture = NULL;
+    }
+
     if( mainRenderer != NULL)
     {
 	    SDL_DestroyRenderer( mainRenderer );
@@ -467,5 +1748,11 @@ void GraphicsHandler::cleanUp()
 	    mainWindow = NULL;
     }
 
+    if( offscreenSurface != NULL )
+    {
+        SDL_FreeSurface( offscreenSurface );
+        offscreenSurface = NULL;
+    }
+
 	SDL_Quit();
 }
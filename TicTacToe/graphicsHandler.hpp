@@ -8,26 +8,13 @@
 #ifndef GRAPHICS_HANDLER_HPP 
 #define GRAPHICS_HANDLER_HPP 
 
+#include "glRenderer.hpp"
 #include "textureHandler.hpp"
-#include "mouseButtons.hpp"
-
-enum Outcome { X_WON, O_WON, DRAW, UNFINISHED };
-
-/*********************************************************************
-** Description: The ButtonClicked structure represents mouse buttons 
-*  that were clicked on by the X and O players.
-*********************************************************************/
-struct ButtonClicked
-{
-    SDL_Rect button; //Specs of the mouse button.
-    Player cPlayer; //Clicked by player X or O.
-
-    ButtonClicked( SDL_Rect button, Player cPlayer ) 
-    {
-        this->button = button; 
-        this->cPlayer = cPlayer; 
-    }
-};
+#include "profiler.hpp"
+#include "gameLogic.hpp"
+#include "spectatorWall.hpp"
+#include "analyzer.hpp"
+#include "frameCapture.hpp"
 
 class GraphicsHandler
 {
@@ -40,10 +27,26 @@ class GraphicsHandler
     SDL_Window* mainWindow;
     SDL_Renderer* mainRenderer;
 
+    //Target of the renderer in offscreen mode.
+    SDL_Surface* offscreenSurface;
+    bool offscreen;
+
+    //The OpenGL renderer, used instead of mainRenderer when its context
+    //was created. Either way the same draw functions describe a frame.
+    GlRenderer glRenderer;
+    SDL_GLContext glContext;
+    bool useOpenGl;
+
+    //Starts only the SDL subsystems and loads only the textures the
+    //first frame needs. Otherwise everything is started up front.
+    bool fastStartup;
+
+    FrameCapture* capture; //Records every frame shown, or NULL.
+
     TextureHandler ticTacToeTextures;
+    const Theme* theme; //The colors of the board.
     
-    int highlightOpacity,
-        turn; //Represents player turn.
+    int highlightOpacity;
 
     Uint8 fontOpacity; 
 
@@ -63,25 +66,91 @@ class GraphicsHandler
     SDL_Rect playAgainBox;
     SDL_Rect playAgainText;
 
-    bool incremented; //Controls points incrementation.
+    //Ultimate and Qubic modes. The grid lines are drawn with one call,
+    //and the marks are kept in a texture that is only drawn into when a
+    //move was made, so a frame draws no cell on its own.
+    SDL_Rect ultimateLines[36];
+    SDL_Rect qubicSlices[QubicPosition::SIZE];
+    SDL_Rect qubicLines[QubicPosition::SIZE * 6];
+    SDL_Texture* marksTexture;
+    GameMode drawnMode; //The game in marksTexture.
+    UltimatePosition drawnUltimate;
+    QubicPosition drawnQubic;
+    bool marksTextureValid;
 
-    vector< ButtonClicked > buttonClicked;
+    //Spectator wall. The boards are kept in a texture as tall as the
+    //wall, or as quads on OpenGL, and only boards whose version changed
+    //are drawn again. A frame shows the part scrolled to.
+    static const int WALL_GAP = 4; //Pixels between two boards.
+    static const int WALL_QUADS = 15; //Quads of one board on OpenGL.
+    int wallBoardSize;
+    int wallScroll;
+    SDL_Texture* wallTexture;
+    vector< uint32_t > drawnVersions;
+    bool wallValid;
 
     //Private Functions
     bool initiateSDL();
+    bool createWindowRenderer();
+    bool createOffscreenRenderer();
+    bool createGlContext();
+    void destroyGlContext();
+    SDL_Surface* readFrame();
+    void captureFrame();
+    static SDL_Rect cellRect( int );
+    void drawBoard( const GameSnapshot & );
+    void drawMarks( const GameSnapshot & );
+    void drawAnalysis( const GameSnapshot &, const Heatmap & );
+    void drawHud( const GameSnapshot & );
+    void drawPoints( int, const SDL_Rect & );
+    void drawUltimate( const GameSnapshot & );
+    void drawUltimateMarks( const UltimatePosition &, const UltimatePosition & );
+    static SDL_Rect ultimateCellRect( int );
+    void drawQubic( const GameSnapshot & );
+    void drawQubicMarks( const QubicPosition &, const QubicPosition & );
+    static SDL_Rect qubicCellRect( int );
+    void drawMnk( const GameSnapshot & );
+    static SDL_Rect mnkCellRect( int, int, int );
+    void updateMarksTexture( const GameSnapshot & );
+    void drawWallBoard( const GamePosition &, int, int );
+    void present();
+    void setViewport( const SDL_Rect & );
+    void fillRects( const SDL_Rect*, int, Uint8, Uint8, Uint8, Uint8 );
+    void fillRects( const SDL_Rect*, int, SDL_Color, Uint8 );
+    void drawMark( Player, const SDL_Rect & );
+    void drawText( GlRenderer::Text, const SDL_Rect &, Uint8 );
     void renderTexture( SDL_Texture* texture = NULL, SDL_Rect* clip = NULL, 
     SDL_Rect* renderQuad = NULL, double angle = 0.0, SDL_Point* center = NULL, 
     SDL_RendererFlip flip = SDL_FLIP_NONE );
 
     public:
-    GraphicsHandler( int, int );
+    GraphicsHandler( int, int, bool = false );
     ~GraphicsHandler();
     bool startUp();
-    void reset(); 
     void clearScreen();
     void cleanUp();
-    void setTurn( int turn ) { this->turn = turn; };
-    void drawGame( MouseButtons* = NULL, Player = No_Player, Outcome = UNFINISHED );
+    void drawGame( const GameSnapshot &, const Heatmap* = NULL );
+    void drawWall( const WallSnapshot & );
+    void scrollWall( int pixels ) { wallScroll += pixels; };
+    void setWallBoardSize( int size ) { wallBoardSize = size; wallValid = false; };
+    bool saveFrame( const string & );
+    int compareFrame( const string &, int );
+    void resetRenderTargets() { marksTextureValid = false; wallValid = false; };
+    void setOpenGl( bool openGl ) { useOpenGl = openGl; };
+    void setFastStartup( bool fast ) { fastStartup = fast; };
+    void setOffscreen( bool memory ) { offscreen = memory; };
+    void setCapture( FrameCapture* frames ) { capture = frames; };
+    bool setTheme( const Theme & );
+    void setTextureBudget( long long budget ) { ticTacToeTextures.setBudget( budget ); };
+    const Theme &getTheme() const { return *theme; };
+    long long getTextureBytes() const;
+    const TextureCache &getTextureCache() const { return ticTacToeTextures.getCache(); };
+    bool isOpenGl() const { return glContext != NULL; };
+    long long getUploadedBytes() const { return glRenderer.getUploadedBytes(); };
+
+    static int ultimateCellAt( int, int );
+    static int qubicCellAt( int, int );
+    static int mnkCellAt( int, int, int, int );
 };
 
 #endif
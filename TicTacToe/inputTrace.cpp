@@ -0,0 +1,270 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The InputTrace class records the input events the game
+*  loop sees, with the frame and the time each came in, and plays them
+*  back into the SDL event queue, so a session can be run again without
+*  a person at the mouse. Played back at the original speed, events come
+*  in at the time they were recorded; played back at full speed, in the
+*  same frame, with no frame waiting on the clock. Traces are written
+*  to a small binary file with the random seed of the session.
+*********************************************************************/
+#include "inputTrace.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const uint32_t VERSION = 1;
+
+/*********************************************************************
+** Description: Constructor. The trace is empty.
+*********************************************************************/
+InputTrace::InputTrace()
+{
+    seed = 0;
+    recording = false;
+    replaying = false;
+    fast = false;
+    next = 0;
+    start = 0;
+}
+
+/*********************************************************************
+** Description: Empties the trace to record a new session. Room for a
+*  long session is reserved, so recording does not allocate per event.
+*
+*  Parameters: uint64_t seed - the random seed of the session.
+*********************************************************************/
+void InputTrace::startRecording( uint64_t seed )
+{
+    this->seed = seed;
+    recording = true;
+    replaying = false;
+    records.clear();
+    records.reserve( 1 << 16 );
+}
+
+/*********************************************************************
+** Description: Starts the clock of the trace. Called before the first
+*  frame, both to record and to replay.
+*********************************************************************/
+void InputTrace::begin()
+{
+    start = SDL_GetTicks();
+    next = 0;
+}
+
+/*********************************************************************
+** Description: Adds an event to the trace while recording. Events
+*  that are not input, such as window and render events, are left out.
+*
+*  Parameters: SDL_Event event - the event polled.
+*              long long frame - the frame it was polled in.
+*********************************************************************/
+void InputTrace::record( const SDL_Event &event, long long frame )
+{
+    if( !recording )
+    {
+        return;
+    }
+
+    Record record;
+    memset( &record, 0, sizeof( record ) );
+
+    switch( event.type )
+    {
+        case SDL_MOUSEMOTION:
+            record.type = MOTION;
+            record.code = event.motion.state;
+            record.x = static_cast<int16_t>( event.motion.x );
+            record.y = static_cast<int16_t>( event.motion.y );
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            record.type = event.type == SDL_MOUSEBUTTONDOWN ? BUTTON_DOWN : BUTTON_UP;
+            record.code = event.button.button;
+            record.x = static_cast<int16_t>( event.button.x );
+            record.y = static_cast<int16_t>( event.button.y );
+            break;
+
+        case SDL_MOUSEWHEEL:
+            record.type = WHEEL;
+            record.x = static_cast<int16_t>( event.wheel.x );
+            record.y = static_cast<int16_t>( event.wheel.y );
+            break;
+
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            record.type = event.type == SDL_KEYDOWN ? KEY_DOWN : KEY_UP;
+            record.code = event.key.keysym.sym;
+            break;
+
+        case SDL_QUIT:
+            record.type = QUIT;
+            break;
+
+        default:
+            return;
+    }
+
+    record.frame = static_cast<uint32_t>( frame );
+    record.time = SDL_GetTicks() - start;
+    records.push_back( record );
+}
+
+/*********************************************************************
+** Description: Writes the trace to a file.
+*
+*  Parameters: string path - the file.
+*
+*  Return: bool - false if the file could not be written.
+*********************************************************************/
+bool InputTrace::save( const string &path ) const
+{
+    MappedFile out;
+
+    if( !out.create( path, sizeof( Header ) + records.size() * sizeof( Record ) ) )
+    {
+        printf( "Could not write %s!\n", path.c_str() );
+        return false;
+    }
+
+    Header header;
+    memcpy( header.magic, "TTTI", 4 );
+    header.version = VERSION;
+    header.seed = seed;
+    header.count = records.size();
+    memcpy( out.getData(), &header, sizeof( header ) );
+
+    if( !records.empty() )
+    {
+        memcpy( out.getData() + sizeof( header ), &records[0], records.size() * sizeof( Record ) );
+    }
+
+    printf( "Recorded %u input events to %s.\n", static_cast<unsigned>( records.size() ), path.c_str() );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Reads a trace from a file to replay it.
+*
+*  Parameters: string path - the file.
+*
+*  Return: bool - false if the file is missing or is not a trace.
+*********************************************************************/
+bool InputTrace::load( const string &path )
+{
+    MappedFile file;
+    Header header;
+
+    if( !file.open( path ) )
+    {
+        return false;
+    }
+
+    memcpy( &header, file.getData(), std::min( file.getSize(), sizeof( Header ) ) );
+
+    if( file.getSize() < sizeof( Header ) || memcmp( header.magic, "TTTI", 4 ) != 0 || header.version != VERSION
+        || file.getSize() != sizeof( Header ) + header.count * sizeof( Record ) )
+    {
+        printf( "%s is not an input trace!\n", path.c_str() );
+        return false;
+    }
+
+    const Record* first = reinterpret_cast< const Record* >( file.getData() + sizeof( Header ) );
+
+    records.assign( first, first + header.count );
+    seed = header.seed;
+    recording = false;
+    replaying = true;
+    next = 0;
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Pushes the events that are due into the SDL event
+*  queue: at full speed those recorded up to this frame, otherwise
+*  those recorded up to this time since begin(). Once the trace runs
+*  out, a quit event ends the game if the trace did not.
+*
+*  Parameters: long long frame - the frame about to poll its events.
+*
+*  Return: bool - false once the whole trace was replayed.
+*********************************************************************/
+bool InputTrace::replay( long long frame )
+{
+    if( !replaying )
+    {
+        return false;
+    }
+
+    Uint32 now = SDL_GetTicks() - start;
+
+    for( ; next < records.size(); next++ )
+    {
+        const Record &record = records[next];
+
+        if( fast ? record.frame > frame : record.time > now )
+        {
+            return true;
+        }
+
+        SDL_Event event;
+        memset( &event, 0, sizeof( event ) );
+
+        switch( record.type )
+        {
+            case MOTION:
+                event.type = SDL_MOUSEMOTION;
+                event.motion.state = record.code;
+                event.motion.x = record.x;
+                event.motion.y = record.y;
+                break;
+
+            case BUTTON_DOWN:
+            case BUTTON_UP:
+                event.type = record.type == BUTTON_DOWN ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+                event.button.button = static_cast<Uint8>( record.code );
+                event.button.state = record.type == BUTTON_DOWN ? SDL_PRESSED : SDL_RELEASED;
+                event.button.clicks = 1;
+                event.button.x = record.x;
+                event.button.y = record.y;
+                break;
+
+            case WHEEL:
+                event.type = SDL_MOUSEWHEEL;
+                event.wheel.x = record.x;
+                event.wheel.y = record.y;
+                break;
+
+            case KEY_DOWN:
+            case KEY_UP:
+                event.type = record.type == KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+                event.key.state = record.type == KEY_DOWN ? SDL_PRESSED : SDL_RELEASED;
+                event.key.keysym.sym = record.code;
+                break;
+
+            default:
+                event.type = SDL_QUIT;
+        }
+
+        SDL_PushEvent( &event );
+    }
+
+    if( records.empty() || records.back().type != QUIT )
+    {
+        SDL_Event quit;
+        memset( &quit, 0, sizeof( quit ) );
+        quit.type = SDL_QUIT;
+        SDL_PushEvent( &quit );
+    }
+
+    replaying = false;
+
+    return false;
+}
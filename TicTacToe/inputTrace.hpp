@@ -0,0 +1,80 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The InputTrace class records the input events the game
+*  loop sees, with the frame and the time each came in, and plays them
+*  back into the SDL event queue, so a session can be run again without
+*  a person at the mouse. Played back at the original speed, events come
+*  in at the time they were recorded; played back at full speed, in the
+*  same frame, with no frame waiting on the clock. Traces are written
+*  to a small binary file with the random seed of the session.
+*********************************************************************/
+#ifndef INPUT_TRACE_HPP
+#define INPUT_TRACE_HPP
+
+#include <SDL.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class InputTrace
+{
+    public:
+        /*********************************************************************
+         ** Description: This struct starts a trace file. The records
+         *  follow, in the order they were seen.
+         *********************************************************************/
+        struct Header
+        {
+            char magic[4]; //"TTTI"
+            uint32_t version;
+            uint64_t seed; //Random seed of the session.
+            uint64_t count; //Number of records.
+        };
+
+        /*********************************************************************
+         ** Description: This struct is one input event of a trace.
+         *********************************************************************/
+        struct Record
+        {
+            uint32_t frame, //Frame the event was polled in.
+                     time; //Milliseconds since the first frame.
+            int32_t code; //Mouse button, key or button state.
+            int16_t x, //Mouse position or wheel scroll.
+                    y;
+            uint8_t type; //One of the event types below.
+            uint8_t reserved[3];
+        };
+
+        enum EventType { MOTION, BUTTON_DOWN, BUTTON_UP, WHEEL, KEY_DOWN, KEY_UP, QUIT };
+
+    private:
+        vector< Record > records;
+        uint64_t seed;
+        bool recording,
+             replaying,
+             fast; //Replays frame by frame instead of on the clock.
+        size_t next; //Next record to replay.
+        Uint32 start; //SDL_GetTicks() at the first frame.
+
+    public:
+        InputTrace();
+        void startRecording( uint64_t );
+        void begin();
+        void record( const SDL_Event &, long long );
+        bool save( const string & ) const;
+        bool load( const string & );
+        bool replay( long long );
+
+        //Getter and setter functions.
+        uint64_t getSeed() const { return seed; };
+        size_t getCount() const { return records.size(); };
+        bool isReplaying() const { return replaying; };
+        void setFast( bool full ) { fast = full; };
+};
+
+#endif
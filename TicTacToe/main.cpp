@@ -0,0 +1,341 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: Entry point of the Tic Tac Toe game. Kept apart from
+*  the TicTacToe class so the benchmark and tool executables can link
+*  the game objects without a second main().
+*********************************************************************/
+#include "TicTacToe.hpp"
+#include "inputTrace.hpp"
+#include "frameCapture.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+//Counts every allocation made through operator new, on any thread, for
+//the report of a replayed session.
+static std::atomic< unsigned long long > allocationCounter( 0 );
+
+void* operator new( std::size_t size )
+{
+    allocationCounter.fetch_add( 1, std::memory_order_relaxed );
+
+    void* memory = malloc( size == 0 ? 1 : size );
+
+    if( memory == NULL )
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete( void* memory ) noexcept
+{
+    free( memory );
+}
+
+void operator delete( void* memory, std::size_t ) noexcept
+{
+    free( memory );
+}
+
+/*********************************************************************
+** Description: Main function. Parameters set as required by SDL.
+*  Accepts "--seed N" to replay a session with the same random choices
+*  and "--profile FILE" to record a frame profile, written to FILE when
+*  F12 is pressed and when the game closes. "--single-thread" runs the
+*  game logic on the render thread and "--slow-ai MS" makes every move
+*  stall the game logic, to compare frame jitter between the two.
+*  "--x-player SPEC" and "--o-player SPEC" hand a side to a computer
+*  player, for example "mcts" or "mcts:time=500,threads=4", or to an
+*  external engine, for example "engine:time=200,./refengine", or
+*  to an opening book, for example "book:4-4-4.book,mcts".
+*  "--mode ultimate" plays Ultimate Tic Tac Toe instead and "--mode
+*  qubic" plays Qubic, Tic Tac Toe on a 4x4x4 cube. "--mode mnk:W,H,K"
+*  plays on a board W cells wide and H high, won by K in a row.
+*  "--renderer gl" draws with OpenGL 3.3, falling back to the SDL
+*  renderer when it is not available. "--spectate N[:SIZE]" shows N
+*  games between the two players side by side on boards SIZE pixels
+*  wide, for watching a tournament. "--full-startup" starts every SDL
+*  subsystem and loads every texture before the first frame, as the
+*  game used to, to compare the startup time printed at the first
+*  frame. "--theme NAME" starts with the classic, chalk or lazy theme,
+*  and T switches themes while playing. "--texture-budget MB" sets how
+*  much texture memory is kept for themes not on the screen.
+*  "--audio-buffer N" sets the audio buffer to N sample frames, smaller
+*  for cues closer to the click, larger if the sound crackles, and
+*  "--mute" plays without sound. "--analysis" shades every empty cell
+*  with the solved outcome of playing there, and A toggles it.
+*  "--record FILE" writes the input of the session to FILE, and
+*  "--replay FILE" plays it back offscreen and silently with the same
+*  seed, at the speed it was recorded or, with "--replay-fast", frame
+*  by frame as fast as the frames are drawn, then prints the frame
+*  times and the allocations made. "--capture PATH" records every
+*  frame shown to a Y4M video if PATH ends in .y4m, to raw frames if it
+*  ends in .raw, or else to PNG images named PATH000000.png and on,
+*  encoded on "--capture-threads N" worker threads, 2 by default.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    StartupProfiler::mark( "process start to main" );
+
+    const int SCREEN_WIDTH = 640,
+              SCREEN_HEIGHT = 480;
+
+    uint64_t seed = Random::timeSeed();
+    string profilePath;
+    bool singleThreaded = false;
+    bool openGl = false;
+    bool fastStartup = true;
+    int theme = 0;
+    long long textureBudget = -1;
+    int audioBuffer = 512;
+    bool muted = false;
+    bool analysis = false;
+    int slowAiDelay = 0;
+    string xPlayer = "human",
+           oPlayer = "human";
+    GameMode mode = CLASSIC_MODE;
+    int mnkSize[3] = { 4, 4, 4 };
+    int spectators = 0,
+        spectatorSize = 48;
+    string recordPath,
+           replayPath;
+    bool replayFast = false;
+    string capturePath;
+    int captureThreads = 2;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--seed" ) == 0 && i + 1 < argc )
+        {
+            seed = strtoull( argv[++i], NULL, 10 );
+        }
+
+        else if( strcmp( argv[i], "--profile" ) == 0 && i + 1 < argc )
+        {
+            profilePath = argv[++i];
+            Profiler::setEnabled( true );
+        }
+
+        else if( strcmp( argv[i], "--single-thread" ) == 0 )
+        {
+            singleThreaded = true;
+        }
+
+        else if( strcmp( argv[i], "--slow-ai" ) == 0 && i + 1 < argc )
+        {
+            slowAiDelay = atoi( argv[++i] );
+        }
+
+        else if( strcmp( argv[i], "--mode" ) == 0 && i + 1 < argc )
+        {
+            i++;
+
+            if( strcmp( argv[i], "ultimate" ) == 0 )
+                mode = ULTIMATE_MODE;
+
+            else if( strcmp( argv[i], "qubic" ) == 0 )
+                mode = QUBIC_MODE;
+
+            else if( strncmp( argv[i], "mnk", 3 ) == 0 )
+            {
+                mode = MNK_MODE;
+
+                if( argv[i][3] == ':' && ( sscanf( argv[i] + 4, "%d,%d,%d", &mnkSize[0], &mnkSize[1], &mnkSize[2] ) != 3
+                                           || !MnkPosition::validSize( mnkSize[0], mnkSize[1], mnkSize[2] ) ) )
+                {
+                    printf( "Unsupported board %s, playing 4,4,4.\n", argv[i] + 4 );
+                    mnkSize[0] = mnkSize[1] = mnkSize[2] = 4;
+                }
+            }
+        }
+
+        else if( strcmp( argv[i], "--renderer" ) == 0 && i + 1 < argc )
+        {
+            openGl = strcmp( argv[++i], "gl" ) == 0;
+        }
+
+        else if( strcmp( argv[i], "--spectate" ) == 0 && i + 1 < argc )
+        {
+            if( sscanf( argv[++i], "%d:%d", &spectators, &spectatorSize ) < 1 || spectators < 0 
+                || spectatorSize < 12 )
+            {
+                printf( "Unsupported wall %s, playing a game instead.\n", argv[i] );
+                spectators = 0;
+            }
+        }
+
+        else if( strcmp( argv[i], "--full-startup" ) == 0 )
+        {
+            fastStartup = false;
+        }
+
+        else if( strcmp( argv[i], "--theme" ) == 0 && i + 1 < argc )
+        {
+            theme = findTheme( argv[++i] );
+
+            if( theme < 0 )
+            {
+                printf( "Unknown theme %s, using %s.\n", argv[i], THEMES[0].name );
+                theme = 0;
+            }
+        }
+
+        else if( strcmp( argv[i], "--texture-budget" ) == 0 && i + 1 < argc )
+        {
+            textureBudget = atoll( argv[++i] ) << 20;
+        }
+
+        else if( strcmp( argv[i], "--audio-buffer" ) == 0 && i + 1 < argc )
+        {
+            audioBuffer = atoi( argv[++i] );
+
+            //SDL wants a power of two.
+            if( audioBuffer < 64 || audioBuffer > 8192 || ( audioBuffer & ( audioBuffer - 1 ) ) != 0 )
+            {
+                printf( "Unsupported audio buffer %s, using 512.\n", argv[i] );
+                audioBuffer = 512;
+            }
+        }
+
+        else if( strcmp( argv[i], "--mute" ) == 0 )
+        {
+            muted = true;
+        }
+
+        else if( strcmp( argv[i], "--analysis" ) == 0 )
+        {
+            analysis = true;
+        }
+
+        else if( strcmp( argv[i], "--record" ) == 0 && i + 1 < argc )
+        {
+            recordPath = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--replay" ) == 0 && i + 1 < argc )
+        {
+            replayPath = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--replay-fast" ) == 0 )
+        {
+            replayFast = true;
+        }
+
+        else if( strcmp( argv[i], "--capture" ) == 0 && i + 1 < argc )
+        {
+            capturePath = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--capture-threads" ) == 0 && i + 1 < argc )
+        {
+            captureThreads = atoi( argv[++i] );
+        }
+
+        else if( strcmp( argv[i], "--x-player" ) == 0 && i + 1 < argc )
+        {
+            xPlayer = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--o-player" ) == 0 && i + 1 < argc )
+        {
+            oPlayer = argv[++i];
+        }
+    }
+
+    InputTrace trace;
+
+    if( !replayPath.empty() )
+    {
+        if( !trace.load( replayPath ) )
+        {
+            printf( "Could not replay %s!\n", replayPath.c_str() );
+            return 1;
+        }
+
+        //The session is replayed with its own random choices.
+        seed = trace.getSeed();
+        trace.setFast( replayFast );
+        muted = true;
+    }
+
+    else if( !recordPath.empty() )
+    {
+        trace.startRecording( seed );
+    }
+
+    printf( "Random seed: %llu\n", static_cast<unsigned long long>( seed ) );
+
+    Random random( seed );
+    TicTacToe ticTacToe( SCREEN_WIDTH, SCREEN_HEIGHT, random );
+
+    ticTacToe.setProfilePath( profilePath );
+    ticTacToe.setSingleThreaded( singleThreaded );
+    ticTacToe.setOpenGl( openGl );
+    ticTacToe.setFastStartup( fastStartup );
+    ticTacToe.setTheme( THEMES[theme] );
+
+    if( textureBudget >= 0 )
+        ticTacToe.setTextureBudget( textureBudget );
+    ticTacToe.setSlowAiDelay( slowAiDelay );
+    ticTacToe.setAudioBufferSize( audioBuffer );
+    ticTacToe.setMuted( muted );
+    ticTacToe.setAnalysis( analysis );
+    ticTacToe.setMnkSize( mnkSize[0], mnkSize[1], mnkSize[2] );
+    ticTacToe.setMode( mode );
+
+    if( spectators > 0 )
+        ticTacToe.setSpectators( spectators, spectatorSize );
+
+    if( !replayPath.empty() || !recordPath.empty() )
+    {
+        ticTacToe.setOffscreen( !replayPath.empty() );
+        ticTacToe.setInputTrace( &trace );
+    }
+
+    if( spectators > 0 )
+    {
+        ticTacToe.setWallPlayer( X_Player, xPlayer );
+        ticTacToe.setWallPlayer( O_Player, oPlayer );
+    }
+
+    else
+    {
+        ticTacToe.setPlayer( X_Player, createPlayer( xPlayer, random.split( 1 ) ) );
+        ticTacToe.setPlayer( O_Player, createPlayer( oPlayer, random.split( 2 ) ) );
+    }
+    FrameCapture capture;
+
+    if( !capturePath.empty() && capture.start( capturePath, SCREEN_WIDTH, SCREEN_HEIGHT, captureThreads ) )
+    {
+        ticTacToe.setCapture( &capture );
+    }
+
+    unsigned long long allocations = allocationCounter.load();
+
+    ticTacToe.runGame();
+    ticTacToe.exportProfile();
+    capture.stop();
+
+    if( !replayPath.empty() )
+    {
+        allocations = allocationCounter.load() - allocations;
+        printf( "Replayed %u input events: %llu allocations, %.1f a frame\n",
+                static_cast<unsigned>( trace.getCount() ), allocations,
+                static_cast<double>( allocations ) / std::max( ticTacToe.getFrameCount(), 1LL ) );
+    }
+
+    else if( !recordPath.empty() )
+    {
+        trace.save( recordPath );
+    }
+
+    ticTacToe.cleanUp();
+
+    return 0;
+}
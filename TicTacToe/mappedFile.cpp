@@ -0,0 +1,193 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MappedFile class maps a file into memory, read only
+*  or created for writing, with mmap or the Windows file mapping
+*  functions. The operating system pages the file in and out as it is
+*  used, so tables larger than memory can be worked on.
+*********************************************************************/
+#include "mappedFile.hpp"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*********************************************************************
+** Description: Constructor. Nothing is mapped.
+*********************************************************************/
+MappedFile::MappedFile()
+{
+    data = NULL;
+    size = 0;
+
+#ifdef _WIN32
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+#else
+    file = -1;
+#endif
+}
+
+/*********************************************************************
+** Description: Destructor. Unmaps the file, writing back any changes.
+*********************************************************************/
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/*********************************************************************
+** Description: Maps an existing file read only.
+*
+*  Parameters: string path - the file.
+*
+*  Return: bool - false if the file could not be mapped.
+*********************************************************************/
+bool MappedFile::open( const string &path )
+{
+    return map( path, 0, false );
+}
+
+/*********************************************************************
+** Description: Creates a file of a given size, replacing any file of
+*  the same name, and maps it for writing.
+*
+*  Parameters: string path - the file.
+*              uint64_t bytes - the size of the file.
+*
+*  Return: bool - false if the file could not be created or mapped.
+*********************************************************************/
+bool MappedFile::create( const string &path, uint64_t bytes )
+{
+    return map( path, bytes, true );
+}
+
+/*********************************************************************
+** Description: Opens or creates a file and maps all of it.
+*
+*  Parameters:
+*  1. string path - the file.
+*  2. uint64_t bytes - the size of a created file.
+*  3. bool writable - creates the file and maps it for writing.
+*
+*  Return: bool - false if the file could not be mapped.
+*********************************************************************/
+bool MappedFile::map( const string &path, uint64_t bytes, bool writable )
+{
+    close();
+
+#ifdef _WIN32
+    file = CreateFileA( path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ,
+                        NULL, writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        printf( "Could not open %s!\n", path.c_str() );
+        return false;
+    }
+
+    if( !writable )
+    {
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx( file, &fileSize );
+        bytes = static_cast<uint64_t>( fileSize.QuadPart );
+    }
+#else
+    file = writable ? ::open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 ) : ::open( path.c_str(), O_RDONLY );
+
+    if( file < 0 )
+    {
+        printf( "Could not open %s!\n", path.c_str() );
+        return false;
+    }
+
+    if( writable && ftruncate( file, static_cast<off_t>( bytes ) ) != 0 )
+    {
+        printf( "Could not size %s to %llu bytes!\n", path.c_str(), static_cast<unsigned long long>( bytes ) );
+        close();
+        return false;
+    }
+
+    if( !writable )
+    {
+        struct stat status;
+        fstat( file, &status );
+        bytes = static_cast<uint64_t>( status.st_size );
+    }
+#endif
+
+    //A 32 bit build can not map more than its address space.
+    if( bytes == 0 || bytes > static_cast<uint64_t>( static_cast<size_t>( -1 ) ) )
+    {
+        printf( "Can not map %s of %llu bytes!\n", path.c_str(), static_cast<unsigned long long>( bytes ) );
+        close();
+        return false;
+    }
+
+    size = static_cast<size_t>( bytes );
+
+#ifdef _WIN32
+    mapping = CreateFileMappingA( file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                  static_cast<DWORD>( bytes >> 32 ), static_cast<DWORD>( bytes ), NULL );
+
+    if( mapping != NULL )
+    {
+        data = static_cast<uint8_t*>( MapViewOfFile( mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size ) );
+    }
+#else
+    void* view = mmap( NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0 );
+
+    if( view != MAP_FAILED )
+    {
+        data = static_cast<uint8_t*>( view );
+    }
+#endif
+
+    if( data == NULL )
+    {
+        printf( "Could not map %s!\n", path.c_str() );
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Unmaps and closes the file. Changes to a created file
+*  are written back by the operating system.
+*********************************************************************/
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if( data != NULL )
+        UnmapViewOfFile( data );
+
+    if( mapping != NULL )
+        CloseHandle( mapping );
+
+    if( file != INVALID_HANDLE_VALUE )
+        CloseHandle( file );
+
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if( data != NULL )
+        munmap( data, size );
+
+    if( file >= 0 )
+        ::close( file );
+
+    file = -1;
+#endif
+
+    data = NULL;
+    size = 0;
+}
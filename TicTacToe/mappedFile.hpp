@@ -0,0 +1,51 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MappedFile class maps a file into memory, read only
+*  or created for writing, with mmap or the Windows file mapping
+*  functions. The operating system pages the file in and out as it is
+*  used, so tables larger than memory can be worked on.
+*********************************************************************/
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+using std::string;
+
+class MappedFile
+{
+    private:
+        uint8_t* data;
+        size_t size;
+
+#ifdef _WIN32
+        void* file;
+        void* mapping;
+#else
+        int file;
+#endif
+
+        bool map( const string &, uint64_t, bool );
+
+        //A mapping can not be shared between two owners.
+        MappedFile( const MappedFile & );
+        MappedFile& operator=( const MappedFile & );
+
+    public:
+        MappedFile();
+        ~MappedFile();
+        bool open( const string & );
+        bool create( const string &, uint64_t );
+        void close();
+
+        //Getter functions.
+        uint8_t* getData() const { return data; };
+        size_t getSize() const { return size; };
+        bool isOpen() const { return data != NULL; };
+};
+
+#endif
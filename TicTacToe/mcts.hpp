@@ -0,0 +1,562 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Mcts class is a Monte Carlo Tree Search engine
+*  (UCT) for any position type that provides MAX_MOVES, getMoves(),
+*  play(), getToMove(), getOutcome() and operator==. Tree nodes come
+*  from a preallocated pool, several threads run playouts in parallel
+*  using virtual loss to spread over the tree, and the subtree of the
+*  position that was reached is kept for the next search.
+*********************************************************************/
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include "gameBoard.hpp"
+#include "random.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*********************************************************************
+** Description: The MctsSettings struct sets the strength of a search.
+*  A search stops at whichever of the two budgets it reaches first; a
+*  budget of 0 is unlimited, but at least one must be set.
+*********************************************************************/
+struct MctsSettings
+{
+    int playouts; //Playouts per move.
+    int timeBudget; //Milliseconds per move.
+    int threads;
+    unsigned poolSize; //Tree nodes in each of the two pools.
+    double exploration; //UCT exploration constant.
+    bool verbose; //Prints the playouts per second after every search.
+
+    MctsSettings()
+    {
+        playouts = 20000;
+        timeBudget = 0;
+        threads = 0; //Uses every hardware thread.
+        poolSize = 1 << 18;
+        exploration = 1.4;
+        verbose = false;
+    }
+};
+
+template< class Position >
+class Mcts
+{
+    private:
+        enum NodeState { UNEXPANDED, EXPANDING, EXPANDED };
+
+        //One tree node. Children of a node are stored next to each other.
+        struct Node
+        {
+            int move; //Move that led to this node.
+            Player mover; //Player who made that move; scores are theirs.
+            unsigned firstChild;
+            int childCount;
+            std::atomic< int > state,
+                               visits,
+                               score, //2 per win and 1 per draw for the mover.
+                               virtualLoss; //Playouts currently passing through.
+        };
+
+        //A block of nodes handed out by bumping an atomic index.
+        struct Pool
+        {
+            Node* nodes;
+            std::atomic< unsigned > used;
+        };
+
+        static const unsigned ROOT = 0;
+        static const int MAX_DEPTH = Position::MAX_MOVES + 1;
+
+        MctsSettings settings;
+        Random random; //Source of the per-thread playout streams.
+        uint64_t searchCount;
+
+        //The tree lives in one pool and is compacted into the other.
+        Pool pools[2];
+        int active;
+
+        Position rootPosition;
+        bool hasTree;
+
+        std::atomic< long long > playoutsStarted;
+        std::chrono::steady_clock::time_point deadline;
+
+        long long lastPlayouts;
+        double lastSeconds;
+
+        /*********************************************************************
+         ** Description: Takes count contiguous nodes from the active pool.
+         *
+         *  Return: unsigned - index of the first node, or 0 if the pool is
+         *  full. Index 0 is always the root, so it is never handed out.
+         *********************************************************************/
+        unsigned allocate( int count )
+        {
+            Pool &pool = pools[active];
+            unsigned first = pool.used.load( std::memory_order_relaxed );
+
+            do
+            {
+                if( first + count > settings.poolSize )
+                {
+                    return 0;
+                }
+            }
+            while( !pool.used.compare_exchange_weak( first, first + count, std::memory_order_relaxed ) );
+
+            return first;
+        }
+
+        /*********************************************************************
+         ** Description: Resets a node to an unvisited leaf.
+         *********************************************************************/
+        static void initNode( Node &node, int move, Player mover )
+        {
+            node.move = move;
+            node.mover = mover;
+            node.firstChild = 0;
+            node.childCount = 0;
+            node.state.store( UNEXPANDED, std::memory_order_relaxed );
+            node.visits.store( 0, std::memory_order_relaxed );
+            node.score.store( 0, std::memory_order_relaxed );
+            node.virtualLoss.store( 0, std::memory_order_relaxed );
+        }
+
+        /*********************************************************************
+         ** Description: Copies a node's fields, ignoring its children.
+         *********************************************************************/
+        static void copyNode( Node &to, const Node &from )
+        {
+            initNode( to, from.move, from.mover );
+            to.visits.store( from.visits.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+            to.score.store( from.score.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+        }
+
+        /*********************************************************************
+         ** Description: Starts a new tree with a single root node.
+         *
+         *  Parameters: Position position - the root position.
+         *********************************************************************/
+        void resetTree( const Position &position )
+        {
+            Pool &pool = pools[active];
+
+            initNode( pool.nodes[ROOT], -1, GameBoard::other( position.getToMove() ) );
+            pool.used.store( ROOT + 1 );
+
+            rootPosition = position;
+            hasTree = true;
+        }
+
+        /*********************************************************************
+         ** Description: Copies the subtree below a node into the other pool,
+         *  with that node as the new root, and makes that pool active.
+         *  Nodes that are no longer reachable are dropped.
+         *
+         *  Parameters: unsigned newRoot - the node in the active pool.
+         *********************************************************************/
+        void compact( unsigned newRoot )
+        {
+            Node* from = pools[active].nodes;
+            Node* to = pools[1 - active].nodes;
+
+            //Each copied node keeps its own old index in firstChild
+            //until its turn in the breadth-first walk.
+            copyNode( to[ROOT], from[newRoot] );
+            to[ROOT].firstChild = newRoot;
+
+            unsigned used = ROOT + 1;
+
+            for( unsigned i = ROOT; i < used; i++ )
+            {
+                const Node &old = from[to[i].firstChild];
+
+                to[i].firstChild = 0;
+
+                if( old.state.load( std::memory_order_relaxed ) != EXPANDED )
+                {
+                    continue;
+                }
+
+                to[i].firstChild = used;
+                to[i].childCount = old.childCount;
+                to[i].state.store( EXPANDED, std::memory_order_relaxed );
+
+                for( int c = 0; c < old.childCount; c++ )
+                {
+                    copyNode( to[used], from[old.firstChild + c] );
+                    to[used].firstChild = old.firstChild + c;
+                    used++;
+                }
+            }
+
+            active = 1 - active;
+            pools[active].used.store( used );
+        }
+
+        /*********************************************************************
+         ** Description: Moves the root to the given position. The current
+         *  tree is kept when the position is the root or one or two moves
+         *  below it, which covers the engine's own move and the reply.
+         *
+         *  Parameters: Position position - the position to search.
+         *********************************************************************/
+        void advanceRoot( const Position &position )
+        {
+            if( hasTree && position == rootPosition )
+            {
+                return;
+            }
+
+            Node* nodes = pools[active].nodes;
+
+            if( hasTree && nodes[ROOT].state.load() == EXPANDED )
+            {
+                const Node &root = nodes[ROOT];
+
+                for( int c = 0; c < root.childCount; c++ )
+                {
+                    unsigned child = root.firstChild + c;
+                    Position next = rootPosition;
+                    next.play( nodes[child].move );
+
+                    if( next == position )
+                    {
+                        compact( child );
+                        rootPosition = position;
+                        return;
+                    }
+
+                    if( nodes[child].state.load() != EXPANDED )
+                    {
+                        continue;
+                    }
+
+                    for( int g = 0; g < nodes[child].childCount; g++ )
+                    {
+                        unsigned grandchild = nodes[child].firstChild + g;
+                        Position reply = next;
+                        reply.play( nodes[grandchild].move );
+
+                        if( reply == position )
+                        {
+                            compact( grandchild );
+                            rootPosition = position;
+                            return;
+                        }
+                    }
+                }
+            }
+
+            resetTree( position );
+        }
+
+        /*********************************************************************
+         ** Description: Creates the children of a leaf. Only the thread that
+         *  wins the state change expands it; the others play out from the
+         *  leaf itself.
+         *
+         *  Return: bool - true if the node has children now.
+         *********************************************************************/
+        bool expand( Node &node, const Position &position )
+        {
+            int expected = UNEXPANDED;
+
+            if( !node.state.compare_exchange_strong( expected, EXPANDING, std::memory_order_acquire ) )
+            {
+                return expected == EXPANDED;
+            }
+
+            int moves[Position::MAX_MOVES];
+            int count = position.getMoves( moves );
+            unsigned first = allocate( count );
+
+            //Out of nodes, so the tree stops growing here.
+            if( first == 0 || count == 0 )
+            {
+                node.state.store( UNEXPANDED, std::memory_order_release );
+                return false;
+            }
+
+            Node* nodes = pools[active].nodes;
+
+            for( int i = 0; i < count; i++ )
+            {
+                initNode( nodes[first + i], moves[i], position.getToMove() );
+            }
+
+            node.firstChild = first;
+            node.childCount = count;
+            node.state.store( EXPANDED, std::memory_order_release );
+
+            return true;
+        }
+
+        /*********************************************************************
+         ** Description: Picks the child with the highest UCT value. Playouts
+         *  in progress count as losses, so parallel threads diverge.
+         *
+         *  Return: unsigned - index of the chosen child.
+         *********************************************************************/
+        unsigned selectChild( const Node &node )
+        {
+            const Node* nodes = pools[active].nodes;
+            int parentVisits = node.visits.load( std::memory_order_relaxed )
+                             + node.virtualLoss.load( std::memory_order_relaxed );
+            double logParent = std::log( static_cast<double>( parentVisits > 1 ? parentVisits : 1 ) );
+
+            unsigned best = node.firstChild;
+            double bestValue = -1.0;
+
+            for( int c = 0; c < node.childCount; c++ )
+            {
+                const Node &child = nodes[node.firstChild + c];
+                int visits = child.visits.load( std::memory_order_relaxed )
+                           + child.virtualLoss.load( std::memory_order_relaxed );
+
+                if( visits == 0 )
+                {
+                    return node.firstChild + c;
+                }
+
+                double value = child.score.load( std::memory_order_relaxed ) / ( 2.0 * visits )
+                             + settings.exploration * std::sqrt( logParent / visits );
+
+                if( value > bestValue )
+                {
+                    bestValue = value;
+                    best = node.firstChild + c;
+                }
+            }
+
+            return best;
+        }
+
+        /*********************************************************************
+         ** Description: Plays random moves until the game ends.
+         *
+         *  Return: Outcome - the result of the game.
+         *********************************************************************/
+        static Outcome rollout( Position position, Random &rng )
+        {
+            int moves[Position::MAX_MOVES];
+
+            while( position.getOutcome() == UNFINISHED )
+            {
+                int count = position.getMoves( moves );
+                position.play( moves[rng.nextInt( count )] );
+            }
+
+            return position.getOutcome();
+        }
+
+        /*********************************************************************
+         ** Description: Runs one playout: select a path with UCT, expand the
+         *  leaf, play out randomly and back the result up the path.
+         *********************************************************************/
+        void playout( Random &rng )
+        {
+            Node* nodes = pools[active].nodes;
+            Position position = rootPosition;
+
+            unsigned path[MAX_DEPTH];
+            int depth = 0;
+
+            unsigned current = ROOT;
+            path[depth++] = current;
+            nodes[current].virtualLoss.fetch_add( 1, std::memory_order_relaxed );
+
+            while( position.getOutcome() == UNFINISHED && depth < MAX_DEPTH )
+            {
+                Node &node = nodes[current];
+
+                if( node.state.load( std::memory_order_acquire ) != EXPANDED && !expand( node, position ) )
+                {
+                    break;
+                }
+
+                current = selectChild( node );
+                position.play( nodes[current].move );
+                path[depth++] = current;
+
+                //The first visit to a node ends the descent.
+                if( nodes[current].virtualLoss.fetch_add( 1, std::memory_order_relaxed ) == 0
+                    && nodes[current].visits.load( std::memory_order_relaxed ) == 0 )
+                {
+                    break;
+                }
+            }
+
+            Outcome result = rollout( position, rng );
+
+            for( int i = 0; i < depth; i++ )
+            {
+                Node &node = nodes[path[i]];
+                int points = 1;
+
+                if( result == X_WON )
+                    points = node.mover == X_Player ? 2 : 0;
+
+                else if( result == O_WON )
+                    points = node.mover == O_Player ? 2 : 0;
+
+                node.score.fetch_add( points, std::memory_order_relaxed );
+                node.visits.fetch_add( 1, std::memory_order_relaxed );
+                node.virtualLoss.fetch_sub( 1, std::memory_order_relaxed );
+            }
+        }
+
+        /*********************************************************************
+         ** Description: One search thread. Runs playouts until a budget is
+         *  used up.
+         *
+         *  Parameters: Random rng - this thread's random stream.
+         *********************************************************************/
+        void searchThread( Random rng )
+        {
+            while( true )
+            {
+                long long started = playoutsStarted.fetch_add( 1 );
+
+                if( settings.playouts > 0 && started >= settings.playouts )
+                {
+                    break;
+                }
+
+                if( settings.timeBudget > 0 && std::chrono::steady_clock::now() >= deadline )
+                {
+                    break;
+                }
+
+                playout( rng );
+            }
+        }
+
+    public:
+        /*********************************************************************
+         ** Description: Constructor. Allocates both node pools up front.
+         *
+         *  Parameters: MctsSettings settings - the search budget, with
+         *              pools of at least 1 + Position::MAX_MOVES nodes.
+         *              Random random - seeds the playouts.
+         *********************************************************************/
+        Mcts( const MctsSettings &settings, const Random &random ) : settings( settings ), random( random )
+        {
+            //The root and at least one child; resetTree() writes the root.
+            assert( this->settings.poolSize >= 2 );
+
+            if( this->settings.threads <= 0 )
+            {
+                unsigned hardware = std::thread::hardware_concurrency();
+                this->settings.threads = hardware > 0 ? hardware : 1;
+            }
+
+            if( this->settings.playouts <= 0 && this->settings.timeBudget <= 0 )
+            {
+                this->settings.playouts = MctsSettings().playouts;
+            }
+
+            for( int i = 0; i < 2; i++ )
+            {
+                pools[i].nodes = new Node[this->settings.poolSize];
+                pools[i].used.store( 0 );
+            }
+
+            active = 0;
+            hasTree = false;
+            searchCount = 0;
+            lastPlayouts = 0;
+            lastSeconds = 0.0;
+        }
+
+        /*********************************************************************
+         ** Description: Destructor. Frees the node pools.
+         *********************************************************************/
+        ~Mcts()
+        {
+            delete [] pools[0].nodes;
+            delete [] pools[1].nodes;
+        }
+
+        /*********************************************************************
+         ** Description: Searches a position and returns the move that was
+         *  played out most often.
+         *
+         *  Parameters: Position position - the position to move in.
+         *
+         *  Return: int - the chosen move, or -1 if there is no legal move.
+         *********************************************************************/
+        int search( const Position &position )
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            advanceRoot( position );
+
+            playoutsStarted.store( 0 );
+            deadline = start + std::chrono::milliseconds( settings.timeBudget );
+            searchCount++;
+
+            std::vector< std::thread > helpers;
+
+            for( int t = 1; t < settings.threads; t++ )
+            {
+                helpers.push_back( std::thread( &Mcts::searchThread, this,
+                                                random.split( searchCount * settings.threads + t ) ) );
+            }
+
+            searchThread( random.split( searchCount * settings.threads ) );
+
+            for( unsigned t = 0; t < helpers.size(); t++ )
+            {
+                helpers[t].join();
+            }
+
+            lastSeconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+            lastPlayouts = playoutsStarted.load() - settings.threads;
+
+            if( settings.verbose )
+            {
+                printf( "MCTS: %lld playouts in %.1f ms (%.0f playouts/sec), %u nodes\n",
+                        lastPlayouts, lastSeconds * 1000.0, getPlayoutsPerSecond(), getTreeSize() );
+            }
+
+            const Node* nodes = pools[active].nodes;
+            const Node &root = nodes[ROOT];
+
+            if( root.state.load() != EXPANDED )
+            {
+                int moves[Position::MAX_MOVES];
+                return position.getMoves( moves ) > 0 ? moves[0] : -1;
+            }
+
+            unsigned best = root.firstChild;
+
+            for( int c = 1; c < root.childCount; c++ )
+            {
+                if( nodes[root.firstChild + c].visits.load() > nodes[best].visits.load() )
+                {
+                    best = root.firstChild + c;
+                }
+            }
+
+            return nodes[best].move;
+        }
+
+        //Getter functions.
+        long long getPlayouts() const { return lastPlayouts; };
+        double getSeconds() const { return lastSeconds; };
+        double getPlayoutsPerSecond() const { return lastSeconds > 0.0 ? lastPlayouts / lastSeconds : 0.0; };
+
+        unsigned getTreeSize() const { return pools[active].used.load(); };
+};
+
+#endif
@@ -0,0 +1,236 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MnkPosition class is a position of an m,n,k game:
+*  Tic Tac Toe on a board width cells wide and height cells high, won
+*  by k marks in a row. Boards of up to 32 cells are supported, with
+*  each player's marks in one 32 bit mask, bit row * width + column.
+*  A move checks only the four lines through its cell for a win.
+*********************************************************************/
+#include "mnkPosition.hpp"
+
+//Right, down, down right and down left, as column and row steps.
+static const int DIRECTIONS[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+
+/*********************************************************************
+** Description: Constructor. Starts with an empty board. The size must
+*  pass validSize().
+*
+*  Parameters:
+*  1. int width - the number of columns.
+*  2. int height - the number of rows.
+*  3. int k - the marks in a row that win.
+*  4. Player toMove - the player who makes the first move.
+*********************************************************************/
+MnkPosition::MnkPosition( int width, int height, int k, Player toMove )
+{
+    marks[X_Player] = 0;
+    marks[O_Player] = 0;
+    this->width = static_cast<uint8_t>( width );
+    this->height = static_cast<uint8_t>( height );
+    this->k = static_cast<uint8_t>( k );
+    this->toMove = toMove;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Checks a board size.
+*
+*  Parameters: int width, int height, int k - the size to check.
+*
+*  Return: bool - true if the board has at most MAX_CELLS cells and a
+*  line of k marks fits on it.
+*********************************************************************/
+bool MnkPosition::validSize( int width, int height, int k )
+{
+    return width >= 1 && height >= 1 && width * height <= MAX_CELLS
+        && k >= 2 && ( k <= width || k <= height );
+}
+
+/*********************************************************************
+** Description: Makes a move for the player to move.
+*
+*  Parameters: int cell - the cell, row * width + column.
+*
+*  Return: bool - false if the game is over or the cell is not empty.
+*********************************************************************/
+bool MnkPosition::play( int cell )
+{
+    if( outcome != UNFINISHED || cell < 0 || cell >= getCells() || ( getEmpty() >> cell & 1 ) == 0 )
+    {
+        return false;
+    }
+
+    marks[toMove] |= 1U << cell;
+
+    if( completesLine( marks[toMove], cell ) )
+        outcome = toMove == X_Player ? X_WON : O_WON;
+
+    else if( getEmpty() == 0 )
+        outcome = DRAW;
+
+    toMove = GameBoard::other( toMove );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Takes back the last move, which was made in a cell.
+*
+*  Parameters: int cell - the cell of the last move.
+*********************************************************************/
+void MnkPosition::undo( int cell )
+{
+    toMove = GameBoard::other( toMove );
+    marks[toMove] &= ~( 1U << cell );
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Lists the legal moves.
+*
+*  Parameters: int* moves - receives up to MAX_MOVES cells.
+*
+*  Return: int - the number of legal moves.
+*********************************************************************/
+int MnkPosition::getMoves( int* moves ) const
+{
+    int count = 0;
+
+    if( outcome != UNFINISHED )
+    {
+        return 0;
+    }
+
+    for( uint32_t empty = getEmpty(); empty != 0; empty &= empty - 1 )
+    {
+        moves[count++] = __builtin_ctz( empty );
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Returns the player who marked a cell.
+*
+*  Parameters: int cell - the cell, row * width + column.
+*
+*  Return: Player - X_Player, O_Player or No_Player.
+*********************************************************************/
+Player MnkPosition::getPick( int cell ) const
+{
+    if( marks[X_Player] >> cell & 1 )
+        return X_Player;
+
+    if( marks[O_Player] >> cell & 1 )
+        return O_Player;
+
+    return No_Player;
+}
+
+/*********************************************************************
+** Description: Counts the marks in a row from a cell, not counting
+*  the cell itself, walking one way along a direction.
+*
+*  Parameters:
+*  1. uint32_t stones - the marks of one player.
+*  2. int cell - the cell to start from.
+*  3. int dx, int dy - the column and row step.
+*
+*  Return: int - the number of marks before the first gap or edge.
+*********************************************************************/
+int MnkPosition::runLength( uint32_t stones, int cell, int dx, int dy ) const
+{
+    int x = cell % width + dx,
+        y = cell / width + dy,
+        count = 0;
+
+    while( x >= 0 && x < width && y >= 0 && y < height && ( stones >> ( y * width + x ) & 1 ) )
+    {
+        count++;
+        x += dx;
+        y += dy;
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Checks whether the marks of a player have k in a row
+*  through a cell.
+*
+*  Parameters: uint32_t stones - the marks of one player.
+*              int cell - a cell holding one of the marks.
+*
+*  Return: bool - true if a line through the cell is complete.
+*********************************************************************/
+bool MnkPosition::completesLine( uint32_t stones, int cell ) const
+{
+    for( int d = 0; d < 4; d++ )
+    {
+        int dx = DIRECTIONS[d][0],
+            dy = DIRECTIONS[d][1];
+
+        if( 1 + runLength( stones, cell, dx, dy ) + runLength( stones, cell, -dx, -dy ) >= k )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Lists every line of k cells on the board as a mask.
+*
+*  Parameters: uint32_t* lines - receives up to MAX_LINES masks.
+*
+*  Return: int - the number of lines.
+*********************************************************************/
+int MnkPosition::getLines( uint32_t* lines ) const
+{
+    int count = 0;
+
+    for( int d = 0; d < 4; d++ )
+    {
+        int dx = DIRECTIONS[d][0],
+            dy = DIRECTIONS[d][1];
+
+        for( int cell = 0; cell < getCells(); cell++ )
+        {
+            int x = cell % width,
+                y = cell / width,
+                endX = x + dx * ( k - 1 ),
+                endY = y + dy * ( k - 1 );
+
+            if( endX < 0 || endX >= width || endY >= height )
+            {
+                continue;
+            }
+
+            uint32_t line = 0;
+
+            for( int step = 0; step < k; step++ )
+            {
+                line |= 1U << ( ( y + dy * step ) * width + x + dx * step );
+            }
+
+            lines[count++] = line;
+        }
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Compares two positions.
+*
+*  Return: bool - true if the size, the marks and the player to move
+*  match.
+*********************************************************************/
+bool MnkPosition::operator==( const MnkPosition &other ) const
+{
+    return width == other.width && height == other.height && k == other.k && toMove == other.toMove
+        && marks[X_Player] == other.marks[X_Player] && marks[O_Player] == other.marks[O_Player];
+}
@@ -0,0 +1,59 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MnkPosition class is a position of an m,n,k game:
+*  Tic Tac Toe on a board width cells wide and height cells high, won
+*  by k marks in a row. Boards of up to 32 cells are supported, with
+*  each player's marks in one 32 bit mask, bit row * width + column.
+*  A move checks only the four lines through its cell for a win.
+*********************************************************************/
+#ifndef MNK_POSITION_HPP
+#define MNK_POSITION_HPP
+
+#include "gameBoard.hpp"
+
+class MnkPosition
+{
+    private:
+        uint32_t marks[2]; //Indexed by X_Player and O_Player.
+        uint8_t width,
+                height,
+                k;
+        Player toMove;
+        Outcome outcome;
+
+        int runLength( uint32_t, int, int, int ) const;
+
+    public:
+        static const int MAX_CELLS = 32;
+        static const int MAX_MOVES = MAX_CELLS;
+        static const int MAX_LINES = 4 * MAX_CELLS;
+
+        MnkPosition( int width = 3, int height = 3, int k = 3, Player toMove = X_Player );
+        bool play( int );
+        void undo( int );
+        int getMoves( int* ) const;
+        Player getPick( int ) const;
+        bool completesLine( uint32_t, int ) const;
+        int getLines( uint32_t* ) const;
+
+        //Getter functions.
+        uint32_t getMarks( Player player ) const { return marks[player]; };
+        uint32_t getEmpty() const { return getFull() & ~( marks[X_Player] | marks[O_Player] ); };
+        uint32_t getFull() const { return static_cast<uint32_t>( ( 1ULL << getCells() ) - 1 ); };
+        int getWidth() const { return width; };
+        int getHeight() const { return height; };
+        int getK() const { return k; };
+        int getCells() const { return width * height; };
+        int getPly() const { return __builtin_popcount( marks[X_Player] | marks[O_Player] ); };
+        Player getToMove() const { return toMove; };
+        Outcome getOutcome() const { return outcome; };
+
+        static bool validSize( int, int, int );
+
+        bool operator==( const MnkPosition & ) const;
+        bool operator!=( const MnkPosition &other ) const { return !( *this == other ); };
+};
+
+#endif
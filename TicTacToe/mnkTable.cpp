@@ -0,0 +1,334 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MnkTable class reads the solved tables of an m,n,k
+*  game written by the retrograde solver. There is one file per ply,
+*  holding the score of every position with that many marks. Positions
+*  are numbered by ranking: the occupied cells are a combination of
+*  ply cells out of all of them, and the cells of the player who moved
+*  second a combination of the occupied ones, so a ply file holds no
+*  unreachable mark counts. Only the ply being looked up is mapped.
+*********************************************************************/
+#include "mnkTable.hpp"
+#include <cstdio>
+#include <cstring>
+
+/*********************************************************************
+** Description: The Binomials struct holds n choose r for every n and
+*  r up to the largest board.
+*********************************************************************/
+struct Binomials
+{
+    uint64_t values[MnkPosition::MAX_CELLS + 1][MnkPosition::MAX_CELLS + 1];
+
+    Binomials()
+    {
+        for( int n = 0; n <= MnkPosition::MAX_CELLS; n++ )
+        {
+            values[n][0] = 1;
+
+            for( int r = 1; r <= MnkPosition::MAX_CELLS; r++ )
+            {
+                values[n][r] = n == 0 ? 0 : values[n - 1][r - 1] + values[n - 1][r];
+            }
+        }
+    }
+};
+
+static const Binomials BINOMIALS;
+
+/*********************************************************************
+** Description: Constructor. No table is open.
+*********************************************************************/
+MnkTable::MnkTable()
+{
+    width = 0;
+    height = 0;
+    k = 0;
+    mappedPly = -1;
+}
+
+/*********************************************************************
+** Description: Opens the solved tables of a board size.
+*
+*  Parameters:
+*  1. string dir - the folder the solver wrote the tables to.
+*  2. int width, int height, int k - the board size.
+*
+*  Return: bool - false if the tables are missing or do not match.
+*********************************************************************/
+bool MnkTable::open( const string &dir, int width, int height, int k )
+{
+    this->dir = dir;
+    this->width = width;
+    this->height = height;
+    this->k = k;
+    mappedPly = -1;
+    file.close();
+
+    if( !MnkPosition::validSize( width, height, k ) || plyScores( 0 ) == NULL )
+    {
+        this->dir.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Returns the scores of one ply, mapping its file if a
+*  different ply is mapped.
+*
+*  Parameters: int ply - the number of marks on the board.
+*
+*  Return: const int8_t* - the scores in rank order, or NULL if the
+*  file is missing or does not match.
+*********************************************************************/
+const int8_t* MnkTable::plyScores( int ply )
+{
+    if( mappedPly != ply )
+    {
+        mappedPly = -1;
+
+        if( !file.open( plyPath( dir, width, height, k, ply ) ) || !checkHeader( file, width, height, k, ply ) )
+        {
+            file.close();
+            return NULL;
+        }
+
+        mappedPly = ply;
+    }
+
+    return reinterpret_cast< const int8_t* >( file.getData() + sizeof( Header ) );
+}
+
+/*********************************************************************
+** Description: Looks up the solved score of a position.
+*
+*  Parameters: MnkPosition position - a position of the open size.
+*
+*  Return: int - 1 plus the empty cells left at the end of the game
+*  if the player to move wins with best play, minus that if they lose,
+*  and 0 for a draw or when the table could not be read.
+*********************************************************************/
+int MnkTable::score( const MnkPosition &position )
+{
+    const int8_t* scores = plyScores( position.getPly() );
+
+    if( scores == NULL )
+    {
+        return 0;
+    }
+
+    uint32_t first,
+             second;
+    splitMarks( position, first, second );
+
+    return scores[rank( first, second )];
+}
+
+/*********************************************************************
+** Description: Returns n choose r.
+*
+*  Parameters: int n, int r - at most MnkPosition::MAX_CELLS.
+*
+*  Return: uint64_t - the number of ways to choose r of n items.
+*********************************************************************/
+uint64_t MnkTable::binomial( int n, int r )
+{
+    return r < 0 || r > n ? 0 : BINOMIALS.values[n][r];
+}
+
+/*********************************************************************
+** Description: Returns the number of positions with a number of marks,
+*  the first player having made the extra move on odd plies.
+*
+*  Parameters: int cells - the cells on the board.
+*              int ply - the number of marks.
+*
+*  Return: uint64_t - the positions in the ply.
+*********************************************************************/
+uint64_t MnkTable::plyCount( int cells, int ply )
+{
+    return binomial( cells, ply ) * binomial( ply, ply / 2 );
+}
+
+/*********************************************************************
+** Description: Ranks a set of bits among all sets with as many bits,
+*  in colexicographic order, which is the order of their values.
+*
+*  Parameters: uint32_t bits - the set.
+*
+*  Return: uint64_t - the sum over the bits of position choose i, the
+*  i-th bit from the bottom counting from 1.
+*********************************************************************/
+uint64_t MnkTable::combinationRank( uint32_t bits )
+{
+    uint64_t index = 0;
+
+    for( int i = 1; bits != 0; i++, bits &= bits - 1 )
+    {
+        index += BINOMIALS.values[__builtin_ctz( bits )][i];
+    }
+
+    return index;
+}
+
+/*********************************************************************
+** Description: Returns the set of bits with a given rank.
+*
+*  Parameters: uint64_t index - the rank.
+*              int count - the number of bits in the set.
+*
+*  Return: uint32_t - the set.
+*********************************************************************/
+uint32_t MnkTable::combinationUnrank( uint64_t index, int count )
+{
+    uint32_t bits = 0;
+    int position = MnkPosition::MAX_CELLS - 1;
+
+    for( int i = count; i >= 1; i-- )
+    {
+        while( BINOMIALS.values[position][i] > index )
+        {
+            position--;
+        }
+
+        index -= BINOMIALS.values[position][i];
+        bits |= 1U << position;
+        position--;
+    }
+
+    return bits;
+}
+
+/*********************************************************************
+** Description: Returns the index of a position within its ply.
+*
+*  Parameters: uint32_t first - the marks of the player who moved
+*              first.
+*              uint32_t second - the marks of the other player.
+*
+*  Return: uint64_t - the rank of the occupied cells times the number
+*  of ways to split them, plus the rank of the second player's share.
+*********************************************************************/
+uint64_t MnkTable::rank( uint32_t first, uint32_t second )
+{
+    uint32_t occupied = first | second,
+             share = 0;
+    int ply = __builtin_popcount( occupied );
+
+    //Number the occupied cells from 0 and keep the second player's.
+    int i = 0;
+
+    for( uint32_t cells = occupied; cells != 0; cells &= cells - 1, i++ )
+    {
+        if( second & cells & ( 0U - cells ) )
+        {
+            share |= 1U << i;
+        }
+    }
+
+    return combinationRank( occupied ) * binomial( ply, ply / 2 ) + combinationRank( share );
+}
+
+/*********************************************************************
+** Description: Returns the position with an index within its ply.
+*
+*  Parameters:
+*  1. uint64_t index - the index, below plyCount().
+*  2. int ply - the number of marks.
+*  3. uint32_t first - receives the marks of the player who moved
+*     first.
+*  4. uint32_t second - receives the marks of the other player.
+*********************************************************************/
+void MnkTable::unrank( uint64_t index, int ply, uint32_t &first, uint32_t &second )
+{
+    uint64_t splits = binomial( ply, ply / 2 );
+    uint32_t occupied = combinationUnrank( index / splits, ply ),
+             share = combinationUnrank( index % splits, ply / 2 );
+
+    first = 0;
+    second = 0;
+
+    for( int i = 0; occupied != 0; occupied &= occupied - 1, i++ )
+    {
+        uint32_t cell = occupied & ( 0U - occupied );
+
+        if( share >> i & 1 )
+            second |= cell;
+
+        else
+            first |= cell;
+    }
+}
+
+/*********************************************************************
+** Description: Splits the marks of a position by who moved first.
+*  The first player is to move whenever the number of marks is even.
+*
+*  Parameters:
+*  1. MnkPosition position - the position.
+*  2. uint32_t first - receives the marks of the player who moved
+*     first.
+*  3. uint32_t second - receives the marks of the other player.
+*********************************************************************/
+void MnkTable::splitMarks( const MnkPosition &position, uint32_t &first, uint32_t &second )
+{
+    Player firstPlayer = position.getPly() % 2 == 0 ? position.getToMove()
+                                                    : GameBoard::other( position.getToMove() );
+
+    first = position.getMarks( firstPlayer );
+    second = position.getMarks( GameBoard::other( firstPlayer ) );
+}
+
+/*********************************************************************
+** Description: Returns the file name of one ply of a table.
+*
+*  Parameters:
+*  1. string dir - the folder of the tables.
+*  2. int width, int height, int k - the board size.
+*  3. int ply - the number of marks.
+*
+*  Return: string - for example "tables/mnk_4x4x4_ply07.bin".
+*********************************************************************/
+string MnkTable::plyPath( const string &dir, int width, int height, int k, int ply )
+{
+    char name[64];
+    snprintf( name, sizeof( name ), "/mnk_%dx%dx%d_ply%02d.bin", width, height, k, ply );
+
+    return dir + name;
+}
+
+/*********************************************************************
+** Description: Checks that a mapped file is the expected ply table.
+*
+*  Parameters:
+*  1. MappedFile file - the mapped file.
+*  2. int width, int height, int k - the board size.
+*  3. int ply - the number of marks.
+*
+*  Return: bool - false, with a message, if the file does not match.
+*********************************************************************/
+bool MnkTable::checkHeader( const MappedFile &file, int width, int height, int k, int ply )
+{
+    Header header;
+    uint64_t count = plyCount( width * height, ply );
+
+    if( file.getSize() >= sizeof( Header ) )
+    {
+        memcpy( &header, file.getData(), sizeof( Header ) );
+
+        if( memcmp( header.magic, "MNKT", 4 ) == 0 && header.width == width && header.height == height
+            && header.k == k && header.ply == ply && header.count == count
+            && file.getSize() == sizeof( Header ) + count )
+        {
+            return true;
+        }
+    }
+
+    printf( "%s is not a solved table of ply %d!\n", plyPath( "", width, height, k, ply ).c_str() + 1, ply );
+
+    return false;
+}
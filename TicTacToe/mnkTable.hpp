@@ -0,0 +1,72 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The MnkTable class reads the solved tables of an m,n,k
+*  game written by the retrograde solver. There is one file per ply,
+*  holding the score of every position with that many marks. Positions
+*  are numbered by ranking: the occupied cells are a combination of
+*  ply cells out of all of them, and the cells of the player who moved
+*  second a combination of the occupied ones, so a ply file holds no
+*  unreachable mark counts. Only the ply being looked up is mapped.
+*********************************************************************/
+#ifndef MNK_TABLE_HPP
+#define MNK_TABLE_HPP
+
+#include "mnkPosition.hpp"
+#include "mappedFile.hpp"
+#include <string>
+
+using std::string;
+
+class MnkTable
+{
+    public:
+        /*********************************************************************
+         ** Description: This struct starts every ply file. The scores
+         *  follow, one int8_t per position in rank order.
+         *********************************************************************/
+        struct Header
+        {
+            char magic[4]; //"MNKT"
+            uint8_t width,
+                    height,
+                    k,
+                    ply;
+            uint64_t count;
+        };
+
+    private:
+        string dir;
+        int width,
+            height,
+            k;
+
+        MappedFile file;
+        int mappedPly;
+
+        const int8_t* plyScores( int );
+
+    public:
+        MnkTable();
+        bool open( const string &, int, int, int );
+        int score( const MnkPosition & );
+
+        //Getter functions.
+        bool isOpen() const { return !dir.empty(); };
+        int getWidth() const { return width; };
+        int getHeight() const { return height; };
+        int getK() const { return k; };
+
+        static uint64_t binomial( int, int );
+        static uint64_t plyCount( int, int );
+        static uint64_t combinationRank( uint32_t );
+        static uint32_t combinationUnrank( uint64_t, int );
+        static uint64_t rank( uint32_t, uint32_t );
+        static void unrank( uint64_t, int, uint32_t &, uint32_t & );
+        static void splitMarks( const MnkPosition &, uint32_t &, uint32_t & );
+        static string plyPath( const string &, int, int, int, int );
+        static bool checkHeader( const MappedFile &, int, int, int, int );
+};
+
+#endif
@@ -6,6 +6,7 @@
 *  interacted with the mouse pointer by clicking or hovering over.
 *********************************************************************/
 #include "mouseButtons.hpp"
+#include "profiler.hpp"
 
 
 /*********************************************************************
@@ -20,7 +21,6 @@ MouseButtons::MouseButtons()
 
     mouseOver = false;
     mouseClick = false;
-    pick = No_Player; //Button that a player has picked in Tic Tac Toe.
 
     xMouseLocation = 0;
     yMouseLocation = 0;
@@ -50,10 +50,15 @@ void MouseButtons::setButtonSpecs( int xLocation, int yLocation, int width, int
  *********************************************************************/
 void MouseButtons::handleEvent( SDL_Event* e )
 {
+    PROFILE_SCOPE( "handleEvent" );
+
     //Checks if a mouse event is occurring.
     if( e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN ) 
     {
-        SDL_GetMouseState( &xMouseLocation, &yMouseLocation );
+        //The position of the event, not of the mouse now, so events
+        //that did not come from moving the mouse land where they point.
+        xMouseLocation = e->type == SDL_MOUSEMOTION ? e->motion.x : e->button.x;
+        yMouseLocation = e->type == SDL_MOUSEMOTION ? e->motion.y : e->button.y;
         mouseOver = true;
         
         //Mouse is left of the button.
@@ -91,5 +96,4 @@ void MouseButtons::reset()
 {
     mouseOver = false;
     mouseClick = false;
-    pick = No_Player;
 }
@@ -10,10 +10,6 @@
 
 #include <SDL.h>
 
-//Used to store information on which player has
-//picked this button.
-enum Player { X_Player, O_Player, No_Player };
-
 class MouseButtons
 {
 	private:
@@ -31,9 +27,6 @@ class MouseButtons
         bool mouseOver,
              mouseClick;
 
-        //Stores which player has picked this button.
-        Player pick;
-
 	public:
         MouseButtons();
 		void handleEvent( SDL_Event* e );
@@ -47,10 +40,6 @@ class MouseButtons
         int  getYLocation()  { return yLocation; };
         int  getWidth()      { return width; };
         int  getHeight()     { return height; };
-        Player getPick()     { return pick; };
-
-        //Sets the player that picks the button.
-        void setPick( Player pick ) { this->pick = pick; };
 };
 
 #endif
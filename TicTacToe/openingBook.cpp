@@ -0,0 +1,246 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The OpeningBook class reads an opening book of an m,n,k
+*  game, written by the bookmaker tool from the results of self-play
+*  games. A book is one memory mapped file: a header, then an entry per
+*  position sorted by key, found by binary search. Positions that are
+*  reflections or rotations of each other share an entry, keyed by the
+*  smallest of their keys, and the book move is stored in that
+*  orientation and turned back on the way out.
+*********************************************************************/
+#include "openingBook.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/*********************************************************************
+** Description: Constructor. No book is open.
+*********************************************************************/
+OpeningBook::OpeningBook()
+{
+    memset( &header, 0, sizeof( header ) );
+    entries = NULL;
+}
+
+/*********************************************************************
+** Description: Opens a book file.
+*
+*  Parameters: string path - the book file.
+*
+*  Return: bool - false if the file is missing or is not a book.
+*********************************************************************/
+bool OpeningBook::open( const string &path )
+{
+    close();
+
+    if( !file.open( path ) )
+    {
+        return false;
+    }
+
+    if( file.getSize() >= sizeof( Header ) )
+    {
+        memcpy( &header, file.getData(), sizeof( Header ) );
+
+        if( memcmp( header.magic, "MNKB", 4 ) == 0
+            && MnkPosition::validSize( header.width, header.height, header.k )
+            && file.getSize() == sizeof( Header ) + header.count * sizeof( Entry ) )
+        {
+            entries = reinterpret_cast< const Entry* >( file.getData() + sizeof( Header ) );
+            return true;
+        }
+    }
+
+    printf( "%s is not an opening book!\n", path.c_str() );
+    close();
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Closes the book file.
+*********************************************************************/
+void OpeningBook::close()
+{
+    file.close();
+    entries = NULL;
+}
+
+/*********************************************************************
+** Description: Looks up the book move of a position.
+*
+*  Parameters: MnkPosition position - a position of the book's size.
+*              int move - receives the book move, in the position's
+*              own orientation.
+*
+*  Return: const Entry* - the position's entry, or NULL if it is not
+*  in the book.
+*********************************************************************/
+const OpeningBook::Entry* OpeningBook::find( const MnkPosition &position, int &move ) const
+{
+    if( entries == NULL || position.getPly() >= header.plies || position.getWidth() != header.width
+        || position.getHeight() != header.height || position.getK() != header.k )
+    {
+        return NULL;
+    }
+
+    int transform = 0;
+    uint64_t key = canonicalKey( position, transform );
+
+    const Entry* end = entries + header.count;
+    const Entry* entry = std::lower_bound( entries, end, key,
+                                           []( const Entry &e, uint64_t k ) { return e.key < k; } );
+
+    if( entry == end || entry->key != key )
+    {
+        return NULL;
+    }
+
+    move = untransformCell( entry->move, transform, header.width, header.height );
+
+    return entry;
+}
+
+/*********************************************************************
+** Description: Returns the key shared by a position and its
+*  reflections and rotations: the smallest of their keys, where a key
+*  holds the marks of the player to move above the other player's, so
+*  a position is found whichever player started.
+*
+*  Parameters: MnkPosition position - the position.
+*              int transform - receives the orientation the key is of.
+*
+*  Return: uint64_t - the key.
+*********************************************************************/
+uint64_t OpeningBook::canonicalKey( const MnkPosition &position, int &transform )
+{
+    int width = position.getWidth(),
+        height = position.getHeight();
+    uint32_t mover = position.getMarks( position.getToMove() ),
+             opponent = position.getMarks( GameBoard::other( position.getToMove() ) );
+    uint64_t best = 0;
+
+    //Boards that are not square can not be turned a quarter.
+    for( int t = 0; t < ( width == height ? 8 : 4 ); t++ )
+    {
+        uint32_t marks[2] = { 0, 0 };
+
+        for( uint32_t bits = mover; bits != 0; bits &= bits - 1 )
+        {
+            marks[0] |= 1U << transformCell( __builtin_ctz( bits ), t, width, height );
+        }
+
+        for( uint32_t bits = opponent; bits != 0; bits &= bits - 1 )
+        {
+            marks[1] |= 1U << transformCell( __builtin_ctz( bits ), t, width, height );
+        }
+
+        uint64_t key = static_cast<uint64_t>( marks[0] ) << 32 | marks[1];
+
+        if( t == 0 || key < best )
+        {
+            best = key;
+            transform = t;
+        }
+    }
+
+    return best;
+}
+
+/*********************************************************************
+** Description: Moves a cell by one of the board's symmetries: bit 0
+*  of the transform mirrors the columns, bit 1 the rows and bit 2, on
+*  square boards only, swaps rows and columns.
+*
+*  Parameters:
+*  1. int cell - the cell, row * width + column.
+*  2. int transform - the symmetry, 0 to 7.
+*  3. int width, int height - the board size.
+*
+*  Return: int - the cell it moves to.
+*********************************************************************/
+int OpeningBook::transformCell( int cell, int transform, int width, int height )
+{
+    int x = cell % width,
+        y = cell / width;
+
+    if( transform & 1 )
+        x = width - 1 - x;
+
+    if( transform & 2 )
+        y = height - 1 - y;
+
+    if( transform & 4 )
+        std::swap( x, y );
+
+    return y * width + x;
+}
+
+/*********************************************************************
+** Description: Undoes transformCell().
+*
+*  Parameters:
+*  1. int cell - the moved cell.
+*  2. int transform - the symmetry, 0 to 7.
+*  3. int width, int height - the board size.
+*
+*  Return: int - the cell that moves to it.
+*********************************************************************/
+int OpeningBook::untransformCell( int cell, int transform, int width, int height )
+{
+    int x = cell % width,
+        y = cell / width;
+
+    if( transform & 4 )
+        std::swap( x, y );
+
+    if( transform & 2 )
+        y = height - 1 - y;
+
+    if( transform & 1 )
+        x = width - 1 - x;
+
+    return y * width + x;
+}
+
+/*********************************************************************
+** Description: Writes a book file, sorting its entries first.
+*
+*  Parameters:
+*  1. string path - the book file.
+*  2. int width, int height, int k - the board size.
+*  3. int plies - positions with fewer marks may be in the book.
+*  4. vector<Entry> entries - the entries, one per key.
+*
+*  Return: bool - false if the file could not be written.
+*********************************************************************/
+bool OpeningBook::write( const string &path, int width, int height, int k, int plies, vector< Entry > &entries )
+{
+    MappedFile out;
+
+    std::sort( entries.begin(), entries.end(), []( const Entry &a, const Entry &b ) { return a.key < b.key; } );
+
+    if( !out.create( path, sizeof( Header ) + entries.size() * sizeof( Entry ) ) )
+    {
+        printf( "Could not write %s!\n", path.c_str() );
+        return false;
+    }
+
+    Header header;
+    memcpy( header.magic, "MNKB", 4 );
+    header.width = static_cast<uint8_t>( width );
+    header.height = static_cast<uint8_t>( height );
+    header.k = static_cast<uint8_t>( k );
+    header.plies = static_cast<uint8_t>( plies );
+    header.count = entries.size();
+    memcpy( out.getData(), &header, sizeof( header ) );
+
+    if( !entries.empty() )
+    {
+        memcpy( out.getData() + sizeof( header ), &entries[0], entries.size() * sizeof( Entry ) );
+    }
+
+    return true;
+}
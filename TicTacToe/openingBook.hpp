@@ -0,0 +1,80 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The OpeningBook class reads an opening book of an m,n,k
+*  game, written by the bookmaker tool from the results of self-play
+*  games. A book is one memory mapped file: a header, then an entry per
+*  position sorted by key, found by binary search. Positions that are
+*  reflections or rotations of each other share an entry, keyed by the
+*  smallest of their keys, and the book move is stored in that
+*  orientation and turned back on the way out.
+*********************************************************************/
+#ifndef OPENING_BOOK_HPP
+#define OPENING_BOOK_HPP
+
+#include "mnkPosition.hpp"
+#include "mappedFile.hpp"
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class OpeningBook
+{
+    public:
+        /*********************************************************************
+         ** Description: This struct starts a book file. The entries follow,
+         *  sorted by key.
+         *********************************************************************/
+        struct Header
+        {
+            char magic[4]; //"MNKB"
+            uint8_t width,
+                    height,
+                    k,
+                    plies; //Positions with fewer marks are in the book.
+            uint64_t count;
+        };
+
+        /*********************************************************************
+         ** Description: This struct is the book move of one position.
+         *********************************************************************/
+        struct Entry
+        {
+            uint64_t key; //The mover's marks above the opponent's.
+            uint32_t games; //Games the book move was played in.
+            uint16_t score; //The mover's points in them, 0 to SCORE_SCALE.
+            uint8_t move,
+                    moveCount; //Different moves played in the position.
+        };
+
+        static const int SCORE_SCALE = 10000;
+
+    private:
+        MappedFile file;
+        Header header;
+        const Entry* entries;
+
+    public:
+        OpeningBook();
+        bool open( const string & );
+        const Entry* find( const MnkPosition &, int & ) const;
+        void close();
+
+        //Getter functions.
+        bool isOpen() const { return entries != NULL; };
+        int getWidth() const { return header.width; };
+        int getHeight() const { return header.height; };
+        int getK() const { return header.k; };
+        int getPlies() const { return header.plies; };
+        uint64_t getCount() const { return header.count; };
+
+        static uint64_t canonicalKey( const MnkPosition &, int & );
+        static int transformCell( int, int, int, int );
+        static int untransformCell( int, int, int, int );
+        static bool write( const string &, int, int, int, int, vector< Entry > & );
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The PerfectPlayer class plays from a table holding the
+*  game theoretic score of every Tic Tac Toe position. The table is
+*  solved once, when the first PerfectPlayer is created, and shared by
+*  every player and thread after that.
+*********************************************************************/
+#include "perfectPlayer.hpp"
+
+//Positions are indexed by the player to move and both players' marks.
+static const int TABLE_SIZE = 1 << 19;
+static const int8_t UNKNOWN = -128;
+
+/*********************************************************************
+** Description: Returns the table index of a position.
+*********************************************************************/
+static int tableIndex( const GamePosition &position )
+{
+    const GameBoard &board = position.getBoard();
+
+    return position.getToMove() << 18 | board.getMarks( X_Player ) << 9 | board.getMarks( O_Player );
+}
+
+/*********************************************************************
+** Description: Returns the solved table, solving it on the first call.
+*  The static local is initialized once even when several threads ask
+*  for it at the same time.
+*********************************************************************/
+const int8_t* PerfectPlayer::table()
+{
+    struct Table
+    {
+        int8_t scores[TABLE_SIZE];
+
+        Table()
+        {
+            for( int i = 0; i < TABLE_SIZE; i++ )
+            {
+                scores[i] = UNKNOWN;
+            }
+
+            GamePosition xFirst( X_Player ),
+                         oFirst( O_Player );
+
+            solve( xFirst, scores );
+            solve( oFirst, scores );
+        }
+    };
+
+    static Table solved;
+
+    return solved.scores;
+}
+
+/*********************************************************************
+** Description: Scores a position for the player to move with negamax.
+*  A win scores 1 plus the number of empty cells left, so a quicker win
+*  scores higher and a later loss scores higher than an earlier one.
+*
+*  Parameters: GamePosition position - the position, restored on return.
+*              int8_t* scores - the table being filled in.
+*
+*  Return: int8_t - the score for the player to move.
+*********************************************************************/
+int8_t PerfectPlayer::solve( GamePosition &position, int8_t* scores )
+{
+    int8_t &entry = scores[tableIndex( position )];
+
+    if( entry != UNKNOWN )
+    {
+        return entry;
+    }
+
+    int empty = __builtin_popcount( position.getBoard().getEmpty() );
+
+    if( position.getOutcome() == DRAW )
+    {
+        entry = 0;
+    }
+
+    //The player who just moved won.
+    else if( position.getOutcome() != UNFINISHED )
+    {
+        entry = static_cast<int8_t>( -( 1 + empty ) );
+    }
+
+    else
+    {
+        int moves[GamePosition::MAX_MOVES];
+        int count = position.getMoves( moves );
+        int best = -GameBoard::CELLS - 1;
+
+        for( int i = 0; i < count; i++ )
+        {
+            position.play( moves[i] );
+            int value = -solve( position, scores );
+            position.undo( moves[i] );
+
+            if( value > best )
+            {
+                best = value;
+            }
+        }
+
+        entry = static_cast<int8_t>( best );
+    }
+
+    return entry;
+}
+
+/*********************************************************************
+** Description: Returns the solved score of a position.
+*
+*  Parameters: GamePosition position - any reachable position.
+*
+*  Return: int - positive if the player to move wins with best play,
+*  negative if they lose and 0 for a draw.
+*********************************************************************/
+int PerfectPlayer::score( const GamePosition &position )
+{
+    return table()[tableIndex( position )];
+}
+
+/*********************************************************************
+** Description: Chooses a random move among the best ones.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int PerfectPlayer::chooseMove( const GamePosition &position )
+{
+    int moves[GamePosition::MAX_MOVES],
+        best[GamePosition::MAX_MOVES];
+    int count = position.getMoves( moves ),
+        bestCount = 0,
+        bestScore = -GameBoard::CELLS - 1;
+
+    for( int i = 0; i < count; i++ )
+    {
+        GamePosition next = position;
+        next.play( moves[i] );
+        int value = -score( next );
+
+        if( value > bestScore )
+        {
+            bestScore = value;
+            bestCount = 0;
+        }
+
+        if( value == bestScore )
+        {
+            best[bestCount++] = moves[i];
+        }
+    }
+
+    return bestCount > 0 ? best[random.nextInt( bestCount )] : -1;
+}
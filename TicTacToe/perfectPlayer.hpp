@@ -0,0 +1,31 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The PerfectPlayer class plays from a table holding the
+*  game theoretic score of every Tic Tac Toe position. The table is
+*  solved once, when the first PerfectPlayer is created, and shared by
+*  every player and thread after that.
+*********************************************************************/
+#ifndef PERFECT_PLAYER_HPP
+#define PERFECT_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+
+class PerfectPlayer : public AiPlayer
+{
+    private:
+        Random random; //Chooses between equally good moves.
+
+        static const int8_t* table();
+        static int8_t solve( GamePosition &, int8_t* );
+
+    public:
+        PerfectPlayer( const Random &random ) : random( random ) { table(); };
+        int chooseMove( const GamePosition & );
+        string getName() const { return "perfect"; };
+
+        static int score( const GamePosition & );
+};
+
+#endif
@@ -0,0 +1,238 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Profiler records how long each stage of a frame
+*  takes. PROFILE_SCOPE( "name" ) times the rest of the enclosing
+*  block. Every thread writes into its own ring buffer without locks,
+*  and exportTrace() writes the buffers as Chrome trace-event JSON
+*  (open with chrome://tracing or Perfetto). When a thread exits, its
+*  buffer is handed to the next thread that starts.
+*
+*  The StartupProfiler times the phases of starting the game, from the
+*  start of the process to the first frame on the screen.
+*********************************************************************/
+#include "profiler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+std::atomic< Profiler::ThreadBuffer* > Profiler::buffers( NULL );
+std::atomic< unsigned > Profiler::threadCount( 0 );
+std::atomic< bool > Profiler::enabled( false );
+
+const char* StartupProfiler::names[StartupProfiler::MAX_PHASES];
+long long StartupProfiler::ends[StartupProfiler::MAX_PHASES];
+int StartupProfiler::count = 0;
+long long StartupProfiler::origin = Profiler::now(); //Static initialization, before main().
+
+/*********************************************************************
+** Description: Returns the current time.
+*
+*  Return: long long - nanoseconds since an arbitrary starting point.
+*********************************************************************/
+long long Profiler::now()
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+           std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/*********************************************************************
+** Description: Returns the ring buffer of the calling thread. On first
+*  use the thread takes over the buffer of a thread that has exited,
+*  keeping its events and its row in the trace, or creates and
+*  registers a new one if every buffer is owned. Buffers are never
+*  freed, so they can still be exported after their thread is gone,
+*  and the list of buffers only grows to the most threads ever running
+*  at once.
+*
+*  Return: ThreadBuffer* - the buffer of this thread.
+*********************************************************************/
+Profiler::ThreadBuffer* Profiler::threadBuffer()
+{
+    static thread_local BufferOwner owner;
+
+    if( owner.buffer != NULL )
+    {
+        return owner.buffer;
+    }
+
+    for( ThreadBuffer* buffer = buffers.load(); buffer != NULL; buffer = buffer->next )
+    {
+        bool owned = false;
+
+        if( !buffer->owned.load( std::memory_order_relaxed )
+            && buffer->owned.compare_exchange_strong( owned, true, std::memory_order_acquire ) )
+        {
+            owner.buffer = buffer;
+            return buffer;
+        }
+    }
+
+    ThreadBuffer* buffer = new ThreadBuffer();
+    buffer->written.store( 0, std::memory_order_relaxed );
+    buffer->owned.store( true, std::memory_order_relaxed );
+    buffer->threadId = threadCount.fetch_add( 1 ) + 1;
+    buffer->next = buffers.load();
+
+    while( !buffers.compare_exchange_weak( buffer->next, buffer ) )
+    {
+        //buffer->next was refreshed by the failed exchange.
+    }
+
+    owner.buffer = buffer;
+
+    return buffer;
+}
+
+/*********************************************************************
+** Description: Stores a timed scope in the calling thread's buffer,
+*  overwriting the oldest event when the buffer is full. The fence
+*  orders the count of the events before this one ahead of the new
+*  event, so an export that reads a half written event also sees that
+*  it may have been overwritten. On x86 it only keeps the compiler
+*  from reordering the stores.
+*
+*  Parameters:
+*  1. const char* name - the scope name, a string literal.
+*  2. long long start - the start time from now().
+*  3. long long end - the end time from now().
+*********************************************************************/
+void Profiler::record( const char* name, long long start, long long end )
+{
+    ThreadBuffer* buffer = threadBuffer();
+    unsigned long long index = buffer->written.load( std::memory_order_relaxed );
+
+    std::atomic_thread_fence( std::memory_order_release );
+
+    Event &event = buffer->events[index % CAPACITY];
+    event.name.store( name, std::memory_order_relaxed );
+    event.start.store( start, std::memory_order_relaxed );
+    event.duration.store( end - start, std::memory_order_relaxed );
+
+    buffer->written.store( index + 1, std::memory_order_release );
+}
+
+/*********************************************************************
+** Description: Writes the recorded events of every thread as Chrome
+*  trace-event JSON. Can be called at any time: each ring is copied,
+*  then its count of written events is read again, and the events its
+*  thread may have overwritten during the copy are left out, like the
+*  retry check of a sequence lock.
+*
+*  Parameters: string path - the JSON file to write.
+*
+*  Return: bool - indicates whether the file was written.
+*********************************************************************/
+bool Profiler::exportTrace( const string &path )
+{
+    FILE* file = fopen( path.c_str(), "w" );
+
+    if( file == NULL )
+    {
+        printf( "Unable to write %s!\n", path.c_str() );
+        return false;
+    }
+
+    fprintf( file, "{\"traceEvents\":[\n" );
+
+    bool first = true;
+    std::vector< const char* > names( CAPACITY );
+    std::vector< long long > starts( CAPACITY ),
+                             durations( CAPACITY );
+
+    for( ThreadBuffer* buffer = buffers.load(); buffer != NULL; buffer = buffer->next )
+    {
+        unsigned long long end = buffer->written.load( std::memory_order_acquire );
+        unsigned long long begin = end > CAPACITY ? end - CAPACITY : 0;
+
+        for( unsigned long long i = begin; i < end; i++ )
+        {
+            const Event &event = buffer->events[i % CAPACITY];
+
+            names[i % CAPACITY] = event.name.load( std::memory_order_relaxed );
+            starts[i % CAPACITY] = event.start.load( std::memory_order_relaxed );
+            durations[i % CAPACITY] = event.duration.load( std::memory_order_relaxed );
+        }
+
+        //The thread may be writing event "after", which overwrites event "after - CAPACITY".
+        std::atomic_thread_fence( std::memory_order_acquire );
+        unsigned long long after = buffer->written.load( std::memory_order_relaxed );
+
+        if( after >= CAPACITY && after - CAPACITY + 1 > begin )
+        {
+            begin = after - CAPACITY + 1;
+        }
+
+        for( unsigned long long i = begin; i < end; i++ )
+        {
+            fprintf( file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",\n", names[i % CAPACITY], buffer->threadId,
+                     starts[i % CAPACITY] / 1000.0, durations[i % CAPACITY] / 1000.0 );
+
+            first = false;
+        }
+    }
+
+    fprintf( file, "\n]}\n" );
+    fclose( file );
+
+    printf( "Profile written to %s\n", path.c_str() );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Forgets the phases and starts timing again from now,
+*  for measuring another start up in the same process.
+*********************************************************************/
+void StartupProfiler::reset()
+{
+    count = 0;
+    origin = Profiler::now();
+}
+
+/*********************************************************************
+** Description: Ends the current phase of the start up. The phase is
+*  also recorded in the frame profile when it is enabled. Phases past
+*  MAX_PHASES are dropped.
+*
+*  Parameters: const char* name - a string literal naming the phase.
+*********************************************************************/
+void StartupProfiler::mark( const char* name )
+{
+    long long end = Profiler::now();
+
+    if( count >= MAX_PHASES )
+    {
+        return;
+    }
+
+    if( Profiler::isEnabled() )
+    {
+        Profiler::record( name, count > 0 ? ends[count - 1] : origin, end );
+    }
+
+    names[count] = name;
+    ends[count] = end;
+    count++;
+}
+
+/*********************************************************************
+** Description: Prints how long each phase took and the time from the
+*  start of the process to the end of the last phase.
+*********************************************************************/
+void StartupProfiler::report()
+{
+    long long start = origin;
+
+    printf( "Startup phases:\n" );
+
+    for( int i = 0; i < count; i++ )
+    {
+        printf( "  %-28s %8.2f ms\n", names[i], ( ends[i] - start ) / 1e6 );
+        start = ends[i];
+    }
+
+    printf( "  %-28s %8.2f ms\n", "total", ( start - origin ) / 1e6 );
+}
@@ -0,0 +1,148 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Profiler records how long each stage of a frame
+*  takes. PROFILE_SCOPE( "name" ) times the rest of the enclosing
+*  block. Every thread writes into its own ring buffer without locks,
+*  and exportTrace() writes the buffers as Chrome trace-event JSON
+*  (open with chrome://tracing or Perfetto). When a thread exits, its
+*  buffer is handed to the next thread that starts, so short lived
+*  threads such as search workers do not each keep a buffer, and share
+*  rows of the trace.
+*
+*  The StartupProfiler times the phases of starting the game, from the
+*  start of the process to the first frame on the screen.
+*
+*  While the profiler is disabled a scope costs a relaxed load and two
+*  well-predicted branches, one where it starts and one where it ends.
+*  Compiling with -DNO_PROFILER removes the scopes entirely.
+*********************************************************************/
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <string>
+using std::string;
+
+class Profiler
+{
+    private:
+        static const unsigned CAPACITY = 1 << 15; //Events kept per thread.
+
+        /*********************************************************************
+         ** Description: This struct represents one timed scope.
+         *********************************************************************/
+        struct Event
+        {
+            std::atomic< const char* > name; //Must be a string literal.
+            std::atomic< long long > start,
+                                     duration; //Nanoseconds.
+        };
+
+        /*********************************************************************
+         ** Description: This struct is the ring buffer of one thread. Only
+         *  its owner writes to it; "written" publishes the new events and,
+         *  as it only grows, tells exportTrace() which it may have missed.
+         *********************************************************************/
+        struct ThreadBuffer
+        {
+            Event events[CAPACITY];
+            std::atomic< unsigned long long > written;
+            std::atomic< bool > owned; //A running thread writes to it.
+            unsigned threadId;
+            ThreadBuffer* next;
+        };
+
+        /*********************************************************************
+         ** Description: This struct holds the buffer of a thread and gives
+         *  it back when the thread exits.
+         *********************************************************************/
+        struct BufferOwner
+        {
+            ThreadBuffer* buffer;
+
+            BufferOwner() : buffer( NULL ) {};
+            ~BufferOwner() { if( buffer != NULL ) buffer->owned.store( false, std::memory_order_release ); };
+        };
+
+        static std::atomic< ThreadBuffer* > buffers; //Lock-free list of all buffers.
+        static std::atomic< unsigned > threadCount;
+        static std::atomic< bool > enabled;
+
+        static ThreadBuffer* threadBuffer();
+
+    public:
+        static void setEnabled( bool on ) { enabled.store( on, std::memory_order_relaxed ); };
+        static bool isEnabled() { return enabled.load( std::memory_order_relaxed ); };
+        static long long now();
+        static void record( const char*, long long, long long );
+        static bool exportTrace( const string & );
+};
+
+/*********************************************************************
+** Description: The ProfileScope class times its own lifetime. Use it
+*  through the PROFILE_SCOPE macro.
+*********************************************************************/
+class ProfileScope
+{
+    private:
+        const char* name; //NULL while the profiler is disabled.
+        long long start;
+
+    public:
+        explicit ProfileScope( const char* name )
+        {
+            this->name = NULL;
+            start = 0;
+
+            if( Profiler::isEnabled() )
+            {
+                this->name = name;
+                start = Profiler::now();
+            }
+        }
+
+        ~ProfileScope()
+        {
+            if( name != NULL )
+            {
+                Profiler::record( name, start, Profiler::now() );
+            }
+        }
+};
+
+/*********************************************************************
+** Description: The StartupProfiler class splits the time from the
+*  start of the process to the first frame into phases. mark( "name" )
+*  ends the phase running since the last mark, and report() prints
+*  them. Meant for the render thread while the game starts, so it is
+*  not synchronized.
+*********************************************************************/
+class StartupProfiler
+{
+    private:
+        static const int MAX_PHASES = 16;
+
+        static const char* names[MAX_PHASES]; //Must be string literals.
+        static long long ends[MAX_PHASES];
+        static int count;
+        static long long origin; //When the program was loaded.
+
+    public:
+        static void reset();
+        static void mark( const char* );
+        static void report();
+        static long long getElapsed() { return Profiler::now() - origin; };
+};
+
+#define PROFILE_CONCAT_( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_( a, b )
+
+#ifdef NO_PROFILER
+#define PROFILE_SCOPE( name )
+#else
+#define PROFILE_SCOPE( name ) ProfileScope PROFILE_CONCAT( profileScope, __LINE__ )( name )
+#endif
+
+#endif
@@ -0,0 +1,231 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The QubicPosition class is a position of Qubic, Tic Tac
+*  Toe on a 4x4x4 cube where four in a row in any direction wins. Each
+*  player's stones are one 64 bit mask, bit z * 16 + y * 4 + x, and the
+*  76 winning lines are precomputed masks, so checking a move for a win
+*  is an AND and a compare for each of the lines through its cell.
+*********************************************************************/
+#include "qubicPosition.hpp"
+
+/*********************************************************************
+** Description: The QubicLines struct holds the 76 winning lines and,
+*  for every cell, the lines through it: 7 for the corners and the
+*  eight center cells, 4 for every other cell.
+*********************************************************************/
+struct QubicLines
+{
+    static const int MAX_PER_CELL = 7;
+
+    uint64_t lines[QubicPosition::LINES];
+    uint64_t cellLines[QubicPosition::CELLS][MAX_PER_CELL];
+    int cellLineCount[QubicPosition::CELLS];
+
+    /*********************************************************************
+     ** Description: Constructor. Walks the 13 directions that are not
+     *  the reverse of another and keeps every start that fits four
+     *  steps inside the cube.
+     *********************************************************************/
+    QubicLines()
+    {
+        const int SIZE = QubicPosition::SIZE;
+        int count = 0;
+
+        for( int cell = 0; cell < QubicPosition::CELLS; cell++ )
+        {
+            cellLineCount[cell] = 0;
+        }
+
+        for( int dz = -1; dz <= 1; dz++ )
+        {
+            for( int dy = -1; dy <= 1; dy++ )
+            {
+                for( int dx = -1; dx <= 1; dx++ )
+                {
+                    //Only the first of each pair of opposite directions.
+                    int direction = dz * 9 + dy * 3 + dx;
+
+                    if( direction <= 0 )
+                    {
+                        continue;
+                    }
+
+                    for( int start = 0; start < QubicPosition::CELLS; start++ )
+                    {
+                        int x = start % SIZE,
+                            y = start / SIZE % SIZE,
+                            z = start / ( SIZE * SIZE );
+                        int endX = x + dx * ( SIZE - 1 ),
+                            endY = y + dy * ( SIZE - 1 ),
+                            endZ = z + dz * ( SIZE - 1 );
+
+                        if( endX < 0 || endX >= SIZE || endY < 0 || endY >= SIZE || endZ < 0 || endZ >= SIZE )
+                        {
+                            continue;
+                        }
+
+                        uint64_t line = 0;
+
+                        for( int step = 0; step < SIZE; step++ )
+                        {
+                            line |= 1ULL << ( ( z + dz * step ) * SIZE * SIZE + ( y + dy * step ) * SIZE + x + dx * step );
+                        }
+
+                        lines[count++] = line;
+                    }
+                }
+            }
+        }
+
+        for( int i = 0; i < count; i++ )
+        {
+            for( uint64_t cells = lines[i]; cells != 0; cells &= cells - 1 )
+            {
+                int cell = __builtin_ctzll( cells );
+                cellLines[cell][cellLineCount[cell]++] = lines[i];
+            }
+        }
+    }
+};
+
+//Built before main() runs; nothing uses it during static initialization.
+static const QubicLines QUBIC_LINES;
+
+/*********************************************************************
+** Description: Constructor. Starts with an empty cube.
+*
+*  Parameters: Player toMove - the player who makes the first move.
+*********************************************************************/
+QubicPosition::QubicPosition( Player toMove )
+{
+    stones[X_Player] = 0;
+    stones[O_Player] = 0;
+    winningLine = 0;
+    this->toMove = toMove;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Makes a move for the player to move. Only the lines
+*  through the new stone are checked.
+*
+*  Parameters: int cell - z * 16 + y * 4 + x.
+*
+*  Return: bool - false if the game is over or the cell is taken.
+*********************************************************************/
+bool QubicPosition::play( int cell )
+{
+    if( outcome != UNFINISHED || cell < 0 || cell >= CELLS )
+    {
+        return false;
+    }
+
+    uint64_t bit = 1ULL << cell;
+
+    if( ( stones[X_Player] | stones[O_Player] ) & bit )
+    {
+        return false;
+    }
+
+    uint64_t own = stones[toMove] |= bit;
+
+    for( int i = 0; i < QUBIC_LINES.cellLineCount[cell]; i++ )
+    {
+        uint64_t line = QUBIC_LINES.cellLines[cell][i];
+
+        if( ( own & line ) == line )
+        {
+            winningLine = line;
+            outcome = toMove == X_Player ? X_WON : O_WON;
+        }
+    }
+
+    if( outcome == UNFINISHED && getEmpty() == 0 )
+    {
+        outcome = DRAW;
+    }
+
+    toMove = GameBoard::other( toMove );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Takes back the last move, which was made in a cell.
+*
+*  Parameters: int cell - the cell of the last move.
+*********************************************************************/
+void QubicPosition::undo( int cell )
+{
+    toMove = GameBoard::other( toMove );
+    stones[toMove] &= ~( 1ULL << cell );
+    winningLine = 0;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Lists the legal moves.
+*
+*  Parameters: int* moves - receives up to MAX_MOVES cells.
+*
+*  Return: int - the number of legal moves.
+*********************************************************************/
+int QubicPosition::getMoves( int* moves ) const
+{
+    int count = 0;
+
+    if( outcome == UNFINISHED )
+    {
+        for( uint64_t empty = getEmpty(); empty != 0; empty &= empty - 1 )
+        {
+            moves[count++] = __builtin_ctzll( empty );
+        }
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Returns which player has a stone in a cell.
+*
+*  Parameters: int cell - z * 16 + y * 4 + x.
+*
+*  Return: Player - X_Player, O_Player or No_Player.
+*********************************************************************/
+Player QubicPosition::getPick( int cell ) const
+{
+    uint64_t bit = 1ULL << cell;
+
+    if( stones[X_Player] & bit )
+        return X_Player;
+
+    if( stones[O_Player] & bit )
+        return O_Player;
+
+    return No_Player;
+}
+
+/*********************************************************************
+** Description: Returns one of the 76 winning lines.
+*
+*  Parameters: int line - 0 to LINES - 1.
+*
+*  Return: uint64_t - the mask of the line's four cells.
+*********************************************************************/
+uint64_t QubicPosition::getLine( int line )
+{
+    return QUBIC_LINES.lines[line];
+}
+
+/*********************************************************************
+** Description: Compares two positions.
+*
+*  Return: bool - true if the stones and the player to move match.
+*********************************************************************/
+bool QubicPosition::operator==( const QubicPosition &other ) const
+{
+    return toMove == other.toMove && stones[X_Player] == other.stones[X_Player]
+        && stones[O_Player] == other.stones[O_Player];
+}
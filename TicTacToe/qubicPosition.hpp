@@ -0,0 +1,49 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The QubicPosition class is a position of Qubic, Tic Tac
+*  Toe on a 4x4x4 cube where four in a row in any direction wins. Each
+*  player's stones are one 64 bit mask, bit z * 16 + y * 4 + x, and the
+*  76 winning lines are precomputed masks, so checking a move for a win
+*  is an AND and a compare for each of the lines through its cell.
+*********************************************************************/
+#ifndef QUBIC_POSITION_HPP
+#define QUBIC_POSITION_HPP
+
+#include "gameBoard.hpp"
+
+class QubicPosition
+{
+    private:
+        uint64_t stones[2]; //Indexed by X_Player and O_Player.
+        uint64_t winningLine; //The completed line once the game is won.
+        Player toMove;
+        Outcome outcome;
+
+    public:
+        static const int SIZE = 4;
+        static const int CELLS = SIZE * SIZE * SIZE;
+        static const int MAX_MOVES = CELLS;
+        static const int LINES = 76;
+
+        QubicPosition( Player toMove = X_Player );
+        bool play( int );
+        void undo( int );
+        int getMoves( int* ) const;
+        Player getPick( int ) const;
+
+        //Getter functions.
+        uint64_t getStones( Player player ) const { return stones[player]; };
+        uint64_t getEmpty() const { return ~( stones[X_Player] | stones[O_Player] ); };
+        uint64_t getWinningLine() const { return winningLine; };
+        Player getToMove() const { return toMove; };
+        Outcome getOutcome() const { return outcome; };
+
+        static uint64_t getLine( int );
+
+        bool operator==( const QubicPosition & ) const;
+        bool operator!=( const QubicPosition &other ) const { return !( *this == other ); };
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Random class is a small seedable random number
+*  generator (PCG32). Every game, AI and simulation is handed its own
+*  Random object instead of sharing the global rand() state, so a run
+*  can be replayed from its seed and threads never contend on a lock.
+*********************************************************************/
+#include "random.hpp"
+#include <ctime>
+
+/*********************************************************************
+** Description: Scrambles a number with the SplitMix64 finalizer, so
+*  seeds that differ in a few bits give unrelated generators.
+*
+*  Parameters: uint64_t value - the number to scramble.
+*
+*  Return: uint64_t - the scrambled number.
+*********************************************************************/
+static uint64_t mix( uint64_t value )
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+
+    return value ^ ( value >> 31 );
+}
+
+/*********************************************************************
+** Description: Constructor. Two generators with the same seed but a
+*  different stream produce independent sequences.
+*
+*  Parameters:
+*  1. uint64_t seed - the starting seed.
+*  2. uint64_t stream - the stream number, e.g. one per thread.
+*********************************************************************/
+Random::Random( uint64_t seed, uint64_t stream )
+{
+    this->seed = seed;
+    this->stream = stream;
+
+    state = 0;
+    increment = ( stream << 1 ) | 1;
+    next();
+    state += seed;
+    next();
+}
+
+/*********************************************************************
+** Description: Advances the generator.
+*
+*  Return: uint32_t - the next 32 random bits.
+*********************************************************************/
+uint32_t Random::next()
+{
+    uint64_t oldState = state;
+    state = oldState * 6364136223846793005ULL + increment;
+
+    uint32_t xorShifted = static_cast<uint32_t>( ( ( oldState >> 18 ) ^ oldState ) >> 27 );
+    uint32_t rotation = static_cast<uint32_t>( oldState >> 59 );
+
+    return ( xorShifted >> rotation ) | ( xorShifted << ( ( 32 - rotation ) & 31 ) );
+}
+
+/*********************************************************************
+** Description: Returns an evenly distributed number in [0, bound).
+*
+*  Parameters: int bound - the exclusive upper limit.
+*
+*  Return: int - the random number, or 0 if bound is not above 0.
+*********************************************************************/
+int Random::nextInt( int bound )
+{
+    if( bound <= 0 )
+    {
+        return 0;
+    }
+
+    uint32_t limit = static_cast<uint32_t>( bound );
+    uint32_t threshold = ( 0u - limit ) % limit; //Rejects the biased remainder.
+    uint32_t value = next();
+
+    while( value < threshold )
+    {
+        value = next();
+    }
+
+    return static_cast<int>( value % limit );
+}
+
+/*********************************************************************
+** Description: Creates a child generator for a stream. Its seed is
+*  derived from this generator's seed and stream, so children of
+*  different parents differ even when they are given the same stream
+*  number, and a chain of splits never falls back to an earlier one.
+*  Used to hand each game, player and worker thread its own generator.
+*
+*  Parameters: uint64_t stream - the stream number of the new generator.
+*
+*  Return: Random - the new generator.
+*********************************************************************/
+Random Random::split( uint64_t stream ) const
+{
+    return Random( mix( seed ^ mix( this->stream ) ), stream );
+}
+
+/*********************************************************************
+** Description: Produces a seed from the clock for runs that were not
+*  given an explicit seed.
+*
+*  Return: uint64_t - the seed.
+*********************************************************************/
+uint64_t Random::timeSeed()
+{
+    return static_cast<uint64_t>( time( NULL ) ) ^ ( static_cast<uint64_t>( clock() ) << 32 );
+}
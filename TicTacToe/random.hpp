@@ -0,0 +1,39 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Random class is a small seedable random number
+*  generator (PCG32). Every game, AI and simulation is handed its own
+*  Random object instead of sharing the global rand() state, so a run
+*  can be replayed from its seed and threads never contend on a lock.
+*********************************************************************/
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <stdint.h>
+
+class Random
+{
+    private:
+        uint64_t state,
+                 increment; //Selects the stream, always odd.
+
+        //Seed and stream this generator was created from.
+        uint64_t seed,
+                 stream;
+
+    public:
+        Random( uint64_t seed = 0, uint64_t stream = 0 );
+        uint32_t next();
+        int nextInt( int );
+        bool nextBool() { return ( next() >> 31 ) != 0; };
+        Random split( uint64_t ) const;
+
+        //Getter functions.
+        uint64_t getSeed()   const { return seed; };
+        uint64_t getStream() const { return stream; };
+
+        static uint64_t timeSeed();
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The SpectatorWall class plays many games of Tic Tac Toe
+*  between computer players at once, for a wall of boards to watch.
+*  The games move at staggered times so only a few change each step,
+*  and every change bumps the version of its board, so a renderer can
+*  redraw just the boards that changed since it last looked. The games
+*  are stepped on their own thread, which publishes a WallSnapshot for
+*  the render thread, so a slow computer player never stalls a frame.
+*  Every game has its own players, which keep their search between
+*  the moves of that game.
+*********************************************************************/
+#include "spectatorWall.hpp"
+#include "profiler.hpp"
+#include <chrono>
+
+//Tree nodes per pool of an MCTS player on the wall, unless its
+//description sets them. A classic board needs far fewer than the
+//default, and every game holds two trees of its own.
+static const char* WALL_NODES = "nodes=8192";
+
+/*********************************************************************
+** Description: Adds the wall's node pool size to an MCTS player
+*  description that does not set one.
+*
+*  Parameters: string spec - the player description.
+*
+*  Return: string - the description to create the game's players from.
+*********************************************************************/
+static string wallPlayerSpec( const string &spec )
+{
+    if( spec.compare( 0, 4, "mcts" ) != 0 || ( spec.size() > 4 && spec[4] != ':' )
+        || spec.find( "nodes=" ) != string::npos )
+    {
+        return spec;
+    }
+
+    if( spec.size() == 4 )
+        return spec + ":" + WALL_NODES;
+
+    if( spec.size() == 5 )
+        return spec + WALL_NODES;
+
+    return spec + "," + WALL_NODES;
+}
+
+/*********************************************************************
+** Description: Constructor. Starts every game with a random delay, so
+*  about one game in MOVE_STEPS moves at each step, and publishes the
+*  empty boards, so there is a snapshot to draw before the thread runs.
+*
+*  Parameters: int count - the number of games.
+*              Random random - staggers the games, plays for the sides
+*              without a computer player and seeds the players.
+*********************************************************************/
+SpectatorWall::SpectatorWall( int count, const Random &random ) : random( random ), running( false )
+{
+    moves = 0;
+
+    games.resize( count );
+
+    for( int g = 0; g < count; g++ )
+    {
+        games[g].wait = 1 + this->random.nextInt( MOVE_STEPS );
+        games[g].version = 0;
+        games[g].players[X_Player] = NULL;
+        games[g].players[O_Player] = NULL;
+    }
+
+    publish();
+}
+
+/*********************************************************************
+** Description: Destructor. Stops the thread if it is still running
+*  and deletes the computer players.
+*********************************************************************/
+SpectatorWall::~SpectatorWall()
+{
+    stop();
+
+    for( unsigned g = 0; g < games.size(); g++ )
+    {
+        delete games[g].players[X_Player];
+        delete games[g].players[O_Player];
+    }
+}
+
+/*********************************************************************
+** Description: Gives one side of every game a computer player of its
+*  own, seeded with its own stream. Call before the thread is started.
+*
+*  Parameters: Player side - X_Player or O_Player.
+*              string spec - the player description, as createPlayer()
+*              takes it. A side without a player plays random moves.
+*********************************************************************/
+void SpectatorWall::setPlayer( Player side, const string &spec )
+{
+    string gameSpec = wallPlayerSpec( spec );
+
+    for( unsigned g = 0; g < games.size(); g++ )
+    {
+        delete games[g].players[side];
+        games[g].players[side] = createPlayer( gameSpec, random.split( 2 * g + side ) );
+
+        //The description did not make a player, so none of the others
+        //would either.
+        if( games[g].players[side] == NULL )
+        {
+            break;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Starts the thread that steps the games.
+*********************************************************************/
+void SpectatorWall::start()
+{
+    if( !running.load() )
+    {
+        running.store( true );
+        worker = std::thread( &SpectatorWall::run, this );
+    }
+}
+
+/*********************************************************************
+** Description: Stops the thread and waits for it to end.
+*********************************************************************/
+void SpectatorWall::stop()
+{
+    running.store( false );
+
+    if( worker.joinable() )
+    {
+        worker.join();
+    }
+}
+
+/*********************************************************************
+** Description: The thread loop. Takes a step every STEP_TIME
+*  milliseconds, about one frame; while the players think longer than
+*  that, the wall moves slower instead of the frames.
+*********************************************************************/
+void SpectatorWall::run()
+{
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+
+    while( running.load() )
+    {
+        step();
+
+        next += std::chrono::milliseconds( STEP_TIME );
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if( next > now )
+            std::this_thread::sleep_until( next );
+
+        else
+            next = now;
+    }
+}
+
+/*********************************************************************
+** Description: Advances the wall by one step and publishes it. Games
+*  whose wait is over make a move, and finished games that have rested
+*  start again. Called by the thread loop, or once per frame by the
+*  render thread when running single-threaded.
+*********************************************************************/
+void SpectatorWall::step()
+{
+    PROFILE_SCOPE( "wallStep" );
+
+    for( unsigned g = 0; g < games.size(); g++ )
+    {
+        Game &game = games[g];
+
+        if( --game.wait > 0 )
+        {
+            continue;
+        }
+
+        if( game.position.getOutcome() != UNFINISHED )
+        {
+            game.position = GamePosition( X_Player );
+        }
+
+        else
+        {
+            AiPlayer* player = game.players[game.position.getToMove()];
+            int move = player != NULL ? player->chooseMove( game.position ) : -1;
+
+            //A side without a player, or a player without a legal move,
+            //moves at random.
+            if( move < 0 || move >= GameBoard::CELLS || !game.position.play( move ) )
+            {
+                int legal[GamePosition::MAX_MOVES];
+                game.position.play( legal[random.nextInt( game.position.getMoves( legal ) )] );
+            }
+
+            moves++;
+        }
+
+        game.version++;
+        game.wait = game.position.getOutcome() == UNFINISHED ? MOVE_STEPS : REST_STEPS;
+    }
+
+    publish();
+}
+
+/*********************************************************************
+** Description: Copies every board into a snapshot for the render
+*  thread. The snapshot's vectors keep their size, so this does not
+*  allocate after the first few steps.
+*********************************************************************/
+void SpectatorWall::publish()
+{
+    WallSnapshot &snapshot = snapshots.writeBuffer();
+
+    snapshot.positions.resize( games.size() );
+    snapshot.versions.resize( games.size() );
+
+    for( unsigned g = 0; g < games.size(); g++ )
+    {
+        snapshot.positions[g] = games[g].position;
+        snapshot.versions[g] = games[g].version;
+    }
+
+    snapshot.moves = moves;
+
+    snapshots.publish();
+}
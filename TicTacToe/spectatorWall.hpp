@@ -0,0 +1,89 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The SpectatorWall class plays many games of Tic Tac Toe
+*  between computer players at once, for a wall of boards to watch.
+*  The games move at staggered times so only a few change each step,
+*  and every change bumps the version of its board, so a renderer can
+*  redraw just the boards that changed since it last looked. The games
+*  are stepped on their own thread, which publishes a WallSnapshot for
+*  the render thread, so a slow computer player never stalls a frame.
+*  Every game has its own players, which keep their search between
+*  the moves of that game.
+*********************************************************************/
+#ifndef SPECTATOR_WALL_HPP
+#define SPECTATOR_WALL_HPP
+
+#include "gamePosition.hpp"
+#include "aiPlayer.hpp"
+#include "random.hpp"
+#include "tripleBuffer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+using std::vector;
+
+/*********************************************************************
+** Description: The WallSnapshot struct is a copy of every board of the
+*  wall for the render thread to draw.
+*********************************************************************/
+struct WallSnapshot
+{
+    vector< GamePosition > positions;
+    vector< uint32_t > versions; //Changes whenever the position does.
+    long long moves; //Moves played on the whole wall so far.
+
+    WallSnapshot() : moves( 0 ) {};
+
+    int getCount() const { return static_cast<int>( positions.size() ); };
+};
+
+class SpectatorWall
+{
+    public:
+        static const int MOVE_STEPS = 30; //Steps between two moves of a game.
+        static const int REST_STEPS = 90; //Steps a finished game stays up.
+        static const int STEP_TIME = 16; //Milliseconds per step on the thread.
+
+    private:
+        /*********************************************************************
+         ** Description: This struct is one game on the wall.
+         *********************************************************************/
+        struct Game
+        {
+            GamePosition position;
+            int wait; //Steps until the next move or the next game.
+            uint32_t version; //Changes whenever the position does.
+            AiPlayer* players[2]; //NULL plays random moves.
+        };
+
+        vector< Game > games;
+        Random random;
+        long long moves;
+
+        TripleBuffer< WallSnapshot > snapshots;
+
+        std::thread worker;
+        std::atomic< bool > running;
+
+        //The players are owned by the wall.
+        SpectatorWall( const SpectatorWall & );
+        SpectatorWall& operator=( const SpectatorWall & );
+
+        //Private functions.
+        void publish();
+        void run();
+
+    public:
+        SpectatorWall( int, const Random & );
+        ~SpectatorWall();
+        void start();
+        void stop();
+        void step();
+        void setPlayer( Player, const string & );
+        const WallSnapshot& latestSnapshot() { return snapshots.read(); };
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The SpscQueue class is a fixed-size, lock-free queue
+*  for exactly one producer thread and one consumer thread. Neither
+*  side ever waits: push() fails when the queue is full and pop() fails
+*  when it is empty.
+*********************************************************************/
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+
+template< class T, unsigned CAPACITY >
+class SpscQueue
+{
+    private:
+        T items[CAPACITY];
+
+        //Kept on separate cache lines so the two threads do not collide.
+        alignas( 64 ) std::atomic< unsigned > head; //Next item to pop.
+        alignas( 64 ) std::atomic< unsigned > tail; //Next free slot.
+
+    public:
+        SpscQueue() : head( 0 ), tail( 0 ) {};
+
+        /*********************************************************************
+         ** Description: Adds an item. Producer thread only.
+         *
+         *  Parameters: T item - the item to add.
+         *
+         *  Return: bool - false if the queue was full.
+         *********************************************************************/
+        bool push( const T &item )
+        {
+            unsigned position = tail.load( std::memory_order_relaxed );
+
+            if( position - head.load( std::memory_order_acquire ) == CAPACITY )
+            {
+                return false;
+            }
+
+            items[position % CAPACITY] = item;
+            tail.store( position + 1, std::memory_order_release );
+
+            return true;
+        }
+
+        /*********************************************************************
+         ** Description: Removes the oldest item. Consumer thread only.
+         *
+         *  Parameters: T item - receives the item.
+         *
+         *  Return: bool - false if the queue was empty.
+         *********************************************************************/
+        bool pop( T &item )
+        {
+            unsigned position = head.load( std::memory_order_relaxed );
+
+            if( position == tail.load( std::memory_order_acquire ) )
+            {
+                return false;
+            }
+
+            item = items[position % CAPACITY];
+            head.store( position + 1, std::memory_order_release );
+
+            return true;
+        }
+};
+
+#endif
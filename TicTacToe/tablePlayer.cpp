@@ -0,0 +1,97 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TablePlayer class plays an m,n,k game perfectly
+*  from the tables written by the retrograde solver, looking up the
+*  score of every move instead of searching. The tables of the board
+*  size being played are opened on the first move. A size without
+*  tables is remembered, so it is not looked for again on every move.
+*********************************************************************/
+#include "tablePlayer.hpp"
+#include <cstdio>
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters: string dir - the folder holding the tables.
+*              Random random - chooses between equally good moves.
+*********************************************************************/
+TablePlayer::TablePlayer( const string &dir, const Random &random )
+    : dir( dir ), random( random )
+{
+    missing = false;
+}
+
+/*********************************************************************
+** Description: Plays classic Tic Tac Toe from the 3x3 k=3 tables.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int TablePlayer::chooseMove( const GamePosition &position )
+{
+    return chooseMnkMove( toMnkPosition( position ) );
+}
+
+/*********************************************************************
+** Description: Chooses a random move among the best ones. Without
+*  tables for the board size it warns once, plays randomly and does
+*  not look for them again.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int TablePlayer::chooseMnkMove( const MnkPosition &position )
+{
+    int moves[MnkPosition::MAX_MOVES],
+        best[MnkPosition::MAX_MOVES];
+    int count = position.getMoves( moves ),
+        bestCount = 0,
+        bestScore = -MnkPosition::MAX_CELLS - 1;
+
+    if( !table.isOpen() || table.getWidth() != position.getWidth() || table.getHeight() != position.getHeight()
+        || table.getK() != position.getK() )
+    {
+        missing = false;
+
+        for( size_t i = 0; i < missingSizes.size(); i += 3 )
+        {
+            missing = missing || ( missingSizes[i] == position.getWidth() && missingSizes[i + 1] == position.getHeight()
+                                   && missingSizes[i + 2] == position.getK() );
+        }
+
+        if( !missing && !table.open( dir, position.getWidth(), position.getHeight(), position.getK() ) )
+        {
+            printf( "No solved tables for %dx%d k=%d in %s, playing randomly. Run the retrograde tool first.\n",
+                    position.getWidth(), position.getHeight(), position.getK(), dir.c_str() );
+
+            missing = true;
+            missingSizes.push_back( position.getWidth() );
+            missingSizes.push_back( position.getHeight() );
+            missingSizes.push_back( position.getK() );
+        }
+    }
+
+    for( int i = 0; i < count; i++ )
+    {
+        MnkPosition next = position;
+        next.play( moves[i] );
+        int value = missing ? 0 : -table.score( next );
+
+        if( value > bestScore )
+        {
+            bestScore = value;
+            bestCount = 0;
+        }
+
+        if( value == bestScore )
+        {
+            best[bestCount++] = moves[i];
+        }
+    }
+
+    return bestCount > 0 ? best[random.nextInt( bestCount )] : -1;
+}
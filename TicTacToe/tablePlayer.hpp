@@ -0,0 +1,36 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TablePlayer class plays an m,n,k game perfectly
+*  from the tables written by the retrograde solver, looking up the
+*  score of every move instead of searching. The tables of the board
+*  size being played are opened on the first move. A size without
+*  tables is remembered, so it is not looked for again on every move.
+*********************************************************************/
+#ifndef TABLE_PLAYER_HPP
+#define TABLE_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+#include "mnkTable.hpp"
+#include <vector>
+
+class TablePlayer : public AiPlayer
+{
+    private:
+        string dir;
+        MnkTable table;
+        Random random; //Chooses between equally good moves.
+        bool missing; //The tables of the size being played could not be opened.
+        std::vector< int > missingSizes; //Sizes with no tables, as width, height and k.
+
+    public:
+        TablePlayer( const string &, const Random & );
+        int chooseMove( const GamePosition & );
+        string getName() const { return "table"; };
+
+        bool playsMnk() const { return true; };
+        int chooseMnkMove( const MnkPosition & );
+};
+
+#endif
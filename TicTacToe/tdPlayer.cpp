@@ -0,0 +1,62 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TdPlayer class plays an m,n,k game from a value
+*  table learned by the tdtrainer tool, choosing the move that leads to
+*  the position of the best learned value. It searches nothing, so each
+*  move costs one lookup per legal move.
+*********************************************************************/
+#include "tdPlayer.hpp"
+#include <cstdio>
+
+/*********************************************************************
+** Description: Constructor. Call load() before the first move.
+*
+*  Parameters: Random random - chooses between equally good moves.
+*********************************************************************/
+TdPlayer::TdPlayer( const Random &random ) : random( random )
+{
+    warned = false;
+}
+
+/*********************************************************************
+** Description: Plays classic Tic Tac Toe from a 3x3 k=3 table.
+*
+*  Parameters: GamePosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int TdPlayer::chooseMove( const GamePosition &position )
+{
+    return chooseMnkMove( toMnkPosition( position ) );
+}
+
+/*********************************************************************
+** Description: Chooses the move of the best learned value. On a board
+*  the table was not learned on it warns once and plays randomly.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int TdPlayer::chooseMnkMove( const MnkPosition &position )
+{
+    if( position.getWidth() != table.getWidth() || position.getHeight() != table.getHeight()
+        || position.getK() != table.getK() )
+    {
+        if( !warned )
+        {
+            printf( "The value table is of %dx%d k=%d, playing randomly.\n", table.getWidth(), table.getHeight(),
+                    table.getK() );
+            warned = true;
+        }
+
+        int moves[MnkPosition::MAX_MOVES];
+        int count = position.getMoves( moves );
+
+        return count > 0 ? moves[random.nextInt( count )] : -1;
+    }
+
+    return table.chooseMove( position, random );
+}
@@ -0,0 +1,33 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TdPlayer class plays an m,n,k game from a value
+*  table learned by the tdtrainer tool, choosing the move that leads to
+*  the position of the best learned value. It searches nothing, so each
+*  move costs one lookup per legal move.
+*********************************************************************/
+#ifndef TD_PLAYER_HPP
+#define TD_PLAYER_HPP
+
+#include "aiPlayer.hpp"
+#include "valueTable.hpp"
+
+class TdPlayer : public AiPlayer
+{
+    private:
+        ValueTable table;
+        Random random; //Chooses between equally good moves.
+        bool warned; //A board of another size was played.
+
+    public:
+        TdPlayer( const Random & );
+        bool load( const string &path ) { return table.load( path ); };
+        int chooseMove( const GamePosition & );
+        string getName() const { return "td"; };
+
+        bool playsMnk() const { return true; };
+        int chooseMnkMove( const MnkPosition & );
+};
+
+#endif
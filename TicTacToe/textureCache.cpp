@@ -0,0 +1,347 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TextureCache class owns the textures made from
+*  images and text, and the fonts the text is rendered with. Asking for
+*  the same image, or the same string in the same font and color, gives
+*  the same texture. Every texture counts its users; one nobody uses
+*  stays cached until the textures take more memory than the budget,
+*  and then the least recently used ones are destroyed first. A font
+*  is closed when no texture or user needs it anymore.
+*********************************************************************/
+#include "textureCache.hpp"
+#include <cstdio>
+
+/*********************************************************************
+** Description: Constructor. The budget starts at 16 MB, room for every
+*  theme at once.
+*********************************************************************/
+TextureCache::TextureCache()
+{
+    renderer = NULL;
+    useClock = 0;
+    bytes = 0;
+    budget = 16LL << 20;
+    evictions = 0;
+}
+
+/*********************************************************************
+** Description: Destructor. clear() frees the textures, while SDL is
+*  still running.
+*********************************************************************/
+TextureCache::~TextureCache()
+{
+    //empty.
+}
+
+/*********************************************************************
+** Description: Sets how much texture memory the cache keeps, and
+*  evicts unused textures down to it. Textures in use are never
+*  evicted, so the cache can stay above a small budget.
+*
+*  Parameters: long long budget - the budget in bytes.
+*********************************************************************/
+void TextureCache::setBudget( long long budget )
+{
+    this->budget = budget;
+    evict();
+}
+
+/*********************************************************************
+** Description: Returns an image as a texture, loading it if it is not
+*  cached. Cyan pixels are transparent.
+*
+*  Parameters: string path - the image file.
+*
+*  Return: SDL_Texture* - the texture, or NULL if it could not be
+*  loaded. Give it back with release().
+*********************************************************************/
+SDL_Texture* TextureCache::acquireImage( const string &path )
+{
+    string key = "image:" + path;
+    Entry* entry = find( key );
+
+    if( entry != NULL )
+    {
+        entry->references++;
+        entry->lastUse = ++useClock;
+        return entry->texture;
+    }
+
+    SDL_Texture* texture = NULL;
+    SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+
+    if( loadedSurface == NULL )
+    {
+        printf( "Unable to load image! SDL_image Error: %s\n", IMG_GetError() );
+        return NULL;
+    }
+
+    //Set transparent color to Cyan.
+    SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+
+    texture = SDL_CreateTextureFromSurface( renderer, loadedSurface );
+    SDL_FreeSurface( loadedSurface );
+
+    if( texture == NULL )
+    {
+        printf( "Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError() );
+        return NULL;
+    }
+
+    return add( key, texture, NULL );
+}
+
+/*********************************************************************
+** Description: Returns a string rendered in a font and color as a
+*  texture, rendering it if it is not cached.
+*
+*  Parameters:
+*  1. string fontPath - the font file.
+*  2. int size - the point size.
+*  3. const char* text - the string.
+*  4. SDL_Color color - the color of the text.
+*
+*  Return: SDL_Texture* - the texture, or NULL on failure. Give it back
+*  with release().
+*********************************************************************/
+SDL_Texture* TextureCache::acquireText( const string &fontPath, int size, const char* text, SDL_Color color )
+{
+    char style[32];
+    snprintf( style, sizeof( style ), ":%d:%02x%02x%02x%02x:", size, color.r, color.g, color.b, color.a );
+
+    string key = "text:" + fontPath + style + text;
+    Entry* entry = find( key );
+
+    if( entry != NULL )
+    {
+        entry->references++;
+        entry->lastUse = ++useClock;
+        return entry->texture;
+    }
+
+    TTF_Font* font = acquireFont( fontPath, size );
+
+    if( font == NULL )
+    {
+        return NULL;
+    }
+
+    SDL_Texture* texture = NULL;
+    SDL_Surface* textSurface = TTF_RenderText_Solid( font, text, color );
+
+    if( textSurface == NULL )
+    {
+        printf( "Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError() );
+    }
+
+    else
+    {
+        texture = SDL_CreateTextureFromSurface( renderer, textSurface );
+
+        if( texture == NULL )
+        {
+            printf( "Unable to create texture from %s! SDL Error: %s\n", text, SDL_GetError() );
+        }
+
+        SDL_FreeSurface( textSurface );
+    }
+
+    if( texture == NULL )
+    {
+        releaseFont( font );
+        return NULL;
+    }
+
+    //The texture keeps its font open, so the next string in the same
+    //font does not open it again.
+    return add( key, texture, font );
+}
+
+/*********************************************************************
+** Description: Gives back a texture from acquireImage() or
+*  acquireText(). Once nobody uses it, it may be evicted.
+*
+*  Parameters: SDL_Texture* texture - the texture, or NULL.
+*********************************************************************/
+void TextureCache::release( SDL_Texture* texture )
+{
+    for( unsigned i = 0; i < entries.size(); i++ )
+    {
+        if( entries[i].texture == texture )
+        {
+            entries[i].references--;
+            entries[i].lastUse = ++useClock;
+
+            if( entries[i].references == 0 )
+            {
+                evict();
+            }
+
+            return;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Returns a font, opening it if it is not open.
+*
+*  Parameters: string path - the font file.
+*              int size - the point size.
+*
+*  Return: TTF_Font* - the font, or NULL if it could not be opened.
+*  Give it back with releaseFont().
+*********************************************************************/
+TTF_Font* TextureCache::acquireFont( const string &path, int size )
+{
+    char points[16];
+    snprintf( points, sizeof( points ), ":%d", size );
+
+    string key = path + points;
+
+    for( unsigned i = 0; i < fonts.size(); i++ )
+    {
+        if( fonts[i].key == key )
+        {
+            fonts[i].references++;
+            return fonts[i].font;
+        }
+    }
+
+    TTF_Font* font = TTF_OpenFont( path.c_str(), size );
+
+    if( font == NULL )
+    {
+        printf( "Failed to load font %s! SDL_ttf Error: %s\n", path.c_str(), TTF_GetError() );
+        return NULL;
+    }
+
+    Font added = { key, font, 1 };
+    fonts.push_back( added );
+
+    return font;
+}
+
+/*********************************************************************
+** Description: Gives back a font from acquireFont(), closing it when
+*  nobody uses it.
+*
+*  Parameters: TTF_Font* font - the font, or NULL.
+*********************************************************************/
+void TextureCache::releaseFont( TTF_Font* font )
+{
+    for( unsigned i = 0; i < fonts.size(); i++ )
+    {
+        if( fonts[i].font == font )
+        {
+            if( --fonts[i].references == 0 )
+            {
+                TTF_CloseFont( font );
+                fonts.erase( fonts.begin() + i );
+            }
+
+            return;
+        }
+    }
+}
+
+/*********************************************************************
+** Description: Destroys every texture and closes every font, used or
+*  not. Called before SDL shuts down.
+*********************************************************************/
+void TextureCache::clear()
+{
+    for( unsigned i = 0; i < entries.size(); i++ )
+    {
+        SDL_DestroyTexture( entries[i].texture );
+    }
+
+    for( unsigned i = 0; i < fonts.size(); i++ )
+    {
+        TTF_CloseFont( fonts[i].font );
+    }
+
+    entries.clear();
+    fonts.clear();
+    bytes = 0;
+}
+
+/*********************************************************************
+** Description: Finds a cached texture.
+*
+*  Parameters: string key - the key of the texture.
+*
+*  Return: Entry* - the entry, or NULL if it is not cached.
+*********************************************************************/
+TextureCache::Entry* TextureCache::find( const string &key )
+{
+    for( unsigned i = 0; i < entries.size(); i++ )
+    {
+        if( entries[i].key == key )
+        {
+            return &entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*********************************************************************
+** Description: Caches a new texture with one user, and evicts unused
+*  textures if the budget is exceeded.
+*
+*  Parameters:
+*  1. string key - the key of the texture.
+*  2. SDL_Texture* texture - the texture.
+*  3. TTF_Font* font - the font it was rendered with, or NULL.
+*
+*  Return: SDL_Texture* - the texture.
+*********************************************************************/
+SDL_Texture* TextureCache::add( const string &key, SDL_Texture* texture, TTF_Font* font )
+{
+    int width = 0,
+        height = 0;
+
+    //Four bytes a pixel; the driver's real layout is not known.
+    SDL_QueryTexture( texture, NULL, NULL, &width, &height );
+
+    Entry entry = { key, texture, font, 4LL * width * height, 1, ++useClock };
+    entries.push_back( entry );
+    bytes += entry.bytes;
+
+    evict();
+
+    return texture;
+}
+
+/*********************************************************************
+** Description: Destroys the least recently used textures nobody uses
+*  until the cache fits its budget, or no unused texture is left.
+*********************************************************************/
+void TextureCache::evict()
+{
+    while( bytes > budget )
+    {
+        int oldest = -1;
+
+        for( unsigned i = 0; i < entries.size(); i++ )
+        {
+            if( entries[i].references == 0 && ( oldest < 0 || entries[i].lastUse < entries[oldest].lastUse ) )
+            {
+                oldest = i;
+            }
+        }
+
+        if( oldest < 0 )
+        {
+            return;
+        }
+
+        SDL_DestroyTexture( entries[oldest].texture );
+        releaseFont( entries[oldest].font );
+        bytes -= entries[oldest].bytes;
+        entries.erase( entries.begin() + oldest );
+        evictions++;
+    }
+}
@@ -0,0 +1,88 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TextureCache class owns the textures made from
+*  images and text, and the fonts the text is rendered with. Asking for
+*  the same image, or the same string in the same font and color, gives
+*  the same texture. Every texture counts its users; one nobody uses
+*  stays cached until the textures take more memory than the budget,
+*  and then the least recently used ones are destroyed first. A font
+*  is closed when no texture or user needs it anymore.
+*********************************************************************/
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+class TextureCache
+{
+    private:
+        /*********************************************************************
+         ** Description: This struct is one cached texture.
+         *********************************************************************/
+        struct Entry
+        {
+            string key; //The image path, or the font, color and string.
+            SDL_Texture* texture;
+            TTF_Font* font; //The font of a text texture, or NULL.
+            long long bytes;
+            int references;
+            unsigned long long lastUse; //For eviction, from useClock.
+        };
+
+        /*********************************************************************
+         ** Description: This struct is one open font.
+         *********************************************************************/
+        struct Font
+        {
+            string key; //The path and point size.
+            TTF_Font* font;
+            int references;
+        };
+
+        SDL_Renderer* renderer;
+        vector< Entry > entries;
+        vector< Font > fonts;
+        unsigned long long useClock;
+        long long bytes, //Memory of all cached textures, estimated.
+                  budget;
+        long long evictions;
+
+        //Private functions.
+        Entry* find( const string & );
+        SDL_Texture* add( const string &, SDL_Texture*, TTF_Font* );
+        void evict();
+
+        //The cache owns what it hands out.
+        TextureCache( const TextureCache & );
+        TextureCache& operator=( const TextureCache & );
+
+    public:
+        TextureCache();
+        ~TextureCache();
+        void setRenderer( SDL_Renderer* newRenderer ) { renderer = newRenderer; };
+        void setBudget( long long );
+        SDL_Texture* acquireImage( const string & );
+        SDL_Texture* acquireText( const string &, int, const char*, SDL_Color );
+        void release( SDL_Texture* );
+        TTF_Font* acquireFont( const string &, int );
+        void releaseFont( TTF_Font* );
+        void clear();
+
+        //Getter functions.
+        long long getBytes() const { return bytes; };
+        long long getBudget() const { return budget; };
+        long long getEvictions() const { return evictions; };
+        int getCount() const { return static_cast<int>( entries.size() ); };
+};
+
+#endif
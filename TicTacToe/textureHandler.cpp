@@ -4,38 +4,26 @@
 ** Date: 7/20/2017
 ** Description: The TextureHandler class generates textures used to
 *  render onto the screen from PNG images or text using SDL_image and 
-*  SDL_ttf respectively.
+*  SDL_ttf respectively, in the font and colors of the current theme.
+*  Each texture is made the first time it is asked for, so the first
+*  frame, and the first frame after switching themes, waits only for
+*  what it shows. The textures come from a TextureCache, which keeps
+*  those of other themes while they fit its budget.
 *********************************************************************/
 #include "textureHandler.hpp"
+#include "profiler.hpp"
 
 /*********************************************************************
-** Description: Constructor. 
+** Description: Constructor. Starts with the first theme.
 *********************************************************************/
-TextureHandler::TextureHandler() : XandO( "image/xo.png" )
+TextureHandler::TextureHandler() : XandO( THEMES[0].spritePath )
 {
-    fontPath = "font/theone.ttf";
-    X_Render = { 0, 0, 0, 0 }; 
-    O_Render = { 0, 0, 0, 0 }; 
-
-    DrawColor = { 0, 0, 0, 0xFF };
+    theme = &THEMES[0];
+    X_Render = theme->xClip; 
+    O_Render = theme->oClip; 
 
     font = NULL;
-    XTurn = NULL;
-    OTurn = NULL;
-    XWin = NULL;
-    OWin = NULL;
-    OP = NULL;
-    XP = NULL;
-    playAgain = NULL;
-
-    XPoint = 0;
-    OPoint = 0;
-
-    //Used to render points. 
-    XpointSS.str(string());  
-    XpointSS << XPoint;
-    OpointSS.str(string()); 
-    OpointSS << OPoint;
+    renderer = NULL;
 }
 
 /*********************************************************************
@@ -47,24 +35,57 @@ TextureHandler::~TextureHandler()
 }
 
 /*********************************************************************
-** Description: This function loads the related media and calls
-*  loadTexture() to optimize the images.
+** Description: This function opens the font of the theme the text is
+*  rendered with. The sprite sheet and the text textures are made when
+*  first asked for, unless they are preloaded.
+*
+*  Parameters: 
+*  1. SDL_Renderer* - the screen renderer.
+*  2. bool preload - make every texture now instead of on first use.
+*
+*  Return: bool - indicates whether the operation was successful.
+*********************************************************************/
+bool TextureHandler::loadMedia( SDL_Renderer* renderer, bool preload )
+{
+    PROFILE_SCOPE( "loadMedia" );
+
+    this->renderer = renderer;
+    cache.setRenderer( renderer );
+
+    return setTheme( *theme, preload );
+}
+
+/*********************************************************************
+** Description: This function switches to another theme. The textures
+*  of the old theme are given back to the cache, and those of the new
+*  one are made as they are drawn, so only what is on the screen is
+*  rasterized again. Switching back to a theme whose textures are still
+*  cached makes none.
+*
+*  Parameters: 
+*  1. Theme theme - the new theme, one of THEMES.
+*  2. bool preload - make every texture now instead of on first use.
 *
 *  Return: bool - indicates whether the operation was successful.
 *********************************************************************/
-bool TextureHandler::loadMedia( SDL_Renderer* renderer )
+bool TextureHandler::setTheme( const Theme &theme, bool preload )
 {
 	bool success = true;
-    
-    XandO.texture = loadTexture( XandO.path, renderer );
 
-    if( XandO.texture == NULL) 
+    releaseTextures();
+
+    this->theme = &theme;
+    XandO = ImageData( theme.spritePath );
+    X_Render = theme.xClip;
+    O_Render = theme.oClip;
+
+    //Before loadMedia() there is nothing to draw with yet.
+    if( renderer == NULL )
     {
-        printf( "Failed to load images!\n" );
-        success = false;
+        return success;
     }
 
-    font = TTF_OpenFont( fontPath.c_str(), 28 );
+    font = cache.acquireFont( theme.fontPath, theme.fontSize );
 
     if( font == NULL )
     {
@@ -72,217 +93,133 @@ bool TextureHandler::loadMedia( SDL_Renderer* renderer )
         success = false;
     }
 
-    else
+    else if( preload )
     {
-        SDL_Color XColor = { 0x55, 0xa3, 0, 0xFF };
-        SDL_Color OColor = { 0x9d, 0, 0, 0xFF };
-
-        XTurn = loadRenderedText( "Player X Turn", XColor, renderer );
-        OTurn = loadRenderedText( "Player O Turn", OColor, renderer );
-        XWin = loadRenderedText( "X WON", XColor, renderer );
-        OWin = loadRenderedText( "O WON", OColor, renderer );
-        Draw = loadRenderedText( "DRAW", DrawColor, renderer );
-        XPoints = loadRenderedText( "X Points: ", XColor, renderer );
-        OPoints = loadRenderedText( "O Points: ", OColor, renderer );
-        XP = loadRenderedText( XpointSS.str(), DrawColor, renderer );
-        OP = loadRenderedText( OpointSS.str(), DrawColor, renderer );
-        playAgain = loadRenderedText( "Play Again?", DrawColor, renderer );
+        if( getXO() == NULL ) 
+        {
+            printf( "Failed to load images!\n" );
+            success = false;
+        }
 
-        if( XTurn == NULL || OTurn == NULL || XWin == NULL || OWin == NULL ) 
+        if( getXTurn() == NULL || getOTurn() == NULL || getXWin() == NULL || getOWin() == NULL 
+            || getDraw() == NULL || getXPoints() == NULL || getOPoints() == NULL || getPlayAgain() == NULL ) 
         {
             printf( "Failed to render text texture!\n" );
             success = false;
         }
-    }
 
-    //Clip the X and O sprites from the PNG image.
-    if( success )
-    {
-        X_Render = { 0, 1181 / 2, 591, 1181 / 2 };
-        O_Render = { 0, 0, 591, 1181 / 2 };
+        for( int i = 0; i < 10; i++ )
+        {
+            if( getDigit( i ) == NULL )
+            {
+                printf( "Failed to render digit texture!\n" );
+                success = false;
+            }
+        }
     }
 
 	return success;
 }
 
 /*********************************************************************
-** Description: This function creates textures from PNG images. 
+** Description: This function returns the X and O sprite sheet, loading
+*  it the first time. Decoding the PNG is the slowest part of loading,
+*  and the first frame has no marks to draw.
 *
-*  Parameters: 
-*  1. string - the path to the picture.
-*  2. SDL_Renderer* - the screen renderer.
-*
-*  Return: SDL_Texture* - The optimized texture from an image. 
+*  Return: SDL_Texture* - the sprite sheet, or NULL if it could not be
+*  loaded.
 *********************************************************************/
-SDL_Texture* TextureHandler::loadTexture( const string &path, SDL_Renderer* renderer )
+SDL_Texture* TextureHandler::getXO()
 {
-    SDL_Texture* newTexture = NULL;
-
-    SDL_Surface* loadedSurface = IMG_Load( path.c_str() ); //Load the image onto a surface.
-
-    if( loadedSurface == NULL )
+    if( !XandO.tried && renderer != NULL )
     {
-    	printf( "Unable to load image! SDL_image Error: %s\n", IMG_GetError() );
-    }
+        PROFILE_SCOPE( "loadTexture" );
 
-    else
-    {
-        //Set transparent color to Cyan.
-        SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-        
-		//Create texture from the loaded surface pixels.
-        newTexture = SDL_CreateTextureFromSurface( renderer, loadedSurface );
-
-		if( newTexture == NULL )
-		{
-			printf( "Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError() );
-		}
-
-		SDL_FreeSurface( loadedSurface ); //Frees the previously loaded surface.
+        XandO.tried = true;
+        XandO.texture = cache.acquireImage( XandO.path );
     }
 
-    return newTexture;
+    return XandO.texture;
 }
 
 /*********************************************************************
-** Description: This function creates textures from ttf files. 
+** Description: This function returns the texture of a digit of the
+*  points, rendering it the first time. The points are drawn from
+*  these, so a new score renders no text.
 *
-*  Parameters: 
-*  1. string - the path to the font file.
-*  2. SDL_Color - the color of the text.
-*  3. SDL_Renderer* - the main renderer.
+*  Parameters: int digit - 0 to 9.
 *
-*  Return: SDL_Texture* - The optimized texture from the font file. 
+*  Return: SDL_Texture* - the digit, or NULL on failure.
 *********************************************************************/
-SDL_Texture* TextureHandler::loadRenderedText( const string &text, SDL_Color textColor, SDL_Renderer* renderer )
+SDL_Texture* TextureHandler::getDigit( int digit )
 {
-    SDL_Texture* newText = NULL;
-
-    SDL_Surface* textSurface = TTF_RenderText_Solid( font, text.c_str(), textColor );
-
-    if( textSurface == NULL )
-    {
-    	printf( "Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError() );
-    }
-
-    else
-    {
-        newText = SDL_CreateTextureFromSurface( renderer, textSurface );
-
-		if( newText == NULL )
-		{
-			printf( "Unable to create texture from %s! SDL Error: %s\n", text.c_str(), SDL_GetError() );
-		}
+    char text[2] = { static_cast<char>( '0' + digit ), '\0' };
 
-		SDL_FreeSurface( textSurface ); //Frees the previously loaded surface.
-    }
-
-    return newText;
+    return getText( digits[digit], text, theme->textColor );
 }
 
 /*********************************************************************
-** Description: This function increments the X points and replaces the 
-*  texture with the updated points. 
+** Description: This function returns a text texture in the font of
+*  the theme, getting it from the cache the first time it is asked for.
+*  A text that failed is not rendered again until the theme changes.
 *
-*  Parameters: SDL_Renderer* - the main renderer.
-*********************************************************************/
-void TextureHandler::incrementX( SDL_Renderer* renderer )
-{   
-    XPoint++;
-    XpointSS.str(string());
-    XpointSS << XPoint;
-    SDL_DestroyTexture( XP );
-    XP = loadRenderedText( XpointSS.str(), DrawColor, renderer );
-}
-
-/*********************************************************************
-** Description: This function increments the O points and replaces the 
-*  texture with the updated points. 
+*  Parameters: 
+*  1. TextData &data - where the texture is kept.
+*  2. const char* - the text.
+*  3. SDL_Color - the color of the text.
 *
-*  Parameters: SDL_Renderer* - the main renderer.
-*********************************************************************/
-void TextureHandler::incrementO( SDL_Renderer* renderer )
-{   
-    OPoint++;
-    OpointSS.str(string());
-    OpointSS << OPoint;
-    SDL_DestroyTexture( OP );
-    OP = loadRenderedText( OpointSS.str(), DrawColor, renderer );
-}
-
-/*********************************************************************
-** Description: This function frees all memory from textures, fonts,
-*  images and shuts down SDL processes.
+*  Return: SDL_Texture* - the text, or NULL on failure.
 *********************************************************************/
-void TextureHandler::cleanUp()
+SDL_Texture* TextureHandler::getText( TextData &data, const char* text, SDL_Color color )
 {
-    XandO.destroyTexture();
-
-    if( font != NULL )
+    if( !data.tried && font != NULL )
     {
-        TTF_CloseFont( font );
-        font = NULL;
-    }
+        PROFILE_SCOPE( "loadRenderedText" );
 
-    if( XTurn != NULL)
-    {
-        SDL_DestroyTexture( XTurn );
-        XTurn = NULL;
-    }
-    
-    if( OTurn != NULL)
-    {
-        SDL_DestroyTexture( OTurn);
-        OTurn = NULL;
+        data.tried = true;
+        data.texture = cache.acquireText( theme->fontPath, theme->fontSize, text, color );
     }
 
-    if( XWin != NULL)
-    {
-        SDL_DestroyTexture( XWin );
-        XWin = NULL;
-    }
+    return data.texture;
+}
 
-    if( OWin != NULL)
-    {
-        SDL_DestroyTexture( OWin );
-        OWin = NULL;
-    }
+/*********************************************************************
+** Description: This function gives every texture and the font of the
+*  theme back to the cache.
+*********************************************************************/
+void TextureHandler::releaseTextures()
+{
+    TextData* texts[8] = { &XTurn, &OTurn, &XWin, &OWin, &Draw, &XPoints, &OPoints, &playAgain };
 
-    if( Draw != NULL)
+    for( int i = 0; i < 8; i++ )
     {
-        SDL_DestroyTexture( Draw );
-        Draw = NULL;
+        cache.release( texts[i]->texture );
+        *texts[i] = TextData();
     }
 
-    if( XPoints != NULL)
+    for( int i = 0; i < 10; i++ )
     {
-        SDL_DestroyTexture( XPoints );
-        XPoints = NULL;
-    }
-    
-    if( OPoints != NULL)
-    {
-        SDL_DestroyTexture( OPoints );
-        OPoints = NULL;
+        cache.release( digits[i].texture );
+        digits[i] = TextData();
     }
 
-    if( XP != NULL)
-    {
-        SDL_DestroyTexture( XP );
-        XP = NULL;
-    }
+    cache.release( XandO.texture );
+    XandO.texture = NULL;
+    XandO.tried = false;
 
-    if( OP != NULL)
-    {
-        SDL_DestroyTexture( OP );
-        OP = NULL;
-    }
+    cache.releaseFont( font );
+    font = NULL;
+}
 
-    if( playAgain != NULL)
-    {
-        SDL_DestroyTexture( playAgain );
-        playAgain = NULL;
-    }
+/*********************************************************************
+** Description: This function frees all memory from textures, fonts,
+*  images and shuts down SDL processes.
+*********************************************************************/
+void TextureHandler::cleanUp()
+{
+    releaseTextures();
+    cache.clear();
+    renderer = NULL;
 
 	IMG_Quit();
     TTF_Quit();
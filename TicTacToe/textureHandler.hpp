@@ -4,7 +4,11 @@
 ** Date: 7/20/2017
 ** Description: The TextureHandler class generates textures used to
 *  render onto the screen from PNG images or text using SDL_image and 
-*  SDL_ttf respectively.
+*  SDL_ttf respectively, in the font and colors of the current theme.
+*  Each texture is made the first time it is asked for, so the first
+*  frame, and the first frame after switching themes, waits only for
+*  what it shows. The textures come from a TextureCache, which keeps
+*  those of other themes while they fit its budget.
 *********************************************************************/
 
 #ifndef TEXTURE_HANDLER_HPP
@@ -14,13 +18,12 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <cstdio>
+#include "textureCache.hpp"
+#include "theme.hpp"
 
 #include <string>
 using std::string;
 
-#include <sstream>
-using std::stringstream;
-
 #include <vector>
 using std::vector;
 
@@ -38,6 +41,8 @@ class TextureHandler
 
         SDL_Texture* texture;
 
+        bool tried; //Loading was attempted, so a missing file is reported once.
+
         /*********************************************************************
          ** Description: Constructor. 
          * 
@@ -47,18 +52,27 @@ class TextureHandler
         {
             this->path = path;
             texture = NULL;
+            tried = false;
         }
+    };
+
+    /*********************************************************************
+     ** Description: This struct holds a text texture and whether it was
+     * rendered, so a text that fails to render is not tried every frame.
+     *********************************************************************/
+    struct TextData
+    {
+        SDL_Texture* texture;
+
+        bool tried; //Rendering was attempted, so a failure is reported once.
 
         /*********************************************************************
-         ** Description: This function frees the texture from memory. 
+         ** Description: Constructor. 
          *********************************************************************/
-        void destroyTexture()
+        TextData()
         {
-            if( texture != NULL )
-            {
-                SDL_DestroyTexture( texture );
-                texture = NULL;
-            }
+            texture = NULL;
+            tried = false;
         }
     };
 
@@ -69,56 +83,52 @@ class TextureHandler
     //The PNG sprite sheet.
     ImageData XandO;
 
-    //Black color used for a game draw outcome.
-    SDL_Color DrawColor;
+    const Theme* theme;
 
-    //Textures rendered to the screen.
-    SDL_Texture* XTurn;
-    SDL_Texture* OTurn;
-    SDL_Texture* XWin;
-    SDL_Texture* OWin;
-    SDL_Texture* Draw;
-    SDL_Texture* XPoints;
-    SDL_Texture* OPoints;
-    SDL_Texture* XP;
-    SDL_Texture* OP;
-    SDL_Texture* playAgain;
+    //Texts rendered to the screen, NULL until first asked for.
+    TextData XTurn;
+    TextData OTurn;
+    TextData XWin;
+    TextData OWin;
+    TextData Draw;
+    TextData XPoints;
+    TextData OPoints;
+    TextData digits[10]; //Digits used to draw the points.
+    TextData playAgain;
 
-    TTF_Font* font; 
-    string fontPath;
+    TTF_Font* font; //Held open for the theme while the texts are made.
 
-    stringstream XpointSS;
-    stringstream OpointSS;
+    SDL_Renderer* renderer; //Makes the textures when first asked for.
 
-    int XPoint,
-        OPoint;
+    TextureCache cache;
 
     //Private functions.
-    SDL_Texture* loadTexture( const string &, SDL_Renderer* );
-    SDL_Texture* loadRenderedText( const string &, SDL_Color, SDL_Renderer* );
+    SDL_Texture* getText( TextData &, const char*, SDL_Color );
+    void releaseTextures();
 
     public:
     TextureHandler();
     ~TextureHandler();
-    bool loadMedia( SDL_Renderer* ); 
-    void incrementX( SDL_Renderer* );
-    void incrementO( SDL_Renderer* );
+    bool loadMedia( SDL_Renderer*, bool = false ); 
+    bool setTheme( const Theme &, bool = false );
+    void setBudget( long long budget ) { cache.setBudget( budget ); };
     void cleanUp();
 
-    //Getter functions.
-    SDL_Texture* getXO() { return XandO.texture; };
-    SDL_Texture* getXTurn() { return XTurn; };
-    SDL_Texture* getOTurn() { return OTurn; };
-    SDL_Texture* getXWin() { return XWin; };
-    SDL_Texture* getOWin() { return OWin; };
-    SDL_Texture* getDraw() { return Draw; };
-    SDL_Texture* getXPoints() { return XPoints; };
-    SDL_Texture* getOPoints() { return OPoints; };
-    SDL_Texture* getXP() { return XP; };
-    SDL_Texture* getOP() { return OP; };
+    //Getter functions. The textures are made on first use.
+    SDL_Texture* getXO();
+    SDL_Texture* getXTurn() { return getText( XTurn, "Player X Turn", theme->xColor ); };
+    SDL_Texture* getOTurn() { return getText( OTurn, "Player O Turn", theme->oColor ); };
+    SDL_Texture* getXWin() { return getText( XWin, "X WON", theme->xColor ); };
+    SDL_Texture* getOWin() { return getText( OWin, "O WON", theme->oColor ); };
+    SDL_Texture* getDraw() { return getText( Draw, "DRAW", theme->textColor ); };
+    SDL_Texture* getXPoints() { return getText( XPoints, "X Points: ", theme->xColor ); };
+    SDL_Texture* getOPoints() { return getText( OPoints, "O Points: ", theme->oColor ); };
+    SDL_Texture* getDigit( int );
     SDL_Rect getRectX() { return X_Render; }; 
     SDL_Rect getRectO() { return O_Render; }; 
-    SDL_Texture* getPlayAgain() { return playAgain; }; 
+    SDL_Texture* getPlayAgain() { return getText( playAgain, "Play Again?", theme->textColor ); }; 
+    const Theme &getTheme() const { return *theme; };
+    const TextureCache &getCache() const { return cache; };
 };
 
 #endif
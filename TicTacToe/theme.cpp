@@ -0,0 +1,49 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: A Theme is the look of the game: the font of the HUD,
+*  the colors of the marks, the text and the board, and the sprite
+*  sheet the SDL renderer draws the marks from. The themes are built
+*  in, one for each font in the font folder.
+*********************************************************************/
+#include "theme.hpp"
+
+//The marks keep the colors of the sprite sheet in every theme, so the
+//SDL and OpenGL renderers agree.
+const Theme THEMES[] =
+{
+    { "classic", "font/theone.ttf", 28, "image/xo.png", { 0, 1181 / 2, 591, 1181 / 2 }, { 0, 0, 591, 1181 / 2 },
+      { 0x55, 0xA3, 0x00, 0xFF }, { 0x9D, 0x00, 0x00, 0xFF }, { 0x00, 0x00, 0x00, 0xFF },
+      { 0x1A, 0x1A, 0x1A, 0xFF }, { 0xCC, 0xCC, 0xCC, 0xFF }, { 0x42, 0xE2, 0xF4, 0xFF } },
+
+    { "chalk", "font/Amatic.ttf", 36, "image/xo.png", { 0, 1181 / 2, 591, 1181 / 2 }, { 0, 0, 591, 1181 / 2 },
+      { 0x55, 0xA3, 0x00, 0xFF }, { 0x9D, 0x00, 0x00, 0xFF }, { 0x1E, 0x3A, 0x2A, 0xFF },
+      { 0x1E, 0x3A, 0x2A, 0xFF }, { 0xE8, 0xE6, 0xD8, 0xFF }, { 0xF4, 0xE0, 0x42, 0xFF } },
+
+    { "lazy", "font/lazy.ttf", 28, "image/xo.png", { 0, 1181 / 2, 591, 1181 / 2 }, { 0, 0, 591, 1181 / 2 },
+      { 0x55, 0xA3, 0x00, 0xFF }, { 0x9D, 0x00, 0x00, 0xFF }, { 0x2B, 0x2D, 0x42, 0xFF },
+      { 0x2B, 0x2D, 0x42, 0xFF }, { 0x8D, 0x99, 0xAE, 0xFF }, { 0xEF, 0x8A, 0x5A, 0xFF } }
+};
+
+const int THEME_COUNT = sizeof( THEMES ) / sizeof( THEMES[0] );
+
+/*********************************************************************
+** Description: Finds a theme by name.
+*
+*  Parameters: string name - the name of the theme.
+*
+*  Return: int - the index in THEMES, or -1 if there is no such theme.
+*********************************************************************/
+int findTheme( const string &name )
+{
+    for( int i = 0; i < THEME_COUNT; i++ )
+    {
+        if( name == THEMES[i].name )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,42 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: A Theme is the look of the game: the font of the HUD,
+*  the colors of the marks, the text and the board, and the sprite
+*  sheet the SDL renderer draws the marks from. The themes are built
+*  in, one for each font in the font folder.
+*********************************************************************/
+#ifndef THEME_HPP
+#define THEME_HPP
+
+#include <SDL.h>
+
+#include <string>
+using std::string;
+
+/*********************************************************************
+** Description: This struct describes one theme.
+*********************************************************************/
+struct Theme
+{
+    const char* name;
+    const char* fontPath;
+    int fontSize; //Point size the text is rasterized at.
+    const char* spritePath; //X and O sprite sheet, cyan is transparent.
+    SDL_Rect xClip, //Where the X and the O are on the sheet.
+             oClip;
+    SDL_Color xColor, //Marks and texts of player X and player O.
+              oColor,
+              textColor, //Texts of neither player.
+              board,
+              lines, //Grid lines and the HUD panel.
+              highlight;
+};
+
+extern const Theme THEMES[];
+extern const int THEME_COUNT;
+
+int findTheme( const string & );
+
+#endif
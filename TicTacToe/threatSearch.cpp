@@ -0,0 +1,279 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ThreatSearch class looks for a forced win in a
+*  GomokuBoard by threat space search. The attacker only plays moves
+*  that threaten to win, so the defender only has a few answers to
+*  each: the cell completing a four, the cells around an open three,
+*  and fours of their own. Fours alone are tried first (victory by
+*  continuous fours), then threes as well, deepening one attacking
+*  move at a time.
+*********************************************************************/
+#include "threatSearch.hpp"
+#include <cstddef>
+
+/*********************************************************************
+** Description: Constructor.
+*********************************************************************/
+ThreatSearch::ThreatSearch()
+{
+    attacker = X_Player;
+    weakest = GomokuBoard::FOUR;
+    nodes = 0;
+}
+
+/*********************************************************************
+** Description: Searches for a forced win of the player to move.
+*
+*  Parameters: GomokuBoard position - the position to search.
+*              int maxDepth - the most attacking moves to look ahead.
+*
+*  Return: int - the first move of a forced win, or -1 if none was
+*  found within the depth.
+*********************************************************************/
+int ThreatSearch::findWin( const GomokuBoard &position, int maxDepth )
+{
+    board = position;
+    attacker = board.getToMove();
+    nodes = 0;
+
+    if( board.getOutcome() != UNFINISHED )
+    {
+        return -1;
+    }
+
+    for( int depth = 1; depth <= maxDepth; depth++ )
+    {
+        int move = -1;
+
+        weakest = GomokuBoard::FOUR;
+
+        if( attack( depth, &move ) )
+        {
+            return move;
+        }
+
+        weakest = GomokuBoard::OPEN_THREE;
+
+        if( attack( depth, &move ) )
+        {
+            return move;
+        }
+    }
+
+    return -1;
+}
+
+/*********************************************************************
+** Description: Lists the empty cells where a player would make at
+*  least a given threat, strongest threats first. A threat needs some
+*  of the player's marks on a line within SPAN cells, a four three of
+*  them for example, so only cells near enough of the player's marks
+*  are classified.
+*
+*  Parameters:
+*  1. Player player - the player to move there.
+*  2. Threat least - the weakest threat to list.
+*  3. int* cells - receives up to GomokuBoard::MAX_CELLS cells.
+*
+*  Return: int - the number of cells.
+*********************************************************************/
+int ThreatSearch::findCells( Player player, GomokuBoard::Threat least, int* cells ) const
+{
+    //Marks already in line that each threat needs, indexed by Threat.
+    static const int NEEDED[7] = { 0, 1, 2, 2, 3, 3, 4 };
+
+    GomokuBoard::Threat threats[GomokuBoard::MAX_CELLS];
+    uint8_t near[GomokuBoard::MAX_CELLS] = { 0 };
+    int size = board.getSize(),
+        count = 0;
+
+    for( int stone = 0; stone < board.getCells(); stone++ )
+    {
+        if( board.getPick( stone ) != player )
+        {
+            continue;
+        }
+
+        for( int d = 0; d < 4; d++ )
+        {
+            for( int step = -GomokuBoard::SPAN; step <= GomokuBoard::SPAN; step++ )
+            {
+                int x = stone % size + step * GomokuBoard::DIRECTIONS[d][0],
+                    y = stone / size + step * GomokuBoard::DIRECTIONS[d][1];
+
+                if( x >= 0 && x < size && y >= 0 && y < size )
+                {
+                    near[y * size + x]++;
+                }
+            }
+        }
+    }
+
+    for( int cell = 0; cell < board.getCells(); cell++ )
+    {
+        if( near[cell] < NEEDED[least] || board.getPick( cell ) != No_Player )
+        {
+            continue;
+        }
+
+        GomokuBoard::Threat threat = board.getBestThreat( cell, player );
+
+        if( threat < least )
+        {
+            continue;
+        }
+
+        //Insertion keeps the stronger threats in front.
+        int i = count++;
+
+        for( ; i > 0 && threats[i - 1] < threat; i-- )
+        {
+            threats[i] = threats[i - 1];
+            cells[i] = cells[i - 1];
+        }
+
+        threats[i] = threat;
+        cells[i] = cell;
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: The attacker is to move. Wins at once if they can,
+*  blocks a five of the defender if they must, and otherwise tries
+*  every threat at least as strong as the weakest allowed.
+*
+*  Parameters: int depth - the attacking moves left.
+*              int* move - receives the winning move, may be NULL.
+*
+*  Return: bool - true if the attacker wins by force.
+*********************************************************************/
+bool ThreatSearch::attack( int depth, int* move )
+{
+    nodes++;
+
+    Player defender = GameBoard::other( attacker );
+    int cells[GomokuBoard::MAX_CELLS];
+
+    if( findCells( attacker, GomokuBoard::FIVE, cells ) > 0 )
+    {
+        if( move != NULL )
+            *move = cells[0];
+
+        return true;
+    }
+
+    int blocks = findCells( defender, GomokuBoard::FIVE, cells );
+
+    if( blocks >= 2 || depth == 0 )
+    {
+        return false;
+    }
+
+    int count = blocks;
+
+    //A forced block keeps the initiative only if it is a threat too.
+    if( blocks == 1 && board.getBestThreat( cells[0], attacker ) < weakest )
+        return false;
+
+    else if( blocks == 0 )
+        count = findCells( attacker, weakest, cells );
+
+    for( int i = 0; i < count; i++ )
+    {
+        board.play( cells[i] );
+        bool won = defend( depth - 1, cells[i] );
+        board.undo( cells[i] );
+
+        if( won )
+        {
+            if( move != NULL )
+                *move = cells[i];
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: The defender is to move after a threat. A five of
+*  their own refutes it, two fives of the attacker can not both be
+*  blocked, and one must be. An open three can be answered on any
+*  empty cell near it or with a four of the defender's own; the
+*  attacker has to win against every answer.
+*
+*  Parameters: int depth - the attacking moves left.
+*              int threat - the cell of the threatening move.
+*
+*  Return: bool - true if the attacker wins by force.
+*********************************************************************/
+bool ThreatSearch::defend( int depth, int threat )
+{
+    nodes++;
+
+    Player defender = GameBoard::other( attacker );
+    int cells[GomokuBoard::MAX_CELLS];
+
+    if( findCells( defender, GomokuBoard::FIVE, cells ) > 0 )
+    {
+        return false;
+    }
+
+    int count = findCells( attacker, GomokuBoard::FIVE, cells );
+
+    if( count >= 2 )
+    {
+        return true;
+    }
+
+    if( count == 0 )
+    {
+        bool listed[GomokuBoard::MAX_CELLS] = { false };
+        int size = board.getSize(),
+            x = threat % size,
+            y = threat / size;
+
+        count = findCells( defender, GomokuBoard::FOUR, cells );
+
+        for( int i = 0; i < count; i++ )
+        {
+            listed[cells[i]] = true;
+        }
+
+        for( int d = 0; d < 4; d++ )
+        {
+            for( int step = -GomokuBoard::SPAN; step <= GomokuBoard::SPAN; step++ )
+            {
+                int cx = x + step * GomokuBoard::DIRECTIONS[d][0],
+                    cy = y + step * GomokuBoard::DIRECTIONS[d][1],
+                    cell = cy * size + cx;
+
+                if( cx >= 0 && cx < size && cy >= 0 && cy < size && !listed[cell]
+                    && board.getPick( cell ) == No_Player )
+                {
+                    listed[cell] = true;
+                    cells[count++] = cell;
+                }
+            }
+        }
+    }
+
+    for( int i = 0; i < count; i++ )
+    {
+        board.play( cells[i] );
+        bool won = attack( depth, NULL );
+        board.undo( cells[i] );
+
+        if( !won )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,39 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ThreatSearch class looks for a forced win in a
+*  GomokuBoard by threat space search. The attacker only plays moves
+*  that threaten to win, so the defender only has a few answers to
+*  each: the cell completing a four, the cells around an open three,
+*  and fours of their own. Fours alone are tried first (victory by
+*  continuous fours), then threes as well, deepening one attacking
+*  move at a time.
+*********************************************************************/
+#ifndef THREAT_SEARCH_HPP
+#define THREAT_SEARCH_HPP
+
+#include "gomokuBoard.hpp"
+
+class ThreatSearch
+{
+    private:
+        GomokuBoard board;
+        Player attacker;
+        GomokuBoard::Threat weakest; //Weakest threat the attacker may play.
+        long long nodes;
+
+        //Private functions.
+        bool attack( int, int* );
+        bool defend( int, int );
+        int findCells( Player, GomokuBoard::Threat, int* ) const;
+
+    public:
+        ThreatSearch();
+        int findWin( const GomokuBoard &, int );
+
+        //Getter functions.
+        long long getNodes() const { return nodes; };
+};
+
+#endif
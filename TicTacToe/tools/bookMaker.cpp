@@ -0,0 +1,371 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BookMaker class builds an opening book of an m,n,k
+*  game from self-play. A pool of worker threads plays games between
+*  two copies of a computer player, opening each game with a few
+*  random moves so the book covers more than one line, and counts the
+*  games and points of every move played in the first plies, keyed by
+*  the position's canonical key so symmetric positions add up. Each
+*  thread counts into its own table and the tables are merged once the
+*  games are done. The move with the best score, among those played
+*  often enough, becomes the book move of its position.
+*********************************************************************/
+#include "bookMaker.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+/*********************************************************************
+** Description: Main function. Takes the board size followed by the
+*  options: "--games N" self-play games, "--plies N" moves of each game
+*  recorded, "--random N" random moves opening each game, "--min N"
+*  games a move needs to be a book move, "--player SPEC" the player, as
+*  used by the game's --x-player option, "--threads N", "--seed N" and
+*  "--out FILE", by default W-H-K.book.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    int games = 10000,
+        plies = 8,
+        randomPlies = 2,
+        minGames = 10;
+    string player = "mcts:playouts=1000",
+           out;
+    int threads = static_cast<int>( std::thread::hardware_concurrency() );
+    uint64_t seed = Random::timeSeed();
+    int size[3],
+        sizeCount = 0;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--games" ) == 0 && i + 1 < argc )
+            games = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--plies" ) == 0 && i + 1 < argc )
+            plies = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--random" ) == 0 && i + 1 < argc )
+            randomPlies = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--min" ) == 0 && i + 1 < argc )
+            minGames = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--player" ) == 0 && i + 1 < argc )
+            player = argv[++i];
+
+        else if( strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc )
+            threads = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--seed" ) == 0 && i + 1 < argc )
+            seed = strtoull( argv[++i], NULL, 10 );
+
+        else if( strcmp( argv[i], "--out" ) == 0 && i + 1 < argc )
+            out = argv[++i];
+
+        else if( sizeCount < 3 )
+            size[sizeCount++] = atoi( argv[i] );
+    }
+
+    if( sizeCount < 3 || !MnkPosition::validSize( size[0], size[1], size[2] ) || games < 1 || plies < 1 )
+    {
+        printf( "Usage: bookmaker [--games N] [--plies N] [--random N] [--min N] [--player SPEC]\n" );
+        printf( "                 [--threads N] [--seed N] [--out FILE] WIDTH HEIGHT K\n" );
+        printf( "The board may have up to %d cells, for example 4 4 4 or 5 5 4.\n", MnkPosition::MAX_CELLS );
+        printf( "Games vary only through their --random opening moves when the player is deterministic, such\n" );
+        printf( "as perfect or alphabeta: N random moves give at most cells^N openings, so use enough that each\n" );
+        printf( "book position is reached --min times. MCTS players vary by themselves and need none.\n" );
+        return 1;
+    }
+
+    if( threads < 1 )
+    {
+        threads = 1;
+    }
+
+    if( out.empty() )
+    {
+        char name[32];
+        snprintf( name, sizeof( name ), "%d-%d-%d.book", size[0], size[1], size[2] );
+        out = name;
+    }
+
+    BookMaker maker( size[0], size[1], size[2], plies, randomPlies, player, seed );
+
+    if( !maker.checkPlayer() )
+    {
+        return 1;
+    }
+
+    printf( "%d self-play games of %s on %dx%d k=%d, %d threads, seed %llu\n", games, player.c_str(), size[0],
+            size[1], size[2], threads, static_cast<unsigned long long>( seed ) );
+
+    double seconds = maker.run( games, threads );
+
+    return maker.write( out, minGames, seconds ) ? 0 : 1;
+}
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters:
+*  1. int width, int height, int k - the board size.
+*  2. int plies - the moves of each game recorded in the book.
+*  3. int randomPlies - the random moves opening each game.
+*  4. string player - the self-play player's description.
+*  5. uint64_t seed - seeds every game.
+*********************************************************************/
+BookMaker::BookMaker( int width, int height, int k, int plies, int randomPlies, const string &player, uint64_t seed )
+    : player( player ), nextGame( 0 ), moves( 0 )
+{
+    this->width = width;
+    this->height = height;
+    this->k = k;
+    this->plies = plies > MnkPosition::MAX_CELLS ? MnkPosition::MAX_CELLS : plies;
+    this->randomPlies = randomPlies;
+    this->seed = seed;
+    games = 0;
+}
+
+/*********************************************************************
+** Description: Creates the player for one side of a game. MCTS players
+*  search on a single thread and quietly, since the games already run
+*  in parallel; options given in the description still take precedence.
+*
+*  Parameters: Random random - seeds the player.
+*
+*  Return: AiPlayer* - a new player, or NULL if the description is not
+*  a computer player.
+*********************************************************************/
+AiPlayer* BookMaker::createSelfPlayer( const Random &random ) const
+{
+    string spec = player;
+
+    if( spec.compare( 0, 4, "mcts" ) == 0 )
+    {
+        string options = spec.size() > 5 ? "," + spec.substr( 5 ) : "";
+        spec = "mcts:threads=1,verbose=0" + options;
+    }
+
+    return createPlayer( spec, random );
+}
+
+/*********************************************************************
+** Description: Checks that the player is a computer player of m,n,k
+*  games.
+*
+*  Return: bool - false if it is not.
+*********************************************************************/
+bool BookMaker::checkPlayer() const
+{
+    AiPlayer* self = createSelfPlayer( Random() );
+    bool plays = self != NULL && self->playsMnk();
+
+    if( !plays )
+    {
+        printf( "\"%s\" is not a computer player of m,n,k games.\n", player.c_str() );
+    }
+
+    delete self;
+
+    return plays;
+}
+
+/*********************************************************************
+** Description: Plays one self-play game and counts its first moves.
+*  Even games are started by X and odd games by O. A move that is not
+*  legal ends the game as a loss. Each side's player gets a stream of
+*  its own in every game, so stochastic players vary from game to game.
+*
+*  Parameters: int game - the game number.
+*              StatsTable table - the calling thread's table.
+*********************************************************************/
+void BookMaker::playGame( int game, StatsTable &table )
+{
+    Random random = Random( seed ).split( game );
+    AiPlayer* players[2] = { createSelfPlayer( Random( seed, 2 * game ) ),
+                             createSelfPlayer( Random( seed, 2 * game + 1 ) ) };
+
+    MnkPosition position( width, height, k, static_cast<Player>( game % 2 ) );
+    std::pair< uint64_t, int > recorded[MnkPosition::MAX_CELLS];
+    Player movers[MnkPosition::MAX_CELLS];
+    int count = 0;
+    Outcome outcome = UNFINISHED;
+
+    while( outcome == UNFINISHED )
+    {
+        Player mover = position.getToMove();
+        int move;
+
+        if( position.getPly() < randomPlies )
+        {
+            int legal[MnkPosition::MAX_MOVES];
+            move = legal[random.nextInt( position.getMoves( legal ) )];
+        }
+
+        else
+            move = players[mover]->chooseMnkMove( position );
+
+        if( count < plies )
+        {
+            int transform = 0;
+            uint64_t key = OpeningBook::canonicalKey( position, transform );
+
+            recorded[count] = std::make_pair( key, OpeningBook::transformCell( move, transform, width, height ) );
+            movers[count++] = mover;
+        }
+
+        moves++;
+
+        if( !position.play( move ) )
+            outcome = mover == X_Player ? O_WON : X_WON;
+
+        else
+            outcome = position.getOutcome();
+    }
+
+    delete players[0];
+    delete players[1];
+
+    for( int i = 0; i < count; i++ )
+    {
+        Stats &stats = table[recorded[i]];
+        stats.games++;
+
+        if( outcome == DRAW )
+            stats.points += 1;
+
+        else if( ( outcome == X_WON ) == ( movers[i] == X_Player ) )
+            stats.points += 2;
+    }
+}
+
+/*********************************************************************
+** Description: One pool thread. Takes the next unplayed game until
+*  there are none left, counting into its own table.
+*
+*  Parameters: int thread - the thread's number.
+*********************************************************************/
+void BookMaker::worker( int thread )
+{
+    for( int game = nextGame.fetch_add( 1 ); game < games; game = nextGame.fetch_add( 1 ) )
+    {
+        playGame( game, shards[thread] );
+    }
+}
+
+/*********************************************************************
+** Description: Plays the self-play games.
+*
+*  Parameters: int games - the number of games.
+*              int threads - the number of worker threads.
+*
+*  Return: double - the wall clock time in seconds.
+*********************************************************************/
+double BookMaker::run( int games, int threads )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    this->games = games;
+    nextGame.store( 0 );
+    moves.store( 0 );
+    shards.assign( threads, StatsTable() );
+
+    vector< std::thread > pool;
+
+    for( int t = 0; t < threads; t++ )
+    {
+        pool.push_back( std::thread( &BookMaker::worker, this, t ) );
+    }
+
+    for( unsigned t = 0; t < pool.size(); t++ )
+    {
+        pool[t].join();
+    }
+
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+/*********************************************************************
+** Description: Merges the threads' tables and writes the book: for
+*  each position, the move with the best average score among those
+*  played in at least minGames games.
+*
+*  Parameters:
+*  1. string path - the book file.
+*  2. int minGames - the games a move needs to be a book move.
+*  3. double seconds - the time the games took, for the report.
+*
+*  Return: bool - false if the book could not be written.
+*********************************************************************/
+bool BookMaker::write( const string &path, int minGames, double seconds )
+{
+    StatsTable merged;
+
+    for( unsigned t = 0; t < shards.size(); t++ )
+    {
+        for( StatsTable::const_iterator it = shards[t].begin(); it != shards[t].end(); ++it )
+        {
+            Stats &stats = merged[it->first];
+            stats.games += it->second.games;
+            stats.points += it->second.points;
+        }
+
+        shards[t].clear();
+    }
+
+    vector< OpeningBook::Entry > entries;
+
+    //Moves of a position are next to each other in the table.
+    for( StatsTable::const_iterator it = merged.begin(); it != merged.end(); )
+    {
+        uint64_t key = it->first.first;
+        OpeningBook::Entry entry;
+        double bestScore = -1.0;
+
+        entry.key = key;
+        entry.games = 0;
+        entry.score = 0;
+        entry.move = 0;
+        entry.moveCount = 0;
+
+        for( ; it != merged.end() && it->first.first == key; ++it )
+        {
+            const Stats &stats = it->second;
+            double score = stats.points / ( 2.0 * stats.games );
+
+            entry.moveCount++;
+
+            if( static_cast<int>( stats.games ) >= minGames && score > bestScore )
+            {
+                bestScore = score;
+                entry.games = stats.games;
+                entry.score = static_cast<uint16_t>( score * OpeningBook::SCORE_SCALE + 0.5 );
+                entry.move = static_cast<uint8_t>( it->first.second );
+            }
+        }
+
+        if( bestScore >= 0.0 )
+        {
+            entries.push_back( entry );
+        }
+    }
+
+    printf( "%d games in %.1f s: %.0f games/sec, %.0f moves/sec\n", games, seconds, games / seconds,
+            moves.load() / seconds );
+    printf( "%d positions and moves seen, %d positions in the book, %.1f KB\n", static_cast<int>( merged.size() ),
+            static_cast<int>( entries.size() ),
+            ( sizeof( OpeningBook::Header ) + entries.size() * sizeof( OpeningBook::Entry ) ) / 1024.0 );
+
+    if( !OpeningBook::write( path, width, height, k, plies, entries ) )
+    {
+        return false;
+    }
+
+    printf( "Wrote %s\n", path.c_str() );
+
+    return true;
+}
@@ -0,0 +1,75 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The BookMaker class builds an opening book of an m,n,k
+*  game from self-play. A pool of worker threads plays games between
+*  two copies of a computer player, opening each game with a few
+*  random moves so the book covers more than one line, and counts the
+*  games and points of every move played in the first plies, keyed by
+*  the position's canonical key so symmetric positions add up. Each
+*  thread counts into its own table and the tables are merged once the
+*  games are done. The move with the best score, among those played
+*  often enough, becomes the book move of its position.
+*********************************************************************/
+#ifndef BOOK_MAKER_HPP
+#define BOOK_MAKER_HPP
+
+#include "../aiPlayer.hpp"
+#include "../openingBook.hpp"
+#include <atomic>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class BookMaker
+{
+    private:
+        /*********************************************************************
+         ** Description: This struct counts the games of one move.
+         *********************************************************************/
+        struct Stats
+        {
+            uint32_t games,
+                     points; //Half points of the player who made the move.
+
+            Stats()
+            {
+                games = 0;
+                points = 0;
+            }
+        };
+
+        //Keyed by the canonical key of the position and the canonical move.
+        typedef std::map< std::pair< uint64_t, int >, Stats > StatsTable;
+
+        int width,
+            height,
+            k,
+            plies, //Moves recorded at the start of each game.
+            randomPlies; //Random moves opening each game.
+        string player;
+        uint64_t seed;
+        int games;
+
+        vector< StatsTable > shards; //One per worker thread.
+        std::atomic< int > nextGame;
+        std::atomic< long long > moves;
+
+        //Private functions.
+        AiPlayer* createSelfPlayer( const Random & ) const;
+        void playGame( int, StatsTable & );
+        void worker( int );
+
+    public:
+        BookMaker( int, int, int, int, int, const string &, uint64_t );
+        bool checkPlayer() const;
+        double run( int, int );
+        bool write( const string &, int, double );
+};
+
+#endif
@@ -0,0 +1,614 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Perft class enumerates the whole game tree below a
+*  position, the way chess engines run perft, counting the positions
+*  reached at every depth and the games ending there by outcome. The
+*  counts of classic Tic Tac Toe are known, 255,168 games and 5,478
+*  distinct positions, so the tool checks the move generation and the
+*  outcome of every move after they are optimized, and its nodes per
+*  second are a benchmark of both. The tree is split a few plies down
+*  into subtrees that worker threads claim one at a time, each counting
+*  on its own. "--check" also recomputes every outcome from scratch.
+*********************************************************************/
+#include "perft.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+
+using std::string;
+
+template< class Position >
+static int perftMain( const Position &, const string &, const string &, int, int, int, bool, bool );
+
+/*********************************************************************
+** Description: Main function. Options: "--mode classic", "ultimate",
+*  "qubic" or "mnk:W,H,K" chooses the game, "--moves A,B,..." plays
+*  moves from the empty board first, "--depth N" stops the tree N
+*  plies down, "--threads N" sets the threads of the parallel run,
+*  "--repeat N" runs each count N times for steadier timings,
+*  "--check" recomputes every outcome and "--unique" also counts the
+*  distinct positions, which classic games always do.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    string mode = "classic",
+           moves;
+    int depth = Perft::MAX_PLIES,
+        repeat = 1,
+        size[3] = { 3, 3, 3 };
+    int threads = static_cast<int>( std::thread::hardware_concurrency() );
+    bool check = false,
+         unique = false;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--mode" ) == 0 && i + 1 < argc )
+            mode = argv[++i];
+
+        else if( strcmp( argv[i], "--moves" ) == 0 && i + 1 < argc )
+            moves = argv[++i];
+
+        else if( strcmp( argv[i], "--depth" ) == 0 && i + 1 < argc )
+            depth = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc )
+            threads = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--repeat" ) == 0 && i + 1 < argc )
+            repeat = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--check" ) == 0 )
+            check = true;
+
+        else if( strcmp( argv[i], "--unique" ) == 0 )
+            unique = true;
+
+        else
+        {
+            mode.clear();
+            break;
+        }
+    }
+
+    if( threads < 1 )
+    {
+        threads = 1;
+    }
+
+    if( depth > Perft::MAX_PLIES )
+    {
+        depth = Perft::MAX_PLIES;
+    }
+
+    if( mode == "classic" )
+        return perftMain( GamePosition( X_Player ), mode, moves, depth, threads, repeat, check, true );
+
+    if( mode == "ultimate" )
+        return perftMain( UltimatePosition( X_Player ), mode, moves, depth, threads, repeat, check, unique );
+
+    if( mode == "qubic" )
+        return perftMain( QubicPosition( X_Player ), mode, moves, depth, threads, repeat, check, unique );
+
+    if( mode.compare( 0, 4, "mnk:" ) == 0 && sscanf( mode.c_str() + 4, "%d,%d,%d", &size[0], &size[1], &size[2] ) == 3
+        && MnkPosition::validSize( size[0], size[1], size[2] ) )
+    {
+        return perftMain( MnkPosition( size[0], size[1], size[2], X_Player ), mode, moves, depth, threads, repeat,
+                          check, unique );
+    }
+
+    printf( "Usage: perft [--mode classic|ultimate|qubic|mnk:W,H,K] [--moves A,B,...] [--depth N]\n" );
+    printf( "             [--threads N] [--repeat N] [--check] [--unique]\n" );
+
+    return 1;
+}
+
+/*********************************************************************
+** Description: Plays the starting moves, counts the tree on one thread
+*  and on many, prints the counts by depth and the nodes per second of
+*  both runs, and compares classic games from the empty board with the
+*  known counts.
+*
+*  Parameters:
+*  1. Position start - the empty board.
+*  2. string mode - the game, for the report.
+*  3. string moves - the starting moves, separated by commas.
+*  4. int depth - positions this many plies down are not expanded.
+*  5. int threads - the threads of the parallel run.
+*  6. int repeat - the times each run is repeated.
+*  7. bool check - recomputes every outcome.
+*  8. bool unique - counts the distinct positions.
+*
+*  Return: int - 0 if the counts are consistent and match the known
+*  ones, 1 if not.
+*********************************************************************/
+template< class Position >
+static int perftMain( const Position &start, const string &mode, const string &moves, int depth, int threads,
+                      int repeat, bool check, bool unique )
+{
+    Position root = start;
+    bool fromEmpty = true;
+
+    for( const char* text = moves.c_str(); *text != '\0'; )
+    {
+        char* end = NULL;
+        int move = static_cast<int>( strtol( text, &end, 10 ) );
+
+        if( end == text || !root.play( move ) )
+        {
+            printf( "Illegal move in \"%s\".\n", moves.c_str() );
+            return 1;
+        }
+
+        fromEmpty = false;
+        text = *end == ',' ? end + 1 : end;
+    }
+
+    Perft perft( depth, check );
+    Perft::Counts single,
+                  parallel;
+    double singleSeconds = 0.0,
+           parallelSeconds = 0.0;
+
+    for( int r = 0; r < repeat; r++ )
+    {
+        single = Perft::Counts();
+        singleSeconds += perft.run( root, 1, single );
+    }
+
+    for( int r = 0; r < repeat && threads > 1; r++ )
+    {
+        parallel = Perft::Counts();
+        parallelSeconds += perft.run( root, threads, parallel );
+    }
+
+    printf( "Perft of %s%s%s", mode.c_str(), fromEmpty ? "" : " after ", moves.c_str() );
+
+    if( depth < Perft::MAX_PLIES )
+        printf( ", depth %d\n", depth );
+
+    else
+        printf( "\n" );
+    printf( "%5s %16s %16s %16s %16s\n", "depth", "nodes", "X wins", "O wins", "draws" );
+
+    uint64_t total[4] = { 0, 0, 0, 0 };
+
+    for( int d = 0; d <= depth && single.nodes[d] > 0; d++ )
+    {
+        printf( "%5d %16llu %16llu %16llu %16llu\n", d, static_cast<unsigned long long>( single.nodes[d] ),
+                static_cast<unsigned long long>( single.xWins[d] ), static_cast<unsigned long long>( single.oWins[d] ),
+                static_cast<unsigned long long>( single.draws[d] ) );
+
+        total[0] += single.nodes[d];
+        total[1] += single.xWins[d];
+        total[2] += single.oWins[d];
+        total[3] += single.draws[d];
+    }
+
+    printf( "%5s %16llu %16llu %16llu %16llu\n", "total", static_cast<unsigned long long>( total[0] ),
+            static_cast<unsigned long long>( total[1] ), static_cast<unsigned long long>( total[2] ),
+            static_cast<unsigned long long>( total[3] ) );
+
+    uint64_t games = total[1] + total[2] + total[3];
+    uint64_t distinct = unique ? perft.countUnique( root ) : 0;
+
+    printf( "%llu finished games", static_cast<unsigned long long>( games ) );
+
+    if( distinct > 0 )
+        printf( ", %llu distinct positions\n", static_cast<unsigned long long>( distinct ) );
+
+    else
+        printf( "\n" );
+
+    printf( "1 thread:  %8.3f s %12.1f M nodes/sec\n", singleSeconds, total[0] * repeat / singleSeconds / 1e6 );
+
+    if( threads > 1 )
+    {
+        printf( "%d threads: %8.3f s %12.1f M nodes/sec, %.2fx\n", threads, parallelSeconds,
+                total[0] * repeat / parallelSeconds / 1e6, singleSeconds / parallelSeconds );
+    }
+
+    bool correct = true;
+
+    if( threads > 1 && !( single == parallel ) )
+    {
+        printf( "FAIL: the parallel count differs from the single threaded one!\n" );
+        correct = false;
+    }
+
+    if( single.errors > 0 )
+    {
+        printf( "FAIL: %llu positions have the wrong outcome or moves!\n", static_cast<unsigned long long>( single.errors ) );
+        correct = false;
+    }
+
+    if( mode == "classic" && fromEmpty && depth >= GameBoard::CELLS )
+    {
+        if( games == 255168 && distinct == 5478 )
+        {
+            printf( "Matches the known 255168 games and 5478 positions of Tic Tac Toe.\n" );
+        }
+
+        else
+        {
+            printf( "FAIL: Tic Tac Toe has 255168 games and 5478 positions!\n" );
+            correct = false;
+        }
+    }
+
+    return correct ? 0 : 1;
+}
+
+/*********************************************************************
+** Description: Constructor. Every count is 0.
+*********************************************************************/
+Perft::Counts::Counts()
+{
+    memset( this, 0, sizeof( *this ) );
+}
+
+/*********************************************************************
+** Description: Adds the counts of another tree.
+*
+*  Parameters: Counts other - the counts to add.
+*********************************************************************/
+void Perft::Counts::add( const Counts &other )
+{
+    for( int d = 0; d <= MAX_PLIES; d++ )
+    {
+        nodes[d] += other.nodes[d];
+        xWins[d] += other.xWins[d];
+        oWins[d] += other.oWins[d];
+        draws[d] += other.draws[d];
+    }
+
+    errors += other.errors;
+}
+
+/*********************************************************************
+** Description: Compares two sets of counts.
+*
+*  Parameters: Counts other - the counts to compare with.
+*
+*  Return: bool - true if every count is the same.
+*********************************************************************/
+bool Perft::Counts::operator==( const Counts &other ) const
+{
+    return memcmp( this, &other, sizeof( *this ) ) == 0;
+}
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters: int depth - positions this many plies down are not
+*              expanded.
+*              bool check - recomputes the outcome of every position.
+*********************************************************************/
+Perft::Perft( int depth, bool check ) : nextTask( 0 )
+{
+    this->depth = depth;
+    this->check = check;
+}
+
+/*********************************************************************
+** Description: Counts one position.
+*
+*  Parameters:
+*  1. Position position - the position.
+*  2. int ply - its depth below the root.
+*  3. Counts counts - receives the counts.
+*  4. KeySet* keys - receives the position's key, or NULL.
+*
+*  Return: bool - true if the position is to be expanded.
+*********************************************************************/
+template< class Position >
+bool Perft::visit( const Position &position, int ply, Counts &counts, KeySet* keys ) const
+{
+    uint64_t key = 0;
+
+    counts.nodes[ply]++;
+
+    if( keys != NULL && positionKey( position, key ) )
+    {
+        keys->insert( key );
+    }
+
+    if( check && !verify( position ) )
+    {
+        counts.errors++;
+    }
+
+    switch( position.getOutcome() )
+    {
+        case X_WON:
+            counts.xWins[ply]++;
+            return false;
+
+        case O_WON:
+            counts.oWins[ply]++;
+            return false;
+
+        case DRAW:
+            counts.draws[ply]++;
+            return false;
+
+        default:
+            return ply < depth;
+    }
+}
+
+/*********************************************************************
+** Description: Counts a subtree, making each move on a copy of the
+*  position.
+*
+*  Parameters:
+*  1. Position position - the root of the subtree.
+*  2. int ply - its depth below the root of the tree.
+*  3. Counts counts - receives the counts.
+*  4. KeySet* keys - receives the keys of the positions, or NULL.
+*********************************************************************/
+template< class Position >
+void Perft::walk( const Position &position, int ply, Counts &counts, KeySet* keys ) const
+{
+    if( !visit( position, ply, counts, keys ) )
+    {
+        return;
+    }
+
+    int moves[Position::MAX_MOVES];
+    int count = position.getMoves( moves );
+
+    for( int i = 0; i < count; i++ )
+    {
+        Position next = position;
+
+        if( !next.play( moves[i] ) )
+        {
+            counts.errors++;
+            continue;
+        }
+
+        walk( next, ply + 1, counts, keys );
+    }
+}
+
+/*********************************************************************
+** Description: One pool thread. Counts the next uncounted subtree until
+*  there are none left.
+*
+*  Parameters:
+*  1. vector<Position> tasks - the roots of the subtrees.
+*  2. int ply - their depth below the root of the tree.
+*  3. Counts* counts - receives the thread's counts.
+*  4. KeySet* keys - receives the thread's keys, or NULL.
+*********************************************************************/
+template< class Position >
+void Perft::worker( const vector< Position > &tasks, int ply, Counts* counts, KeySet* keys )
+{
+    for( size_t task = nextTask.fetch_add( 1 ); task < tasks.size(); task = nextTask.fetch_add( 1 ) )
+    {
+        walk( tasks[task], ply, *counts, keys );
+    }
+}
+
+/*********************************************************************
+** Description: Counts the tree below a position. With more than one
+*  thread, the plies near the root are counted here until there are
+*  enough positions to give each thread several subtrees.
+*
+*  Parameters:
+*  1. Position root - the root of the tree.
+*  2. int threads - the number of threads.
+*  3. Counts counts - receives the counts.
+*
+*  Return: double - the wall clock time in seconds.
+*********************************************************************/
+template< class Position >
+double Perft::run( const Position &root, int threads, Counts &counts )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if( threads <= 1 )
+    {
+        walk( root, 0, counts, NULL );
+        return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    vector< Position > tasks( 1, root );
+    int ply = 0;
+
+    while( !tasks.empty() && static_cast<int>( tasks.size() ) < threads * 16 )
+    {
+        vector< Position > next;
+
+        for( size_t t = 0; t < tasks.size(); t++ )
+        {
+            if( !visit( tasks[t], ply, counts, NULL ) )
+            {
+                continue;
+            }
+
+            int moves[Position::MAX_MOVES];
+            int count = tasks[t].getMoves( moves );
+
+            for( int i = 0; i < count; i++ )
+            {
+                next.push_back( tasks[t] );
+
+                if( !next.back().play( moves[i] ) )
+                {
+                    counts.errors++;
+                    next.pop_back();
+                }
+            }
+        }
+
+        tasks.swap( next );
+        ply++;
+    }
+
+    vector< Counts > threadCounts( threads );
+    vector< std::thread > pool;
+
+    nextTask.store( 0 );
+
+    for( int t = 0; t < threads; t++ )
+    {
+        pool.push_back( std::thread( &Perft::worker< Position >, this, std::cref( tasks ), ply, &threadCounts[t],
+                                     static_cast< KeySet* >( NULL ) ) );
+    }
+
+    for( int t = 0; t < threads; t++ )
+    {
+        pool[t].join();
+        counts.add( threadCounts[t] );
+    }
+
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+/*********************************************************************
+** Description: Counts the distinct positions of the tree below a
+*  position, on one thread.
+*
+*  Parameters: Position root - the root of the tree.
+*
+*  Return: uint64_t - the number of distinct positions, or 0 if the
+*  game's positions have no key.
+*********************************************************************/
+template< class Position >
+uint64_t Perft::countUnique( const Position &root )
+{
+    KeySet keys;
+    Counts counts;
+
+    walk( root, 0, counts, &keys );
+
+    return keys.size();
+}
+
+/*********************************************************************
+** Description: Returns the key of a classic position.
+*
+*  Parameters: GamePosition position - the position.
+*              uint64_t key - receives the key.
+*
+*  Return: bool - true.
+*********************************************************************/
+bool Perft::positionKey( const GamePosition &position, uint64_t &key )
+{
+    const GameBoard &board = position.getBoard();
+    key = board.getMarks( X_Player ) | board.getMarks( O_Player ) << 9 | position.getToMove() << 18;
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Returns the key of an m,n,k position. The player to
+*  move follows from the marks within one tree.
+*
+*  Parameters: MnkPosition position - the position.
+*              uint64_t key - receives the key.
+*
+*  Return: bool - true.
+*********************************************************************/
+bool Perft::positionKey( const MnkPosition &position, uint64_t &key )
+{
+    key = static_cast<uint64_t>( position.getMarks( X_Player ) ) << 32 | position.getMarks( O_Player );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Recomputes the outcome of a classic position from its
+*  marks with the eight winning lines, and counts its empty cells.
+*
+*  Parameters: GamePosition position - the position.
+*
+*  Return: bool - false if the position's outcome or moves differ.
+*********************************************************************/
+bool Perft::verify( const GamePosition &position ) const
+{
+    const GameBoard &board = position.getBoard();
+    bool won[2] = { false, false };
+
+    for( int line = 0; line < 8; line++ )
+    {
+        for( int p = 0; p < 2; p++ )
+        {
+            uint16_t mask = GameBoard::WIN_LINES[line];
+            won[p] = won[p] || ( board.getMarks( static_cast<Player>( p ) ) & mask ) == mask;
+        }
+    }
+
+    Outcome expected = won[X_Player] ? X_WON : ( won[O_Player] ? O_WON : ( board.getEmpty() == 0 ? DRAW : UNFINISHED ) );
+    int moves[GamePosition::MAX_MOVES];
+    int count = expected == UNFINISHED ? __builtin_popcount( board.getEmpty() ) : 0;
+
+    return !( won[X_Player] && won[O_Player] ) && position.getOutcome() == expected
+        && position.getMoves( moves ) == count;
+}
+
+/*********************************************************************
+** Description: Recomputes the outcome of a Qubic position from its
+*  stones with the 76 lines of the cube, and counts its empty cells.
+*
+*  Parameters: QubicPosition position - the position.
+*
+*  Return: bool - false if the position's outcome or moves differ.
+*********************************************************************/
+bool Perft::verify( const QubicPosition &position ) const
+{
+    bool won[2] = { false, false };
+
+    for( int line = 0; line < QubicPosition::LINES; line++ )
+    {
+        for( int p = 0; p < 2; p++ )
+        {
+            uint64_t mask = QubicPosition::getLine( line );
+            won[p] = won[p] || ( position.getStones( static_cast<Player>( p ) ) & mask ) == mask;
+        }
+    }
+
+    Outcome expected = won[X_Player] ? X_WON : ( won[O_Player] ? O_WON : ( position.getEmpty() == 0 ? DRAW : UNFINISHED ) );
+    int moves[QubicPosition::MAX_MOVES];
+    int count = expected == UNFINISHED ? __builtin_popcountll( position.getEmpty() ) : 0;
+
+    return !( won[X_Player] && won[O_Player] ) && position.getOutcome() == expected
+        && position.getMoves( moves ) == count;
+}
+
+/*********************************************************************
+** Description: Recomputes the outcome of an m,n,k position from its
+*  marks with every line of k cells, and counts its empty cells.
+*
+*  Parameters: MnkPosition position - the position.
+*
+*  Return: bool - false if the position's outcome or moves differ.
+*********************************************************************/
+bool Perft::verify( const MnkPosition &position ) const
+{
+    uint32_t lines[MnkPosition::MAX_LINES];
+    int lineCount = position.getLines( lines );
+    bool won[2] = { false, false };
+
+    for( int line = 0; line < lineCount; line++ )
+    {
+        for( int p = 0; p < 2; p++ )
+        {
+            won[p] = won[p] || ( position.getMarks( static_cast<Player>( p ) ) & lines[line] ) == lines[line];
+        }
+    }
+
+    Outcome expected = won[X_Player] ? X_WON : ( won[O_Player] ? O_WON : ( position.getEmpty() == 0 ? DRAW : UNFINISHED ) );
+    int moves[MnkPosition::MAX_MOVES];
+    int count = expected == UNFINISHED ? __builtin_popcount( position.getEmpty() ) : 0;
+
+    return !( won[X_Player] && won[O_Player] ) && position.getOutcome() == expected
+        && position.getMoves( moves ) == count;
+}
@@ -0,0 +1,84 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Perft class enumerates the whole game tree below a
+*  position, the way chess engines run perft, counting the positions
+*  reached at every depth and the games ending there by outcome. The
+*  counts of classic Tic Tac Toe are known, 255,168 games and 5,478
+*  distinct positions, so the tool checks the move generation and the
+*  outcome of every move after they are optimized, and its nodes per
+*  second are a benchmark of both. The tree is split a few plies down
+*  into subtrees that worker threads claim one at a time, each counting
+*  on its own. "--check" also recomputes every outcome from scratch.
+*********************************************************************/
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#include "../gamePosition.hpp"
+#include "../ultimatePosition.hpp"
+#include "../qubicPosition.hpp"
+#include "../mnkPosition.hpp"
+#include <atomic>
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+using std::vector;
+
+class Perft
+{
+    public:
+        static const int MAX_PLIES = UltimatePosition::CELLS;
+
+        /*********************************************************************
+         ** Description: This struct holds the counts of a tree, by depth.
+         *********************************************************************/
+        struct Counts
+        {
+            uint64_t nodes[MAX_PLIES + 1],
+                     xWins[MAX_PLIES + 1],
+                     oWins[MAX_PLIES + 1],
+                     draws[MAX_PLIES + 1];
+            uint64_t errors; //Positions whose rules check failed.
+
+            Counts();
+            void add( const Counts & );
+            bool operator==( const Counts & ) const;
+        };
+
+    private:
+        typedef std::unordered_set< uint64_t > KeySet;
+
+        int depth; //Positions this many plies down are not expanded.
+        bool check;
+
+        std::atomic< size_t > nextTask;
+
+        //Private functions.
+        template< class Position >
+        bool visit( const Position &, int, Counts &, KeySet * ) const;
+        template< class Position >
+        void walk( const Position &, int, Counts &, KeySet * ) const;
+        template< class Position >
+        void worker( const vector< Position > &, int, Counts *, KeySet * );
+
+        bool verify( const GamePosition & ) const;
+        bool verify( const UltimatePosition & ) const { return true; };
+        bool verify( const QubicPosition & ) const;
+        bool verify( const MnkPosition & ) const;
+
+        static bool positionKey( const GamePosition &, uint64_t & );
+        static bool positionKey( const UltimatePosition &, uint64_t & ) { return false; };
+        static bool positionKey( const QubicPosition &, uint64_t & ) { return false; };
+        static bool positionKey( const MnkPosition &, uint64_t & );
+
+    public:
+        Perft( int, bool );
+        template< class Position >
+        double run( const Position &, int, Counts & );
+        template< class Position >
+        uint64_t countUnique( const Position & );
+};
+
+#endif
@@ -0,0 +1,219 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The RefEngine class is a trivial engine for the engine
+*  protocol described in engine.hpp. It reads commands on its standard
+*  input and answers every go at once with a random legal move, so it
+*  can stand in for a real engine when the protocol is tested, and its
+*  round trips measure the protocol's own cost per move. It is built
+*  without the game core, the way an engine from elsewhere would be.
+*********************************************************************/
+#include "refEngine.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*********************************************************************
+** Description: Runs the reference engine until quit or the end of its
+*  input. "--seed N" seeds its moves.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    uint64_t seed = 1;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--seed" ) == 0 && i + 1 < argc )
+        {
+            seed = strtoull( argv[++i], NULL, 10 );
+        }
+    }
+
+    RefEngine engine( seed );
+    engine.run();
+
+    return 0;
+}
+
+/*********************************************************************
+** Description: Constructor. Starts on an empty classic board.
+*
+*  Parameters: uint64_t seed - seeds the moves.
+*********************************************************************/
+RefEngine::RefEngine( uint64_t seed )
+{
+    game = "classic";
+    cells = ".........";
+    board = -1;
+    this->seed = seed == 0 ? 1 : seed;
+}
+
+/*********************************************************************
+** Description: Answers commands, one a line, until quit or the end of
+*  the input.
+*********************************************************************/
+void RefEngine::run()
+{
+    char buffer[512];
+
+    while( fgets( buffer, sizeof( buffer ), stdin ) != NULL )
+    {
+        string line = buffer;
+
+        while( !line.empty() && ( line[line.size() - 1] == '\n' || line[line.size() - 1] == '\r' ) )
+        {
+            line.erase( line.size() - 1 );
+        }
+
+        if( !handle( line ) )
+        {
+            break;
+        }
+
+        fflush( stdout );
+    }
+}
+
+/*********************************************************************
+** Description: Answers one command.
+*
+*  Parameters: string line - the command.
+*
+*  Return: bool - false on quit.
+*********************************************************************/
+bool RefEngine::handle( const string &line )
+{
+    if( line == "ttp" )
+    {
+        printf( "id name reference\n" );
+        printf( "games classic ultimate qubic mnk\n" );
+        printf( "ttpok\n" );
+    }
+
+    else if( line == "isready" )
+        printf( "readyok\n" );
+
+    else if( line.compare( 0, 9, "position " ) == 0 )
+        setPosition( line.substr( 9 ) );
+
+    else if( line.compare( 0, 3, "go " ) == 0 || line == "go" )
+    {
+        //Searches are answered at once, so stop has nothing to do.
+        size_t id = line.find( " id " );
+
+        if( id == string::npos )
+            printf( "bestmove %d\n", chooseMove() );
+
+        else
+            printf( "bestmove %d id %s\n", chooseMove(), line.c_str() + id + 4 );
+    }
+
+    else if( line == "quit" )
+        return false;
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Reads the position to search.
+*
+*  Parameters: string text - GAME CELLS SIDE [BOARD].
+*********************************************************************/
+void RefEngine::setPosition( const string &text )
+{
+    char gameText[32],
+         cellText[128],
+         sideText[4],
+         boardText[4];
+
+    int read = sscanf( text.c_str(), "%31s %127s %3s %3s", gameText, cellText, sideText, boardText );
+
+    if( read < 2 )
+    {
+        return;
+    }
+
+    game = gameText;
+    cells = cellText;
+    board = read == 4 && boardText[0] >= '0' && boardText[0] <= '8' ? boardText[0] - '0' : -1;
+}
+
+/*********************************************************************
+** Description: Chooses a random empty cell. In Ultimate Tic Tac Toe
+*  the cell is in the board to play in, or in any board that is not won
+*  or full when that one is closed or any board may be played.
+*
+*  Return: int - the chosen cell, or -1 if there is none.
+*********************************************************************/
+int RefEngine::chooseMove()
+{
+    int moves[128],
+        count = 0;
+    bool ultimate = game == "ultimate";
+    int active = ultimate && board >= 0 && !boardClosed( board ) ? board : -1;
+
+    for( int cell = 0; cell < static_cast<int>( cells.size() ) && count < 128; cell++ )
+    {
+        if( cells[cell] != '.' )
+        {
+            continue;
+        }
+
+        if( ultimate && ( active >= 0 ? cell / 9 != active : boardClosed( cell / 9 ) ) )
+        {
+            continue;
+        }
+
+        moves[count++] = cell;
+    }
+
+    return count == 0 ? -1 : moves[nextInt( count )];
+}
+
+/*********************************************************************
+** Description: Checks whether an Ultimate board is won or full.
+*
+*  Parameters: int b - the board, 0 to 8.
+*
+*  Return: bool - true if no more moves can be made in it.
+*********************************************************************/
+bool RefEngine::boardClosed( int b ) const
+{
+    static const int LINES[8][3] = { { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 }, { 0, 3, 6 },
+                                     { 1, 4, 7 }, { 2, 5, 8 }, { 0, 4, 8 }, { 2, 4, 6 } };
+    const char* square = cells.c_str() + b * 9;
+
+    if( cells.size() < static_cast<size_t>( b * 9 + 9 ) )
+    {
+        return true;
+    }
+
+    for( int i = 0; i < 8; i++ )
+    {
+        char first = square[LINES[i][0]];
+
+        if( first != '.' && first == square[LINES[i][1]] && first == square[LINES[i][2]] )
+        {
+            return true;
+        }
+    }
+
+    return memchr( square, '.', 9 ) == NULL;
+}
+
+/*********************************************************************
+** Description: Returns a random number with xorshift64*.
+*
+*  Parameters: int bound - the number of values.
+*
+*  Return: int - a number from 0 to bound - 1.
+*********************************************************************/
+int RefEngine::nextInt( int bound )
+{
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+
+    return static_cast<int>( ( ( seed * 2685821657736338717ULL ) >> 32 ) % bound );
+}
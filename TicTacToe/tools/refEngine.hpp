@@ -0,0 +1,40 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The RefEngine class is a trivial engine for the engine
+*  protocol described in engine.hpp. It reads commands on its standard
+*  input and answers every go at once with a random legal move, so it
+*  can stand in for a real engine when the protocol is tested, and its
+*  round trips measure the protocol's own cost per move. It is built
+*  without the game core, the way an engine from elsewhere would be.
+*********************************************************************/
+#ifndef REF_ENGINE_HPP
+#define REF_ENGINE_HPP
+
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+class RefEngine
+{
+    private:
+        string game, //classic, ultimate, qubic or mnk:W,H,K.
+               cells; //One character a cell, x, o or '.'.
+        int board; //The Ultimate board to play in, or -1 for any.
+        uint64_t seed;
+
+        //Private functions.
+        bool handle( const string & );
+        void setPosition( const string & );
+        int chooseMove();
+        bool boardClosed( int ) const;
+        int nextInt( int );
+
+    public:
+        RefEngine( uint64_t );
+        void run();
+};
+
+#endif
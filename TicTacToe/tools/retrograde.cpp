@@ -0,0 +1,449 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Retrograde class solves an m,n,k game by retrograde
+*  analysis. Every move adds a mark, so the scores of a ply depend only
+*  on the ply after it: the plies are solved from the full board back
+*  to the empty one, each written to its own memory mapped table file
+*  while the next ply's file is read. Only those two plies are in use
+*  at a time and the operating system pages them in and out, so tables
+*  larger than memory can be solved. The positions of a ply are split
+*  into chunks that worker threads claim one at a time.
+*********************************************************************/
+#include "retrograde.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/*********************************************************************
+** Description: Solves one board size and writes its tables.
+*
+*  Usage: retrograde [--dir DIR] [--threads N] WIDTH HEIGHT K
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    string dir = "tables";
+    int threads = static_cast<int>( std::thread::hardware_concurrency() );
+    int size[3],
+        sizeCount = 0;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--dir" ) == 0 && i + 1 < argc )
+        {
+            dir = argv[++i];
+        }
+
+        else if( strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc )
+        {
+            threads = atoi( argv[++i] );
+        }
+
+        else if( sizeCount < 3 )
+        {
+            size[sizeCount++] = atoi( argv[i] );
+        }
+    }
+
+    if( sizeCount < 3 || !MnkPosition::validSize( size[0], size[1], size[2] ) )
+    {
+        printf( "Usage: retrograde [--dir DIR] [--threads N] WIDTH HEIGHT K\n" );
+        printf( "The board may have up to %d cells, for example 4 4 4 or 5 4 4.\n", MnkPosition::MAX_CELLS );
+        return 1;
+    }
+
+    if( threads < 1 )
+    {
+        threads = 1;
+    }
+
+#ifdef _WIN32
+    _mkdir( dir.c_str() );
+#else
+    mkdir( dir.c_str(), 0755 );
+#endif
+
+    Retrograde retrograde( size[0], size[1], size[2], dir );
+
+    return retrograde.solve( threads ) ? 0 : 1;
+}
+
+/*********************************************************************
+** Description: Returns the next larger number with as many set bits,
+*  which is the next combination in colexicographic order.
+*
+*  Parameters: uint64_t bits - the current combination.
+*
+*  Return: uint64_t - the next combination, or 0 for the empty set.
+*********************************************************************/
+static uint64_t nextCombination( uint64_t bits )
+{
+    if( bits == 0 )
+    {
+        return 0;
+    }
+
+    uint64_t lowest = bits & ( 0 - bits ),
+             ripple = bits + lowest;
+
+    return ( ( ( ripple ^ bits ) >> 2 ) / lowest ) | ripple;
+}
+
+/*********************************************************************
+** Description: Constructor. Lists the winning lines of the board.
+*
+*  Parameters:
+*  1. int width, int height, int k - the board size.
+*  2. string dir - the folder the tables are written to.
+*********************************************************************/
+Retrograde::Retrograde( int width, int height, int k, const string &dir )
+    : dir( dir ), nextChunk( 0 ), wins( 0 ), draws( 0 ), losses( 0 )
+{
+    this->width = width;
+    this->height = height;
+    this->k = k;
+    cells = width * height;
+    lineCount = MnkPosition( width, height, k ).getLines( lines );
+
+    ply = 0;
+    count = 0;
+    scores = NULL;
+    nextScores = NULL;
+}
+
+/*********************************************************************
+** Description: Solves every ply, from the full board back to the
+*  empty one, and prints the result of the game.
+*
+*  Parameters: int threads - the number of worker threads.
+*
+*  Return: bool - false if a table file could not be written.
+*********************************************************************/
+bool Retrograde::solve( int threads )
+{
+    uint64_t total = 0;
+
+    for( int p = 0; p <= cells; p++ )
+    {
+        total += MnkTable::plyCount( cells, p );
+    }
+
+    printf( "Solving %dx%d k=%d: %llu positions, %d lines, %d threads, tables in %s\n", width, height, k,
+            static_cast<unsigned long long>( total ), lineCount, threads, dir.c_str() );
+    printf( "%4s %14s %14s %14s %14s %9s %14s\n", "Ply", "Positions", "Wins", "Draws", "Losses", "Seconds",
+            "Positions/sec" );
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int p = cells; p >= 0; p-- )
+    {
+        if( !solvePly( p, threads ) )
+        {
+            return false;
+        }
+    }
+
+    double seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    MnkTable table;
+
+    if( !table.open( dir, width, height, k ) )
+    {
+        return false;
+    }
+
+    int score = table.score( MnkPosition( width, height, k ) );
+
+    if( score > 0 )
+        printf( "\nThe first player wins, on move %d at the latest.\n", cells + 1 - score );
+
+    else if( score < 0 )
+        printf( "\nThe second player wins, on move %d at the latest.\n", cells + 1 + score );
+
+    else
+        printf( "\nThe game is a draw.\n" );
+
+    printf( "%llu positions in %.2f s (%.0f positions/sec)\n", static_cast<unsigned long long>( total ), seconds,
+            total / seconds );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Solves one ply into its table file, reading the table
+*  of the next ply.
+*
+*  Parameters: int p - the ply.
+*              int threads - the number of worker threads.
+*
+*  Return: bool - false if a table file could not be mapped.
+*********************************************************************/
+bool Retrograde::solvePly( int p, int threads )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ply = p;
+    count = MnkTable::plyCount( cells, ply );
+
+    MappedFile file,
+               next;
+
+    if( !file.create( MnkTable::plyPath( dir, width, height, k, ply ), sizeof( MnkTable::Header ) + count ) )
+    {
+        return false;
+    }
+
+    MnkTable::Header header;
+    memcpy( header.magic, "MNKT", 4 );
+    header.width = static_cast<uint8_t>( width );
+    header.height = static_cast<uint8_t>( height );
+    header.k = static_cast<uint8_t>( k );
+    header.ply = static_cast<uint8_t>( ply );
+    header.count = count;
+    memcpy( file.getData(), &header, sizeof( header ) );
+
+    scores = reinterpret_cast< int8_t* >( file.getData() + sizeof( header ) );
+    nextScores = NULL;
+
+    if( ply < cells )
+    {
+        if( !next.open( MnkTable::plyPath( dir, width, height, k, ply + 1 ) )
+            || !MnkTable::checkHeader( next, width, height, k, ply + 1 ) )
+        {
+            return false;
+        }
+
+        nextScores = reinterpret_cast< const int8_t* >( next.getData() + sizeof( header ) );
+    }
+
+    nextChunk.store( 0 );
+    wins.store( 0 );
+    draws.store( 0 );
+    losses.store( 0 );
+
+    std::vector< std::thread > pool;
+
+    for( int t = 0; t < threads; t++ )
+    {
+        pool.push_back( std::thread( &Retrograde::worker, this ) );
+    }
+
+    for( unsigned t = 0; t < pool.size(); t++ )
+    {
+        pool[t].join();
+    }
+
+    double seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    printf( "%4d %14llu %14llu %14llu %14llu %9.2f %14.0f\n", ply, static_cast<unsigned long long>( count ),
+            static_cast<unsigned long long>( wins.load() ), static_cast<unsigned long long>( draws.load() ),
+            static_cast<unsigned long long>( losses.load() ), seconds, count / seconds );
+    fflush( stdout );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: One pool thread. Claims chunks of the ply until none
+*  are left. Within a chunk the positions are stepped through in rank
+*  order instead of unranking each one: the second player's share of
+*  the occupied cells moves to its next combination, and when those
+*  run out the occupied cells do.
+*********************************************************************/
+void Retrograde::worker()
+{
+    uint64_t splits = MnkTable::binomial( ply, ply / 2 ),
+             firstShare = ( 1ULL << ( ply / 2 ) ) - 1;
+    uint64_t counted[3] = { 0, 0, 0 }; //Wins, draws and losses.
+
+    for( uint64_t start = nextChunk.fetch_add( CHUNK ); start < count; start = nextChunk.fetch_add( CHUNK ) )
+    {
+        uint64_t end = start + CHUNK < count ? start + CHUNK : count,
+                 shareIndex = start % splits;
+        uint64_t occupied = MnkTable::combinationUnrank( start / splits, ply ),
+                 share = MnkTable::combinationUnrank( shareIndex, ply / 2 );
+
+        for( uint64_t index = start; index < end; index++ )
+        {
+            uint32_t first = 0,
+                     second = 0;
+            int i = 0;
+
+            for( uint32_t cells = static_cast<uint32_t>( occupied ); cells != 0; cells &= cells - 1, i++ )
+            {
+                uint32_t cell = cells & ( 0U - cells );
+
+                if( share >> i & 1 )
+                    second |= cell;
+
+                else
+                    first |= cell;
+            }
+
+            int8_t score = solvePosition( first, second, static_cast<uint32_t>( share ) );
+            scores[index] = score;
+            counted[score > 0 ? 0 : score == 0 ? 1 : 2]++;
+
+            if( ++shareIndex == splits )
+            {
+                shareIndex = 0;
+                share = firstShare;
+                occupied = nextCombination( occupied );
+            }
+
+            else
+            {
+                share = nextCombination( share );
+            }
+        }
+    }
+
+    wins.fetch_add( counted[0] );
+    draws.fetch_add( counted[1] );
+    losses.fetch_add( counted[2] );
+}
+
+/*********************************************************************
+** Description: Checks whether a player's marks complete a line.
+*
+*  Parameters: uint32_t marks - the marks of one player.
+*
+*  Return: bool - true if one of the lines is complete.
+*********************************************************************/
+bool Retrograde::hasLine( uint32_t marks ) const
+{
+    for( int i = 0; i < lineCount; i++ )
+    {
+        if( ( marks & lines[i] ) == lines[i] )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Scores a position of the current ply from the scores
+*  of its children. A child's index is built from the position's own
+*  rank: the occupied cells below the new mark keep their terms, the
+*  new mark adds one, and the cells above it move up one place, so the
+*  prefix and suffix sums of those terms give every child's index in
+*  one pass over the board.
+*
+*  Parameters:
+*  1. uint32_t first - the marks of the player who moved first.
+*  2. uint32_t second - the marks of the other player.
+*  3. uint32_t share - which of the occupied cells, numbered from the
+*     bottom, are the second player's.
+*
+*  Return: int8_t - the score for the player to move, as PerfectPlayer
+*  scores a position.
+*********************************************************************/
+int8_t Retrograde::solvePosition( uint32_t first, uint32_t second, uint32_t share ) const
+{
+    bool firstToMove = ply % 2 == 0;
+    uint32_t occupied = first | second;
+
+    //The player who just moved won.
+    if( ply > 0 && hasLine( firstToMove ? second : first ) )
+    {
+        return static_cast<int8_t>( -( 1 + cells - ply ) );
+    }
+
+    if( ply == cells )
+    {
+        return 0;
+    }
+
+    //Terms of the occupied cells' rank, below and above each place.
+    uint64_t below[MnkPosition::MAX_CELLS + 1],
+             above[MnkPosition::MAX_CELLS + 1];
+    int places[MnkPosition::MAX_CELLS];
+    int i = 0;
+
+    for( uint32_t bits = occupied; bits != 0; bits &= bits - 1 )
+    {
+        places[i++] = __builtin_ctz( bits );
+    }
+
+    below[0] = 0;
+    above[ply] = 0;
+
+    for( i = 1; i <= ply; i++ )
+    {
+        below[i] = below[i - 1] + MnkTable::binomial( places[i - 1], i );
+    }
+
+    for( i = ply - 1; i >= 0; i-- )
+    {
+        above[i] = above[i + 1] + MnkTable::binomial( places[i], i + 2 );
+    }
+
+    //The same for the share, whose places move up one above the new
+    //mark. When the second player moves the share also gains a bit.
+    int shareCount = __builtin_popcount( share );
+    uint64_t shareBelow[MnkPosition::MAX_CELLS + 1],
+             shareAbove[MnkPosition::MAX_CELLS + 1],
+             shareAboveShifted[MnkPosition::MAX_CELLS + 1];
+    i = 0;
+
+    for( uint32_t bits = share; bits != 0; bits &= bits - 1 )
+    {
+        places[i++] = __builtin_ctz( bits );
+    }
+
+    shareBelow[0] = 0;
+    shareAbove[shareCount] = 0;
+    shareAboveShifted[shareCount] = 0;
+
+    for( i = 1; i <= shareCount; i++ )
+    {
+        shareBelow[i] = shareBelow[i - 1] + MnkTable::binomial( places[i - 1], i );
+    }
+
+    for( i = shareCount - 1; i >= 0; i-- )
+    {
+        shareAbove[i] = shareAbove[i + 1] + MnkTable::binomial( places[i] + 1, i + 1 );
+        shareAboveShifted[i] = shareAboveShifted[i + 1] + MnkTable::binomial( places[i] + 1, i + 2 );
+    }
+
+    uint64_t nextSplits = MnkTable::binomial( ply + 1, ( ply + 1 ) / 2 );
+    int best = -cells - 1,
+        place = 0, //Occupied cells below the current one.
+        sharePlace = 0; //Second player's cells below the current one.
+
+    for( int cell = 0; cell < cells; cell++ )
+    {
+        if( occupied >> cell & 1 )
+        {
+            sharePlace += share >> place & 1;
+            place++;
+            continue;
+        }
+
+        uint64_t occupiedRank = below[place] + MnkTable::binomial( cell, place + 1 ) + above[place],
+                 shareRank = firstToMove ? shareBelow[sharePlace] + shareAbove[sharePlace]
+                                         : shareBelow[sharePlace] + MnkTable::binomial( place, sharePlace + 1 )
+                                           + shareAboveShifted[sharePlace];
+
+        int value = -nextScores[occupiedRank * nextSplits + shareRank];
+
+        if( value > best )
+        {
+            best = value;
+        }
+    }
+
+    return static_cast<int8_t>( best );
+}
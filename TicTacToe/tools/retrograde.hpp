@@ -0,0 +1,58 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Retrograde class solves an m,n,k game by retrograde
+*  analysis. Every move adds a mark, so the scores of a ply depend only
+*  on the ply after it: the plies are solved from the full board back
+*  to the empty one, each written to its own memory mapped table file
+*  while the next ply's file is read. Only those two plies are in use
+*  at a time and the operating system pages them in and out, so tables
+*  larger than memory can be solved. The positions of a ply are split
+*  into chunks that worker threads claim one at a time.
+*********************************************************************/
+#ifndef RETROGRADE_HPP
+#define RETROGRADE_HPP
+
+#include "../mnkTable.hpp"
+#include <atomic>
+#include <string>
+
+using std::string;
+
+class Retrograde
+{
+    private:
+        static const uint64_t CHUNK = 1 << 16; //Positions claimed by a worker at a time.
+
+        int width,
+            height,
+            k,
+            cells;
+        string dir;
+
+        uint32_t lines[MnkPosition::MAX_LINES];
+        int lineCount;
+
+        //The ply being solved.
+        int ply;
+        uint64_t count;
+        int8_t* scores;
+        const int8_t* nextScores;
+        std::atomic< uint64_t > nextChunk;
+        std::atomic< uint64_t > wins,
+                                draws,
+                                losses;
+
+        //Private functions.
+        void worker();
+        int8_t solvePosition( uint32_t, uint32_t, uint32_t ) const;
+        bool hasLine( uint32_t ) const;
+        bool solvePly( int, int );
+
+    public:
+        Retrograde( int, int, int, const string & );
+        bool solve( int );
+};
+
+#endif
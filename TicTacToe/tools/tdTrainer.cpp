@@ -0,0 +1,394 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TdTrainer class learns a value table of an m,n,k
+*  game by self-play with temporal difference learning. Actor threads
+*  play games against themselves from the current values, exploring
+*  with a random move now and then, and hand each finished game to the
+*  learner through their own lock-free queue. The learner, the calling
+*  thread, moves the value of every position of a game towards the
+*  value of the position after it, from the end of the game back, while
+*  the actors keep reading the table. It saves the table at regular
+*  checkpoints and reports the games and updates per second.
+*********************************************************************/
+#include "tdTrainer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+/*********************************************************************
+** Description: Main function. Takes the board size followed by the
+*  options: "--games N" self-play games, "--actors N" actor threads, up
+*  to 32, "--alpha X" the learning step, "--epsilon X" the share of
+*  random moves, "--bits N" the table size, 2 to the power N slots,
+*  "--checkpoint S" seconds between saves, "--seed N", "--out FILE",
+*  by default W-H-K.td, and "--resume" to go on learning from it.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    long long games = 1000000;
+    int actors = static_cast<int>( std::thread::hardware_concurrency() ) - 1;
+    float alpha = 0.1f,
+          epsilon = 0.1f;
+    int bits = 22;
+    double checkpoint = 60.0;
+    uint64_t seed = Random::timeSeed();
+    string out;
+    bool resume = false;
+    int size[3],
+        sizeCount = 0;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--games" ) == 0 && i + 1 < argc )
+            games = atoll( argv[++i] );
+
+        else if( strcmp( argv[i], "--actors" ) == 0 && i + 1 < argc )
+            actors = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--alpha" ) == 0 && i + 1 < argc )
+            alpha = static_cast<float>( atof( argv[++i] ) );
+
+        else if( strcmp( argv[i], "--epsilon" ) == 0 && i + 1 < argc )
+            epsilon = static_cast<float>( atof( argv[++i] ) );
+
+        else if( strcmp( argv[i], "--bits" ) == 0 && i + 1 < argc )
+            bits = atoi( argv[++i] );
+
+        else if( strcmp( argv[i], "--checkpoint" ) == 0 && i + 1 < argc )
+            checkpoint = atof( argv[++i] );
+
+        else if( strcmp( argv[i], "--seed" ) == 0 && i + 1 < argc )
+            seed = strtoull( argv[++i], NULL, 10 );
+
+        else if( strcmp( argv[i], "--out" ) == 0 && i + 1 < argc )
+            out = argv[++i];
+
+        else if( strcmp( argv[i], "--resume" ) == 0 )
+            resume = true;
+
+        else if( sizeCount < 3 )
+            size[sizeCount++] = atoi( argv[i] );
+    }
+
+    //Written so that NaN fails too.
+    bool rates = alpha > 0.0f && alpha <= 1.0f && epsilon >= 0.0f && epsilon <= 1.0f;
+
+    if( sizeCount < 3 || !MnkPosition::validSize( size[0], size[1], size[2] ) || games < 1 || bits < 10
+        || bits > 32 || !rates )
+    {
+        printf( "Usage: tdtrainer [--games N] [--actors N] [--alpha X] [--epsilon X] [--bits N]\n" );
+        printf( "                 [--checkpoint S] [--seed N] [--out FILE] [--resume] WIDTH HEIGHT K\n" );
+        printf( "The board may have up to %d cells, for example 4 4 4 or 5 5 4.\n", MnkPosition::MAX_CELLS );
+        printf( "The alpha is above 0 and at most 1, the epsilon from 0 to 1.\n" );
+        return 1;
+    }
+
+    if( actors < 1 )
+    {
+        actors = 1;
+    }
+
+    if( actors > TdTrainer::MAX_ACTORS )
+    {
+        actors = TdTrainer::MAX_ACTORS;
+    }
+
+    if( out.empty() )
+    {
+        char name[32];
+        snprintf( name, sizeof( name ), "%d-%d-%d.td", size[0], size[1], size[2] );
+        out = name;
+    }
+
+    TdTrainer trainer( size[0], size[1], size[2], alpha, epsilon, seed );
+
+    if( !trainer.start( bits, out, resume ) )
+    {
+        return 1;
+    }
+
+    printf( "%lld self-play games on %dx%d k=%d, %d actors, alpha %.3f, epsilon %.3f, seed %llu\n", games, size[0],
+            size[1], size[2], actors, alpha, epsilon, static_cast<unsigned long long>( seed ) );
+
+    trainer.run( games, actors, out, checkpoint );
+
+    return 0;
+}
+
+/*********************************************************************
+** Description: Constructor.
+*
+*  Parameters:
+*  1. int width, int height, int k - the board size.
+*  2. float alpha - the step towards each target, from 0 to 1.
+*  3. float epsilon - the share of random moves, from 0 to 1.
+*  4. uint64_t seed - seeds every game.
+*********************************************************************/
+TdTrainer::TdTrainer( int width, int height, int k, float alpha, float epsilon, uint64_t seed )
+    : nextGame( 0 ), finishedActors( 0 )
+{
+    this->width = width;
+    this->height = height;
+    this->k = k;
+    this->alpha = alpha;
+    this->epsilon = epsilon;
+    this->seed = seed;
+    games = 0;
+    learned = 0;
+    updates = 0;
+    misses = 0;
+    wins = 0;
+}
+
+/*********************************************************************
+** Description: Creates the value table, or loads it to go on learning.
+*
+*  Parameters:
+*  1. int bits - the table has 2 to the power bits slots.
+*  2. string path - the table file.
+*  3. bool resume - loads the table from the file.
+*
+*  Return: bool - false if the table could not be created or loaded.
+*********************************************************************/
+bool TdTrainer::start( int bits, const string &path, bool resume )
+{
+    if( !resume )
+    {
+        return table.create( width, height, k, bits );
+    }
+
+    if( !table.load( path, bits ) )
+    {
+        printf( "Could not resume from %s!\n", path.c_str() );
+        return false;
+    }
+
+    if( table.getWidth() != width || table.getHeight() != height || table.getK() != k )
+    {
+        printf( "%s is a table of %dx%d k=%d!\n", path.c_str(), table.getWidth(), table.getHeight(), table.getK() );
+        return false;
+    }
+
+    printf( "Resumed from %s with %llu positions\n", path.c_str(), static_cast<unsigned long long>( table.getUsed() ) );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Plays one self-play game from the current values. Even
+*  games are started by X and odd games by O.
+*
+*  Parameters: long long game - the game number, which seeds it.
+*              Episode episode - receives the game.
+*********************************************************************/
+void TdTrainer::playGame( long long game, Episode &episode )
+{
+    Random random = Random( seed ).split( game );
+    MnkPosition position( width, height, k, static_cast<Player>( game % 2 ) );
+
+    episode.length = 0;
+
+    while( position.getOutcome() == UNFINISHED )
+    {
+        //In double, so an epsilon of 1 explores on every move.
+        bool explore = random.next() < epsilon * 4294967296.0;
+        int move;
+
+        if( explore )
+        {
+            int moves[MnkPosition::MAX_MOVES];
+            move = moves[random.nextInt( position.getMoves( moves ) )];
+        }
+
+        else
+            move = table.chooseMove( position, random );
+
+        position.play( move );
+        episode.keys[episode.length] = ValueTable::afterKey( position );
+        episode.explored[episode.length++] = explore;
+    }
+
+    episode.won = position.getOutcome() != DRAW;
+}
+
+/*********************************************************************
+** Description: One actor thread. Plays the next unplayed game until
+*  there are none left, waiting while the learner catches up with its
+*  queue.
+*
+*  Parameters: int index - the actor's number.
+*********************************************************************/
+void TdTrainer::actor( int index )
+{
+    Episode episode;
+
+    for( long long game = nextGame.fetch_add( 1 ); game < games; game = nextGame.fetch_add( 1 ) )
+    {
+        playGame( game, episode );
+
+        while( !queues[index].push( episode ) )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    finishedActors.fetch_add( 1 );
+}
+
+/*********************************************************************
+** Description: Learns from one game. The last position is worth 1 to
+*  the player who made the last move if it won and 0 if it drew, and
+*  every earlier position is moved towards minus the value of the
+*  position after it, which is the other player's. A position followed
+*  by a random move is not moved, since that move says nothing about
+*  the position's value.
+*
+*  Parameters: Episode episode - the game.
+*********************************************************************/
+void TdTrainer::learn( const Episode &episode )
+{
+    float next = episode.won ? 1.0f : 0.0f;
+
+    for( int m = episode.length - 2; m >= 0; m-- )
+    {
+        uint64_t key = episode.keys[m];
+
+        if( !episode.explored[m + 1] )
+        {
+            if( table.update( key, -next, alpha ) )
+                updates++;
+
+            else
+                misses++;
+        }
+
+        next = table.value( key );
+    }
+
+    learned++;
+
+    if( episode.won )
+    {
+        wins++;
+    }
+}
+
+/*********************************************************************
+** Description: Prints the progress.
+*
+*  Parameters:
+*  1. double seconds - the time since the last report.
+*  2. long long games - the games learned since then.
+*  3. long long updates - the updates made since then.
+*********************************************************************/
+void TdTrainer::report( double seconds, long long games, long long updates ) const
+{
+    printf( "%10lld games %10.0f games/sec %12.0f updates/sec %10llu positions (%4.1f%% full) %4.1f%% decisive\n",
+            learned, games / seconds, updates / seconds, static_cast<unsigned long long>( table.getUsed() ),
+            100.0 * table.getUsed() / table.getCapacity(), learned > 0 ? 100.0 * wins / learned : 0.0 );
+}
+
+/*********************************************************************
+** Description: Plays and learns from the self-play games, saving the
+*  table at each checkpoint and at the end.
+*
+*  Parameters:
+*  1. long long games - the number of games.
+*  2. int actors - the number of actor threads.
+*  3. string path - the table file.
+*  4. double checkpoint - seconds between saves.
+*
+*  Return: double - the wall clock time in seconds.
+*********************************************************************/
+double TdTrainer::run( long long games, int actors, const string &path, double checkpoint )
+{
+    const double REPORT_SECONDS = 5.0;
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now(),
+                      lastReport = start,
+                      lastCheckpoint = start;
+    long long reportedGames = 0,
+              reportedUpdates = 0;
+
+    this->games = games;
+    nextGame.store( 0 );
+    finishedActors.store( 0 );
+
+    vector< std::thread > pool;
+
+    for( int a = 0; a < actors; a++ )
+    {
+        pool.push_back( std::thread( &TdTrainer::actor, this, a ) );
+    }
+
+    Episode episode;
+
+    for( ;; )
+    {
+        //Read before draining, so no game pushed before it is missed.
+        bool finished = finishedActors.load() == actors;
+        int popped = 0;
+
+        for( int a = 0; a < actors; a++ )
+        {
+            for( int n = 0; n < 64 && queues[a].pop( episode ); n++ )
+            {
+                learn( episode );
+                popped++;
+            }
+        }
+
+        if( popped == 0 )
+        {
+            if( finished )
+            {
+                break;
+            }
+
+            std::this_thread::yield();
+        }
+
+        Clock::time_point now = Clock::now();
+
+        if( now - lastReport >= std::chrono::duration< double >( REPORT_SECONDS ) )
+        {
+            report( std::chrono::duration< double >( now - lastReport ).count(), learned - reportedGames,
+                    updates - reportedUpdates );
+            lastReport = now;
+            reportedGames = learned;
+            reportedUpdates = updates;
+        }
+
+        if( now - lastCheckpoint >= std::chrono::duration< double >( checkpoint ) )
+        {
+            table.save( path );
+            lastCheckpoint = now;
+        }
+    }
+
+    for( unsigned t = 0; t < pool.size(); t++ )
+    {
+        pool[t].join();
+    }
+
+    double seconds = std::chrono::duration< double >( Clock::now() - start ).count();
+
+    report( seconds, learned, updates );
+
+    if( misses > 0 )
+    {
+        printf( "%lld updates found the table full, use more --bits.\n", misses );
+    }
+
+    if( table.save( path ) )
+    {
+        printf( "Wrote %s\n", path.c_str() );
+    }
+
+    return seconds;
+}
@@ -0,0 +1,80 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TdTrainer class learns a value table of an m,n,k
+*  game by self-play with temporal difference learning. Actor threads
+*  play games against themselves from the current values, exploring
+*  with a random move now and then, and hand each finished game to the
+*  learner through their own lock-free queue. The learner, the calling
+*  thread, moves the value of every position of a game towards the
+*  value of the position after it, from the end of the game back, while
+*  the actors keep reading the table. It saves the table at regular
+*  checkpoints and reports the games and updates per second.
+*********************************************************************/
+#ifndef TD_TRAINER_HPP
+#define TD_TRAINER_HPP
+
+#include "../valueTable.hpp"
+#include "../spscQueue.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class TdTrainer
+{
+    private:
+        /*********************************************************************
+         ** Description: This struct is one self-play game: the key of the
+         *  position after each move, whether the move was a random one,
+         *  and whether the last move won.
+         *********************************************************************/
+        struct Episode
+        {
+            uint64_t keys[MnkPosition::MAX_CELLS];
+            bool explored[MnkPosition::MAX_CELLS];
+            int length;
+            bool won;
+        };
+
+    public:
+        static const int MAX_ACTORS = 32;
+
+    private:
+        typedef SpscQueue< Episode, 32 > EpisodeQueue;
+
+        int width,
+            height,
+            k;
+        float alpha, //The step towards each target.
+              epsilon; //The share of random moves.
+        uint64_t seed;
+
+        ValueTable table;
+        EpisodeQueue queues[MAX_ACTORS]; //One per actor.
+        long long games;
+        std::atomic< long long > nextGame;
+        std::atomic< int > finishedActors;
+
+        //Learner thread only.
+        long long learned,
+                  updates,
+                  misses, //Updates the table had no room for.
+                  wins;
+
+        //Private functions.
+        void actor( int );
+        void playGame( long long, Episode & );
+        void learn( const Episode & );
+        void report( double, long long, long long ) const;
+
+    public:
+        TdTrainer( int, int, int, float, float, uint64_t );
+        bool start( int, const string &, bool );
+        double run( long long, int, const string &, double );
+};
+
+#endif
@@ -0,0 +1,448 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Tournament class plays computer players against
+*  each other, round robin or as a gauntlet against the first player,
+*  on a pool of worker threads and without any SDL window. Colors
+*  alternate between games, every game is seeded from the tournament
+*  seed, and the results are reported as Elo ratings, with the number
+*  of different games each pairing played.
+*********************************************************************/
+#include "tournament.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <thread>
+
+/*********************************************************************
+** Description: Main function. Takes the player descriptions, as used
+*  by the game's --x-player option, followed by the options:
+*  "--gauntlet" plays the first player against each of the others
+*  instead of a round robin, "--games N" sets the games per pairing,
+*  "--threads N" the worker threads and "--seed N" the random seed.
+*********************************************************************/
+int main( int argc, char** argv )
+{
+    vector< string > players;
+    bool gauntlet = false;
+    int games = 100;
+    int threads = static_cast<int>( std::thread::hardware_concurrency() );
+    uint64_t seed = Random::timeSeed();
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "--gauntlet" ) == 0 )
+        {
+            gauntlet = true;
+        }
+
+        else if( strcmp( argv[i], "--games" ) == 0 && i + 1 < argc )
+        {
+            games = atoi( argv[++i] );
+        }
+
+        else if( strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc )
+        {
+            threads = atoi( argv[++i] );
+        }
+
+        else if( strcmp( argv[i], "--seed" ) == 0 && i + 1 < argc )
+        {
+            seed = strtoull( argv[++i], NULL, 10 );
+        }
+
+        else
+        {
+            players.push_back( argv[i] );
+        }
+    }
+
+    if( players.size() < 2 || games < 1 )
+    {
+        printf( "Usage: tournament [--gauntlet] [--games N] [--threads N] [--seed N] PLAYER PLAYER...\n" );
+        printf( "Players: random, perfect, alphabeta[:depth=N], mcts[:playouts=N,time=MS,...]\n" );
+        return 1;
+    }
+
+    if( threads < 1 )
+    {
+        threads = 1;
+    }
+
+    Tournament tournament( players, gauntlet, games, seed );
+
+    if( !tournament.checkPlayers() )
+    {
+        return 1;
+    }
+
+    printf( "%s, %d players, %d games per pairing, %d threads, seed %llu\n",
+            gauntlet ? "Gauntlet" : "Round robin", static_cast<int>( players.size() ), games, threads,
+            static_cast<unsigned long long>( seed ) );
+
+    double seconds = tournament.run( threads );
+    tournament.printResults( seconds );
+
+    return 0;
+}
+
+/*********************************************************************
+** Description: Constructor. Sets up the pairings.
+*
+*  Parameters:
+*  1. vector<string> players - the player descriptions.
+*  2. bool gauntlet - pairs the first player with each of the others
+*     instead of every player with every other.
+*  3. int gamesPerPairing - games played by each pairing.
+*  4. uint64_t seed - seeds every game.
+*********************************************************************/
+Tournament::Tournament( const vector< string > &players, bool gauntlet, int gamesPerPairing, uint64_t seed )
+    : players( players ), nextGame( 0 )
+{
+    this->gamesPerPairing = gamesPerPairing;
+    this->seed = seed;
+
+    for( unsigned first = 0; first < players.size(); first++ )
+    {
+        for( unsigned second = first + 1; second < players.size(); second++ )
+        {
+            if( !gauntlet || first == 0 )
+            {
+                pairings.push_back( Pairing( first, second ) );
+            }
+        }
+    }
+
+    results.resize( pairings.size() * gamesPerPairing, 0 );
+    moveLists.resize( results.size(), 0 );
+}
+
+/*********************************************************************
+** Description: Creates a player for one game. MCTS players search on
+*  a single thread and quietly, since the games already run in
+*  parallel; options given in the description still take precedence.
+*
+*  Parameters: int player - index of the player description.
+*              Random random - seeds the player.
+*
+*  Return: AiPlayer* - a new player, or NULL if the description is
+*  not a computer player.
+*********************************************************************/
+AiPlayer* Tournament::createTournamentPlayer( int player, const Random &random ) const
+{
+    string spec = players[player];
+
+    if( spec.compare( 0, 4, "mcts" ) == 0 )
+    {
+        string options = spec.size() > 5 ? "," + spec.substr( 5 ) : "";
+        spec = "mcts:threads=1,verbose=0" + options;
+    }
+
+    return createPlayer( spec, random );
+}
+
+/*********************************************************************
+** Description: Checks that every description is a computer player.
+*
+*  Return: bool - false if a player could not be created.
+*********************************************************************/
+bool Tournament::checkPlayers() const
+{
+    for( unsigned i = 0; i < players.size(); i++ )
+    {
+        AiPlayer* player = createTournamentPlayer( i, Random() );
+
+        if( player == NULL )
+        {
+            printf( "\"%s\" is not a computer player.\n", players[i].c_str() );
+            return false;
+        }
+
+        delete player;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Plays one game. Even games give X, who moves first, to
+*  the first player of the pairing and odd games to the second. A
+*  player making an illegal move loses the game. The moves are kept in
+*  the game's slot of moveLists.
+*
+*  Parameters: int game - the game number across all pairings.
+*
+*  Return: int - 1 if the first player won, -1 if the second, 0 for a
+*  draw.
+*********************************************************************/
+int Tournament::playGame( int game )
+{
+    const Pairing &pairing = pairings[game / gamesPerPairing];
+    bool firstIsX = game % gamesPerPairing % 2 == 0;
+
+    Random random( seed );
+    AiPlayer* first = createTournamentPlayer( pairing.first, random.split( 2 * game + 1 ) );
+    AiPlayer* second = createTournamentPlayer( pairing.second, random.split( 2 * game + 2 ) );
+
+    AiPlayer* xPlayer = firstIsX ? first : second;
+    AiPlayer* oPlayer = firstIsX ? second : first;
+
+    GamePosition position( X_Player );
+    Outcome outcome = UNFINISHED;
+    uint64_t moves = 0;
+
+    while( outcome == UNFINISHED )
+    {
+        Player mover = position.getToMove();
+        AiPlayer* player = mover == X_Player ? xPlayer : oPlayer;
+        int move = player->chooseMove( position );
+
+        moves = ( moves << 4 ) | ( ( move + 1 ) & 0xF );
+
+        if( !position.play( move ) )
+        {
+            outcome = mover == X_Player ? O_WON : X_WON;
+        }
+
+        else
+        {
+            outcome = position.getOutcome();
+        }
+    }
+
+    delete first;
+    delete second;
+
+    moveLists[game] = moves;
+
+    if( outcome == DRAW )
+    {
+        return 0;
+    }
+
+    return ( outcome == X_WON ) == firstIsX ? 1 : -1;
+}
+
+/*********************************************************************
+** Description: One pool thread. Takes the next unplayed game until
+*  there are none left. Each game writes only its own result slot.
+*********************************************************************/
+void Tournament::worker()
+{
+    int total = static_cast<int>( results.size() );
+
+    for( int game = nextGame.fetch_add( 1 ); game < total; game = nextGame.fetch_add( 1 ) )
+    {
+        results[game] = playGame( game );
+    }
+}
+
+/*********************************************************************
+** Description: Plays every game and tallies the pairings, counting
+*  the different games of each.
+*
+*  Parameters: int threads - the number of worker threads.
+*
+*  Return: double - the wall clock time in seconds.
+*********************************************************************/
+double Tournament::run( int threads )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    nextGame.store( 0 );
+
+    vector< std::thread > pool;
+
+    for( int t = 0; t < threads; t++ )
+    {
+        pool.push_back( std::thread( &Tournament::worker, this ) );
+    }
+
+    for( unsigned t = 0; t < pool.size(); t++ )
+    {
+        pool[t].join();
+    }
+
+    for( unsigned game = 0; game < results.size(); game++ )
+    {
+        Pairing &pairing = pairings[game / gamesPerPairing];
+
+        if( results[game] > 0 )
+            pairing.firstWins++;
+
+        else if( results[game] < 0 )
+            pairing.secondWins++;
+
+        else
+            pairing.draws++;
+    }
+
+    for( unsigned p = 0; p < pairings.size(); p++ )
+    {
+        std::set< uint64_t > games( moveLists.begin() + p * gamesPerPairing,
+                                    moveLists.begin() + ( p + 1 ) * gamesPerPairing );
+        pairings[p].unique = static_cast<int>( games.size() );
+    }
+
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+/*********************************************************************
+** Description: Fits Elo ratings to the results with the Bradley-Terry
+*  model, counting a draw as half a win. Each pairing gets one extra
+*  virtual draw so a player who won or lost every game still gets a
+*  finite rating. Ratings average 0.
+*
+*  Parameters: vector<double> ratings - receives the Elo ratings.
+*              vector<double> margins - receives the 95% confidence
+*              margins, from the Fisher information of each rating.
+*********************************************************************/
+void Tournament::computeRatings( vector< double > &ratings, vector< double > &margins ) const
+{
+    const double ELO_PER_LN = 400.0 / log( 10.0 );
+    int count = static_cast<int>( players.size() );
+
+    //Strength of each player; the expected score of i against j is
+    //strength[i] / ( strength[i] + strength[j] ).
+    vector< double > strength( count, 1.0 ),
+                     scores( count, 0.0 );
+
+    for( unsigned p = 0; p < pairings.size(); p++ )
+    {
+        const Pairing &pairing = pairings[p];
+
+        scores[pairing.first] += pairing.firstWins + 0.5 * pairing.draws + 0.5;
+        scores[pairing.second] += pairing.secondWins + 0.5 * pairing.draws + 0.5;
+    }
+
+    for( int iteration = 0; iteration < 10000; iteration++ )
+    {
+        double change = 0.0;
+
+        for( int i = 0; i < count; i++ )
+        {
+            double denominator = 0.0;
+
+            for( unsigned p = 0; p < pairings.size(); p++ )
+            {
+                const Pairing &pairing = pairings[p];
+                int other = pairing.first == i ? pairing.second : pairing.second == i ? pairing.first : -1;
+
+                if( other >= 0 )
+                {
+                    double games = pairing.firstWins + pairing.secondWins + pairing.draws + 1;
+                    denominator += games / ( strength[i] + strength[other] );
+                }
+            }
+
+            double updated = denominator > 0.0 ? scores[i] / denominator : strength[i];
+            change = fmax( change, fabs( log( updated / strength[i] ) ) );
+            strength[i] = updated;
+        }
+
+        if( change < 1e-9 )
+        {
+            break;
+        }
+    }
+
+    double meanLog = 0.0;
+
+    for( int i = 0; i < count; i++ )
+    {
+        meanLog += log( strength[i] ) / count;
+    }
+
+    ratings.assign( count, 0.0 );
+    margins.assign( count, 0.0 );
+
+    for( int i = 0; i < count; i++ )
+    {
+        ratings[i] = ( log( strength[i] ) - meanLog ) * ELO_PER_LN;
+
+        double information = 0.0;
+
+        for( unsigned p = 0; p < pairings.size(); p++ )
+        {
+            const Pairing &pairing = pairings[p];
+            int other = pairing.first == i ? pairing.second : pairing.second == i ? pairing.first : -1;
+
+            if( other >= 0 )
+            {
+                double games = pairing.firstWins + pairing.secondWins + pairing.draws + 1;
+                double expected = strength[i] / ( strength[i] + strength[other] );
+                information += games * expected * ( 1.0 - expected );
+            }
+        }
+
+        margins[i] = information > 0.0 ? 1.96 * ELO_PER_LN / sqrt( information ) : 0.0;
+    }
+}
+
+/*********************************************************************
+** Description: Prints the ratings, the result of every pairing and
+*  the games per second. A pairing that played no more than one game
+*  per color replayed the same games, which is expected only when both
+*  players are deterministic, so it is pointed out.
+*
+*  Parameters: double seconds - the time the tournament took.
+*********************************************************************/
+void Tournament::printResults( double seconds ) const
+{
+    vector< double > ratings,
+                     margins;
+    computeRatings( ratings, margins );
+
+    vector< int > order;
+
+    for( unsigned i = 0; i < players.size(); i++ )
+    {
+        order.push_back( i );
+    }
+
+    for( unsigned i = 1; i < order.size(); i++ )
+    {
+        for( unsigned j = i; j > 0 && ratings[order[j]] > ratings[order[j - 1]]; j-- )
+        {
+            int swapped = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = swapped;
+        }
+    }
+
+    printf( "\n%4s  %-32s %8s %8s\n", "Rank", "Player", "Elo", "+/-" );
+
+    for( unsigned rank = 0; rank < order.size(); rank++ )
+    {
+        int i = order[rank];
+        printf( "%4u  %-32s %8.0f %8.0f\n", rank + 1, players[i].c_str(), ratings[i], margins[i] );
+    }
+
+    printf( "\n%-32s %-32s %6s %6s %6s %7s %7s\n", "Player", "Opponent", "Wins", "Draws", "Losses", "Score",
+            "Unique" );
+
+    bool repeated = false;
+
+    for( unsigned p = 0; p < pairings.size(); p++ )
+    {
+        const Pairing &pairing = pairings[p];
+
+        printf( "%-32s %-32s %6d %6d %6d %6.1f%% %7d\n", players[pairing.first].c_str(),
+                players[pairing.second].c_str(), pairing.firstWins, pairing.draws, pairing.secondWins,
+                100.0 * ( pairing.firstWins + 0.5 * pairing.draws ) / gamesPerPairing, pairing.unique );
+
+        repeated = repeated || ( gamesPerPairing > 2 && pairing.unique <= 2 );
+    }
+
+    if( repeated )
+    {
+        printf( "\nSome pairings played only one game per color; their players did not vary their moves.\n" );
+    }
+
+    printf( "\n%d games in %.2f s (%.0f games/sec)\n", static_cast<int>( results.size() ), seconds,
+            results.size() / seconds );
+}
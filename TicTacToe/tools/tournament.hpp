@@ -0,0 +1,70 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The Tournament class plays computer players against
+*  each other, round robin or as a gauntlet against the first player,
+*  on a pool of worker threads and without any SDL window. Colors
+*  alternate between games, every game is seeded from the tournament
+*  seed, and the results are reported as Elo ratings.
+*********************************************************************/
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include "../aiPlayer.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class Tournament
+{
+    private:
+        /*********************************************************************
+         ** Description: This struct holds the games between two players.
+         *********************************************************************/
+        struct Pairing
+        {
+            int first,
+                second;
+            int firstWins,
+                secondWins,
+                draws,
+                unique; //Games that differ from every other of the pairing.
+
+            Pairing( int first, int second )
+            {
+                this->first = first;
+                this->second = second;
+                firstWins = 0;
+                secondWins = 0;
+                draws = 0;
+                unique = 0;
+            }
+        };
+
+        vector< string > players;
+        vector< Pairing > pairings;
+        int gamesPerPairing;
+        uint64_t seed;
+
+        vector< int > results; //Per game: 1 if the first player won, -1 if the second, 0 for a draw.
+        vector< uint64_t > moveLists; //Per game: the moves played, four bits each.
+        std::atomic< int > nextGame;
+
+        //Private functions.
+        void worker();
+        int playGame( int );
+        AiPlayer* createTournamentPlayer( int, const Random & ) const;
+        void computeRatings( vector< double > &, vector< double > & ) const;
+
+    public:
+        Tournament( const vector< string > &, bool, int, uint64_t );
+        bool checkPlayers() const;
+        double run( int );
+        void printResults( double ) const;
+};
+
+#endif
@@ -0,0 +1,59 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The TripleBuffer class hands the latest value from one
+*  writer thread to one reader thread without locks. The writer fills
+*  its own buffer and publishes it; the reader always gets the newest
+*  published value and never sees a half-written one. Values the
+*  reader did not get to in time are skipped.
+*********************************************************************/
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+template< class T >
+class TripleBuffer
+{
+    private:
+        static const unsigned INDEX = 3;
+        static const unsigned FRESH = 4; //Set while the middle buffer is unread.
+
+        T buffers[3];
+
+        unsigned back,  //Owned by the writer.
+                 front; //Owned by the reader.
+
+        std::atomic< unsigned > middle; //Exchanged between the two.
+
+    public:
+        TripleBuffer() : back( 0 ), front( 1 ), middle( 2 ) {};
+
+        //The buffer the writer fills before calling publish().
+        T& writeBuffer() { return buffers[back]; };
+
+        /*********************************************************************
+         ** Description: Makes the write buffer the newest value. Writer only.
+         *********************************************************************/
+        void publish()
+        {
+            back = middle.exchange( back | FRESH, std::memory_order_acq_rel ) & INDEX;
+        }
+
+        /*********************************************************************
+         ** Description: Returns the newest published value. Reader only. The
+         *  reference stays valid until the next call.
+         *********************************************************************/
+        const T& read()
+        {
+            if( middle.load( std::memory_order_relaxed ) & FRESH )
+            {
+                front = middle.exchange( front, std::memory_order_acq_rel ) & INDEX;
+            }
+
+            return buffers[front];
+        }
+};
+
+#endif
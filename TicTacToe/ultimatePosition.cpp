@@ -0,0 +1,228 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The UltimatePosition class is a position of Ultimate
+*  Tic Tac Toe: a 3x3 grid of 3x3 boards, where the cell a player picks
+*  sends the other player to the board in the same place. Winning a
+*  board claims its place on the grid and three boards in a row win the
+*  game. Each board is a 9 bit mask per player, and the won and closed
+*  boards are kept as 9 bit masks of the grid that are updated with
+*  every move, so no move rescans the whole position.
+*********************************************************************/
+#include "ultimatePosition.hpp"
+
+//The winning lines through each cell of a 3x3 board.
+static const uint16_t CELL_LINES[GameBoard::CELLS][4] = {
+    { 0x007, 0x049, 0x111 }, { 0x007, 0x092 }, { 0x007, 0x124, 0x054 },
+    { 0x038, 0x049 }, { 0x038, 0x092, 0x111, 0x054 }, { 0x038, 0x124 },
+    { 0x1C0, 0x049, 0x054 }, { 0x1C0, 0x092 }, { 0x1C0, 0x124, 0x111 } };
+
+static const int CELL_LINE_COUNT[GameBoard::CELLS] = { 3, 2, 3, 2, 4, 2, 3, 2, 3 };
+
+/*********************************************************************
+** Description: Constructor. Starts with empty boards and a free choice
+*  of board for the first move.
+*
+*  Parameters: Player toMove - the player who makes the first move.
+*********************************************************************/
+UltimatePosition::UltimatePosition( Player toMove )
+{
+    for( int board = 0; board < GameBoard::CELLS; board++ )
+    {
+        marks[X_Player][board] = 0;
+        marks[O_Player][board] = 0;
+    }
+
+    won[X_Player] = 0;
+    won[O_Player] = 0;
+    closed = 0;
+    activeBoard = ANY_BOARD;
+    this->toMove = toMove;
+    outcome = UNFINISHED;
+}
+
+/*********************************************************************
+** Description: Checks only the lines through the cell that was just
+*  taken, which are the only lines the move can have completed.
+*
+*  Parameters: uint16_t mask - a 3x3 mask, of a board or the grid.
+*              int cell - the cell that was just taken.
+*
+*  Return: bool - true if a line through the cell is complete.
+*********************************************************************/
+bool UltimatePosition::completesLine( uint16_t mask, int cell )
+{
+    for( int i = 0; i < CELL_LINE_COUNT[cell]; i++ )
+    {
+        if( ( mask & CELL_LINES[cell][i] ) == CELL_LINES[cell][i] )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*********************************************************************
+** Description: Makes a move for the player to move, updates the won
+*  and closed boards and the outcome, and chooses the next board.
+*
+*  Parameters: int cell - board * 9 + cell within the board.
+*
+*  Return: bool - false if the move is not legal.
+*********************************************************************/
+bool UltimatePosition::play( int cell )
+{
+    if( cell < 0 || cell >= CELLS )
+    {
+        return false;
+    }
+
+    int board = cell / GameBoard::CELLS,
+        local = cell % GameBoard::CELLS;
+
+    if( ( getMoveMask( board ) & ( 1 << local ) ) == 0 )
+    {
+        return false;
+    }
+
+    uint16_t &boardMarks = marks[toMove][board];
+    boardMarks |= 1 << local;
+
+    if( completesLine( boardMarks, local ) )
+    {
+        won[toMove] |= 1 << board;
+        closed |= 1 << board;
+
+        if( completesLine( won[toMove], board ) )
+        {
+            outcome = toMove == X_Player ? X_WON : O_WON;
+        }
+    }
+
+    else if( ( boardMarks | marks[GameBoard::other( toMove )][board] ) == GameBoard::FULL )
+    {
+        closed |= 1 << board;
+    }
+
+    if( outcome == UNFINISHED && closed == GameBoard::FULL )
+    {
+        outcome = DRAW;
+    }
+
+    //A closed board gives the next player a free choice.
+    activeBoard = ( closed & ( 1 << local ) ) ? ANY_BOARD : local;
+    toMove = GameBoard::other( toMove );
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Returns the boards the player to move may play in.
+*
+*  Return: uint16_t - a 3x3 mask of boards, 0 once the game is over.
+*********************************************************************/
+uint16_t UltimatePosition::getPlayableBoards() const
+{
+    if( outcome != UNFINISHED )
+    {
+        return 0;
+    }
+
+    if( activeBoard == ANY_BOARD )
+    {
+        return GameBoard::FULL & ~closed;
+    }
+
+    return 1 << activeBoard;
+}
+
+/*********************************************************************
+** Description: Returns the legal moves within one board.
+*
+*  Parameters: int board - the board, 0 to 8.
+*
+*  Return: uint16_t - a 3x3 mask of the empty cells, or 0 if the board
+*  may not be played in.
+*********************************************************************/
+uint16_t UltimatePosition::getMoveMask( int board ) const
+{
+    if( ( getPlayableBoards() & ( 1 << board ) ) == 0 )
+    {
+        return 0;
+    }
+
+    return GameBoard::FULL & ~( marks[X_Player][board] | marks[O_Player][board] );
+}
+
+/*********************************************************************
+** Description: Lists the legal moves.
+*
+*  Parameters: int* moves - receives up to MAX_MOVES cells.
+*
+*  Return: int - the number of legal moves.
+*********************************************************************/
+int UltimatePosition::getMoves( int* moves ) const
+{
+    int count = 0;
+
+    for( uint16_t boards = getPlayableBoards(); boards != 0; boards &= boards - 1 )
+    {
+        int board = __builtin_ctz( boards );
+        uint16_t empty = GameBoard::FULL & ~( marks[X_Player][board] | marks[O_Player][board] );
+
+        for( ; empty != 0; empty &= empty - 1 )
+        {
+            moves[count++] = board * GameBoard::CELLS + __builtin_ctz( empty );
+        }
+    }
+
+    return count;
+}
+
+/*********************************************************************
+** Description: Returns which player has marked a cell.
+*
+*  Parameters: int cell - board * 9 + cell within the board.
+*
+*  Return: Player - X_Player, O_Player or No_Player.
+*********************************************************************/
+Player UltimatePosition::getPick( int cell ) const
+{
+    int board = cell / GameBoard::CELLS;
+    uint16_t bit = 1 << ( cell % GameBoard::CELLS );
+
+    if( marks[X_Player][board] & bit )
+        return X_Player;
+
+    if( marks[O_Player][board] & bit )
+        return O_Player;
+
+    return No_Player;
+}
+
+/*********************************************************************
+** Description: Compares two positions.
+*
+*  Return: bool - true if the marks, the player to move and the board
+*  to move in match.
+*********************************************************************/
+bool UltimatePosition::operator==( const UltimatePosition &other ) const
+{
+    if( toMove != other.toMove || activeBoard != other.activeBoard )
+    {
+        return false;
+    }
+
+    for( int board = 0; board < GameBoard::CELLS; board++ )
+    {
+        if( marks[X_Player][board] != other.marks[X_Player][board]
+            || marks[O_Player][board] != other.marks[O_Player][board] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,55 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The UltimatePosition class is a position of Ultimate
+*  Tic Tac Toe: a 3x3 grid of 3x3 boards, where the cell a player picks
+*  sends the other player to the board in the same place. Winning a
+*  board claims its place on the grid and three boards in a row win the
+*  game. Each board is a 9 bit mask per player, and the won and closed
+*  boards are kept as 9 bit masks of the grid that are updated with
+*  every move, so no move rescans the whole position.
+*********************************************************************/
+#ifndef ULTIMATE_POSITION_HPP
+#define ULTIMATE_POSITION_HPP
+
+#include "gameBoard.hpp"
+
+class UltimatePosition
+{
+    private:
+        uint16_t marks[2][GameBoard::CELLS]; //Per player, per board.
+        uint16_t won[2]; //Boards won by each player.
+        uint16_t closed; //Boards that are won or full.
+        int8_t activeBoard; //Board to move in, or ANY_BOARD.
+        Player toMove;
+        Outcome outcome;
+
+        static bool completesLine( uint16_t, int );
+
+    public:
+        //Cell numbers are board * 9 + cell within the board.
+        static const int CELLS = GameBoard::CELLS * GameBoard::CELLS;
+        static const int MAX_MOVES = CELLS;
+        static const int ANY_BOARD = -1;
+
+        UltimatePosition( Player toMove = X_Player );
+        bool play( int );
+        int getMoves( int* ) const;
+        uint16_t getPlayableBoards() const;
+        uint16_t getMoveMask( int ) const;
+        Player getPick( int ) const;
+
+        //Getter functions.
+        Player getToMove() const { return toMove; };
+        Outcome getOutcome() const { return outcome; };
+        int getActiveBoard() const { return activeBoard; };
+        uint16_t getWonBoards( Player player ) const { return won[player]; };
+        uint16_t getClosedBoards() const { return closed; };
+        uint16_t getBoardMarks( int board, Player player ) const { return marks[player][board]; };
+
+        bool operator==( const UltimatePosition & ) const;
+        bool operator!=( const UltimatePosition &other ) const { return !( *this == other ); };
+};
+
+#endif
@@ -0,0 +1,343 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ValueTable class holds learned values of m,n,k
+*  positions in a hash table with open addressing. A value belongs to
+*  the position after a move and is the expected result, from -1 to 1,
+*  for the player who made it; positions are keyed by their canonical
+*  key, so reflections and rotations share a value. One thread writes
+*  the table while any number of threads read it, without locks: a
+*  slot's value is stored before its key is published. Tables are saved
+*  to and loaded from files of their used slots, sorted by key.
+*********************************************************************/
+#include "valueTable.hpp"
+#include "openingBook.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+
+/*********************************************************************
+** Description: Constructor. The table has no slots until create() or
+*  load().
+*********************************************************************/
+ValueTable::ValueTable() : used( 0 )
+{
+    slots = NULL;
+    mask = 0;
+    width = 0;
+    height = 0;
+    k = 0;
+}
+
+/*********************************************************************
+** Description: Destructor.
+*********************************************************************/
+ValueTable::~ValueTable()
+{
+    delete [] slots;
+}
+
+/*********************************************************************
+** Description: Creates an empty table, replacing any values.
+*
+*  Parameters:
+*  1. int width, int height, int k - the board size.
+*  2. int bits - the table has 2 to the power bits slots, 16 bytes each.
+*
+*  Return: bool - false if the memory could not be allocated.
+*********************************************************************/
+bool ValueTable::create( int width, int height, int k, int bits )
+{
+    delete [] slots;
+    slots = new (std::nothrow) Slot[1ULL << bits];
+
+    if( slots == NULL )
+    {
+        printf( "Could not allocate a value table of %llu slots!\n", 1ULL << bits );
+        mask = 0;
+        return false;
+    }
+
+    mask = ( 1ULL << bits ) - 1;
+    used.store( 0 );
+    this->width = width;
+    this->height = height;
+    this->k = k;
+
+    for( uint64_t i = 0; i <= mask; i++ )
+    {
+        slots[i].key.store( EMPTY, std::memory_order_relaxed );
+        slots[i].value.store( 0.0f, std::memory_order_relaxed );
+        slots[i].updates = 0;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Finds the slot of a key, probing the slots after its
+*  hash.
+*
+*  Parameters: uint64_t key - the position's key.
+*              bool claim - returns the first empty slot if the key is
+*              missing. Writer thread only.
+*
+*  Return: Slot* - the slot, or NULL if the key is missing and not
+*  claimed, or the probed slots are all used.
+*********************************************************************/
+ValueTable::Slot* ValueTable::findSlot( uint64_t key, bool claim ) const
+{
+    if( slots == NULL )
+    {
+        return NULL;
+    }
+
+    uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+
+    for( int probe = 0; probe < PROBES; probe++ )
+    {
+        Slot* slot = &slots[( ( hash >> 32 ) + probe ) & mask];
+        uint64_t found = slot->key.load( std::memory_order_acquire );
+
+        if( found == key )
+        {
+            return slot;
+        }
+
+        if( found == EMPTY )
+        {
+            return claim ? slot : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/*********************************************************************
+** Description: Returns the value of a position. Any thread.
+*
+*  Parameters: uint64_t key - the position's key, from afterKey().
+*
+*  Return: float - the value, 0 if the position was never updated.
+*********************************************************************/
+float ValueTable::value( uint64_t key ) const
+{
+    Slot* slot = findSlot( key, false );
+
+    return slot == NULL ? 0.0f : slot->value.load( std::memory_order_relaxed );
+}
+
+/*********************************************************************
+** Description: Moves the value of a position a step towards a target.
+*  Writer thread only.
+*
+*  Parameters:
+*  1. uint64_t key - the position's key, from afterKey().
+*  2. float target - the value it should have.
+*  3. float alpha - the step, from 0 to 1.
+*
+*  Return: bool - false if the table had no room for the position.
+*********************************************************************/
+bool ValueTable::update( uint64_t key, float target, float alpha )
+{
+    Slot* slot = findSlot( key, true );
+
+    if( slot == NULL )
+    {
+        return false;
+    }
+
+    float old = slot->value.load( std::memory_order_relaxed );
+    slot->value.store( old + alpha * ( target - old ), std::memory_order_relaxed );
+    slot->updates++;
+
+    if( slot->key.load( std::memory_order_relaxed ) == EMPTY )
+    {
+        slot->key.store( key, std::memory_order_release );
+        used.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Chooses the move leading to the position of the best
+*  value. A move that wins is worth 1 and one that draws 0, and ties
+*  are broken at random.
+*
+*  Parameters: MnkPosition position - the position to move in.
+*              Random random - breaks ties.
+*
+*  Return: int - the chosen cell, or -1 if there is no legal move.
+*********************************************************************/
+int ValueTable::chooseMove( const MnkPosition &position, Random &random ) const
+{
+    int moves[MnkPosition::MAX_MOVES],
+        best[MnkPosition::MAX_MOVES];
+    int count = position.getMoves( moves ),
+        bestCount = 0;
+    float bestValue = -2.0f;
+
+    for( int i = 0; i < count; i++ )
+    {
+        MnkPosition next = position;
+        next.play( moves[i] );
+
+        float result;
+
+        if( next.getOutcome() == UNFINISHED )
+            result = value( afterKey( next ) );
+
+        else
+            result = next.getOutcome() == DRAW ? 0.0f : 1.0f;
+
+        if( result > bestValue )
+        {
+            bestValue = result;
+            bestCount = 0;
+        }
+
+        if( result == bestValue )
+        {
+            best[bestCount++] = moves[i];
+        }
+    }
+
+    return bestCount > 0 ? best[random.nextInt( bestCount )] : -1;
+}
+
+/*********************************************************************
+** Description: Returns the key a position's value is stored under: its
+*  canonical key, which holds the marks of the player to move, the one
+*  who did not make the last move, above the other player's.
+*
+*  Parameters: MnkPosition position - the position after a move.
+*
+*  Return: uint64_t - the key.
+*********************************************************************/
+uint64_t ValueTable::afterKey( const MnkPosition &position )
+{
+    int transform = 0;
+
+    return OpeningBook::canonicalKey( position, transform );
+}
+
+/*********************************************************************
+** Description: Writes the used slots to a file, sorted by key. Safe
+*  while other threads read the table, but not while it is updated.
+*
+*  Parameters: string path - the file.
+*
+*  Return: bool - false if the file could not be written.
+*********************************************************************/
+bool ValueTable::save( const string &path ) const
+{
+    std::vector< Entry > entries;
+    entries.reserve( getUsed() );
+
+    for( uint64_t i = 0; slots != NULL && i <= mask; i++ )
+    {
+        uint64_t key = slots[i].key.load( std::memory_order_relaxed );
+
+        if( key != EMPTY )
+        {
+            Entry entry;
+            entry.key = key;
+            entry.value = slots[i].value.load( std::memory_order_relaxed );
+            entry.updates = slots[i].updates;
+            entries.push_back( entry );
+        }
+    }
+
+    std::sort( entries.begin(), entries.end(), []( const Entry &a, const Entry &b ) { return a.key < b.key; } );
+
+    MappedFile out;
+
+    if( !out.create( path, sizeof( Header ) + entries.size() * sizeof( Entry ) ) )
+    {
+        printf( "Could not write %s!\n", path.c_str() );
+        return false;
+    }
+
+    Header header;
+    memcpy( header.magic, "MNKV", 4 );
+    header.width = static_cast<uint8_t>( width );
+    header.height = static_cast<uint8_t>( height );
+    header.k = static_cast<uint8_t>( k );
+    header.reserved = 0;
+    header.count = entries.size();
+    memcpy( out.getData(), &header, sizeof( header ) );
+
+    if( !entries.empty() )
+    {
+        memcpy( out.getData() + sizeof( header ), &entries[0], entries.size() * sizeof( Entry ) );
+    }
+
+    return true;
+}
+
+/*********************************************************************
+** Description: Reads a value file into a new table.
+*
+*  Parameters: string path - the file.
+*              int bits - the table has 2 to the power bits slots, or
+*              0 for twice the values in the file.
+*
+*  Return: bool - false if the file is missing or is not a value file.
+*********************************************************************/
+bool ValueTable::load( const string &path, int bits )
+{
+    MappedFile file;
+    Header header;
+
+    if( !file.open( path ) )
+    {
+        return false;
+    }
+
+    memcpy( &header, file.getData(), std::min( file.getSize(), sizeof( Header ) ) );
+
+    if( file.getSize() < sizeof( Header ) || memcmp( header.magic, "MNKV", 4 ) != 0
+        || !MnkPosition::validSize( header.width, header.height, header.k )
+        || file.getSize() != sizeof( Header ) + header.count * sizeof( Entry ) )
+    {
+        printf( "%s is not a value table!\n", path.c_str() );
+        return false;
+    }
+
+    if( bits == 0 )
+    {
+        bits = 10;
+
+        while( ( 1ULL << bits ) < 2 * header.count )
+        {
+            bits++;
+        }
+    }
+
+    if( !create( header.width, header.height, header.k, bits ) )
+    {
+        return false;
+    }
+
+    const Entry* entries = reinterpret_cast< const Entry* >( file.getData() + sizeof( Header ) );
+
+    for( uint64_t i = 0; i < header.count; i++ )
+    {
+        Slot* slot = findSlot( entries[i].key, true );
+
+        if( slot != NULL )
+        {
+            slot->value.store( entries[i].value, std::memory_order_relaxed );
+            slot->updates = entries[i].updates;
+            slot->key.store( entries[i].key, std::memory_order_release );
+            used.fetch_add( 1, std::memory_order_relaxed );
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,99 @@
+/*********************************************************************
+** Program name: Tic Tac Toe
+** Author: Long Le
+** Date: 10/19/2026
+** Description: The ValueTable class holds learned values of m,n,k
+*  positions in a hash table with open addressing. A value belongs to
+*  the position after a move and is the expected result, from -1 to 1,
+*  for the player who made it; positions are keyed by their canonical
+*  key, so reflections and rotations share a value. One thread writes
+*  the table while any number of threads read it, without locks: a
+*  slot's value is stored before its key is published. Tables are saved
+*  to and loaded from files of their used slots, sorted by key.
+*********************************************************************/
+#ifndef VALUE_TABLE_HPP
+#define VALUE_TABLE_HPP
+
+#include "mnkPosition.hpp"
+#include "random.hpp"
+#include <atomic>
+#include <string>
+
+using std::string;
+
+class ValueTable
+{
+    public:
+        /*********************************************************************
+         ** Description: This struct starts a value file. The entries
+         *  follow, sorted by key.
+         *********************************************************************/
+        struct Header
+        {
+            char magic[4]; //"MNKV"
+            uint8_t width,
+                    height,
+                    k,
+                    reserved;
+            uint64_t count;
+        };
+
+        /*********************************************************************
+         ** Description: This struct is one value in a value file.
+         *********************************************************************/
+        struct Entry
+        {
+            uint64_t key;
+            float value;
+            uint32_t updates;
+        };
+
+    private:
+        /*********************************************************************
+         ** Description: This struct is one slot of the hash table.
+         *********************************************************************/
+        struct Slot
+        {
+            std::atomic< uint64_t > key; //EMPTY until the slot is used.
+            std::atomic< float > value;
+            uint32_t updates; //Writer thread only.
+        };
+
+        static const uint64_t EMPTY = ~0ULL; //No position has every cell twice.
+        static const int PROBES = 16;
+
+        Slot* slots;
+        uint64_t mask;
+        std::atomic< uint64_t > used;
+        int width,
+            height,
+            k;
+
+        //Private functions.
+        Slot* findSlot( uint64_t, bool ) const;
+
+        //The slots are owned by one table only.
+        ValueTable( const ValueTable & );
+        ValueTable& operator=( const ValueTable & );
+
+    public:
+        ValueTable();
+        ~ValueTable();
+        bool create( int, int, int, int );
+        float value( uint64_t ) const;
+        bool update( uint64_t, float, float );
+        int chooseMove( const MnkPosition &, Random & ) const;
+        bool save( const string & ) const;
+        bool load( const string &, int = 0 );
+
+        //Getter functions.
+        uint64_t getUsed() const { return used.load( std::memory_order_relaxed ); };
+        uint64_t getCapacity() const { return slots == NULL ? 0 : mask + 1; };
+        int getWidth() const { return width; };
+        int getHeight() const { return height; };
+        int getK() const { return k; };
+
+        static uint64_t afterKey( const MnkPosition & );
+};
+
+#endif